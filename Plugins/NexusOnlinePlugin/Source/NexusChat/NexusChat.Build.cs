@@ -23,7 +23,10 @@ public class NexusChat : ModuleRules
                 "NetCore",
                 "UMG",
                 "InputCore",
-                "RenderCore"
+                "RenderCore",
+                "DeveloperSettings",
+                "Sockets",
+                "Networking"
             }
         );
     }
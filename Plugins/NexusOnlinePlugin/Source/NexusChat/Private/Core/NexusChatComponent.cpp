@@ -7,6 +7,14 @@
 #include "Net/UnrealNetwork.h"
 #include "Types/NexusChatTypes.h"
 #include "Core/NexusChatSubsystem.h"
+#include "Core/NexusChatStats.h"
+#include "Core/NexusChatSegments.h"
+#include "Core/NexusChatHistoryStore.h"
+#include "Relay/NexusChatRelaySubsystem.h"
+#include "Engine/GameInstance.h"
+#include "Engine/NetConnection.h"
+#include "Engine/ActorChannel.h"
+#include "TimerManager.h"
 
 const float UNexusChatComponent::DefaultSpamCooldown = 0.5f;
 
@@ -36,6 +44,7 @@ void UNexusChatComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>&
     Super::GetLifetimeReplicatedProps(OutLifetimeProps);
     DOREPLIFETIME(UNexusChatComponent, TeamId);
     DOREPLIFETIME(UNexusChatComponent, PartyId);
+    DOREPLIFETIME(UNexusChatComponent, GuildName);
     DOREPLIFETIME(UNexusChatComponent, ChatConfig);
 }
 
@@ -89,6 +98,128 @@ void UNexusChatComponent::SetPartyId(int32 NewPartyId)
     }
 }
 
+void UNexusChatComponent::SetGuildName(FName NewGuildName)
+{
+    if (!GetOwner()->HasAuthority() || GuildName == NewGuildName)
+        return;
+
+    GuildName = NewGuildName;
+
+    // Le relay route les messages de guilde par serveur : il doit connaitre la nouvelle guilde
+    if (UGameInstance* GI = GetWorld() ? GetWorld()->GetGameInstance() : nullptr)
+    {
+        if (UNexusChatRelaySubsystem* Relay = GI->GetSubsystem<UNexusChatRelaySubsystem>())
+        {
+            Relay->UpdatePlayerPresence(Cast<APlayerController>(GetOwner()));
+        }
+    }
+}
+
+void UNexusChatComponent::ReceiveRelayedMessage(const FNexusChatMessage& Message)
+{
+    if (GetOwner()->HasAuthority())
+    {
+        DeliverMessage(Message);
+    }
+}
+
+void UNexusChatComponent::DeliverMessage(const FNexusChatMessage& Message)
+{
+    if (!ChatConfig)
+    {
+        Client_ReceiveChatMessage(Message);
+        return;
+    }
+
+    const FNexusChatDeliverySettings Delivery = ChatConfig->GetDeliverySettings(Message.Channel);
+
+    // 1. Shedding : ne pas remplir davantage une connexion deja saturee avec du chat basse priorite
+    if (Delivery.bSheddable && GetConnectionSaturation() >= ChatConfig->ShedSaturationThreshold)
+    {
+        NexusChatStats::RecordDropped(Message.Channel);
+        return;
+    }
+
+    // 2. Coalescing : la premiere ligne part tout de suite, les doublons sont regroupes en une ligne "(xN)"
+    // (N = toutes les occurrences, la premiere comprise)
+    if (Delivery.bCoalesceDuplicates)
+    {
+        if (bHasPendingCoalesced
+            && PendingCoalesced.Channel == Message.Channel
+            && PendingCoalesced.SenderName == Message.SenderName
+            && PendingCoalesced.MessageContent == Message.MessageContent)
+        {
+            PendingCoalesced.RepeatCount++;
+            PendingCoalesced.Timestamp = Message.Timestamp;
+            return;
+        }
+
+        FlushCoalescedMessage();
+        SendToClient(Message, Delivery);
+
+        PendingCoalesced = Message;
+        PendingCoalesced.RepeatCount = 1;
+        bHasPendingCoalesced = true;
+
+        if (UWorld* World = GetWorld())
+        {
+            World->GetTimerManager().SetTimer(CoalesceTimerHandle, this, &UNexusChatComponent::FlushCoalescedMessage, ChatConfig->CoalesceWindow, false);
+        }
+        return;
+    }
+
+    SendToClient(Message, Delivery);
+}
+
+void UNexusChatComponent::SendToClient(const FNexusChatMessage& Message, const FNexusChatDeliverySettings& Delivery)
+{
+    if (Delivery.Delivery == ENexusChatDelivery::UnreliableSequenced)
+    {
+        Client_ReceiveChatMessageUnreliable(Message, ++NextUnreliableSequence);
+    }
+    else
+    {
+        Client_ReceiveChatMessage(Message);
+    }
+}
+
+void UNexusChatComponent::FlushCoalescedMessage()
+{
+    NEXUSCHAT_TRACE_SCOPE(NexusChat_FlushCoalesced);
+
+    if (UWorld* World = GetWorld())
+    {
+        World->GetTimerManager().ClearTimer(CoalesceTimerHandle);
+    }
+
+    if (!bHasPendingCoalesced)
+        return;
+
+    bHasPendingCoalesced = false;
+    // Aucun doublon depuis la premiere ligne : rien a ajouter
+    if (PendingCoalesced.RepeatCount > 1 && ChatConfig)
+    {
+        SendToClient(PendingCoalesced, ChatConfig->GetDeliverySettings(PendingCoalesced.Channel));
+    }
+}
+
+float UNexusChatComponent::GetConnectionSaturation() const
+{
+    const APlayerController* PC = Cast<APlayerController>(GetOwner());
+    if (!PC || PC->IsLocalController())
+        return 0.f;
+
+    UNetConnection* Connection = PC->GetNetConnection();
+    if (!Connection)
+        return 0.f;
+
+    const UActorChannel* Channel = Connection->FindActorChannelRef(GetOwner());
+    if (!Channel)
+        return 0.f;
+
+    return FMath::Clamp(static_cast<float>(Channel->NumOutRec) / static_cast<float>(RELIABLE_BUFFER), 0.f, 1.f);
+}
+
 void UNexusChatComponent::RegisterBlueprintCommand(FString CommandName)
 {
     if (CommandName.IsEmpty())
@@ -100,7 +231,7 @@ void UNexusChatComponent::RegisterBlueprintCommand(FString CommandName)
         OnCustomCommand.Broadcast(CleanCmd, Params);
     }));
     
-    UE_LOG(LogTemp, Log, TEXT("[NexusChat] Registered BP command: %s"), *CleanCmd);
+    UE_LOG(LogNexusChat, Log, TEXT("[NexusChat] Registered BP command: %s"), *CleanCmd);
 }
 
 // ──────────────────────────────────────────────
@@ -114,17 +245,35 @@ bool UNexusChatComponent::Server_SendChatMessage_Validate(const FString& Content
 
 void UNexusChatComponent::Server_SendChatMessage_Implementation(const FString& Content, ENexusChatChannel Channel, FName ChannelName)
 {
+    NEXUSCHAT_TRACE_SCOPE(NexusChat_ServerSend);
+
+    NexusChatStats::RecordReceived(Channel);
+
     APlayerController* PC = Cast<APlayerController>(GetOwner());
     if (!PC || !PC->PlayerState)
+    {
+        NexusChatStats::RecordDropped(Channel);
         return;
-
-    FString ProcessedContent = Content;
-    
-    FilterProfanity(ProcessedContent);
+    }
 
     FNexusChatMessage Msg;
+    if (ChatConfig && ChatConfig->bStructuredPayloads)
+    {
+        // Segments : pas d'echappement, le client ne parse jamais le contenu. Le masquage garde la longueur des spans.
+        // Texte client : chaque <link> est verifie, sinon il reste du texte (pas de lien url/joueur/objet forge)
+        NexusChatSegments::Tokenize(Content, Msg, [this](ENexusChatSegmentType Type, FStringView Display, FStringView Data)
+        {
+            return IsClientLinkAllowed(Type, Display, Data);
+        });
+        MaskProfanity(Msg.MessageContent);
+    }
+    else
+    {
+        Msg.MessageContent = Content;
+        FilterProfanity(Msg.MessageContent);
+    }
+
     Msg.SenderName = PC->PlayerState->GetPlayerName();
-    Msg.MessageContent = ProcessedContent;
     Msg.Channel = Channel;
     Msg.ChannelName = ChannelName;
     Msg.SenderTeamId = TeamId;
@@ -132,7 +281,19 @@ void UNexusChatComponent::Server_SendChatMessage_Implementation(const FString& C
     Msg.Timestamp = FDateTime::Now();
     Msg.TargetName = ChannelName.IsNone() ? "" : ChannelName.ToString();
 
-    if (UWorld* World = GetWorld())
+    if (Channel == ENexusChatChannel::Guild)
+    {
+        if (GuildName.IsNone())
+        {
+            NexusChatStats::RecordDropped(Channel);
+            Client_ReceiveChatMessage(FNexusChatMessage::MakeSystem("You are not in a guild."));
+            return;
+        }
+        Msg.TargetName = GuildName.ToString();
+    }
+
+    UWorld* World = GetWorld();
+    if (World)
     {
         if (UNexusChatSubsystem* ChatSubsystem = World->GetSubsystem<UNexusChatSubsystem>())
         {
@@ -141,10 +302,23 @@ void UNexusChatComponent::Server_SendChatMessage_Implementation(const FString& C
     }
 
     RouteMessage(Msg);
+
+    // Cross-server (Global / Guild / Whisper vers un joueur absent de ce serveur)
+    if (UGameInstance* GI = World ? World->GetGameInstance() : nullptr)
+    {
+        if (UNexusChatRelaySubsystem* Relay = GI->GetSubsystem<UNexusChatRelaySubsystem>())
+        {
+            Relay->PublishMessage(Msg);
+        }
+    }
 }
 
 void UNexusChatComponent::RouteMessage(const FNexusChatMessage& Msg)
 {
+    SCOPE_CYCLE_COUNTER(STAT_NexusChat_RouteTime);
+    NEXUSCHAT_TRACE_SCOPE(NexusChat_RouteMessage);
+    CSV_SCOPED_TIMING_STAT(NexusChat, RouteMessage);
+
     APlayerController* SenderPC = Cast<APlayerController>(GetOwner());
     UWorld* World = GetWorld();
     if (!World || !SenderPC)
@@ -156,7 +330,7 @@ void UNexusChatComponent::RouteMessage(const FNexusChatMessage& Msg)
     // ─────────────────────────────────────────────────────────────────
     // A. ROUTING HYBRIDE
     // ─────────────────────────────────────────────────────────────────
-    if (Msg.Channel != ENexusChatChannel::Global && Msg.Channel != ENexusChatChannel::System && Msg.Channel != ENexusChatChannel::GameLog)
+    if (Msg.Channel != ENexusChatChannel::Global && Msg.Channel != ENexusChatChannel::System && Msg.Channel != ENexusChatChannel::GameLog && Msg.Channel != ENexusChatChannel::Guild)
     {
         if (OnRoutingQuery.IsBound())
         {
@@ -223,6 +397,16 @@ void UNexusChatComponent::RouteMessage(const FNexusChatMessage& Msg)
                     break;
                 }
 
+                case ENexusChatChannel::Guild:
+                {
+                    UNexusChatComponent* TargetComp = TargetPC->FindComponentByClass<UNexusChatComponent>();
+                    if (TargetComp && !TargetComp->GetGuildName().IsNone() && TargetComp->GetGuildName().ToString() == Msg.TargetName)
+                    {
+                        bShouldReceive = true;
+                    }
+                    break;
+                }
+
                 case ENexusChatChannel::Whisper:
                 {
                     // For Whisper, target is specified in Msg.ChannelName
@@ -250,11 +434,13 @@ void UNexusChatComponent::RouteMessage(const FNexusChatMessage& Msg)
     // ─────────────────────────────────────────────────────────────────
     // C. ENVOI FINAL
     // ─────────────────────────────────────────────────────────────────
+    NexusChatStats::RecordRouted(Msg.Channel, Recipients.Num(), NexusChatStats::EstimateNetSize(Msg));
+
     for (APlayerController* Target : Recipients)
     {
         if (UNexusChatComponent* TargetComp = Target->FindComponentByClass<UNexusChatComponent>())
         {
-            TargetComp->Client_ReceiveChatMessage(Msg);
+            TargetComp->DeliverMessage(Msg);
         }
     }
 }
@@ -265,6 +451,33 @@ void UNexusChatComponent::RouteMessage(const FNexusChatMessage& Msg)
 
 void UNexusChatComponent::Client_ReceiveChatMessage_Implementation(const FNexusChatMessage& Message)
 {
+    HandleIncomingMessage(Message);
+}
+
+void UNexusChatComponent::Client_ReceiveChatMessageUnreliable_Implementation(const FNexusChatMessage& Message, uint32 Sequence)
+{
+    // Arrive en retard ou en double : deja remplace par un message plus recent
+    if (Sequence <= LastUnreliableSequence)
+        return;
+
+    const uint32 Missed = Sequence - LastUnreliableSequence - 1;
+    LastUnreliableSequence = Sequence;
+
+    const int32 GapTolerance = ChatConfig ? ChatConfig->SequenceGapTolerance : 0;
+    if (Missed > static_cast<uint32>(GapTolerance))
+    {
+        HandleIncomingMessage(FNexusChatMessage::MakeSystem(FString::Printf(TEXT("%u chat message(s) lost."), Missed)));
+    }
+
+    HandleIncomingMessage(Message);
+}
+
+void UNexusChatComponent::HandleIncomingMessage(const FNexusChatMessage& Message)
+{
+    NEXUSCHAT_TRACE_SCOPE(NexusChat_HandleIncoming);
+
+    NexusChatStats::RecordClientReceived(Message.Channel, NexusChatStats::EstimateNetSize(Message));
+
     if (Message.Channel == ENexusChatChannel::Whisper)
     {
         LastWhisperSender = Message.SenderName;
@@ -272,6 +485,15 @@ void UNexusChatComponent::Client_ReceiveChatMessage_Implementation(const FNexusC
     
     ClientChatHistory.Add(Message);
 
+    // Copie locale (GameInstance) : sert a reconstruire l'historique si ce client devient l'heritier
+    if (UNexusChatHistoryStore* Store = GetHistoryStore())
+    {
+        if (GetNetMode() == NM_Client)
+        {
+            Store->AddToLocalCopy(Message);
+        }
+    }
+
     OnMessageReceived.Broadcast(Message);
 }
 
@@ -293,6 +515,15 @@ void UNexusChatComponent::Server_RequestChatHistory_Implementation()
 void UNexusChatComponent::Client_ReceiveChatHistory_Implementation(const TArray<FNexusChatMessage>& History)
 {
     ClientChatHistory = History;
+
+    if (UNexusChatHistoryStore* Store = GetHistoryStore())
+    {
+        if (GetNetMode() == NM_Client)
+        {
+            Store->SetLocalCopy(History);
+        }
+    }
+
     OnChatHistoryReceived.Broadcast(ClientChatHistory);
 }
 
@@ -300,13 +531,30 @@ void UNexusChatComponent::Client_ReceiveChatHistory_Implementation(const TArray<
 // UTILS & LOGIC
 // ──────────────────────────────────────────────
 
+UNexusChatHistoryStore* UNexusChatComponent::GetHistoryStore() const
+{
+    const UWorld* World = GetWorld();
+    const UGameInstance* GI = World ? World->GetGameInstance() : nullptr;
+    return GI ? GI->GetSubsystem<UNexusChatHistoryStore>() : nullptr;
+}
+
 void UNexusChatComponent::FilterProfanity(FString& Message)
 {
     // 1. Sécurité HTML (Anti-Injection)
     Message = Message.Replace(TEXT("<"), TEXT("&lt;"));
     Message = Message.Replace(TEXT(">"), TEXT("&gt;"));
 
-    // 2. Censure (Config)
+    // 2. Censure
+    MaskProfanity(Message);
+}
+
+void UNexusChatComponent::MaskProfanity(FString& Message)
+{
+    SCOPE_CYCLE_COUNTER(STAT_NexusChat_FilterTime);
+    NEXUSCHAT_TRACE_SCOPE(NexusChat_FilterProfanity);
+    CSV_SCOPED_TIMING_STAT(NexusChat, FilterProfanity);
+
+    // Le masque a la meme longueur que le mot : les spans des segments restent valides
     if (ChatConfig)
     {
         for (const FString& BadWord : ChatConfig->BannedWords)
@@ -328,6 +576,45 @@ void UNexusChatComponent::FilterProfanity(FString& Message)
     }
 }
 
+bool UNexusChatComponent::IsClientLinkAllowed(ENexusChatSegmentType Type, FStringView Display, FStringView Data) const
+{
+    if (!ChatConfig || !ChatConfig->ClientLinkTypes.Contains(Type))
+        return false;
+
+    APlayerController* PC = Cast<APlayerController>(GetOwner());
+    const FStringView Payload = Data.IsEmpty() ? Display : Data;
+
+    switch (Type)
+    {
+        case ENexusChatSegmentType::Url:
+            // Le texte affiche doit etre l'adresse ouverte
+            return Payload == Display && NexusChatSegments::IsSafeUrl(Payload);
+
+        case ENexusChatSegmentType::Player:
+        {
+            const UWorld* World = GetWorld();
+            const AGameStateBase* GS = World ? World->GetGameState() : nullptr;
+            if (!GS)
+                return false;
+
+            for (const APlayerState* PS : GS->PlayerArray)
+            {
+                if (PS && Payload.Equals(PS->GetPlayerName(), ESearchCase::IgnoreCase))
+                    return true;
+            }
+            return false;
+        }
+
+        case ENexusChatSegmentType::Item:
+        case ENexusChatSegmentType::Quest:
+        case ENexusChatSegmentType::Gps:
+            return OnValidateLink.IsBound() && OnValidateLink.Execute(PC, Type, FString(Payload));
+
+        default:
+            return false;
+    }
+}
+
 FString UNexusChatComponent::DecorateMessage(const FString& Message, ENexusChatChannel Channel) const
 {
     // Note: Cette fonction est maintenant purement utilitaire pour le Client.
@@ -360,6 +647,8 @@ void UNexusChatComponent::RegisterCommands()
     RegisterInternalCommand(TEXT("/r"), FChatCommandDelegate::CreateUObject(this, &UNexusChatComponent::Cmd_Reply));
     RegisterInternalCommand(TEXT("/reply"), FChatCommandDelegate::CreateUObject(this, &UNexusChatComponent::Cmd_Reply));
     RegisterInternalCommand(TEXT("/team"), FChatCommandDelegate::CreateUObject(this, &UNexusChatComponent::Cmd_Team));
+    RegisterInternalCommand(TEXT("/g"), FChatCommandDelegate::CreateUObject(this, &UNexusChatComponent::Cmd_Guild));
+    RegisterInternalCommand(TEXT("/guild"), FChatCommandDelegate::CreateUObject(this, &UNexusChatComponent::Cmd_Guild));
 }
 
 void UNexusChatComponent::RegisterInternalCommand(const FString& Command, FChatCommandDelegate Callback)
@@ -423,6 +712,11 @@ void UNexusChatComponent::Cmd_Team(const FString& Params)
     Server_SendChatMessage(Params, ENexusChatChannel::Team);
 }
 
+void UNexusChatComponent::Cmd_Guild(const FString& Params)
+{
+    Server_SendChatMessage(Params, ENexusChatChannel::Guild);
+}
+
 void UNexusChatComponent::Cmd_Reply(const FString& Params)
 {
     if (LastWhisperSender.IsEmpty())
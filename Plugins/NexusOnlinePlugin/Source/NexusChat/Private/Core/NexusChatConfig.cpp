@@ -3,4 +3,27 @@
 UNexusChatConfig::UNexusChatConfig()
 {
 	SpamCooldown = 0.5f;
+
+	ClientLinkTypes = { ENexusChatSegmentType::Player, ENexusChatSegmentType::Item, ENexusChatSegmentType::Url,
+		ENexusChatSegmentType::Quest, ENexusChatSegmentType::Gps };
+
+	FNexusChatDeliverySettings Unreliable;
+	Unreliable.Delivery = ENexusChatDelivery::UnreliableSequenced;
+	Unreliable.bSheddable = true;
+
+	FNexusChatDeliverySettings GameLog = Unreliable;
+	GameLog.bCoalesceDuplicates = true;
+
+	ChannelDelivery.Add(ENexusChatChannel::Global, Unreliable);
+	ChannelDelivery.Add(ENexusChatChannel::GameLog, GameLog);
+	ChannelDelivery.Add(ENexusChatChannel::Whisper, FNexusChatDeliverySettings());
+}
+
+FNexusChatDeliverySettings UNexusChatConfig::GetDeliverySettings(ENexusChatChannel Channel) const
+{
+	if (const FNexusChatDeliverySettings* Found = ChannelDelivery.Find(Channel))
+	{
+		return *Found;
+	}
+	return FNexusChatDeliverySettings();
 }
@@ -0,0 +1,99 @@
+#include "Core/NexusChatHistoryStore.h"
+#include "Core/NexusChatStats.h"
+#include "Engine/World.h"
+
+
+void UNexusChatHistoryStore::Deinitialize()
+{
+	History.Empty();
+	LocalCopy.Empty();
+	Super::Deinitialize();
+}
+
+// ──────────────────────────────────────────────
+// AUTHORITATIVE HISTORY
+// ──────────────────────────────────────────────
+
+void UNexusChatHistoryStore::AddMessage(const FNexusChatMessage& Msg)
+{
+	History.Add(Msg);
+	Trim(History);
+
+	NexusChatStats::RecordHistorySize(History.Num());
+}
+
+void UNexusChatHistoryStore::ClearHistory()
+{
+	History.Reset();
+	NexusChatStats::RecordHistorySize(0);
+}
+
+// ──────────────────────────────────────────────
+// LOCAL COPY
+// ──────────────────────────────────────────────
+
+void UNexusChatHistoryStore::AddToLocalCopy(const FNexusChatMessage& Msg)
+{
+	LocalCopy.Add(Msg);
+	Trim(LocalCopy);
+}
+
+void UNexusChatHistoryStore::SetLocalCopy(const TArray<FNexusChatMessage>& Messages)
+{
+	LocalCopy = Messages;
+	Trim(LocalCopy);
+}
+
+void UNexusChatHistoryStore::SeedFromLocalCopy()
+{
+	History.Reset(LocalCopy.Num());
+
+	// Team / Party / Whisper received by the heir must not be served to everybody
+	for (FNexusChatMessage& Msg : LocalCopy)
+	{
+		if (Msg.Channel == ENexusChatChannel::Global || Msg.Channel == ENexusChatChannel::System || Msg.Channel == ENexusChatChannel::GameLog)
+		{
+			History.Add(MoveTemp(Msg));
+		}
+	}
+
+	LocalCopy.Reset();
+	NexusChatStats::RecordHistorySize(History.Num());
+
+	UE_LOG(LogNexusChat, Log, TEXT("[NexusChat] History seeded from local copy (%d messages)."), History.Num());
+}
+
+void UNexusChatHistoryStore::NotifyWorldBeginPlay(const UWorld& World)
+{
+	const ENetMode NetMode = World.GetNetMode();
+
+	switch (NetMode)
+	{
+		case NM_ListenServer:
+			// Client world replaced by a listen server : we are the migration heir
+			if (LastNetMode == NM_Client && !LocalCopy.IsEmpty())
+			{
+				SeedFromLocalCopy();
+			}
+			break;
+
+		case NM_Standalone:
+			// Back to menu : nothing from the previous session should leak into the next one
+			LocalCopy.Reset();
+			History.Reset();
+			break;
+
+		default:
+			break;
+	}
+
+	LastNetMode = NetMode;
+}
+
+void UNexusChatHistoryStore::Trim(TArray<FNexusChatMessage>& Messages) const
+{
+	if (Messages.Num() > MaxHistorySize)
+	{
+		Messages.RemoveAt(0, Messages.Num() - MaxHistorySize, EAllowShrinking::No);
+	}
+}
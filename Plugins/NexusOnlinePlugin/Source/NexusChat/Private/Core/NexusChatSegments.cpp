@@ -0,0 +1,349 @@
+#include "Core/NexusChatSegments.h"
+#include "Core/NexusLinkHelpers.h"
+
+namespace NexusChatSegments
+{
+	namespace
+	{
+		const FStringView LinkOpen = TEXTVIEW("<link ");
+		const FStringView LinkClose = TEXTVIEW("</>");
+
+		void AddSegment(FNexusChatMessage& OutMsg, ENexusChatSegmentType Type, FStringView Display, FStringView Data)
+		{
+			if (Display.IsEmpty())
+				return;
+
+			// Merge consecutive text runs
+			if (Type == ENexusChatSegmentType::Text && OutMsg.Segments.Num() > 0 && OutMsg.Segments.Last().Type == ENexusChatSegmentType::Text)
+			{
+				OutMsg.MessageContent.Append(Display);
+				OutMsg.Segments.Last().Length += Display.Len();
+				return;
+			}
+
+			FNexusChatSegment& Segment = OutMsg.Segments.AddDefaulted_GetRef();
+			Segment.Type = Type;
+			Segment.Start = OutMsg.MessageContent.Len();
+			Segment.Length = Display.Len();
+			OutMsg.MessageContent.Append(Display);
+
+			if (!Data.IsEmpty() && Data != Display)
+			{
+				Segment.DataStart = OutMsg.SegmentData.Len();
+				Segment.DataLength = Data.Len();
+				OutMsg.SegmentData.Append(Data);
+			}
+		}
+
+		bool IsUrlTerminator(TCHAR C)
+		{
+			return FChar::IsWhitespace(C) || C == TEXT('<') || C == TEXT('>') || C == TEXT('"');
+		}
+
+		/** Plain text, with bare http(s) URLs promoted to Url segments. */
+		void AddText(FNexusChatMessage& OutMsg, FStringView Text)
+		{
+			int32 TextStart = 0;
+			int32 Index = 0;
+
+			while (Index < Text.Len())
+			{
+				const FStringView Rest = Text.RightChop(Index);
+				int32 SchemeLen = 0;
+				if (Rest.StartsWith(TEXTVIEW("http://"), ESearchCase::IgnoreCase))
+				{
+					SchemeLen = 7;
+				}
+				else if (Rest.StartsWith(TEXTVIEW("https://"), ESearchCase::IgnoreCase))
+				{
+					SchemeLen = 8;
+				}
+
+				if (SchemeLen == 0)
+				{
+					++Index;
+					continue;
+				}
+
+				int32 End = Index + SchemeLen;
+				while (End < Text.Len() && !IsUrlTerminator(Text[End]))
+				{
+					++End;
+				}
+
+				if (End == Index + SchemeLen)
+				{
+					Index = End;
+					continue;
+				}
+
+				AddSegment(OutMsg, ENexusChatSegmentType::Text, Text.Mid(TextStart, Index - TextStart), FStringView());
+				AddSegment(OutMsg, ENexusChatSegmentType::Url, Text.Mid(Index, End - Index), FStringView());
+
+				Index = End;
+				TextStart = End;
+			}
+
+			AddSegment(OutMsg, ENexusChatSegmentType::Text, Text.RightChop(TextStart), FStringView());
+		}
+
+		/** Reads attr="value" inside a tag header. */
+		bool FindAttribute(FStringView Header, FStringView Name, FStringView& OutValue)
+		{
+			const FString Pattern = FString::Printf(TEXT("%.*s=\""), Name.Len(), Name.GetData());
+			const int32 ValueStart = UE::String::FindFirst(Header, Pattern, ESearchCase::IgnoreCase);
+			if (ValueStart == INDEX_NONE)
+				return false;
+
+			const FStringView AfterQuote = Header.RightChop(ValueStart + Pattern.Len());
+			int32 QuoteIndex = INDEX_NONE;
+			if (!AfterQuote.FindChar(TEXT('"'), QuoteIndex))
+				return false;
+
+			OutValue = AfterQuote.Left(QuoteIndex);
+			return true;
+		}
+
+		struct FParsedLink
+		{
+			ENexusChatSegmentType Type = ENexusChatSegmentType::Text;
+			FStringView Display;
+			FString Data;
+			int32 Consumed = 0;
+		};
+
+		/**
+		 * Reads <link type="x" data="y">Display</> at the start of Input.
+		 * Returns false if this is not a well-formed link of a known type.
+		 */
+		bool TryReadLink(FStringView Input, FParsedLink& OutLink)
+		{
+			int32 HeaderEnd = INDEX_NONE;
+			if (!Input.FindChar(TEXT('>'), HeaderEnd))
+				return false;
+
+			const FStringView Header = Input.Mid(LinkOpen.Len(), HeaderEnd - LinkOpen.Len());
+
+			FStringView TypeName, RawData;
+			if (!FindAttribute(Header, TEXTVIEW("type"), TypeName) || !ParseLinkType(TypeName, OutLink.Type))
+				return false;
+
+			FindAttribute(Header, TEXTVIEW("data"), RawData);
+
+			const FStringView Body = Input.RightChop(HeaderEnd + 1);
+			const int32 CloseIndex = UE::String::FindFirst(Body, LinkClose);
+			if (CloseIndex == INDEX_NONE)
+				return false;
+
+			// Inverse of UNexusLinkHelpers::MakeLink escaping
+			OutLink.Data = FString(RawData).Replace(TEXT("&quot;"), TEXT("\"")).Replace(TEXT("&amp;"), TEXT("&"));
+			OutLink.Display = Body.Left(CloseIndex);
+			OutLink.Consumed = HeaderEnd + 1 + CloseIndex + LinkClose.Len();
+			return true;
+		}
+
+		void TokenizeImpl(const FString& RawContent, FNexusChatMessage& OutMsg, FLinkFilter Filter)
+		{
+			OutMsg.MessageContent.Reset(RawContent.Len());
+			OutMsg.Segments.Reset();
+			OutMsg.SegmentData.Reset();
+
+			const FStringView Raw(RawContent);
+			int32 TextStart = 0;
+			int32 Index = 0;
+
+			while (Index < Raw.Len())
+			{
+				const int32 TagStart = UE::String::FindFirst(Raw.RightChop(Index), LinkOpen, ESearchCase::IgnoreCase);
+				if (TagStart == INDEX_NONE)
+					break;
+
+				const int32 TagIndex = Index + TagStart;
+
+				FParsedLink Link;
+				if (!TryReadLink(Raw.RightChop(TagIndex), Link))
+				{
+					// Not a link we know : stays plain text
+					Index = TagIndex + 1;
+					continue;
+				}
+
+				AddText(OutMsg, Raw.Mid(TextStart, TagIndex - TextStart));
+				if (Filter(Link.Type, Link.Display, Link.Data))
+				{
+					AddSegment(OutMsg, Link.Type, Link.Display, Link.Data);
+				}
+				else
+				{
+					// Lien refuse : seul le texte affiche est garde, la balise disparait
+					AddText(OutMsg, Link.Display);
+				}
+
+				Index = TagIndex + Link.Consumed;
+				TextStart = Index;
+			}
+
+			AddText(OutMsg, Raw.RightChop(TextStart));
+		}
+	}
+
+	const TCHAR* GetLinkTypeName(ENexusChatSegmentType Type)
+	{
+		switch (Type)
+		{
+			case ENexusChatSegmentType::Player: return TEXT("player");
+			case ENexusChatSegmentType::Item:   return TEXT("item");
+			case ENexusChatSegmentType::Url:    return TEXT("url");
+			case ENexusChatSegmentType::Quest:  return TEXT("quest");
+			case ENexusChatSegmentType::Gps:    return TEXT("gps");
+			default:                            return TEXT("");
+		}
+	}
+
+	bool ParseLinkType(FStringView Name, ENexusChatSegmentType& OutType)
+	{
+		static const ENexusChatSegmentType LinkTypes[] =
+		{
+			ENexusChatSegmentType::Player, ENexusChatSegmentType::Item, ENexusChatSegmentType::Url,
+			ENexusChatSegmentType::Quest, ENexusChatSegmentType::Gps
+		};
+
+		for (ENexusChatSegmentType Type : LinkTypes)
+		{
+			if (Name.Equals(GetLinkTypeName(Type), ESearchCase::IgnoreCase))
+			{
+				OutType = Type;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void Tokenize(const FString& RawContent, FNexusChatMessage& OutMsg)
+	{
+		TokenizeImpl(RawContent, OutMsg, [](ENexusChatSegmentType, FStringView, FStringView) { return true; });
+	}
+
+	void Tokenize(const FString& RawContent, FNexusChatMessage& OutMsg, FLinkFilter Filter)
+	{
+		TokenizeImpl(RawContent, OutMsg, Filter);
+	}
+
+	bool IsSafeUrl(FStringView Url)
+	{
+		int32 SchemeLen = 0;
+		if (Url.StartsWith(TEXTVIEW("http://"), ESearchCase::IgnoreCase))
+		{
+			SchemeLen = 7;
+		}
+		else if (Url.StartsWith(TEXTVIEW("https://"), ESearchCase::IgnoreCase))
+		{
+			SchemeLen = 8;
+		}
+		else
+		{
+			return false;
+		}
+
+		for (TCHAR C : Url)
+		{
+			if (IsUrlTerminator(C) || C < 0x20)
+				return false;
+		}
+
+		// Host : jusqu'au premier '/', '?' ou '#'. Pas d'identifiants ("user@host") qui masquent la vraie destination
+		const FStringView AfterScheme = Url.RightChop(SchemeLen);
+		int32 HostEnd = 0;
+		while (HostEnd < AfterScheme.Len() && AfterScheme[HostEnd] != TEXT('/') && AfterScheme[HostEnd] != TEXT('?') && AfterScheme[HostEnd] != TEXT('#'))
+		{
+			++HostEnd;
+		}
+
+		const FStringView Host = AfterScheme.Left(HostEnd);
+		if (Host.IsEmpty() || Host.StartsWith(TEXT('.')) || Host.StartsWith(TEXT(':')))
+			return false;
+
+		for (TCHAR C : Host)
+		{
+			if (!(C < 128 && FChar::IsAlnum(C)) && C != TEXT('.') && C != TEXT('-') && C != TEXT(':'))
+				return false;
+		}
+		return true;
+	}
+
+	bool IsSegmentValid(const FNexusChatMessage& Msg, const FNexusChatSegment& Segment)
+	{
+		return Segment.Start >= 0 && Segment.Length >= 0 && Segment.Start + Segment.Length <= Msg.MessageContent.Len()
+			&& Segment.DataStart >= 0 && Segment.DataLength >= 0 && Segment.DataStart + Segment.DataLength <= Msg.SegmentData.Len();
+	}
+
+	bool AreSegmentsValid(const FNexusChatMessage& Msg)
+	{
+		int32 Expected = 0;
+		for (const FNexusChatSegment& Segment : Msg.Segments)
+		{
+			if (!IsSegmentValid(Msg, Segment) || Segment.Start != Expected || Segment.Type > ENexusChatSegmentType::Gps)
+				return false;
+
+			if (Segment.Type == ENexusChatSegmentType::Url && (Segment.DataLength != 0 || !IsSafeUrl(GetDisplayText(Msg, Segment))))
+				return false;
+
+			Expected = Segment.Start + Segment.Length;
+		}
+		return Expected == Msg.MessageContent.Len();
+	}
+
+	FStringView GetDisplayText(const FNexusChatMessage& Msg, const FNexusChatSegment& Segment)
+	{
+		return FStringView(Msg.MessageContent).Mid(Segment.Start, Segment.Length);
+	}
+
+	FStringView GetData(const FNexusChatMessage& Msg, const FNexusChatSegment& Segment)
+	{
+		if (Segment.DataLength == 0)
+		{
+			return GetDisplayText(Msg, Segment);
+		}
+		return FStringView(Msg.SegmentData).Mid(Segment.DataStart, Segment.DataLength);
+	}
+
+	FString ToMarkup(const FNexusChatMessage& Msg)
+	{
+		FString Result;
+		Result.Reserve(Msg.MessageContent.Len() + Msg.SegmentData.Len() + Msg.Segments.Num() * 32);
+
+		for (const FNexusChatSegment& Segment : Msg.Segments)
+		{
+			if (!IsSegmentValid(Msg, Segment))
+				continue;
+
+			const FString Display = EscapeMarkup(GetDisplayText(Msg, Segment));
+			if (Segment.Type == ENexusChatSegmentType::Text)
+			{
+				Result += Display;
+			}
+			else
+			{
+				Result += UNexusLinkHelpers::MakeLink(GetLinkTypeName(Segment.Type), FString(GetData(Msg, Segment)), Display);
+			}
+		}
+		return Result;
+	}
+
+	FString EscapeMarkup(FStringView Text)
+	{
+		FString Result;
+		Result.Reserve(Text.Len());
+
+		for (TCHAR C : Text)
+		{
+			switch (C)
+			{
+				case TEXT('<'): Result += TEXT("&lt;"); break;
+				case TEXT('>'): Result += TEXT("&gt;"); break;
+				default:        Result.AppendChar(C); break;
+			}
+		}
+		return Result;
+	}
+}
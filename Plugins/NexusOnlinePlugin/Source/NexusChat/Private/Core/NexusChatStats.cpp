@@ -0,0 +1,184 @@
+#include "Core/NexusChatStats.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/OutputDevice.h"
+
+DEFINE_LOG_CATEGORY(LogNexusChat);
+
+UE_TRACE_CHANNEL_DEFINE(NexusChatChannel);
+
+DEFINE_STAT(STAT_NexusChat_FilterTime);
+DEFINE_STAT(STAT_NexusChat_RouteTime);
+DEFINE_STAT(STAT_NexusChat_HistoryTime);
+DEFINE_STAT(STAT_NexusChat_MessagesReceived);
+DEFINE_STAT(STAT_NexusChat_MessagesRouted);
+DEFINE_STAT(STAT_NexusChat_MessagesDropped);
+DEFINE_STAT(STAT_NexusChat_Recipients);
+DEFINE_STAT(STAT_NexusChat_BytesSerialized);
+DEFINE_STAT(STAT_NexusChat_ClientReceived);
+DEFINE_STAT(STAT_NexusChat_LastRecipients);
+DEFINE_STAT(STAT_NexusChat_HistorySize);
+
+CSV_DEFINE_CATEGORY_MODULE(NEXUSCHAT_API, NexusChat, true);
+
+// Unreal Insights (-trace=counters), à côté des scopes du canal NexusChat
+TRACE_DECLARE_INT_COUNTER(NexusChat_MessagesReceived, TEXT("Nexus/Chat/Messages Received"));
+TRACE_DECLARE_INT_COUNTER(NexusChat_MessagesRouted, TEXT("Nexus/Chat/Messages Routed"));
+TRACE_DECLARE_INT_COUNTER(NexusChat_MessagesDropped, TEXT("Nexus/Chat/Messages Dropped"));
+TRACE_DECLARE_INT_COUNTER(NexusChat_LastRecipients, TEXT("Nexus/Chat/Recipients (Last Message)"));
+
+namespace NexusChatStats
+{
+	namespace
+	{
+		constexpr int32 WindowSeconds = 60;
+
+		enum ECounter : uint8
+		{
+			Received,
+			Routed,
+			Dropped,
+			Bytes,
+			ClientReceived,
+			NumCounters
+		};
+
+		/** One second bucket. Stamp is the absolute second it belongs to, stale buckets are ignored. */
+		struct FBucket
+		{
+			int64 Stamp = -1;
+			int64 Values[NumCounters] = {};
+		};
+
+		struct FChannelWindow
+		{
+			FBucket Buckets[WindowSeconds];
+
+			void Add(ECounter Counter, int64 Amount)
+			{
+				const int64 Second = static_cast<int64>(FPlatformTime::Seconds());
+				FBucket& Bucket = Buckets[Second % WindowSeconds];
+				if (Bucket.Stamp != Second)
+				{
+					Bucket = FBucket();
+					Bucket.Stamp = Second;
+				}
+				Bucket.Values[Counter] += Amount;
+			}
+
+			void Sum(int64 (&OutTotals)[NumCounters]) const
+			{
+				const int64 Now = static_cast<int64>(FPlatformTime::Seconds());
+				for (const FBucket& Bucket : Buckets)
+				{
+					if (Bucket.Stamp >= 0 && Now - Bucket.Stamp < WindowSeconds)
+					{
+						for (int32 i = 0; i < NumCounters; ++i)
+						{
+							OutTotals[i] += Bucket.Values[i];
+						}
+					}
+				}
+			}
+		};
+
+		TMap<ENexusChatChannel, FChannelWindow>& GetWindows()
+		{
+			static TMap<ENexusChatChannel, FChannelWindow> Windows;
+			return Windows;
+		}
+
+		void AddToWindow(ENexusChatChannel Channel, ECounter Counter, int64 Amount)
+		{
+			check(IsInGameThread());
+			GetWindows().FindOrAdd(Channel).Add(Counter, Amount);
+		}
+
+		FAutoConsoleCommandWithOutputDevice DumpRatesCommand(
+			TEXT("NexusChat.DumpRates"),
+			TEXT("Dumps per-channel chat rates (messages/s, bytes/s) over the last minute."),
+			FConsoleCommandWithOutputDeviceDelegate::CreateStatic(&DumpRates));
+	}
+
+	int32 EstimateNetSize(const FNexusChatMessage& Msg)
+	{
+		// 4 byte length prefix per string, 8 timestamp, 1 channel, ~4 FName, 2 * 4 ids, ~6 per packed segment
+		return (Msg.SenderName.Len() + 4)
+			+ (Msg.MessageContent.Len() + 4)
+			+ (Msg.TargetName.Len() + 4)
+			+ 8 + 1 + 4 + 8
+			+ (Msg.Segments.Num() > 0 ? Msg.Segments.Num() * 6 + Msg.SegmentData.Len() + 4 : 1);
+	}
+
+	void RecordReceived(ENexusChatChannel Channel)
+	{
+		INC_DWORD_STAT(STAT_NexusChat_MessagesReceived);
+		CSV_CUSTOM_STAT(NexusChat, MessagesReceived, 1, ECsvCustomStatOp::Accumulate);
+		TRACE_COUNTER_INCREMENT(NexusChat_MessagesReceived);
+		AddToWindow(Channel, Received, 1);
+	}
+
+	void RecordRouted(ENexusChatChannel Channel, int32 NumRecipients, int32 MessageBytes)
+	{
+		const int32 TotalBytes = NumRecipients * MessageBytes;
+
+		INC_DWORD_STAT(STAT_NexusChat_MessagesRouted);
+		INC_DWORD_STAT_BY(STAT_NexusChat_Recipients, NumRecipients);
+		INC_DWORD_STAT_BY(STAT_NexusChat_BytesSerialized, TotalBytes);
+		SET_DWORD_STAT(STAT_NexusChat_LastRecipients, NumRecipients);
+
+		CSV_CUSTOM_STAT(NexusChat, MessagesRouted, 1, ECsvCustomStatOp::Accumulate);
+		CSV_CUSTOM_STAT(NexusChat, Recipients, NumRecipients, ECsvCustomStatOp::Accumulate);
+		CSV_CUSTOM_STAT(NexusChat, BytesSerialized, TotalBytes, ECsvCustomStatOp::Accumulate);
+
+		TRACE_COUNTER_INCREMENT(NexusChat_MessagesRouted);
+		TRACE_COUNTER_SET(NexusChat_LastRecipients, NumRecipients);
+
+		AddToWindow(Channel, Routed, NumRecipients);
+		AddToWindow(Channel, Bytes, TotalBytes);
+	}
+
+	void RecordDropped(ENexusChatChannel Channel)
+	{
+		INC_DWORD_STAT(STAT_NexusChat_MessagesDropped);
+		CSV_CUSTOM_STAT(NexusChat, MessagesDropped, 1, ECsvCustomStatOp::Accumulate);
+		TRACE_COUNTER_INCREMENT(NexusChat_MessagesDropped);
+		AddToWindow(Channel, Dropped, 1);
+	}
+
+	void RecordClientReceived(ENexusChatChannel Channel, int32 MessageBytes)
+	{
+		INC_DWORD_STAT(STAT_NexusChat_ClientReceived);
+		CSV_CUSTOM_STAT(NexusChat, ClientMessagesReceived, 1, ECsvCustomStatOp::Accumulate);
+		CSV_CUSTOM_STAT(NexusChat, ClientBytesReceived, MessageBytes, ECsvCustomStatOp::Accumulate);
+		AddToWindow(Channel, ClientReceived, 1);
+	}
+
+	void RecordHistorySize(int32 HistorySize)
+	{
+		SET_DWORD_STAT(STAT_NexusChat_HistorySize, HistorySize);
+		CSV_CUSTOM_STAT(NexusChat, HistorySize, HistorySize, ECsvCustomStatOp::Set);
+	}
+
+	void DumpRates(FOutputDevice& Ar)
+	{
+		const UEnum* ChannelEnum = StaticEnum<ENexusChatChannel>();
+
+		Ar.Logf(TEXT("[NexusChat] Rates over the last %d s (per second):"), WindowSeconds);
+		Ar.Logf(TEXT("  %-10s %10s %10s %10s %12s %10s"), TEXT("Channel"), TEXT("Received"), TEXT("Delivered"), TEXT("Dropped"), TEXT("Bytes"), TEXT("ClientRx"));
+
+		for (const auto& Pair : GetWindows())
+		{
+			int64 Totals[NumCounters] = {};
+			Pair.Value.Sum(Totals);
+
+			const FString ChannelName = ChannelEnum ? ChannelEnum->GetNameStringByValue(static_cast<int64>(Pair.Key)) : FString::FromInt(static_cast<int32>(Pair.Key));
+			Ar.Logf(TEXT("  %-10s %10.2f %10.2f %10.2f %12.1f %10.2f"),
+				*ChannelName,
+				Totals[Received] / static_cast<double>(WindowSeconds),
+				Totals[Routed] / static_cast<double>(WindowSeconds),
+				Totals[Dropped] / static_cast<double>(WindowSeconds),
+				Totals[Bytes] / static_cast<double>(WindowSeconds),
+				Totals[ClientReceived] / static_cast<double>(WindowSeconds));
+		}
+	}
+}
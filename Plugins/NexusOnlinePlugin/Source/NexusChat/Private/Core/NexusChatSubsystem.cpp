@@ -1,11 +1,15 @@
 #include "Core/NexusChatSubsystem.h"
 #include "HAL/PlatformProcess.h"
+#include "Core/NexusChatStats.h"
+#include "Core/NexusChatHistoryStore.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
 
 
 void UNexusChatSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
-	GlobalChatHistory.Empty();
+	FallbackHistory.Empty();
 	FilteredChannels.Empty();
 	LinkHandlers.Empty();
 }
@@ -16,13 +20,55 @@ void UNexusChatSubsystem::Deinitialize()
 	Super::Deinitialize();
 }
 
+void UNexusChatSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (UNexusChatHistoryStore* Store = GetHistoryStore())
+	{
+		Store->NotifyWorldBeginPlay(InWorld);
+	}
+}
+
+UNexusChatHistoryStore* UNexusChatSubsystem::GetHistoryStore() const
+{
+	const UWorld* World = GetWorld();
+	const UGameInstance* GI = World ? World->GetGameInstance() : nullptr;
+	return GI ? GI->GetSubsystem<UNexusChatHistoryStore>() : nullptr;
+}
+
+const TArray<FNexusChatMessage>& UNexusChatSubsystem::GetHistory() const
+{
+	if (const UNexusChatHistoryStore* Store = GetHistoryStore())
+	{
+		return Store->GetHistory();
+	}
+	return FallbackHistory;
+}
+
 // ════════════════════════════════════════════════════════════════════════════════
 // HISTORY MANAGEMENT
 // ════════════════════════════════════════════════════════════════════════════════
 
 void UNexusChatSubsystem::AddMessage(const FNexusChatMessage& Msg)
 {
-	GlobalChatHistory.Add(Msg);
+	SCOPE_CYCLE_COUNTER(STAT_NexusChat_HistoryTime);
+	NEXUSCHAT_TRACE_SCOPE(NexusChat_AddToHistory);
+	CSV_SCOPED_TIMING_STAT(NexusChat, AddMessage);
+
+	if (UNexusChatHistoryStore* Store = GetHistoryStore())
+	{
+		Store->AddMessage(Msg);
+	}
+	else
+	{
+		FallbackHistory.Add(Msg);
+		if (FallbackHistory.Num() > 50)
+		{
+			FallbackHistory.RemoveAt(0);
+		}
+		NexusChatStats::RecordHistorySize(FallbackHistory.Num());
+	}
 
 	if (Msg.Channel == ENexusChatChannel::Whisper)
 	{
@@ -45,23 +91,20 @@ void UNexusChatSubsystem::AddMessage(const FNexusChatMessage& Msg)
 		if (Msg.TargetName != TEXT("System")) ActiveWhisperTargets.Add(Msg.TargetName);
 	}
 
-	if (GlobalChatHistory.Num() > MaxHistorySize)
-	{
-		GlobalChatHistory.RemoveAt(0);
-	}
 }
 
 TArray<FNexusChatMessage> UNexusChatSubsystem::GetFilteredHistory() const
 {
+	const TArray<FNexusChatMessage>& History = GetHistory();
 	if (FilteredChannels.IsEmpty())
 	{
-		return GlobalChatHistory;
+		return History;
 	}
 
 	TArray<FNexusChatMessage> Result;
-	Result.Reserve(GlobalChatHistory.Num());
+	Result.Reserve(History.Num());
 
-	for (const FNexusChatMessage& Msg : GlobalChatHistory)
+	for (const FNexusChatMessage& Msg : History)
 	{
 		if (IsMessagePassesFilter(Msg))
 		{
@@ -184,7 +227,7 @@ void UNexusChatSubsystem::HandleUrlLink(const FString& Url)
 
 void UNexusChatSubsystem::HandlePlayerLink(const FString& PlayerName)
 {
-	UE_LOG(LogTemp, Log, TEXT("[NexusChat] Player link clicked: %s"), *PlayerName);
+	UE_LOG(LogNexusChat, Log, TEXT("[NexusChat] Player link clicked: %s"), *PlayerName);
 }
 
 void UNexusChatSubsystem::AddWhisperTarget(const FString& PlayerName)
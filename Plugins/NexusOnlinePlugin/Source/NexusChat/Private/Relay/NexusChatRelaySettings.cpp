@@ -0,0 +1,16 @@
+#include "Relay/NexusChatRelaySettings.h"
+#include "Relay/NexusChatRelayProtocol.h"
+
+UNexusChatRelaySettings::UNexusChatRelaySettings()
+{
+	CategoryName = TEXT("Game");
+	SectionName = TEXT("Nexus Chat Relay");
+
+	bEnableRelay = false;
+	RelayHost = TEXT("127.0.0.1");
+	RelayPort = NexusChatRelay::DEFAULT_PORT;
+	ReconnectDelay = 3.0f;
+	FlushInterval = 0.05f;
+	MaxBatchMessages = 128;
+	MaxQueuedBytes = 256 * 1024;
+}
@@ -0,0 +1,549 @@
+#include "Relay/NexusChatRelaySubsystem.h"
+#include "Relay/NexusChatRelaySettings.h"
+#include "Core/NexusChatComponent.h"
+#include "Core/NexusChatSubsystem.h"
+#include "Core/NexusChatStats.h"
+#include "Core/NexusChatSegments.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerState.h"
+#include "IPAddress.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+
+using namespace NexusChatRelay;
+
+namespace
+{
+	constexpr double ConnectTimeoutSeconds = 5.0;
+
+	bool ToRelayRoute(ENexusChatChannel Channel, ERoute& OutRoute)
+	{
+		switch (Channel)
+		{
+			case ENexusChatChannel::Global:  OutRoute = ERoute::Global;  return true;
+			case ENexusChatChannel::Guild:   OutRoute = ERoute::Guild;   return true;
+			case ENexusChatChannel::Whisper: OutRoute = ERoute::Whisper; return true;
+			default: return false;
+		}
+	}
+
+	ENexusChatChannel FromRelayRoute(ERoute Route)
+	{
+		switch (Route)
+		{
+			case ERoute::Guild:   return ENexusChatChannel::Guild;
+			case ERoute::Whisper: return ENexusChatChannel::Whisper;
+			default:              return ENexusChatChannel::Global;
+		}
+	}
+}
+
+// ──────────────────────────────────────────────
+// LIFECYCLE
+// ──────────────────────────────────────────────
+
+bool UNexusChatRelaySubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	FString Override;
+	return GetDefault<UNexusChatRelaySettings>()->bEnableRelay
+		|| FParse::Value(FCommandLine::Get(), TEXT("-NexusChatRelay="), Override);
+}
+
+void UNexusChatRelaySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	const UNexusChatRelaySettings* Settings = GetDefault<UNexusChatRelaySettings>();
+	RelayHost = Settings->RelayHost;
+	RelayPort = Settings->RelayPort;
+
+	// -NexusChatRelay=127.0.0.1:7790
+	FString Override;
+	if (FParse::Value(FCommandLine::Get(), TEXT("-NexusChatRelay="), Override))
+	{
+		FString Host, PortStr;
+		if (Override.Split(TEXT(":"), &Host, &PortStr))
+		{
+			RelayHost = Host;
+			RelayPort = FCString::Atoi(*PortStr);
+		}
+		else
+		{
+			RelayHost = Override;
+		}
+	}
+
+	TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UNexusChatRelaySubsystem::Tick));
+	PostLoginHandle = FGameModeEvents::GameModePostLoginEvent.AddUObject(this, &UNexusChatRelaySubsystem::OnPostLogin);
+	LogoutHandle = FGameModeEvents::GameModeLogoutEvent.AddUObject(this, &UNexusChatRelaySubsystem::OnLogout);
+
+	UE_LOG(LogNexusChat, Log, TEXT("[NexusChatRelay] Relay client initialized (%s:%d)."), *RelayHost, RelayPort);
+}
+
+void UNexusChatRelaySubsystem::Deinitialize()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+	FGameModeEvents::GameModePostLoginEvent.Remove(PostLoginHandle);
+	FGameModeEvents::GameModeLogoutEvent.Remove(LogoutHandle);
+
+	CloseConnection(TEXT("Shutdown"));
+
+	Super::Deinitialize();
+}
+
+bool UNexusChatRelaySubsystem::IsServerWorld() const
+{
+	const UWorld* World = GetGameInstance() ? GetGameInstance()->GetWorld() : nullptr;
+	if (!World)
+		return false;
+
+	const ENetMode NetMode = World->GetNetMode();
+	return NetMode == NM_ListenServer || NetMode == NM_DedicatedServer;
+}
+
+bool UNexusChatRelaySubsystem::Tick(float DeltaTime)
+{
+	if (!IsServerWorld())
+	{
+		if (ConnectionState != EConnectionState::Disconnected)
+		{
+			CloseConnection(TEXT("No longer a server"));
+		}
+		return true;
+	}
+
+	switch (ConnectionState)
+	{
+		case EConnectionState::Disconnected:
+		{
+			const float ReconnectDelay = GetDefault<UNexusChatRelaySettings>()->ReconnectDelay;
+			if (LastConnectAttemptTime < 0.0 || FPlatformTime::Seconds() - LastConnectAttemptTime >= ReconnectDelay)
+			{
+				BeginConnect();
+			}
+			break;
+		}
+
+		case EConnectionState::Connecting:
+			PollConnect();
+			break;
+
+		case EConnectionState::Handshaking:
+		case EConnectionState::Connected:
+			PollConnected();
+			break;
+	}
+
+	return true;
+}
+
+// ──────────────────────────────────────────────
+// PUBLIC API
+// ──────────────────────────────────────────────
+
+void UNexusChatRelaySubsystem::PublishMessage(const FNexusChatMessage& Msg)
+{
+	NEXUSCHAT_TRACE_SCOPE(NexusChatRelay_Publish);
+
+	ERoute Route;
+	if (!ToRelayRoute(Msg.Channel, Route))
+		return;
+
+	if (ConnectionState != EConnectionState::Connected)
+		return;
+
+	FMessage RelayMsg;
+	RelayMsg.Route = Route;
+	RelayMsg.SenderName = Msg.SenderName;
+	RelayMsg.Content = Msg.MessageContent;
+	RelayMsg.TimestampTicks = Msg.Timestamp.GetTicks();
+	RelayMsg.SegmentData = Msg.SegmentData;
+	RelayMsg.Segments.Reserve(Msg.Segments.Num());
+	for (const FNexusChatSegment& Segment : Msg.Segments)
+	{
+		FSegment& Wire = RelayMsg.Segments.AddDefaulted_GetRef();
+		Wire.Type = static_cast<uint8>(Segment.Type);
+		Wire.Start = Segment.Start;
+		Wire.Length = Segment.Length;
+		Wire.DataStart = Segment.DataStart;
+		Wire.DataLength = Segment.DataLength;
+	}
+
+	if (Route == ERoute::Whisper)
+	{
+		// Target is in ChannelName (see UNexusChatComponent::RouteMessage). Local whispers never leave the server.
+		RelayMsg.Target = Msg.ChannelName.ToString();
+		if (RelayMsg.Target.IsEmpty() || IsPlayerLocal(RelayMsg.Target))
+			return;
+	}
+	else if (Route == ERoute::Guild)
+	{
+		RelayMsg.Target = Msg.TargetName;
+		if (RelayMsg.Target.IsEmpty())
+			return;
+	}
+
+	// Backpressure : shed Global first, Guild/Whisper are kept
+	const int32 MaxQueuedBytes = GetDefault<UNexusChatRelaySettings>()->MaxQueuedBytes;
+	if (Route == ERoute::Global && Stream->GetQueuedBytes() + OutgoingBatchBytes > MaxQueuedBytes)
+	{
+		DroppedMessages++;
+		NexusChatStats::RecordDropped(Msg.Channel);
+		return;
+	}
+
+	OutgoingBatchBytes += RelayMsg.GetApproximateSize();
+	OutgoingBatch.Add(MoveTemp(RelayMsg));
+}
+
+void UNexusChatRelaySubsystem::UpdatePlayerPresence(APlayerController* PC)
+{
+	if (ConnectionState == EConnectionState::Connected)
+	{
+		SendPresence(PC);
+	}
+}
+
+bool UNexusChatRelaySubsystem::IsPlayerLocal(const FString& PlayerName) const
+{
+	const UWorld* World = GetGameInstance() ? GetGameInstance()->GetWorld() : nullptr;
+	const AGameStateBase* GS = World ? World->GetGameState() : nullptr;
+	if (!GS)
+		return false;
+
+	for (const APlayerState* PS : GS->PlayerArray)
+	{
+		if (PS && PS->GetPlayerName() == PlayerName)
+			return true;
+	}
+	return false;
+}
+
+// ──────────────────────────────────────────────
+// CONNECTION
+// ──────────────────────────────────────────────
+
+void UNexusChatRelaySubsystem::BeginConnect()
+{
+	LastConnectAttemptTime = FPlatformTime::Seconds();
+
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+	if (!SocketSubsystem)
+		return;
+
+	TSharedRef<FInternetAddr> Addr = SocketSubsystem->CreateInternetAddr();
+	bool bIsValid = false;
+	Addr->SetIp(*RelayHost, bIsValid);
+	Addr->SetPort(RelayPort);
+
+	if (!bIsValid)
+	{
+		UE_LOG(LogNexusChat, Warning, TEXT("[NexusChatRelay] Invalid relay address '%s'."), *RelayHost);
+		return;
+	}
+
+	PendingSocket = SocketSubsystem->CreateSocket(NAME_Stream, TEXT("NexusChatRelayClient"), Addr->GetProtocolType());
+	if (!PendingSocket)
+		return;
+
+	PendingSocket->SetNonBlocking(true);
+	if (!PendingSocket->Connect(*Addr))
+	{
+		SocketSubsystem->DestroySocket(PendingSocket);
+		PendingSocket = nullptr;
+		return;
+	}
+
+	ConnectionState = EConnectionState::Connecting;
+}
+
+void UNexusChatRelaySubsystem::PollConnect()
+{
+	const ESocketConnectionState State = PendingSocket->GetConnectionState();
+
+	if (State == SCS_Connected)
+	{
+		Stream = MakeUnique<FStream>(PendingSocket);
+		PendingSocket = nullptr;
+
+		FHello Hello;
+		Hello.ServerName = ResolveServerName();
+		Stream->QueueFrame(EFrameType::Hello, MakePayload(Hello));
+
+		ConnectionState = EConnectionState::Handshaking;
+		return;
+	}
+
+	if (State == SCS_ConnectionError || FPlatformTime::Seconds() - LastConnectAttemptTime > ConnectTimeoutSeconds)
+	{
+		CloseConnection(TEXT("Connect failed"));
+	}
+}
+
+void UNexusChatRelaySubsystem::PollConnected()
+{
+	TArray<FFrame> Frames;
+	const bool bAlive = Stream->Receive(Frames);
+
+	for (const FFrame& Frame : Frames)
+	{
+		HandleFrame(Frame);
+	}
+
+	if (!bAlive)
+	{
+		CloseConnection(TEXT("Connection lost"));
+		return;
+	}
+
+	const float FlushInterval = GetDefault<UNexusChatRelaySettings>()->FlushInterval;
+	const double Now = FPlatformTime::Seconds();
+	if (OutgoingBatch.Num() > 0 && Now - LastFlushTime >= FlushInterval)
+	{
+		LastFlushTime = Now;
+		FlushOutgoing();
+	}
+
+	if (!Stream->Flush())
+	{
+		CloseConnection(TEXT("Send failed"));
+	}
+}
+
+void UNexusChatRelaySubsystem::CloseConnection(const TCHAR* Reason)
+{
+	if (ConnectionState == EConnectionState::Connected)
+	{
+		UE_LOG(LogNexusChat, Warning, TEXT("[NexusChatRelay] Disconnected from relay: %s"), Reason);
+	}
+
+	if (PendingSocket)
+	{
+		if (ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM))
+		{
+			SocketSubsystem->DestroySocket(PendingSocket);
+		}
+		PendingSocket = nullptr;
+	}
+
+	Stream.Reset();
+	OutgoingBatch.Reset();
+	OutgoingBatchBytes = 0;
+	AssignedServerId = 0;
+	ConnectionState = EConnectionState::Disconnected;
+}
+
+// ──────────────────────────────────────────────
+// PROTOCOL
+// ──────────────────────────────────────────────
+
+void UNexusChatRelaySubsystem::HandleFrame(const FFrame& Frame)
+{
+	switch (Frame.Type)
+	{
+		case EFrameType::HelloAck:
+		{
+			if (ReadPayload(Frame.Payload, AssignedServerId))
+			{
+				ConnectionState = EConnectionState::Connected;
+				UE_LOG(LogNexusChat, Log, TEXT("[NexusChatRelay] Connected to relay %s:%d as server #%u."), *RelayHost, RelayPort, AssignedServerId);
+
+				// The relay forgot everything about us if we were disconnected
+				AnnounceAllPlayers();
+			}
+			break;
+		}
+
+		case EFrameType::Batch:
+		{
+			TArray<FMessage> Messages;
+			if (ReadBatchPayload(Frame.Payload, Messages))
+			{
+				for (const FMessage& Msg : Messages)
+				{
+					DeliverRelayedMessage(Msg);
+				}
+			}
+			break;
+		}
+
+		default:
+			break;
+	}
+}
+
+void UNexusChatRelaySubsystem::DeliverRelayedMessage(const FMessage& RelayMsg)
+{
+	NEXUSCHAT_TRACE_SCOPE(NexusChatRelay_Deliver);
+
+	UWorld* World = GetGameInstance() ? GetGameInstance()->GetWorld() : nullptr;
+	AGameStateBase* GS = World ? World->GetGameState() : nullptr;
+	if (!GS)
+		return;
+
+	// Segments tels qu'emis par le serveur d'origine : on ne re-tokenize pas (les liens garderaient leur texte seul)
+	FNexusChatMessage Msg;
+	Msg.MessageContent = RelayMsg.Content;
+	Msg.SegmentData = RelayMsg.SegmentData;
+	Msg.Segments.Reserve(RelayMsg.Segments.Num());
+	for (const FSegment& Wire : RelayMsg.Segments)
+	{
+		FNexusChatSegment& Segment = Msg.Segments.AddDefaulted_GetRef();
+		Segment.Type = static_cast<ENexusChatSegmentType>(Wire.Type);
+		Segment.Start = Wire.Start;
+		Segment.Length = Wire.Length;
+		Segment.DataStart = Wire.DataStart;
+		Segment.DataLength = Wire.DataLength;
+	}
+
+	if (Msg.Segments.Num() > 0 && !NexusChatSegments::AreSegmentsValid(Msg))
+	{
+		// Payload incoherent : tout le message redevient du texte
+		UE_LOG(LogNexusChat, Warning, TEXT("[NexusChatRelay] Invalid segments from server %u, message sent as plain text."), RelayMsg.OriginServerId);
+		Msg.Segments.Reset();
+		Msg.SegmentData.Reset();
+		FNexusChatSegment& Text = Msg.Segments.AddDefaulted_GetRef();
+		Text.Length = Msg.MessageContent.Len();
+	}
+	else if (Msg.Segments.Num() == 0)
+	{
+		// Message legacy, rendu comme markup par le client : jamais de balise venant d'un autre serveur
+		Msg.MessageContent = NexusChatSegments::EscapeMarkup(Msg.MessageContent);
+	}
+	Msg.SenderName = RelayMsg.SenderName;
+	Msg.Timestamp = FDateTime(RelayMsg.TimestampTicks);
+	Msg.Channel = FromRelayRoute(RelayMsg.Route);
+	Msg.TargetName = RelayMsg.Target;
+	if (RelayMsg.Route == ERoute::Whisper)
+	{
+		Msg.ChannelName = FName(*RelayMsg.Target);
+	}
+
+	if (RelayMsg.Route == ERoute::Global)
+	{
+		if (UNexusChatSubsystem* ChatSubsystem = World->GetSubsystem<UNexusChatSubsystem>())
+		{
+			ChatSubsystem->AddMessage(Msg);
+		}
+	}
+
+	for (APlayerState* PS : GS->PlayerArray)
+	{
+		if (!PS)
+			continue;
+
+		APlayerController* TargetPC = Cast<APlayerController>(PS->GetOwner());
+		UNexusChatComponent* TargetComp = TargetPC ? TargetPC->FindComponentByClass<UNexusChatComponent>() : nullptr;
+		if (!TargetComp)
+			continue;
+
+		bool bShouldReceive = false;
+		switch (RelayMsg.Route)
+		{
+			case ERoute::Global:
+				bShouldReceive = true;
+				break;
+
+			case ERoute::Guild:
+				bShouldReceive = !TargetComp->GetGuildName().IsNone() && TargetComp->GetGuildName().ToString() == RelayMsg.Target;
+				break;
+
+			case ERoute::Whisper:
+				bShouldReceive = PS->GetPlayerName() == RelayMsg.Target;
+				break;
+		}
+
+		if (bShouldReceive)
+		{
+			TargetComp->ReceiveRelayedMessage(Msg);
+		}
+	}
+}
+
+void UNexusChatRelaySubsystem::AnnounceAllPlayers()
+{
+	UWorld* World = GetGameInstance() ? GetGameInstance()->GetWorld() : nullptr;
+	if (!World)
+		return;
+
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		SendPresence(It->Get());
+	}
+}
+
+void UNexusChatRelaySubsystem::SendPresence(APlayerController* PC)
+{
+	if (!PC || !PC->PlayerState || !Stream)
+		return;
+
+	FPresence Presence;
+	Presence.PlayerName = PC->PlayerState->GetPlayerName();
+	if (const UNexusChatComponent* Comp = PC->FindComponentByClass<UNexusChatComponent>())
+	{
+		Presence.GuildName = Comp->GetGuildName().IsNone() ? FString() : Comp->GetGuildName().ToString();
+	}
+
+	if (!Presence.PlayerName.IsEmpty())
+	{
+		Stream->QueueFrame(EFrameType::PlayerOnline, MakePayload(Presence));
+	}
+}
+
+void UNexusChatRelaySubsystem::FlushOutgoing()
+{
+	NEXUSCHAT_TRACE_SCOPE(NexusChatRelay_FlushOutgoing);
+
+	const int32 MaxBatch = GetDefault<UNexusChatRelaySettings>()->MaxBatchMessages;
+
+	DroppedMessages += QueueBatchFrames(OutgoingBatch, MaxBatch, [this](const TArray<uint8>& Payload)
+	{
+		Stream->QueueFrame(EFrameType::Batch, Payload);
+	});
+
+	OutgoingBatch.Reset();
+	OutgoingBatchBytes = 0;
+}
+
+// ──────────────────────────────────────────────
+// GAME MODE EVENTS
+// ──────────────────────────────────────────────
+
+void UNexusChatRelaySubsystem::OnPostLogin(AGameModeBase* GameMode, APlayerController* NewPlayer)
+{
+	if (ConnectionState == EConnectionState::Connected && GameMode && GameMode->GetGameInstance() == GetGameInstance())
+	{
+		SendPresence(NewPlayer);
+	}
+}
+
+void UNexusChatRelaySubsystem::OnLogout(AGameModeBase* GameMode, AController* Exiting)
+{
+	if (ConnectionState != EConnectionState::Connected || !GameMode || GameMode->GetGameInstance() != GetGameInstance())
+		return;
+
+	if (Exiting && Exiting->PlayerState)
+	{
+		FString PlayerName = Exiting->PlayerState->GetPlayerName();
+		Stream->QueueFrame(EFrameType::PlayerOffline, MakePayload(PlayerName));
+	}
+}
+
+FString UNexusChatRelaySubsystem::ResolveServerName() const
+{
+	FString Name;
+	if (FParse::Value(FCommandLine::Get(), TEXT("-NexusChatServerName="), Name))
+		return Name;
+
+	Name = GetDefault<UNexusChatRelaySettings>()->ServerName;
+	if (!Name.IsEmpty())
+		return Name;
+
+	const UWorld* World = GetGameInstance() ? GetGameInstance()->GetWorld() : nullptr;
+	const int32 Port = World ? World->URL.Port : 0;
+	return FString::Printf(TEXT("%s:%d"), World ? *World->GetMapName() : TEXT("Unknown"), Port);
+}
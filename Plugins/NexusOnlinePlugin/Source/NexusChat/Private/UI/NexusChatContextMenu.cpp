@@ -3,6 +3,7 @@
 #include "Components/CanvasPanelSlot.h"
 #include "Engine/GameViewportClient.h"
 #include "Engine/Engine.h"
+#include "Core/NexusChatStats.h"
 
 void UNexusChatContextMenu::NativeConstruct()
 {
@@ -62,7 +63,7 @@ void UNexusChatContextMenu::ShowForPlayer(const FString& PlayerName, FVector2D S
 	}
 	else
 	{
-		UE_LOG(LogTemp, Warning, TEXT("[NexusChat] ContextMenu must be placed inside a CanvasPanel to work properly!"));
+		UE_LOG(LogNexusChat, Warning, TEXT("[NexusChat] ContextMenu must be placed inside a CanvasPanel to work properly!"));
 	}
 
 	SetFocus();
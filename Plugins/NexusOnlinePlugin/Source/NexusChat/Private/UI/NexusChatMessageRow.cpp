@@ -3,6 +3,8 @@
 #include "Core/NexusChatComponent.h"
 #include "Core/NexusChatConfig.h"
 #include "Core/NexusLinkHelpers.h"
+#include "Core/NexusChatSegments.h"
+#include "UI/NexusRichTextBlock.h"
 
 void UNexusChatMessageRow::NativeOnListItemObjectSet(UObject* ListItemObject)
 {
@@ -59,18 +61,50 @@ void UNexusChatMessageRow::InitWidget_Implementation(const FNexusChatMessage& Me
 		}
 	}
 
+	const bool bIsSystemMessage = (Message.Channel == ENexusChatChannel::System || Message.Channel == ENexusChatChannel::GameLog);
+	FString PrefixStr = ChannelPrefix.IsEmpty() ? "" : ChannelPrefix.ToString() + " ";
+
 	// ────────────────────────────────────────────────────
-	// 2. Formatage du Contenu
+	// 2. Message structuré (segments) : pas de regex, pas de parsing
+	// ────────────────────────────────────────────────────
+	if (Message.Segments.Num() > 0)
+	{
+		if (UNexusRichTextBlock* NexusText = Cast<UNexusRichTextBlock>(MessageText))
+		{
+			NexusText->SetChatMessage(PrefixStr, Message, !bIsSystemMessage, 15);
+		}
+		else
+		{
+			FString Content = NexusChatSegments::ToMarkup(Message);
+			if (Message.RepeatCount > 1)
+			{
+				Content += FString::Printf(TEXT(" (x%d)"), Message.RepeatCount);
+			}
+
+			const FString SafePrefix = NexusChatSegments::EscapeMarkup(PrefixStr);
+			MessageText->SetText(FText::FromString(bIsSystemMessage
+				? SafePrefix + Content
+				: FString::Printf(TEXT("%s%s: %s"), *SafePrefix, *UNexusLinkHelpers::MakePlayerLink(Message.SenderName, 15), *Content)));
+		}
+
+		MessageText->SetDefaultColorAndOpacity(FSlateColor(ChannelColor));
+		return;
+	}
+
+	// ────────────────────────────────────────────────────
+	// 3. Formatage du Contenu (legacy)
 	// ────────────────────────────────────────────────────
 	FString Content = Message.MessageContent;
 	FString FormattedContent = UNexusLinkHelpers::AutoFormatUrls(Content);
-	
-	const bool bIsSystemMessage = (Message.Channel == ENexusChatChannel::System || Message.Channel == ENexusChatChannel::GameLog);
+
+	if (Message.RepeatCount > 1)
+	{
+		FormattedContent += FString::Printf(TEXT(" (x%d)"), Message.RepeatCount);
+	}
 
 	// ────────────────────────────────────────────────────
-	// 3. Construction de la chaîne finale
+	// 4. Construction de la chaîne finale
 	// ────────────────────────────────────────────────────
-	FString PrefixStr = ChannelPrefix.IsEmpty() ? "" : ChannelPrefix.ToString() + " ";
 	FString FullText;
 	
 	if (bIsSystemMessage)
@@ -84,7 +118,7 @@ void UNexusChatMessageRow::InitWidget_Implementation(const FNexusChatMessage& Me
 	}
 
 	// ────────────────────────────────────────────────────
-	// 4. Mise à jour de l'UI
+	// 5. Mise à jour de l'UI
 	// ────────────────────────────────────────────────────
 	
 	MessageText->SetText(FText::FromString(FullText));
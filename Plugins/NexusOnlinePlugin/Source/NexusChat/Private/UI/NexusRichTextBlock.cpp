@@ -1,7 +1,101 @@
 #include "UI/NexusRichTextBlock.h"
 #include "UI/NexusLinkDecorator.h"
+#include "Core/NexusChatSegments.h"
+#include "Framework/Text/IRichTextMarkupParser.h"
+#include "Framework/Text/RichTextMarkupProcessing.h"
 
 
+/**
+ * Markup parser that skips parsing for text set through SetChatMessage : runs were already built
+ * from the message segments. Anything else (SetText from Blueprint) goes through the default parser.
+ *
+ * The source string is "<display><hidden>" : runs only cover the display part, the hidden tail holds
+ * link types and payloads that FNexusLinkTextDecorator reads through the "type" / "data" metadata ranges.
+ */
+class FNexusSegmentMarkupParser : public IRichTextMarkupParser
+{
+public:
+	FString Source;
+	TArray<FTextRunParseResults> Runs;
+
+	virtual void Process(TArray<FTextLineParseResults>& Results, const FString& Input, FString& Output) override
+	{
+		if (!Runs.IsEmpty() && Input == Source)
+		{
+			Output = Input;
+			FTextLineParseResults& Line = Results.Emplace_GetRef(FTextRange(0, Output.Len()));
+			Line.Runs = Runs;
+			return;
+		}
+
+		FDefaultRichTextMarkupParser::GetStaticInstance()->Process(Results, Input, Output);
+	}
+};
+
+namespace
+{
+	struct FRunBuilder
+	{
+		FString Display;
+		FString Hidden;
+		TArray<FTextRunParseResults> Runs;
+
+		// Hidden ranges are relative to the hidden tail until Finish()
+		TArray<int32> LinkRuns;
+		TMap<ENexusChatSegmentType, FTextRange> TypeRanges;
+
+		void AddText(FStringView Text)
+		{
+			if (Text.IsEmpty())
+				return;
+
+			const int32 Start = Display.Len();
+			Display.Append(Text);
+			Runs.Emplace(FString(), FTextRange(Start, Display.Len()));
+		}
+
+		void AddLink(ENexusChatSegmentType Type, FStringView Text, FStringView Data)
+		{
+			if (Text.IsEmpty())
+				return;
+
+			const int32 Start = Display.Len();
+			Display.Append(Text);
+
+			FTextRunParseResults& Run = Runs.Emplace_GetRef(TEXT("link"), FTextRange(Start, Display.Len()), FTextRange(Start, Display.Len()));
+
+			if (!TypeRanges.Contains(Type))
+			{
+				const int32 TypeStart = Hidden.Len();
+				Hidden.Append(NexusChatSegments::GetLinkTypeName(Type));
+				TypeRanges.Add(Type, FTextRange(TypeStart, Hidden.Len()));
+			}
+			Run.MetaData.Add(TEXT("type"), TypeRanges[Type]);
+
+			const int32 DataStart = Hidden.Len();
+			Hidden.Append(Data);
+			Run.MetaData.Add(TEXT("data"), FTextRange(DataStart, Hidden.Len()));
+
+			LinkRuns.Add(Runs.Num() - 1);
+		}
+
+		void Finish(FNexusSegmentMarkupParser& Parser)
+		{
+			const int32 Offset = Display.Len();
+			for (int32 RunIndex : LinkRuns)
+			{
+				for (auto& Pair : Runs[RunIndex].MetaData)
+				{
+					Pair.Value.Offset(Offset);
+				}
+			}
+
+			Parser.Source = Display + Hidden;
+			Parser.Runs = MoveTemp(Runs);
+		}
+	};
+}
+
 UNexusRichTextBlock::UNexusRichTextBlock(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
 	DecoratorClasses.AddUnique(UNexusLinkDecorator::StaticClass());
@@ -12,3 +106,59 @@ TSharedRef<SWidget> UNexusRichTextBlock::RebuildWidget()
 	DecoratorClasses.AddUnique(UNexusLinkDecorator::StaticClass());
 	return Super::RebuildWidget();
 }
+
+TSharedPtr<IRichTextMarkupParser> UNexusRichTextBlock::CreateMarkupParser()
+{
+	if (!SegmentParser.IsValid())
+	{
+		SegmentParser = MakeShared<FNexusSegmentMarkupParser>();
+	}
+	return SegmentParser;
+}
+
+void UNexusRichTextBlock::SetChatMessage(const FString& Prefix, const FNexusChatMessage& Message, bool bShowSender, int32 MaxSenderLength)
+{
+	if (!SegmentParser.IsValid())
+	{
+		SegmentParser = MakeShared<FNexusSegmentMarkupParser>();
+	}
+
+	FRunBuilder Builder;
+	Builder.AddText(Prefix);
+
+	if (bShowSender)
+	{
+		FString SenderDisplay = Message.SenderName;
+		if (MaxSenderLength > 0 && SenderDisplay.Len() > MaxSenderLength)
+		{
+			SenderDisplay = SenderDisplay.Left(MaxSenderLength) + TEXT("...");
+		}
+
+		Builder.AddLink(ENexusChatSegmentType::Player, SenderDisplay, Message.SenderName);
+		Builder.AddText(TEXTVIEW(": "));
+	}
+
+	for (const FNexusChatSegment& Segment : Message.Segments)
+	{
+		if (!NexusChatSegments::IsSegmentValid(Message, Segment))
+			continue;
+
+		const FStringView Text = NexusChatSegments::GetDisplayText(Message, Segment);
+		if (Segment.Type == ENexusChatSegmentType::Text)
+		{
+			Builder.AddText(Text);
+		}
+		else
+		{
+			Builder.AddLink(Segment.Type, Text, NexusChatSegments::GetData(Message, Segment));
+		}
+	}
+
+	if (Message.RepeatCount > 1)
+	{
+		Builder.AddText(FString::Printf(TEXT(" (x%d)"), Message.RepeatCount));
+	}
+
+	Builder.Finish(*SegmentParser);
+	SetText(FText::FromString(SegmentParser->Source));
+}
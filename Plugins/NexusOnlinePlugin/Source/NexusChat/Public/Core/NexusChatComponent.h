@@ -6,11 +6,15 @@
 #include "NexusChatComponent.generated.h"
 
 class UNexusChatConfig;
+class UNexusChatHistoryStore;
 class APlayerController;
 
 
 DECLARE_DELEGATE_RetVal_TwoParams(TArray<APlayerController*>, FNexusChatRoutingDelegate, APlayerController* /*Sender*/, FName /*ChannelName*/);
 
+/** Server side : does the item / quest / gps id a player linked exist ? */
+DECLARE_DELEGATE_RetVal_ThreeParams(bool, FNexusChatLinkValidator, APlayerController* /*Sender*/, ENexusChatSegmentType /*Type*/, const FString& /*Data*/);
+
 DECLARE_DELEGATE_OneParam(FChatCommandDelegate, const FString& /*Params*/);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnCustomCommand, const FString&, Command, const FString&, Params);
 
@@ -40,6 +44,9 @@ public:
     
     FNexusChatRoutingDelegate OnRoutingQuery;
 
+    /** Item / quest / gps links sent by players are kept only if this returns true (unbound = sent as plain text). */
+    FNexusChatLinkValidator OnValidateLink;
+
     // ─────────────────────────────────────────────────────────────────
     // API PUBLIQUE
     // ─────────────────────────────────────────────────────────────────
@@ -55,18 +62,33 @@ public:
     UFUNCTION(BlueprintCallable, Category = "NexusChat")
     void SetPartyId(int32 NewPartyId);
 
+    UFUNCTION(BlueprintCallable, Category = "NexusChat")
+    void SetGuildName(FName NewGuildName);
+
     UFUNCTION(BlueprintPure, Category = "NexusChat")
     int32 GetTeamId() const { return TeamId; }
 
     UFUNCTION(BlueprintPure, Category = "NexusChat")
     int32 GetPartyId() const { return PartyId; }
 
+    UFUNCTION(BlueprintPure, Category = "NexusChat")
+    FName GetGuildName() const { return GuildName; }
+
     UFUNCTION(BlueprintPure, Category = "NexusChat")
     const TArray<FNexusChatMessage>& GetClientChatHistory() const { return ClientChatHistory; }
 
     UFUNCTION(BlueprintCallable, Category = "NexusChat")
     void RegisterBlueprintCommand(FString CommandName);
 
+    /** Server only. Delivers a message coming from another server through the chat relay. */
+    void ReceiveRelayedMessage(const FNexusChatMessage& Message);
+
+    /** Server only. Sends a message to this client using the channel's delivery class (ChatConfig->ChannelDelivery). */
+    void DeliverMessage(const FNexusChatMessage& Message);
+
+    /** Server only. Reliable buffer fill ratio of the owning connection (0 = idle, 1 = full). */
+    float GetConnectionSaturation() const;
+
 protected:
     // ─────────────────────────────────────────────────────────────────
     // LIFECYCLE & RESEAU
@@ -80,6 +102,9 @@ protected:
     UFUNCTION(Client, Reliable)
     void Client_ReceiveChatMessage(const FNexusChatMessage& Message);
 
+    UFUNCTION(Client, Unreliable)
+    void Client_ReceiveChatMessageUnreliable(const FNexusChatMessage& Message, uint32 Sequence);
+
     UFUNCTION(Client, Reliable)
     void Client_ReceiveChatHistory(const TArray<FNexusChatMessage>& History);
 
@@ -90,7 +115,13 @@ protected:
     // LOGIQUE INTERNE
     // ─────────────────────────────────────────────────────────────────
     virtual void RouteMessage(const FNexusChatMessage& Msg);
+    void HandleIncomingMessage(const FNexusChatMessage& Message);
+    void SendToClient(const FNexusChatMessage& Message, const FNexusChatDeliverySettings& Delivery);
+    void FlushCoalescedMessage();
     void FilterProfanity(FString& Message);
+    void MaskProfanity(FString& Message);
+    bool IsClientLinkAllowed(ENexusChatSegmentType Type, FStringView Display, FStringView Data) const;
+    UNexusChatHistoryStore* GetHistoryStore() const;
     
     FString DecorateMessage(const FString& Message, ENexusChatChannel Channel) const;
 
@@ -110,6 +141,7 @@ protected:
     void Cmd_Quit(const FString& Params);
     void Cmd_Whisper(const FString& Params);
     void Cmd_Team(const FString& Params);
+    void Cmd_Guild(const FString& Params);
     void Cmd_Reply(const FString& Params);
 
     void RegisterInternalCommand(const FString& Command, FChatCommandDelegate Callback);
@@ -127,9 +159,21 @@ private:
     UPROPERTY(Replicated)
     int32 PartyId = -1;
 
+    UPROPERTY(Replicated)
+    FName GuildName = NAME_None;
+
     TMap<FString, FChatCommandDelegate> CommandHandlers;
 
     TArray<FNexusChatMessage> ClientChatHistory;
 
+    // Unreliable delivery (server : next sequence to send, client : last sequence received)
+    uint32 NextUnreliableSequence = 0;
+    uint32 LastUnreliableSequence = 0;
+
+    // GameLog coalescing (server)
+    FNexusChatMessage PendingCoalesced;
+    bool bHasPendingCoalesced = false;
+    FTimerHandle CoalesceTimerHandle;
+
     static const float DefaultSpamCooldown;
 };
\ No newline at end of file
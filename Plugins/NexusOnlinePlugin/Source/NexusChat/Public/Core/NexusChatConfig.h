@@ -19,6 +19,20 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "NexusChat|Moderation")
 	TArray<FString> BannedWords;
 
+	/**
+	 * Server tokenizes messages into typed segments (text, player, item, url, quest, gps).
+	 * Clients render them without parsing markup. Disable to keep the legacy escaped markup strings.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "NexusChat|General")
+	bool bStructuredPayloads = true;
+
+	/**
+	 * Link types players may send. Url links must show their own address, player links must name a connected player,
+	 * item / quest / gps links need UNexusChatComponent::OnValidateLink to accept their id. Anything else is sent as plain text.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "NexusChat|General", meta = (EditCondition = "bStructuredPayloads"))
+	TSet<ENexusChatSegmentType> ClientLinkTypes;
+
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "NexusChat|Channels")
 	TMap<ENexusChatChannel, FText> ChannelPrefixes;
 
@@ -28,6 +42,25 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "NexusChat|Channels")
 	TMap<FName, FLinearColor> CustomChannelColors;
 
+	// ====== Delivery ======
+
+	/** Per-channel delivery class. Channels not listed are reliable ordered. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "NexusChat|Delivery")
+	TMap<ENexusChatChannel, FNexusChatDeliverySettings> ChannelDelivery;
+
+	/** Missed unreliable messages tolerated silently before the client shows a "messages lost" line. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "NexusChat|Delivery", meta = (ClampMin = 0))
+	int32 SequenceGapTolerance = 3;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "NexusChat|Delivery", meta = (ClampMin = 0.05f))
+	float CoalesceWindow = 1.0f;
+
+	/** Reliable buffer fill ratio (0-1) above which sheddable channels are dropped for that connection. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "NexusChat|Delivery", meta = (ClampMin = 0.0f, ClampMax = 1.0f))
+	float ShedSaturationThreshold = 0.75f;
+
+	FNexusChatDeliverySettings GetDeliverySettings(ENexusChatChannel Channel) const;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "NexusChat|Notifications")
 	bool bEnableNotifications = true;
 
@@ -0,0 +1,58 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Types/NexusChatTypes.h"
+#include "NexusChatHistoryStore.generated.h"
+
+
+/**
+ * Chat history owned by the GameInstance, so it survives map travel and host migration.
+ *
+ * - Authoritative history : written by the server (UNexusChatSubsystem::AddMessage), served to joining clients.
+ *   UNexusChatSubsystem reads it in place, each new world gets the same array (no copy).
+ * - Local copy : what this client received. When a client world is replaced by a listen server world
+ *   (host migration heir), the authoritative history is seeded from it.
+ */
+UCLASS()
+class NEXUSCHAT_API UNexusChatHistoryStore : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// ====== Authoritative (server) ======
+
+	void AddMessage(const FNexusChatMessage& Msg);
+
+	const TArray<FNexusChatMessage>& GetHistory() const { return History; }
+
+	UFUNCTION(BlueprintCallable, Category = "NexusChat|History")
+	void ClearHistory();
+
+	// ====== Local copy (client) ======
+
+	void AddToLocalCopy(const FNexusChatMessage& Msg);
+	void SetLocalCopy(const TArray<FNexusChatMessage>& Messages);
+
+	/** Replaces the authoritative history with the public part (Global, System, GameLog) of the local copy. */
+	UFUNCTION(BlueprintCallable, Category = "NexusChat|History")
+	void SeedFromLocalCopy();
+
+	/** Called by UNexusChatSubsystem when a world begins play : detects Client -> ListenServer (migration heir). */
+	void NotifyWorldBeginPlay(const UWorld& World);
+
+	int32 GetMaxHistorySize() const { return MaxHistorySize; }
+
+private:
+	void Trim(TArray<FNexusChatMessage>& Messages) const;
+
+	UPROPERTY()
+	TArray<FNexusChatMessage> History;
+
+	UPROPERTY()
+	TArray<FNexusChatMessage> LocalCopy;
+
+	TEnumAsByte<ENetMode> LastNetMode = NM_Standalone;
+	int32 MaxHistorySize = 50;
+};
@@ -0,0 +1,52 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Types/NexusChatTypes.h"
+
+/**
+ * Structured chat payloads.
+ *
+ * The server turns the raw input (plain text + <link> tags built by UNexusLinkHelpers) into
+ * typed segments once, clients render them directly : no regex, no markup parsing per row,
+ * and player-typed '<' / '>' stay plain text.
+ */
+namespace NexusChatSegments
+{
+	/** Link type as used by UNexusChatSubsystem::HandleLinkClicked ("player", "item", "url", "quest", "gps"). Empty for Text. */
+	NEXUSCHAT_API const TCHAR* GetLinkTypeName(ENexusChatSegmentType Type);
+
+	NEXUSCHAT_API bool ParseLinkType(FStringView Name, ENexusChatSegmentType& OutType);
+
+	/** Decides whether a <link> read from untrusted input becomes a link segment. */
+	using FLinkFilter = TFunctionRef<bool(ENexusChatSegmentType /*Type*/, FStringView /*Display*/, FStringView /*Data*/)>;
+
+	/** Fills MessageContent (display text), Segments and SegmentData from a raw input string. */
+	NEXUSCHAT_API void Tokenize(const FString& RawContent, FNexusChatMessage& OutMsg);
+
+	/**
+	 * Same, for input typed by a client : links rejected by Filter keep only their display text, as plain text.
+	 * Bare http(s) URLs are still promoted (their payload is their display text).
+	 */
+	NEXUSCHAT_API void Tokenize(const FString& RawContent, FNexusChatMessage& OutMsg, FLinkFilter Filter);
+
+	/** http(s) URL with a plain host name (no credentials, no whitespace or markup characters). */
+	NEXUSCHAT_API bool IsSafeUrl(FStringView Url);
+
+	/** False if the segment spans fall outside the message buffers. */
+	NEXUSCHAT_API bool IsSegmentValid(const FNexusChatMessage& Msg, const FNexusChatSegment& Segment);
+
+	/**
+	 * Checks a segment list received from elsewhere (chat relay) : known types, valid spans covering the whole display
+	 * text in order, url links showing their own safe address.
+	 */
+	NEXUSCHAT_API bool AreSegmentsValid(const FNexusChatMessage& Msg);
+
+	NEXUSCHAT_API FStringView GetDisplayText(const FNexusChatMessage& Msg, const FNexusChatSegment& Segment);
+
+	/** Link payload, falls back to the display text when the segment has no dedicated data. */
+	NEXUSCHAT_API FStringView GetData(const FNexusChatMessage& Msg, const FNexusChatSegment& Segment);
+
+	/** Escaped markup for plain URichTextBlocks (UNexusRichTextBlock renders segments directly). */
+	NEXUSCHAT_API FString ToMarkup(const FNexusChatMessage& Msg);
+
+	NEXUSCHAT_API FString EscapeMarkup(FStringView Text);
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Trace/Trace.h"
+#include "Logging/LogMacros.h"
+#include "Types/NexusChatTypes.h"
+
+// ──────────────────────────────────────────────
+// Log category & trace channel (NexusChat has no dependency on NexusFramework)
+// ──────────────────────────────────────────────
+
+/** Chat routing, history and relay client. */
+NEXUSCHAT_API DECLARE_LOG_CATEGORY_EXTERN(LogNexusChat, Log, All);
+
+/** Unreal Insights : -trace=default,nexuschat or "Trace.Enable NexusChat". */
+UE_TRACE_CHANNEL_EXTERN(NexusChatChannel, NEXUSCHAT_API);
+
+/** Scoped CPU event on the NexusChat channel, e.g. NEXUSCHAT_TRACE_SCOPE(NexusChat_RouteMessage). */
+#define NEXUSCHAT_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Name, NexusChatChannel)
+
+// ──────────────────────────────────────────────
+// Stat group (stat NexusChat)
+// ──────────────────────────────────────────────
+DECLARE_STATS_GROUP(TEXT("NexusChat"), STATGROUP_NexusChat, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Filter Profanity"), STAT_NexusChat_FilterTime, STATGROUP_NexusChat, NEXUSCHAT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Route Message"), STAT_NexusChat_RouteTime, STATGROUP_NexusChat, NEXUSCHAT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Add To History"), STAT_NexusChat_HistoryTime, STATGROUP_NexusChat, NEXUSCHAT_API);
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Messages Received"), STAT_NexusChat_MessagesReceived, STATGROUP_NexusChat, NEXUSCHAT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Messages Routed"), STAT_NexusChat_MessagesRouted, STATGROUP_NexusChat, NEXUSCHAT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Messages Dropped"), STAT_NexusChat_MessagesDropped, STATGROUP_NexusChat, NEXUSCHAT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Recipients"), STAT_NexusChat_Recipients, STATGROUP_NexusChat, NEXUSCHAT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Bytes Serialized"), STAT_NexusChat_BytesSerialized, STATGROUP_NexusChat, NEXUSCHAT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Client Messages Received"), STAT_NexusChat_ClientReceived, STATGROUP_NexusChat, NEXUSCHAT_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Recipients (Last Message)"), STAT_NexusChat_LastRecipients, STATGROUP_NexusChat, NEXUSCHAT_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("History Size"), STAT_NexusChat_HistorySize, STATGROUP_NexusChat, NEXUSCHAT_API);
+
+// ──────────────────────────────────────────────
+// CSV profiler (csvprofile start / -csvCategories=NexusChat)
+// ──────────────────────────────────────────────
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(NEXUSCHAT_API, NexusChat);
+
+
+/**
+ * Chat counters : feeds the stat group, the CSV profiler and a per-channel one minute window
+ * dumped by "NexusChat.DumpRates".
+ * Game thread only.
+ */
+namespace NexusChatStats
+{
+	/** Rough replicated size of a message (FString net serialization is ANSI when possible). */
+	NEXUSCHAT_API int32 EstimateNetSize(const FNexusChatMessage& Msg);
+
+	/** Server received a message from a client (Server_SendChatMessage). */
+	NEXUSCHAT_API void RecordReceived(ENexusChatChannel Channel);
+
+	/** Server routed a message to NumRecipients clients, MessageBytes each. */
+	NEXUSCHAT_API void RecordRouted(ENexusChatChannel Channel, int32 NumRecipients, int32 MessageBytes);
+
+	/** Message discarded before delivery (invalid sender, no guild, relay backpressure...). */
+	NEXUSCHAT_API void RecordDropped(ENexusChatChannel Channel);
+
+	/** Client side, Client_ReceiveChatMessage. */
+	NEXUSCHAT_API void RecordClientReceived(ENexusChatChannel Channel, int32 MessageBytes);
+
+	NEXUSCHAT_API void RecordHistorySize(int32 HistorySize);
+
+	NEXUSCHAT_API void DumpRates(FOutputDevice& Ar);
+}
@@ -4,6 +4,7 @@
 #include "Types/NexusChatTypes.h"
 #include "NexusChatSubsystem.generated.h"
 
+class UNexusChatHistoryStore;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnChatLinkClicked, const FString&, LinkType, const FString&, LinkData);
 DECLARE_DYNAMIC_DELEGATE_OneParam(FLinkTypeHandler, const FString&, LinkData);
@@ -17,13 +18,15 @@ class NEXUSCHAT_API UNexusChatSubsystem : public UWorldSubsystem
 public:
 	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
 	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
 
 	UFUNCTION(BlueprintCallable, Category = "NexusChat")
 	void AddMessage(const FNexusChatMessage& Msg);
 
 	// ====== History ======
 	
-	const TArray<FNexusChatMessage>& GetHistory() const { return GlobalChatHistory; }
+	/** Authoritative history, owned by UNexusChatHistoryStore (survives travel). */
+	const TArray<FNexusChatMessage>& GetHistory() const;
 
 	UFUNCTION(BlueprintPure, Category = "NexusChat")
 	TArray<FNexusChatMessage> GetFilteredHistory() const;
@@ -69,8 +72,11 @@ private:
 	void HandleUrlLink(const FString& Url);
 	void HandlePlayerLink(const FString& PlayerName);
 
+	UNexusChatHistoryStore* GetHistoryStore() const;
+
+	/** Only used when the world has no GameInstance (editor preview worlds...). */
 	UPROPERTY()
-	TArray<FNexusChatMessage> GlobalChatHistory;
+	TArray<FNexusChatMessage> FallbackHistory;
 
 	UPROPERTY()
 	TSet<FName> FilteredChannels;
@@ -79,7 +85,6 @@ private:
 	TMap<FString, FLinkTypeHandler> LinkHandlers;
 
 	bool bWhitelistMode = false;
-	int32 MaxHistorySize = 50;
 
 	UPROPERTY()
 	TSet<FString> ActiveWhisperTargets;
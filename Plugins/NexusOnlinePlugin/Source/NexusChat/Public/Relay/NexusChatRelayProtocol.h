@@ -0,0 +1,398 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+
+/**
+ * Wire protocol shared by the NexusChatRelay program and the plugin-side relay client.
+ *
+ * Header-only and Core/Sockets only on purpose : the relay is a headless program target
+ * that does not link CoreUObject, so nothing in here may depend on UObjects.
+ *
+ * Frame layout : [uint32 PayloadSize][uint8 FrameType][Payload...] (little endian).
+ */
+namespace NexusChatRelay
+{
+	//───────────────────────────────────────────────
+	// Constants
+	//───────────────────────────────────────────────
+	inline constexpr uint32 PROTOCOL_VERSION = 2;
+	inline constexpr int32 DEFAULT_PORT = 7790;
+	inline constexpr int32 FRAME_HEADER_SIZE = 5;
+	inline constexpr int32 MAX_FRAME_PAYLOAD = 256 * 1024;
+	inline constexpr int32 RECV_CHUNK_SIZE = 16 * 1024;
+
+	enum class EFrameType : uint8
+	{
+		Hello,          // Server -> Relay : ServerName, ProtocolVersion
+		HelloAck,       // Relay -> Server : assigned ServerId
+		PlayerOnline,   // Server -> Relay : PlayerName, GuildName
+		PlayerOffline,  // Server -> Relay : PlayerName
+		Batch,          // Both ways : uint16 Count + Count * FMessage
+		Max
+	};
+
+	enum class ERoute : uint8
+	{
+		Global,
+		Guild,
+		Whisper
+	};
+
+	//───────────────────────────────────────────────
+	// Payloads
+	//───────────────────────────────────────────────
+
+	/** FNexusChatSegment on the wire (the relay program has no UObject types). */
+	struct FSegment
+	{
+		uint8 Type = 0;
+		int32 Start = 0;
+		int32 Length = 0;
+		int32 DataStart = 0;
+		int32 DataLength = 0;
+
+		friend FArchive& operator<<(FArchive& Ar, FSegment& Segment)
+		{
+			Ar << Segment.Type;
+			Ar << Segment.Start;
+			Ar << Segment.Length;
+			Ar << Segment.DataStart;
+			Ar << Segment.DataLength;
+			return Ar;
+		}
+	};
+
+	struct FMessage
+	{
+		ERoute Route = ERoute::Global;
+		uint32 OriginServerId = 0;
+		FString SenderName;
+		FString Target;       // Guild name or whisper target, empty for Global
+		FString Content;
+		int64 TimestampTicks = 0;
+
+		/** Structured payload of Content, checked again by the receiving server. Empty for legacy (escaped markup) messages. */
+		TArray<FSegment> Segments;
+		FString SegmentData;
+
+		/** Rough wire size, used for batching and backpressure accounting. */
+		int32 GetApproximateSize() const
+		{
+			return 16 + (SenderName.Len() + Target.Len() + Content.Len() + SegmentData.Len()) * sizeof(TCHAR) + Segments.Num() * 17;
+		}
+
+		friend FArchive& operator<<(FArchive& Ar, FMessage& Msg)
+		{
+			uint8 RouteByte = static_cast<uint8>(Msg.Route);
+			Ar << RouteByte;
+			Msg.Route = static_cast<ERoute>(RouteByte);
+
+			Ar << Msg.OriginServerId;
+			Ar << Msg.SenderName;
+			Ar << Msg.Target;
+			Ar << Msg.Content;
+			Ar << Msg.TimestampTicks;
+			Ar << Msg.Segments;
+			Ar << Msg.SegmentData;
+			return Ar;
+		}
+	};
+
+	struct FHello
+	{
+		uint32 ProtocolVersion = PROTOCOL_VERSION;
+		FString ServerName;
+
+		friend FArchive& operator<<(FArchive& Ar, FHello& Hello)
+		{
+			Ar << Hello.ProtocolVersion;
+			Ar << Hello.ServerName;
+			return Ar;
+		}
+	};
+
+	struct FPresence
+	{
+		FString PlayerName;
+		FString GuildName;
+
+		friend FArchive& operator<<(FArchive& Ar, FPresence& Presence)
+		{
+			Ar << Presence.PlayerName;
+			Ar << Presence.GuildName;
+			return Ar;
+		}
+	};
+
+	struct FFrame
+	{
+		EFrameType Type = EFrameType::Max;
+		TArray<uint8> Payload;
+	};
+
+	//───────────────────────────────────────────────
+	// Serialization Helpers
+	//───────────────────────────────────────────────
+	template<typename T>
+	TArray<uint8> MakePayload(T& Value)
+	{
+		TArray<uint8> Bytes;
+		FMemoryWriter Writer(Bytes);
+		Writer << Value;
+		return Bytes;
+	}
+
+	template<typename T>
+	bool ReadPayload(const TArray<uint8>& Bytes, T& OutValue)
+	{
+		FMemoryReader Reader(Bytes);
+		Reader << OutValue;
+		return !Reader.IsError();
+	}
+
+	/**
+	 * Queues Messages as Batch frames of at most MaxMessages, each flushed before its encoded size exceeds MAX_FRAME_PAYLOAD.
+	 * A message that cannot fit in any frame is skipped (the peer would close the connection). Returns the number skipped.
+	 */
+	template<typename QueueFrameFunc>
+	int32 QueueBatchFrames(TArrayView<FMessage> Messages, int32 MaxMessages, QueueFrameFunc&& QueueFrame)
+	{
+		MaxMessages = FMath::Clamp(MaxMessages, 1, static_cast<int32>(MAX_uint16));
+
+		TArray<uint8> Bytes;
+		TArray<uint8> Encoded;
+		uint16 Count = 0;
+		int32 Skipped = 0;
+
+		auto FlushBatch = [&]()
+		{
+			if (Count == 0)
+				return;
+
+			FMemoryWriter Header(Bytes);
+			Header << Count;
+			QueueFrame(Bytes);
+			Count = 0;
+		};
+
+		for (FMessage& Msg : Messages)
+		{
+			Encoded.Reset();
+			FMemoryWriter Writer(Encoded);
+			Writer << Msg;
+
+			if (static_cast<int32>(sizeof(uint16)) + Encoded.Num() > MAX_FRAME_PAYLOAD)
+			{
+				Skipped++;
+				continue;
+			}
+
+			if (Count > 0 && (Count >= MaxMessages || Bytes.Num() + Encoded.Num() > MAX_FRAME_PAYLOAD))
+			{
+				FlushBatch();
+			}
+
+			if (Count == 0)
+			{
+				// Compteur reecrit a la fermeture du batch
+				Bytes.SetNumZeroed(sizeof(uint16));
+			}
+
+			Bytes.Append(Encoded);
+			Count++;
+		}
+
+		FlushBatch();
+		return Skipped;
+	}
+
+	inline bool ReadBatchPayload(const TArray<uint8>& Bytes, TArray<FMessage>& OutMessages)
+	{
+		FMemoryReader Reader(Bytes);
+
+		uint16 Count = 0;
+		Reader << Count;
+		OutMessages.Reserve(OutMessages.Num() + Count);
+
+		for (int32 i = 0; i < Count && !Reader.IsError(); ++i)
+		{
+			Reader << OutMessages.AddDefaulted_GetRef();
+		}
+		return !Reader.IsError();
+	}
+
+	//───────────────────────────────────────────────
+	// Buffered non-blocking stream
+	//───────────────────────────────────────────────
+
+	/**
+	 * Owns a connected TCP socket and handles framing.
+	 * Outgoing frames are queued and written as far as the kernel accepts them on every Flush,
+	 * so the queued byte count is the backpressure signal for both sides.
+	 */
+	class FStream
+	{
+	public:
+		explicit FStream(FSocket* InSocket)
+			: Socket(InSocket)
+		{
+			if (Socket)
+			{
+				Socket->SetNonBlocking(true);
+				Socket->SetNoDelay(true);
+			}
+		}
+
+		~FStream()
+		{
+			Close();
+		}
+
+		FStream(const FStream&) = delete;
+		FStream& operator=(const FStream&) = delete;
+
+		bool IsOpen() const { return Socket != nullptr; }
+
+		int32 GetQueuedBytes() const { return SendBuffer.Num() - SendOffset; }
+
+		void QueueFrame(EFrameType Type, const TArray<uint8>& Payload)
+		{
+			const uint32 Size = static_cast<uint32>(Payload.Num());
+			const int32 Start = SendBuffer.AddUninitialized(FRAME_HEADER_SIZE + Payload.Num());
+
+			uint8* Dest = SendBuffer.GetData() + Start;
+			Dest[0] = static_cast<uint8>(Size & 0xFF);
+			Dest[1] = static_cast<uint8>((Size >> 8) & 0xFF);
+			Dest[2] = static_cast<uint8>((Size >> 16) & 0xFF);
+			Dest[3] = static_cast<uint8>((Size >> 24) & 0xFF);
+			Dest[4] = static_cast<uint8>(Type);
+
+			if (Payload.Num() > 0)
+			{
+				FMemory::Memcpy(Dest + FRAME_HEADER_SIZE, Payload.GetData(), Payload.Num());
+			}
+		}
+
+		/** Writes as much of the queue as the socket accepts. Returns false if the connection is dead. */
+		bool Flush()
+		{
+			if (!Socket)
+				return false;
+
+			while (SendOffset < SendBuffer.Num())
+			{
+				int32 BytesSent = 0;
+				if (!Socket->Send(SendBuffer.GetData() + SendOffset, SendBuffer.Num() - SendOffset, BytesSent))
+				{
+					ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+					if (SocketSubsystem && SocketSubsystem->GetLastErrorCode() == SE_EWOULDBLOCK)
+						break;
+
+					return false;
+				}
+
+				if (BytesSent <= 0)
+					break;
+
+				SendOffset += BytesSent;
+			}
+
+			// Compact once everything queued so far has been written, or when the dead prefix gets large
+			if (SendOffset == SendBuffer.Num())
+			{
+				SendBuffer.Reset();
+				SendOffset = 0;
+			}
+			else if (SendOffset > 64 * 1024)
+			{
+				SendBuffer.RemoveAt(0, SendOffset, EAllowShrinking::No);
+				SendOffset = 0;
+			}
+
+			return true;
+		}
+
+		/**
+		 * Drains the socket and appends every complete frame to OutFrames. Returns false on close or protocol error ;
+		 * frames received before the close are still returned.
+		 */
+		bool Receive(TArray<FFrame>& OutFrames)
+		{
+			if (!Socket)
+				return false;
+
+			// Close is reported after parsing : the peer's last frames may already be buffered
+			bool bClosed = false;
+			uint8 Chunk[RECV_CHUNK_SIZE];
+			for (;;)
+			{
+				int32 BytesRead = 0;
+				if (!Socket->Recv(Chunk, RECV_CHUNK_SIZE, BytesRead))
+				{
+					bClosed = true;
+					break;
+				}
+
+				if (BytesRead <= 0)
+					break;
+
+				RecvBuffer.Append(Chunk, BytesRead);
+			}
+
+			int32 ReadOffset = 0;
+			while (RecvBuffer.Num() - ReadOffset >= FRAME_HEADER_SIZE)
+			{
+				const uint8* Src = RecvBuffer.GetData() + ReadOffset;
+				const uint32 Size = static_cast<uint32>(Src[0])
+					| (static_cast<uint32>(Src[1]) << 8)
+					| (static_cast<uint32>(Src[2]) << 16)
+					| (static_cast<uint32>(Src[3]) << 24);
+
+				if (Size > static_cast<uint32>(MAX_FRAME_PAYLOAD) || Src[4] >= static_cast<uint8>(EFrameType::Max))
+					return false;
+
+				if (RecvBuffer.Num() - ReadOffset < FRAME_HEADER_SIZE + static_cast<int32>(Size))
+					break;
+
+				FFrame& Frame = OutFrames.AddDefaulted_GetRef();
+				Frame.Type = static_cast<EFrameType>(Src[4]);
+				Frame.Payload.Append(Src + FRAME_HEADER_SIZE, Size);
+
+				ReadOffset += FRAME_HEADER_SIZE + Size;
+			}
+
+			if (ReadOffset > 0)
+			{
+				RecvBuffer.RemoveAt(0, ReadOffset, EAllowShrinking::No);
+			}
+
+			return !bClosed;
+		}
+
+		void Close()
+		{
+			if (Socket)
+			{
+				Socket->Close();
+				if (ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM))
+				{
+					SocketSubsystem->DestroySocket(Socket);
+				}
+				Socket = nullptr;
+			}
+
+			SendBuffer.Reset();
+			RecvBuffer.Reset();
+			SendOffset = 0;
+		}
+
+	private:
+		FSocket* Socket = nullptr;
+		TArray<uint8> SendBuffer;
+		int32 SendOffset = 0;
+		TArray<uint8> RecvBuffer;
+	};
+}
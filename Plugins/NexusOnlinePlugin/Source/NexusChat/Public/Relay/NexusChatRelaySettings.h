@@ -0,0 +1,45 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "NexusChatRelaySettings.generated.h"
+
+
+/**
+ * Connection settings for the cross-server chat relay (NexusChatRelay program).
+ * Can be overridden per server instance with -NexusChatRelay=Host:Port and -NexusChatServerName=Name.
+ */
+UCLASS(Config=Game, DefaultConfig, meta=(DisplayName="Nexus Chat Relay"))
+class NEXUSCHAT_API UNexusChatRelaySettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	UNexusChatRelaySettings();
+
+	UPROPERTY(Config, EditAnywhere, Category="General")
+	bool bEnableRelay;
+
+	UPROPERTY(Config, EditAnywhere, Category="Connection")
+	FString RelayHost;
+
+	UPROPERTY(Config, EditAnywhere, Category="Connection", meta=(ClampMin=1, ClampMax=65535))
+	int32 RelayPort;
+
+	/** Name announced to the relay. Empty = "<MapName>:<ListenPort>". */
+	UPROPERTY(Config, EditAnywhere, Category="Connection")
+	FString ServerName;
+
+	UPROPERTY(Config, EditAnywhere, Category="Connection", meta=(ClampMin=0.1f))
+	float ReconnectDelay;
+
+	/** Outgoing messages are batched and sent at most once per interval. */
+	UPROPERTY(Config, EditAnywhere, Category="Batching", meta=(ClampMin=0.0f))
+	float FlushInterval;
+
+	UPROPERTY(Config, EditAnywhere, Category="Batching", meta=(ClampMin=1, ClampMax=65535))
+	int32 MaxBatchMessages;
+
+	/** Above this many unsent bytes, Global messages are no longer published (Guild/Whisper still are). */
+	UPROPERTY(Config, EditAnywhere, Category="Batching", meta=(ClampMin=1024))
+	int32 MaxQueuedBytes;
+};
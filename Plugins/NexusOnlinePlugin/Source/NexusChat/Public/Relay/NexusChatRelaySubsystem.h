@@ -0,0 +1,98 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Containers/Ticker.h"
+#include "Types/NexusChatTypes.h"
+#include "Relay/NexusChatRelayProtocol.h"
+#include "NexusChatRelaySubsystem.generated.h"
+
+class AGameModeBase;
+class APlayerController;
+class AController;
+
+
+/**
+ * Server-side client of the NexusChatRelay program.
+ *
+ * Publishes Global / Guild / cross-server Whisper messages to the relay and delivers
+ * what the relay sends back to the local recipients. Only active on listen and dedicated servers.
+ * Player presence (name + guild) is announced on login/logout and re-sent after every reconnect.
+ */
+UCLASS()
+class NEXUSCHAT_API UNexusChatRelaySubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/** Called by UNexusChatComponent once a message has been delivered locally. */
+	void PublishMessage(const FNexusChatMessage& Msg);
+
+	/** Re-announces a player (e.g. after a guild change). */
+	void UpdatePlayerPresence(APlayerController* PC);
+
+	/** True if the player is connected to this server. */
+	bool IsPlayerLocal(const FString& PlayerName) const;
+
+	UFUNCTION(BlueprintPure, Category = "NexusChat|Relay")
+	bool IsRelayConnected() const { return ConnectionState == EConnectionState::Connected; }
+
+	UFUNCTION(BlueprintPure, Category = "NexusChat|Relay")
+	int64 GetDroppedMessageCount() const { return DroppedMessages; }
+
+private:
+	enum class EConnectionState : uint8
+	{
+		Disconnected,
+		Connecting,
+		Handshaking,
+		Connected
+	};
+
+	bool Tick(float DeltaTime);
+	bool IsServerWorld() const;
+
+	// ====== Connection ======
+
+	void BeginConnect();
+	void PollConnect();
+	void PollConnected();
+	void CloseConnection(const TCHAR* Reason);
+
+	// ====== Protocol ======
+
+	void HandleFrame(const NexusChatRelay::FFrame& Frame);
+	void DeliverRelayedMessage(const NexusChatRelay::FMessage& RelayMsg);
+	void AnnounceAllPlayers();
+	void SendPresence(APlayerController* PC);
+	void FlushOutgoing();
+
+	// ====== Game Mode Events ======
+
+	void OnPostLogin(AGameModeBase* GameMode, APlayerController* NewPlayer);
+	void OnLogout(AGameModeBase* GameMode, AController* Exiting);
+
+	FString ResolveServerName() const;
+
+	FString RelayHost;
+	int32 RelayPort = NexusChatRelay::DEFAULT_PORT;
+
+	TUniquePtr<NexusChatRelay::FStream> Stream;
+	FSocket* PendingSocket = nullptr;
+	EConnectionState ConnectionState = EConnectionState::Disconnected;
+
+	uint32 AssignedServerId = 0;
+	double LastConnectAttemptTime = -1.0;
+	double LastFlushTime = 0.0;
+
+	TArray<NexusChatRelay::FMessage> OutgoingBatch;
+	int32 OutgoingBatchBytes = 0;
+	int64 DroppedMessages = 0;
+
+	FTSTicker::FDelegateHandle TickHandle;
+	FDelegateHandle PostLoginHandle;
+	FDelegateHandle LogoutHandle;
+};
@@ -12,7 +12,93 @@ enum class ENexusChatChannel : uint8
 	Whisper		UMETA(DisplayName = "Whisper"),
 	System		UMETA(DisplayName = "System"),
 	GameLog		UMETA(DisplayName = "GameLog"),
-	Custom      UMETA(DisplayName = "Custom")
+	Custom      UMETA(DisplayName = "Custom"),
+	Guild		UMETA(DisplayName = "Guild")
+};
+
+UENUM(BlueprintType)
+enum class ENexusChatDelivery : uint8
+{
+	ReliableOrdered		UMETA(DisplayName = "Reliable Ordered"),
+	UnreliableSequenced	UMETA(DisplayName = "Unreliable Sequenced")
+};
+
+/**
+ * How a channel is sent to clients. Unreliable channels do not consume the reliable buffer,
+ * so kill-feed / global spam cannot overflow it and disconnect a slow client.
+ */
+USTRUCT(BlueprintType)
+struct NEXUSCHAT_API FNexusChatDeliverySettings
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Chat")
+	ENexusChatDelivery Delivery = ENexusChatDelivery::ReliableOrdered;
+
+	/** Identical consecutive lines are merged into one "(xN)" line per coalesce window. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Chat")
+	bool bCoalesceDuplicates = false;
+
+	/** Low priority : dropped for a connection whose reliable buffer is saturated. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Chat")
+	bool bSheddable = false;
+};
+
+UENUM(BlueprintType)
+enum class ENexusChatSegmentType : uint8
+{
+	Text		UMETA(DisplayName = "Text"),
+	Player		UMETA(DisplayName = "Player"),
+	Item		UMETA(DisplayName = "Item"),
+	Url			UMETA(DisplayName = "Url"),
+	Quest		UMETA(DisplayName = "Quest"),
+	Gps			UMETA(DisplayName = "Gps")
+};
+
+/**
+ * Typed span of a message. Display text lives in FNexusChatMessage::MessageContent,
+ * link payload (item id, url...) in FNexusChatMessage::SegmentData. DataLength == 0 means "same as display".
+ */
+USTRUCT(BlueprintType)
+struct NEXUSCHAT_API FNexusChatSegment
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Chat")
+	ENexusChatSegmentType Type = ENexusChatSegmentType::Text;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Chat")
+	int32 Start = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Chat")
+	int32 Length = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Chat")
+	int32 DataStart = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Chat")
+	int32 DataLength = 0;
+
+	void NetSerialize(FArchive& Ar)
+	{
+		uint8 TypeByte = static_cast<uint8>(Type);
+		Ar << TypeByte;
+
+		uint32 Packed[4] = { static_cast<uint32>(Start), static_cast<uint32>(Length), static_cast<uint32>(DataStart), static_cast<uint32>(DataLength) };
+		for (uint32& Value : Packed)
+		{
+			Ar.SerializeIntPacked(Value);
+		}
+
+		if (Ar.IsLoading())
+		{
+			Type = static_cast<ENexusChatSegmentType>(TypeByte);
+			Start = static_cast<int32>(Packed[0]);
+			Length = static_cast<int32>(Packed[1]);
+			DataStart = static_cast<int32>(Packed[2]);
+			DataLength = static_cast<int32>(Packed[3]);
+		}
+	}
 };
 
 USTRUCT(BlueprintType)
@@ -44,12 +130,25 @@ struct NEXUSCHAT_API FNexusChatMessage
 	UPROPERTY(BlueprintReadOnly, Category = "Chat")
 	FString TargetName;
 
+	/** Number of identical lines this message stands for (coalesced GameLog). */
+	UPROPERTY(BlueprintReadOnly, Category = "Chat")
+	int32 RepeatCount;
+
+	/** Optional structured content. Empty = MessageContent is a plain (legacy, escaped) string. */
+	UPROPERTY(BlueprintReadOnly, Category = "Chat")
+	TArray<FNexusChatSegment> Segments;
+
+	/** Shared buffer for segment payloads (see FNexusChatSegment::DataStart). */
+	UPROPERTY(BlueprintReadOnly, Category = "Chat")
+	FString SegmentData;
+
 	FNexusChatMessage()
 		: Timestamp(0)
 		, Channel(ENexusChatChannel::Global)
 		, ChannelName(NAME_None)
 		, SenderTeamId(-1)
 		, SenderPartyId(-1)
+		, RepeatCount(1)
 	{}
 	
 	static FNexusChatMessage MakeSystem(const FString& Content)
@@ -81,6 +180,40 @@ struct NEXUSCHAT_API FNexusChatMessage
 		Ar << SenderPartyId;
 		Ar << TargetName;
 
+		uint32 Repeat = static_cast<uint32>(FMath::Max(RepeatCount, 1));
+		Ar.SerializeIntPacked(Repeat);
+		if (Ar.IsLoading())
+		{
+			RepeatCount = static_cast<int32>(Repeat);
+		}
+
+		uint32 NumSegments = static_cast<uint32>(Segments.Num());
+		Ar.SerializeIntPacked(NumSegments);
+		if (Ar.IsLoading())
+		{
+			// Messages are capped at 512 chars server side, a segment is at least 1 char
+			if (NumSegments > 512)
+			{
+				bOutSuccess = false;
+				return false;
+			}
+			Segments.SetNum(NumSegments);
+		}
+
+		for (FNexusChatSegment& Segment : Segments)
+		{
+			Segment.NetSerialize(Ar);
+		}
+
+		if (NumSegments > 0)
+		{
+			Ar << SegmentData;
+		}
+		else if (Ar.IsLoading())
+		{
+			SegmentData.Reset();
+		}
+
 		bOutSuccess = true;
 		return true;
 	}
@@ -1,8 +1,11 @@
 #pragma once
 #include "CoreMinimal.h"
 #include "Components/RichTextBlock.h"
+#include "Types/NexusChatTypes.h"
 #include "NexusRichTextBlock.generated.h"
 
+class FNexusSegmentMarkupParser;
+
 
 UCLASS(meta = (DisplayName = "Nexus Rich Text Block"))
 class NEXUSCHAT_API UNexusRichTextBlock : public URichTextBlock
@@ -12,6 +15,19 @@ class NEXUSCHAT_API UNexusRichTextBlock : public URichTextBlock
 public:
 	UNexusRichTextBlock(const FObjectInitializer& ObjectInitializer);
 
+	/**
+	 * Renders a structured message (FNexusChatMessage::Segments) straight into runs :
+	 * no markup parsing, so player text can never inject tags.
+	 *
+	 * @param Prefix Plain channel prefix, may be empty
+	 * @param bShowSender Adds a clickable "Sender: " before the content
+	 */
+	void SetChatMessage(const FString& Prefix, const FNexusChatMessage& Message, bool bShowSender, int32 MaxSenderLength = 0);
+
 protected:
 	virtual TSharedRef<SWidget> RebuildWidget() override;
+	virtual TSharedPtr<IRichTextMarkupParser> CreateMarkupParser() override;
+
+private:
+	TSharedPtr<FNexusSegmentMarkupParser> SegmentParser;
 };
@@ -24,7 +24,8 @@ public class NexusFramework : ModuleRules
 	    {
 		    "Slate",
 		    "SlateCore",
-            "DeveloperSettings"
+            "DeveloperSettings",
+            "Sockets"
 	    });
 
 	    PublicIncludePaths.AddRange(new string[]
@@ -3,10 +3,16 @@
 #include "OnlineSessionSettings.h"
 #include "Interfaces/OnlineSessionInterface.h"
 #include "Utils/NexusOnlineHelpers.h"
+#include "Utils/NexusTrace.h"
+#include "Configs/NexusSessionSearchConfig.h"
+#include "Subsystems/NexusMapPreloadSubsystem.h"
+#include "Subsystems/NexusSessionOperationSubsystem.h"
 #include "Data/SessionSearchFilter.h"
 #include "Kismet/GameplayStatics.h"
 #include "Engine/World.h"
 #include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Subsystems/NexusPingProberSubsystem.h"
 
 #define LOCTEXT_NAMESPACE "NexusOnline|CreateSession"
 
@@ -14,7 +20,7 @@
 // Factory Function
 // ──────────────────────────────────────────────
 UAsyncTask_CreateSession* UAsyncTask_CreateSession::CreateSession(UObject* WorldContextObject, const FSessionSettingsData& SettingsData,
-	const TArray<FSessionSearchFilter>& AdditionalSettings, bool bAutoTravel, USessionFilterPreset* Preset)
+	const TArray<FSessionSearchFilter>& AdditionalSettings, bool bAutoTravel, USessionFilterPreset* Preset, bool bPreloadMap)
 {
 	UAsyncTask_CreateSession* Node = NewObject<UAsyncTask_CreateSession>();
 	Node->WorldContextObject = WorldContextObject;
@@ -22,6 +28,7 @@ UAsyncTask_CreateSession* UAsyncTask_CreateSession::CreateSession(UObject* World
 	Node->bShouldAutoTravel = bAutoTravel;
 	Node->SessionAdditionalSettings = AdditionalSettings;
 	Node->SessionPreset = Preset;
+	Node->bPreloadMap = bPreloadMap;
 	
 	return Node;
 }
@@ -31,10 +38,12 @@ UAsyncTask_CreateSession* UAsyncTask_CreateSession::CreateSession(UObject* World
 // ──────────────────────────────────────────────
 void UAsyncTask_CreateSession::Activate()
 {
+	NEXUS_TRACE_SCOPE(NexusCreateSession_Activate);
+
 	if (!WorldContextObject)
 	{
-		UE_LOG(LogTemp, Error, TEXT("[CreateSession] Invalid WorldContextObject."));
-		OnFailure.Broadcast();
+		UE_LOG(LogNexusOnline, Error, TEXT("[CreateSession] Invalid WorldContextObject."));
+		Fail();
 		return;
 	}
 
@@ -42,83 +51,51 @@ void UAsyncTask_CreateSession::Activate()
 	IOnlineSessionPtr Session = NexusOnline::GetSessionInterface(World);
 	if (!Session.IsValid())
 	{
-		UE_LOG(LogTemp, Error, TEXT("[CreateSession] Invalid Online Session Interface."));
-		OnFailure.Broadcast();
+		UE_LOG(LogNexusOnline, Error, TEXT("[CreateSession] Invalid Online Session Interface."));
+		Fail();
 		return;
 	}
 
 	const FName InternalSessionName = NexusOnline::SessionTypeToName(Data.SessionType);
 
-	// 1. VÉRIFICATION
-	if (Session->GetNamedSession(InternalSessionName))
+	UNexusSessionOperationSubsystem* Operations = UNexusSessionOperationSubsystem::Get(World);
+	if (!Operations)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("[CreateSession] Existing session '%s' found. Destroying asynchronously..."), *InternalSessionName.ToString());
-
-		DestroyDelegateHandle = Session->AddOnDestroySessionCompleteDelegate_Handle(FOnDestroySessionCompleteDelegate::CreateUObject(this,
-			&UAsyncTask_CreateSession::OnOldSessionDestroyed));
-
-		if (!Session->DestroySession(InternalSessionName))
-		{
-			Session->ClearOnDestroySessionCompleteDelegate_Handle(DestroyDelegateHandle);
-			OnFailure.Broadcast();
-		}
-		
-		return; 
+		UE_LOG(LogNexusOnline, Error, TEXT("[CreateSession] Session operation subsystem unavailable."));
+		Fail();
+		return;
 	}
 
-	// 2. Si aucune session n'existe, on passe directement à la création
-	CreateSessionInternal();
-}
-
-// ──────────────────────────────────────────────
-// Step 1.5: Old Session Destroyed
-// ──────────────────────────────────────────────
-void UAsyncTask_CreateSession::OnOldSessionDestroyed(FName SessionName, bool bWasSuccessful)
-{
-	UWorld* World = GEngine->GetWorldFromContextObjectChecked(WorldContextObject);
-	IOnlineSessionPtr Session = NexusOnline::GetSessionInterface(World);
-	
-	if (Session.IsValid())
+	// 0. La map se charge pendant l'appel OSS (la mesure du temps jusqu'en jeu démarre ici)
+	if (UNexusMapPreloadSubsystem* Preload = UNexusMapPreloadSubsystem::Get(World))
 	{
-		Session->ClearOnDestroySessionCompleteDelegate_Handle(DestroyDelegateHandle);
+		Preload->BeginFlow(Data.MapName, bPreloadMap && bShouldAutoTravel);
+		bTravelFlowStarted = true;
 	}
 
-	if (bWasSuccessful)
-	{
-		UE_LOG(LogTemp, Log, TEXT("[CreateSession] Old session destroyed. Proceeding to creation."));
-		CreateSessionInternal();
-	}
-	else
-	{
-		UE_LOG(LogTemp, Error, TEXT("[CreateSession] Failed to destroy old session. Cannot create new one safely."));
-		OnFailure.Broadcast();
-	}
+	// 1. Requête : la file de la session détruit l'éventuelle session existante avant de créer
+	FNexusSessionOperationRequest Request;
+	Request.Type = ENexusSessionOperationType::Create;
+	Request.SessionName = InternalSessionName;
+	Request.CoalesceKey = MakeCoalesceKey();
+	BuildSessionSettings(World, Request.Settings);
+
+	UE_LOG(LogNexusOnline, Log, TEXT("[CreateSession] Creating session '%s'..."), *InternalSessionName.ToString());
+
+	Operations->Enqueue(MoveTemp(Request), FOnNexusSessionOperationComplete::CreateUObject(this, &UAsyncTask_CreateSession::OnOperationComplete));
 }
 
 // ──────────────────────────────────────────────
-// Step 2: Internal Creation Logic
+// Settings
 // ──────────────────────────────────────────────
-void UAsyncTask_CreateSession::CreateSessionInternal()
+void UAsyncTask_CreateSession::BuildSessionSettings(UWorld* World, FOnlineSessionSettings& Settings)
 {
-	UWorld* World = GEngine->GetWorldFromContextObjectChecked(WorldContextObject);
-	IOnlineSessionPtr Session = NexusOnline::GetSessionInterface(World);
-	if (!Session.IsValid()) 
-	{
-		OnFailure.Broadcast();
-		return;
-	}
-
-	const FName InternalSessionName = NexusOnline::SessionTypeToName(Data.SessionType);
-
-	// --- Configuration des Settings ---
-	FOnlineSessionSettings Settings;
-
 	const IOnlineSubsystem* Subsystem = Online::GetSubsystem(World);
 	const bool bIsNullSubsystem = Subsystem && Subsystem->GetSubsystemName() == TEXT("NULL");
 	
 	if (bIsNullSubsystem)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("[CreateSession] 'NULL' subsystem detected. Forcing LAN match."));
+		UE_LOG(LogNexusOnline, Log, TEXT("[CreateSession] 'NULL' subsystem detected. Forcing LAN match."));
 	}
 
 	const bool bIsLAN = bIsNullSubsystem ? true : Data.bIsLAN;
@@ -179,6 +156,23 @@ void UAsyncTask_CreateSession::CreateSessionInternal()
 	}
 
 	Settings.Set(TEXT("USES_PRESENCE"), true, EOnlineDataAdvertisementType::ViaOnlineService);
+
+	// Port du répondeur de ping (UNexusPingProberSubsystem), pour les clients qui sondent l'hôte.
+	// Démarré ici plutôt qu'au premier tick serveur : le port n'est annoncé que s'il est vraiment lié
+	const UNexusSessionSearchConfig* SearchConfig = GetDefault<UNexusSessionSearchConfig>();
+	UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	if (UNexusPingProberSubsystem* Prober = GameInstance ? GameInstance->GetSubsystem<UNexusPingProberSubsystem>() : nullptr)
+	{
+		if (SearchConfig && SearchConfig->bEnableEchoResponder && !Prober->IsEchoResponderRunning())
+		{
+			Prober->StartEchoResponder(0);
+		}
+
+		if (Prober->IsEchoResponderRunning())
+		{
+			Settings.Set(TEXT("PING_PORT_KEY"), Prober->GetEchoResponderPort(), EOnlineDataAdvertisementType::ViaOnlineService);
+		}
+	}
 	
 	TArray<FSessionSearchFilter> CombinedSettings = SessionAdditionalSettings;
 	if (SessionPreset)
@@ -186,51 +180,52 @@ void UAsyncTask_CreateSession::CreateSessionInternal()
 	
 	if (!CombinedSettings.IsEmpty())
 		NexusSessionFilterUtils::ApplyFiltersToSettings(CombinedSettings, Settings);
+}
 
-	// Launch 
-	CreateDelegateHandle = Session->AddOnCreateSessionCompleteDelegate_Handle(FOnCreateSessionCompleteDelegate::CreateUObject(this,
-		&UAsyncTask_CreateSession::OnCreateSessionComplete));
-	
-	UE_LOG(LogTemp, Log, TEXT("[CreateSession] Creating session '%s'..."), *InternalSessionName.ToString());
+FString UAsyncTask_CreateSession::MakeCoalesceKey() const
+{
+	// Calculée avant la génération du SessionId : deux clics sur le même bouton donnent la même clé
+	FString Key;
+	FSessionSettingsData::StaticStruct()->ExportText(Key, &Data, nullptr, nullptr, PPF_None, nullptr);
 
-	if (!Session->CreateSession(0, InternalSessionName, Settings))
+	for (const FSessionSearchFilter& Filter : SessionAdditionalSettings)
 	{
-		Session->ClearOnCreateSessionCompleteDelegate_Handle(CreateDelegateHandle);
-		OnFailure.Broadcast();
+		FSessionSearchFilter::StaticStruct()->ExportText(Key, &Filter, nullptr, nullptr, PPF_None, nullptr);
 	}
+
+	if (SessionPreset)
+	{
+		Key += SessionPreset->GetPathName();
+	}
+
+	return Key;
 }
 
 // ──────────────────────────────────────────────
-// Step 3: Completion
+// Completion
 // ──────────────────────────────────────────────
-void UAsyncTask_CreateSession::OnCreateSessionComplete(FName SessionName, bool bWasSuccessful)
+void UAsyncTask_CreateSession::OnOperationComplete(const FNexusSessionOperationResult& Result)
 {
-	UWorld* World = GEngine->GetWorldFromContextObjectChecked(WorldContextObject);
+	NEXUS_TRACE_SCOPE(NexusCreateSession_OnComplete);
+
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull);
 	IOnlineSessionPtr Session = NexusOnline::GetSessionInterface(World);
 
-	if (Session.IsValid())
-	{
-		Session->ClearOnCreateSessionCompleteDelegate_Handle(CreateDelegateHandle);
-	}
-	else
+	if (!Result.WasSuccessful() || !Session.IsValid())
 	{
-		OnFailure.Broadcast();
+		UE_LOG(LogNexusOnline, Error, TEXT("[CreateSession] Failed to create session (%s)."), *UEnum::GetValueAsString(Result.Status));
+		Fail();
 		return;
 	}
 
-	if (!bWasSuccessful)
-	{
-		UE_LOG(LogTemp, Error, TEXT("[CreateSession] Failed to create session."));
-		OnFailure.Broadcast();
-		return;
-	}
+	Session->StartSession(Result.SessionName);
+
+	UE_LOG(LogNexusOnline, Log, TEXT("[CreateSession] Success. AutoTravel = %s"), bShouldAutoTravel ? TEXT("TRUE") : TEXT("FALSE"));
 
-	if (Session.IsValid())
+	if (UNexusMapPreloadSubsystem* Preload = UNexusMapPreloadSubsystem::Get(World))
 	{
-		Session->StartSession(SessionName);
+		Preload->NotifySessionReady();
 	}
-
-	UE_LOG(LogTemp, Log, TEXT("[CreateSession] Success. AutoTravel = %s"), bShouldAutoTravel ? TEXT("TRUE") : TEXT("FALSE"));
 	
 	OnSuccess.Broadcast();
 
@@ -239,4 +234,20 @@ void UAsyncTask_CreateSession::OnCreateSessionComplete(FName SessionName, bool b
 		UGameplayStatics::OpenLevel(World, FName(*Data.MapName), true, TEXT("listen"));
 	}
 }
+
+void UAsyncTask_CreateSession::Fail()
+{
+	// Seul le flux lancé par ce nœud est annulé
+	if (bTravelFlowStarted)
+	{
+		bTravelFlowStarted = false;
+		if (UNexusMapPreloadSubsystem* Preload = UNexusMapPreloadSubsystem::Get(WorldContextObject))
+		{
+			Preload->CancelFlow();
+		}
+	}
+
+	OnFailure.Broadcast();
+}
+
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
@@ -4,6 +4,8 @@
 #include "OnlineSessionSettings.h"
 #include "Interfaces/OnlineSessionInterface.h"
 #include "Utils/NexusOnlineHelpers.h"
+#include "Utils/NexusTrace.h"
+#include "Subsystems/NexusSessionOperationSubsystem.h"
 #include "Kismet/GameplayStatics.h"
 #include "Engine/World.h"
 #include "Engine/Engine.h"
@@ -24,9 +26,11 @@ UAsyncTask_CreateSessionFromConfig* UAsyncTask_CreateSessionFromConfig::CreateSe
 
 void UAsyncTask_CreateSessionFromConfig::Activate()
 {
+	NEXUS_TRACE_SCOPE(NexusCreateSessionFromConfig_Activate);
+
 	if (!WorldContextObject || !SessionConfig)
 	{
-		UE_LOG(LogTemp, Error, TEXT("[CreateSessionConfig] Invalid Context or Config Asset."));
+		UE_LOG(LogNexusOnline, Error, TEXT("[CreateSessionConfig] Invalid Context or Config Asset."));
 		OnFailure.Broadcast();
 		return;
 	}
@@ -39,53 +43,10 @@ void UAsyncTask_CreateSessionFromConfig::Activate()
 		return;
 	}
 
-	const FName InternalSessionName = NexusOnline::SessionTypeToName(SessionConfig->SessionSettings.SessionType);
-
-	// 1. Check existing
-	if (Session->GetNamedSession(InternalSessionName))
-	{
-		UE_LOG(LogTemp, Warning, TEXT("[CreateSessionConfig] Existing session found. Destroying..."));
-		DestroyDelegateHandle = Session->AddOnDestroySessionCompleteDelegate_Handle(FOnDestroySessionCompleteDelegate::CreateUObject(this,
-			&UAsyncTask_CreateSessionFromConfig::OnOldSessionDestroyed));
-
-		if (!Session->DestroySession(InternalSessionName))
-		{
-			Session->ClearOnDestroySessionCompleteDelegate_Handle(DestroyDelegateHandle);
-			OnFailure.Broadcast();
-		}
-		return; 
-	}
-
-	// 2. Proceed
-	CreateSessionInternal();
-}
-
-void UAsyncTask_CreateSessionFromConfig::OnOldSessionDestroyed(FName SessionName, bool bWasSuccessful)
-{
-	UWorld* World = GEngine->GetWorldFromContextObjectChecked(WorldContextObject);
-	IOnlineSessionPtr Session = NexusOnline::GetSessionInterface(World);
-	
-	if (Session.IsValid())
-	{
-		Session->ClearOnDestroySessionCompleteDelegate_Handle(DestroyDelegateHandle);
-	}
-
-	if (bWasSuccessful)
-	{
-		CreateSessionInternal();
-	}
-	else
-	{
-		OnFailure.Broadcast();
-	}
-}
-
-void UAsyncTask_CreateSessionFromConfig::CreateSessionInternal()
-{
-	UWorld* World = GEngine->GetWorldFromContextObjectChecked(WorldContextObject);
-	IOnlineSessionPtr Session = NexusOnline::GetSessionInterface(World);
-	if (!Session.IsValid()) 
+	UNexusSessionOperationSubsystem* Operations = UNexusSessionOperationSubsystem::Get(World);
+	if (!Operations)
 	{
+		UE_LOG(LogNexusOnline, Error, TEXT("[CreateSessionConfig] Session operation subsystem unavailable."));
 		OnFailure.Broadcast();
 		return;
 	}
@@ -93,56 +54,49 @@ void UAsyncTask_CreateSessionFromConfig::CreateSessionInternal()
 	const FName InternalSessionName = NexusOnline::SessionTypeToName(SessionConfig->SessionSettings.SessionType);
 
 	// --- KEY DIFFERENCE: Use the Config Asset to generate settings ---
-	FOnlineSessionSettings Settings;
+	FNexusSessionOperationRequest Request;
+	Request.Type = ENexusSessionOperationType::Create;
+	Request.SessionName = InternalSessionName;
+
+	// Same asset = same session : repeated requests are merged while one is pending
+	Request.CoalesceKey = SessionConfig->GetPathName();
 	
 	// Delegate logic to the DataAsset (allows for C++ overrides!)
-	SessionConfig->ModifySessionSettings(Settings);
+	SessionConfig->ModifySessionSettings(Request.Settings);
 	
 	// Apply Subsystem overrides (NULL/LAN) if necessary
 	const IOnlineSubsystem* Subsystem = Online::GetSubsystem(World);
 	if (Subsystem && Subsystem->GetSubsystemName() == TEXT("NULL"))
 	{
-		Settings.bIsLANMatch = true;
+		Request.Settings.bIsLANMatch = true;
 	}
 
-	// Launch
-	CreateDelegateHandle = Session->AddOnCreateSessionCompleteDelegate_Handle(FOnCreateSessionCompleteDelegate::CreateUObject(this,
-		&UAsyncTask_CreateSessionFromConfig::OnCreateSessionComplete));
-	
-	UE_LOG(LogTemp, Log, TEXT("[CreateSessionConfig] Creating session '%s' using Config '%s'..."), 
+	// Launch (an existing session is destroyed first by the operation queue)
+	UE_LOG(LogNexusOnline, Log, TEXT("[CreateSessionConfig] Creating session '%s' using Config '%s'..."), 
 		*InternalSessionName.ToString(), *SessionConfig->GetName());
 
-	if (!Session->CreateSession(0, InternalSessionName, Settings))
-	{
-		Session->ClearOnCreateSessionCompleteDelegate_Handle(CreateDelegateHandle);
-		OnFailure.Broadcast();
-	}
+	Operations->Enqueue(MoveTemp(Request), FOnNexusSessionOperationComplete::CreateUObject(this,
+		&UAsyncTask_CreateSessionFromConfig::OnOperationComplete));
 }
 
-void UAsyncTask_CreateSessionFromConfig::OnCreateSessionComplete(FName SessionName, bool bWasSuccessful)
+void UAsyncTask_CreateSessionFromConfig::OnOperationComplete(const FNexusSessionOperationResult& Result)
 {
-	UWorld* World = GEngine->GetWorldFromContextObjectChecked(WorldContextObject);
-	IOnlineSessionPtr Session = NexusOnline::GetSessionInterface(World);
+	NEXUS_TRACE_SCOPE(NexusCreateSessionFromConfig_OnComplete);
 
-	if (Session.IsValid())
-	{
-		Session->ClearOnCreateSessionCompleteDelegate_Handle(CreateDelegateHandle);
-	}
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull);
+	IOnlineSessionPtr Session = NexusOnline::GetSessionInterface(World);
 
-	if (!bWasSuccessful)
+	if (!Result.WasSuccessful() || !Session.IsValid())
 	{
 		OnFailure.Broadcast();
 		return;
 	}
 
-	if (Session.IsValid())
-	{
-		Session->StartSession(SessionName);
-	}
+	Session->StartSession(Result.SessionName);
 	
 	OnSuccess.Broadcast();
 
-	if (bShouldAutoTravel && World && !SessionConfig->SessionSettings.MapName.IsEmpty())
+	if (bShouldAutoTravel && World && SessionConfig && !SessionConfig->SessionSettings.MapName.IsEmpty())
 	{
 		UGameplayStatics::OpenLevel(World, FName(*SessionConfig->SessionSettings.MapName), true, TEXT("listen"));
 	}
@@ -1,5 +1,6 @@
 ﻿#include "Async/AsyncTask_DestroySession.h"
 #include "Utils/NexusOnlineHelpers.h"
+#include "Utils/NexusTrace.h"
 #include "Managers/OnlineSessionManager.h"
 #include "OnlineSubsystem.h"
 #include "Interfaces/OnlineSessionInterface.h"
@@ -27,10 +28,12 @@ UAsyncTask_DestroySession* UAsyncTask_DestroySession::DestroySession(UObject* Wo
 
 void UAsyncTask_DestroySession::Activate()
 {
+	NEXUS_TRACE_SCOPE(NexusDestroySession_Activate);
+
 	// Validate context
 	if (!WorldContextObject)
 	{
-		UE_LOG(LogTemp, Error, TEXT("[DestroySession] Invalid WorldContextObject."));
+		UE_LOG(LogNexusOnline, Error, TEXT("[DestroySession] Invalid WorldContextObject."));
 		OnFailure.Broadcast();
 		
 		return;
@@ -48,7 +51,7 @@ void UAsyncTask_DestroySession::Activate()
 	IOnlineSessionPtr Session = NexusOnline::GetSessionInterface(World);
 	if (!Session.IsValid())
 	{
-		UE_LOG(LogTemp, Error, TEXT("[DestroySession] No valid OnlineSubsystem or SessionInterface."));
+		UE_LOG(LogNexusOnline, Error, TEXT("[DestroySession] No valid OnlineSubsystem or SessionInterface."));
 		OnFailure.Broadcast();
 		
 		return;
@@ -56,46 +59,47 @@ void UAsyncTask_DestroySession::Activate()
 
 	const FName InternalSessionName = NexusOnline::SessionTypeToName(TargetSessionType);
 
-	// Ensure session exists
-	if (!Session->GetNamedSession(InternalSessionName))
+	UNexusSessionOperationSubsystem* Operations = UNexusSessionOperationSubsystem::Get(World);
+	if (!Operations)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("[DestroySession] '%s' does not exist or is already destroyed."), *InternalSessionName.ToString());
+		UE_LOG(LogNexusOnline, Error, TEXT("[DestroySession] Session operation subsystem unavailable."));
 		OnFailure.Broadcast();
 		
 		return;
 	}
 
-	// Bind delegate & initiate destruction
-	DestroyDelegateHandle = Session->AddOnDestroySessionCompleteDelegate_Handle(
-		FOnDestroySessionCompleteDelegate::CreateUObject(this, &UAsyncTask_DestroySession::OnDestroySessionComplete)
-	);
-
-	UE_LOG(LogTemp, Log, TEXT("[DestroySession] Destroying session: %s"), *InternalSessionName.ToString());
-
-	if (!Session->DestroySession(InternalSessionName))
+	// Ensure session exists (or is about to : a queued create / join may still be running)
+	if (!Session->GetNamedSession(InternalSessionName) && !Operations->IsBusy(InternalSessionName))
 	{
-		UE_LOG(LogTemp, Error, TEXT("[DestroySession] DestroySession() call failed immediately."));
-		Session->ClearOnDestroySessionCompleteDelegate_Handle(DestroyDelegateHandle);
-		
+		UE_LOG(LogNexusOnline, Warning, TEXT("[DestroySession] '%s' does not exist or is already destroyed."), *InternalSessionName.ToString());
 		OnFailure.Broadcast();
+		
+		return;
 	}
+
+	// Queue destruction (runs after any pending create / join of this session; repeated requests are merged)
+	FNexusSessionOperationRequest Request;
+	Request.Type = ENexusSessionOperationType::Destroy;
+	Request.SessionName = InternalSessionName;
+	Request.CoalesceKey = TEXT("Destroy");
+
+	UE_LOG(LogNexusOnline, Log, TEXT("[DestroySession] Destroying session: %s"), *InternalSessionName.ToString());
+
+	Operations->Enqueue(MoveTemp(Request), FOnNexusSessionOperationComplete::CreateUObject(this, &UAsyncTask_DestroySession::OnOperationComplete));
 }
 
 // ──────────────────────────────────────────────
-// OnDestroySessionComplete
+// OnOperationComplete
 // ──────────────────────────────────────────────
 
-void UAsyncTask_DestroySession::OnDestroySessionComplete(FName SessionName, bool bWasSuccessful)
+void UAsyncTask_DestroySession::OnOperationComplete(const FNexusSessionOperationResult& Result)
 {
-	UWorld* World = GEngine->GetWorldFromContextObjectChecked(WorldContextObject);
-	IOnlineSessionPtr Session = NexusOnline::GetSessionInterface(World);
+	NEXUS_TRACE_SCOPE(NexusDestroySession_OnComplete);
 
-	if (Session.IsValid())
-	{
-		Session->ClearOnDestroySessionCompleteDelegate_Handle(DestroyDelegateHandle);
-	}
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull);
+	const bool bWasSuccessful = Result.WasSuccessful();
 
-	UE_LOG(LogTemp, Log, TEXT("[DestroySession] Session '%s' destruction result: %s"), *SessionName.ToString(),
+	UE_LOG(LogNexusOnline, Log, TEXT("[DestroySession] Session '%s' destruction result: %s"), *Result.SessionName.ToString(),
 		bWasSuccessful ? TEXT("SUCCESS") : TEXT("FAILURE"));
 
 	if (bWasSuccessful && World)
@@ -1,7 +1,12 @@
 ﻿#include "Async/AsyncTask_FindSessionById.h"
+#include "Async/AsyncTask_FindSessions.h"
 #include "Interfaces/OnlineSessionInterface.h"
 #include "OnlineSubsystem.h"
+#include "OnlineSessionSettings.h"
+#include "Configs/NexusSessionSearchConfig.h"
+#include "Subsystems/NexusSessionCacheSubsystem.h"
 #include "Utils/NexusOnlineHelpers.h"
+#include "Utils/NexusTrace.h"
 #include "Engine/World.h"
 #include "Engine/Engine.h"
 
@@ -10,58 +15,220 @@ UAsyncTask_FindSessionById* UAsyncTask_FindSessionById::FindSessionById(UObject*
 {
     UAsyncTask_FindSessionById* Node = NewObject<UAsyncTask_FindSessionById>();
     Node->WorldContextObject = WorldContextObject;
-    Node->TargetSessionId = SessionId;
+    if (!SessionId.IsEmpty())
+    {
+        Node->RequestedIds.Add(SessionId);
+    }
+    return Node;
+}
+
+UAsyncTask_FindSessionById* UAsyncTask_FindSessionById::FindSessionsByIds(UObject* WorldContextObject, const TArray<FString>& SessionIds, bool bForceRefresh)
+{
+    UAsyncTask_FindSessionById* Node = NewObject<UAsyncTask_FindSessionById>();
+    Node->WorldContextObject = WorldContextObject;
+    Node->bBulk = true;
+    Node->bForceRefresh = bForceRefresh;
+
+    for (const FString& SessionId : SessionIds)
+    {
+        if (!SessionId.IsEmpty())
+        {
+            Node->RequestedIds.AddUnique(SessionId);
+        }
+    }
     return Node;
 }
 
 void UAsyncTask_FindSessionById::Activate()
 {
-    IOnlineSessionPtr Session = NexusOnline::GetSessionInterface(GEngine->GetWorldFromContextObjectChecked(WorldContextObject));
-    if (!Session.IsValid())
+    NEXUS_TRACE_SCOPE(NexusFindSessionById_Activate);
+
+    // ---- Réponse locale : ids déjà vus par une recherche récente
+    UNexusSessionCacheSubsystem* Cache = bForceRefresh ? nullptr : UNexusSessionCacheSubsystem::Get(WorldContextObject);
+    if (Cache)
+    {
+        for (const FString& SessionId : RequestedIds)
+        {
+            FOnlineSessionSearchResultData Indexed;
+            if (Cache->FindIndexedSession(SessionId, Indexed))
+            {
+                ResolvedSessions.Add(SessionId, MoveTemp(Indexed));
+            }
+        }
+    }
+
+    for (const FString& SessionId : RequestedIds)
     {
-        OnCompleted.Broadcast(false, FOnlineSessionSearchResultData());
+        if (!ResolvedSessions.Contains(SessionId))
+        {
+            QueriedIds.Add(SessionId);
+        }
+    }
+
+    if (QueriedIds.IsEmpty())
+    {
+        UE_LOG(LogNexusOnline, Verbose, TEXT("[FindSessionById] %d id(s) answered from the index."), RequestedIds.Num());
+        Finish();
         return;
     }
 
+    // ---- Une requête filtrée par id manquant, l'une après l'autre : une recherche non filtrée plafonnée manquerait des ids
+    const UNexusSessionSearchConfig* Config = GetDefault<UNexusSessionSearchConfig>();
+    const int32 MaxQueries = Config ? Config->BulkLookupMaxQueries : 32;
+    if (QueriedIds.Num() > MaxQueries)
+    {
+        UE_LOG(LogNexusOnline, Warning, TEXT("[FindSessionById] %d id(s) to look up, only the first %d are queried."), QueriedIds.Num(), MaxQueries);
+        QueriedIds.SetNum(MaxQueries);
+    }
+
+    UE_LOG(LogNexusOnline, Log, TEXT("[FindSessionById] Looking up %d id(s) online (%d answered from the index)."),
+        QueriedIds.Num(), RequestedIds.Num() - QueriedIds.Num());
+
+    if (!StartNextQuery())
+    {
+        Finish();
+    }
+}
+
+bool UAsyncTask_FindSessionById::StartNextQuery()
+{
+    // Un id peut déjà être revenu dans les résultats d'une requête précédente
+    while (QueriedIds.IsValidIndex(NextQueryIndex) && ResolvedSessions.Contains(QueriedIds[NextQueryIndex]))
+    {
+        ++NextQueryIndex;
+    }
+
+    if (!QueriedIds.IsValidIndex(NextQueryIndex))
+        return false;
+
+    IOnlineSessionPtr Session = NexusOnline::GetSessionInterface(GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull));
+    if (!Session.IsValid())
+        return false;
+
     SearchSettings = MakeShareable(new FOnlineSessionSearch());
-    SearchSettings->MaxSearchResults = 50;
-	SearchSettings->QuerySettings.Set(FName("SESSION_ID_KEY"), TargetSessionId, EOnlineComparisonOp::Equals);
+    SearchSettings->MaxSearchResults = 10;
+    SearchSettings->QuerySettings.Set(FName("SESSION_ID_KEY"), QueriedIds[NextQueryIndex++], EOnlineComparisonOp::Equals);
+
+    FindSessionsHandle = Session->AddOnFindSessionsCompleteDelegate_Handle(FOnFindSessionsCompleteDelegate::CreateUObject(this, &UAsyncTask_FindSessionById::OnFindSessionsComplete));
 
-    Session->AddOnFindSessionsCompleteDelegate_Handle(FOnFindSessionsCompleteDelegate::CreateUObject(this, &UAsyncTask_FindSessionById::OnFindSessionsComplete));
+    OssCallTime = NexusTrace::BeginOssCall();
 
     if (!Session->FindSessions(0, SearchSettings.ToSharedRef()))
     {
-        OnCompleted.Broadcast(false, FOnlineSessionSearchResultData());
+        NexusTrace::EndOssCall(OssCallTime);
+        Session->ClearOnFindSessionsCompleteDelegate_Handle(FindSessionsHandle);
+        FindSessionsHandle.Reset();
+        return false;
+    }
+    return true;
+}
+
+void UAsyncTask_FindSessionById::Cancel()
+{
+    if (FindSessionsHandle.IsValid())
+    {
+        NexusTrace::EndOssCall(OssCallTime);
+
+        // Pas de CancelFindSessions : la recherche en vol de l'interface peut être celle d'un autre nœud
+        if (IOnlineSessionPtr Session = NexusOnline::GetSessionInterface(WorldContextObject))
+        {
+            Session->ClearOnFindSessionsCompleteDelegate_Handle(FindSessionsHandle);
+        }
+        FindSessionsHandle.Reset();
     }
+
+    // Plus aucune requête : les ids restants ne sont pas cherchés
+    NextQueryIndex = QueriedIds.Num();
+    SetReadyToDestroy();
 }
 
 void UAsyncTask_FindSessionById::OnFindSessionsComplete(bool bWasSuccessful)
 {
-    if (!bWasSuccessful || SearchSettings->SearchResults.IsEmpty())
+    // Le delegate est partagé par toutes les recherches : la fin d'une autre ne concerne pas ce nœud
+    if (SearchSettings.IsValid() && SearchSettings->SearchState == EOnlineAsyncTaskState::InProgress)
+        return;
+
+    NEXUS_TRACE_SCOPE(NexusFindSessionById_OnComplete);
+    NexusTrace::EndOssCall(OssCallTime);
+
+    if (IOnlineSessionPtr Session = NexusOnline::GetSessionInterface(WorldContextObject))
+    {
+        Session->ClearOnFindSessionsCompleteDelegate_Handle(FindSessionsHandle);
+    }
+    FindSessionsHandle.Reset();
+
+    if (!bWasSuccessful || !SearchSettings.IsValid() || SearchSettings->SearchResults.IsEmpty())
     {
-        OnCompleted.Broadcast(false, FOnlineSessionSearchResultData());
+        if (!StartNextQuery())
+        {
+            Finish();
+        }
         return;
     }
 
-    for (const FOnlineSessionSearchResult& Result : SearchSettings->SearchResults)
+    // Les résultats bruts passent dans un ensemble partagé : le join n'aura pas à les copier
+    TSharedRef<FNexusSessionResultSet, ESPMode::ThreadSafe> ResultSet = MakeShared<FNexusSessionResultSet, ESPMode::ThreadSafe>();
+    ResultSet->Results = MoveTemp(SearchSettings->SearchResults);
+
+    TArray<FOnlineSessionSearchResultData> AllResults;
+    AllResults.Reserve(ResultSet->Results.Num());
+
+    TMap<FString, int32> IndexById;
+    IndexById.Reserve(ResultSet->Results.Num());
+
+    for (int32 Index = 0; Index < ResultSet->Results.Num(); ++Index)
     {
-        FString FoundId;
-        Result.Session.SessionSettings.Get(TEXT("SESSION_ID_KEY"), FoundId);
+        AllResults.Add(UAsyncTask_FindSessions::MakeResultData(ResultSet, Index));
+        IndexById.Add(NexusOnline::GetSessionIdentity(ResultSet->Results[Index]), Index);
+    }
 
-        if (FoundId == TargetSessionId)
+    for (const FString& SessionId : QueriedIds)
+    {
+        if (const int32* Index = IndexById.Find(SessionId))
         {
-        	FOnlineSessionSearchResultData Data;
-        	Data.RawResult = Result;
-        	Data.SessionDisplayName = Result.GetSessionIdStr();
-        	Data.CurrentPlayers = Result.Session.SessionSettings.NumPublicConnections - Result.Session.NumOpenPublicConnections;
-        	Data.MaxPlayers = Result.Session.SessionSettings.NumPublicConnections;
+            ResolvedSessions.Add(SessionId, AllResults[*Index]);
+        }
+    }
 
-        	Result.Session.SessionSettings.Get(TEXT("SESSION_DISPLAY_NAME"), Data.SessionDisplayName);
+    // Tout ce qui est revenu sert aux prochaines recherches par id
+    if (UNexusSessionCacheSubsystem* Cache = UNexusSessionCacheSubsystem::Get(WorldContextObject))
+    {
+        Cache->IndexResults(AllResults);
+    }
 
-        	OnCompleted.Broadcast(true, Data);
-        	return;
+    if (!StartNextQuery())
+    {
+        Finish();
+    }
+}
+
+void UAsyncTask_FindSessionById::Finish()
+{
+    if (bBulk)
+    {
+        TArray<FOnlineSessionSearchResultData> Found;
+        TArray<FString> MissingIds;
+        Found.Reserve(RequestedIds.Num());
+
+        for (const FString& SessionId : RequestedIds)
+        {
+            if (const FOnlineSessionSearchResultData* Result = ResolvedSessions.Find(SessionId))
+            {
+                Found.Add(*Result);
+            }
+            else
+            {
+                MissingIds.Add(SessionId);
+            }
         }
+
+        OnBulkCompleted.Broadcast(MissingIds.IsEmpty(), Found, MissingIds);
+    }
+    else
+    {
+        const FOnlineSessionSearchResultData* Result = RequestedIds.IsEmpty() ? nullptr : ResolvedSessions.Find(RequestedIds[0]);
+        OnCompleted.Broadcast(Result != nullptr, Result ? *Result : FOnlineSessionSearchResultData());
     }
 
-    OnCompleted.Broadcast(false, FOnlineSessionSearchResultData());
+    SetReadyToDestroy();
 }
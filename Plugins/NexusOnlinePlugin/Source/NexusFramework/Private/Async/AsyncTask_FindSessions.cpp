@@ -1,17 +1,24 @@
 #include "Async/AsyncTask_FindSessions.h"
 #include "Async/Async.h"
 #include "Algo/Sort.h"
+#include "Async/ParallelFor.h"
 #include "Data/SessionSearchFilter.h"
 #include "Filters/SessionFilterRule.h"
 #include "Filters/SessionSortRule.h"
+#include "Filters/Rules/SessionSortRule_MatchScore.h"
 #include "Data/SessionFilterPreset.h"
+#include "Subsystems/NexusSessionCacheSubsystem.h"
+#include "Subsystems/NexusPingProberSubsystem.h"
+#include "Configs/NexusSessionSearchConfig.h"
 #include "Utils/NexusOnlineHelpers.h"
+#include "Utils/NexusTrace.h"
 #include "OnlineSubsystemUtils.h"
 #include "OnlineSubsystem.h"
 #include "Interfaces/OnlineSessionInterface.h"
 #include "OnlineSessionSettings.h"
 #include "GameFramework/PlayerController.h"
 #include "Engine/LocalPlayer.h"
+#include "Engine/GameInstance.h"
 
 #define LOCTEXT_NAMESPACE "NexusOnline|FindSessions"
 
@@ -20,7 +27,7 @@
 // ──────────────────────────────────────────────
 UAsyncTask_FindSessions* UAsyncTask_FindSessions::FindSessions(UObject* WorldContextObject, ENexusSessionType SessionType, int32 MaxResults, bool bIsLANQuery,
 	const TArray<FSessionSearchFilter>& SimpleFilters, const TArray<USessionFilterRule*>& AdvancedRules,
-	const TArray<USessionSortRule*>& SortRules, USessionFilterPreset* Preset)
+	const TArray<USessionSortRule*>& SortRules, USessionFilterPreset* Preset, bool bUseCache)
 {
 	UAsyncTask_FindSessions* Node = NewObject<UAsyncTask_FindSessions>();
 	Node->WorldContextObject = WorldContextObject;
@@ -32,6 +39,7 @@ UAsyncTask_FindSessions* UAsyncTask_FindSessions::FindSessions(UObject* WorldCon
 	Node->SearchSettings->bIsLanQuery = bIsLANQuery;
 	Node->UserSimpleFilters = SimpleFilters;
 	Node->UserPreset = Preset;
+	Node->bUseCache = bUseCache;
 
 	for (USessionFilterRule* Rule : AdvancedRules)
 	{
@@ -48,29 +56,128 @@ UAsyncTask_FindSessions* UAsyncTask_FindSessions::FindSessions(UObject* WorldCon
 	return Node;
 }
 
+UAsyncTask_FindSessions* UAsyncTask_FindSessions::FindSessionsStreamed(UObject* WorldContextObject, ENexusSessionType SessionType, int32 MaxResults, bool bIsLANQuery,
+	const TArray<FSessionSearchFilter>& SimpleFilters, const TArray<USessionFilterRule*>& AdvancedRules,
+	const TArray<USessionSortRule*>& SortRules, USessionFilterPreset* Preset, int32 PageSize)
+{
+	UAsyncTask_FindSessions* Node = FindSessions(WorldContextObject, SessionType, MaxResults, bIsLANQuery, SimpleFilters, AdvancedRules, SortRules, Preset, false);
+	Node->bStreaming = true;
+
+	const UNexusSessionSearchConfig* Config = GetDefault<UNexusSessionSearchConfig>();
+	Node->StreamPageSize = (PageSize > 0) ? PageSize : (Config ? Config->DefaultPageSize : 10);
+
+	// Le traitement s'étale sur plusieurs frames : le nœud doit survivre au GC jusqu'à SetReadyToDestroy
+	Node->RegisterWithGameInstance(WorldContextObject);
+	return Node;
+}
+
+UAsyncTask_FindSessions* UAsyncTask_FindSessions::FindSessionsMulti(UObject* WorldContextObject, const TArray<FNexusSessionSubQuery>& SubQueries,
+	const TArray<FSessionSearchFilter>& SimpleFilters, const TArray<USessionFilterRule*>& AdvancedRules,
+	const TArray<USessionSortRule*>& SortRules, USessionFilterPreset* Preset)
+{
+	const ENexusSessionType FirstType = SubQueries.Num() > 0 ? SubQueries[0].SessionType : ENexusSessionType::GameSession;
+	
+	UAsyncTask_FindSessions* Node = FindSessions(WorldContextObject, FirstType, 0, false, SimpleFilters, AdvancedRules, SortRules, Preset, false);
+	Node->bMultiQuery = true;
+
+	for (const FNexusSessionSubQuery& SubQuery : SubQueries)
+	{
+		FSubQueryState& State = Node->SubQueries.AddDefaulted_GetRef();
+		State.SessionType = SubQuery.SessionType;
+		State.Search = MakeShareable(new FOnlineSessionSearch());
+		State.Search->MaxSearchResults = (SubQuery.MaxResults > 0) ? SubQuery.MaxResults : 50;
+		State.Search->bIsLanQuery = SubQuery.bIsLANQuery;
+	}
+
+	// Les requêtes s'enchaînent parfois sur plusieurs frames : le nœud doit survivre au GC jusqu'à SetReadyToDestroy
+	Node->RegisterWithGameInstance(WorldContextObject);
+	return Node;
+}
+
+UAsyncTask_FindSessions* UAsyncTask_FindSessions::QuickMatch(UObject* WorldContextObject, ENexusSessionType SessionType, const FNexusMatchScoringParams& Scoring,
+	int32 K, FOnNexusQuickMatchComplete OnComplete, const TArray<FSessionSearchFilter>& SimpleFilters, int32 MaxResults)
+{
+	USessionSortRule_MatchScore* ScoreRule = NewObject<USessionSortRule_MatchScore>(GetTransientPackage());
+	ScoreRule->Scoring = Scoring;
+	ScoreRule->TopK = FMath::Max(K, 1);
+
+	UAsyncTask_FindSessions* Node = FindSessions(WorldContextObject, SessionType, MaxResults, false, SimpleFilters, {}, { ScoreRule }, nullptr, false);
+	Node->QuickMatchCompletion = MoveTemp(OnComplete);
+
+	Node->RegisterWithGameInstance(WorldContextObject);
+	Node->Activate();
+	return Node;
+}
+
+void UAsyncTask_FindSessions::BeginDestroy()
+{
+	if (StreamTickHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(StreamTickHandle);
+		StreamTickHandle.Reset();
+	}
+
+	if (SubQueryTimeoutHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(SubQueryTimeoutHandle);
+		SubQueryTimeoutHandle.Reset();
+	}
+
+	if (CacheWaitTimeoutHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(CacheWaitTimeoutHandle);
+		CacheWaitTimeoutHandle.Reset();
+	}
+
+	// Propriétaire du refresh détruit avant la réponse : les nœuds en attente sur la clé sont libérés
+	if (bOwnsCacheRefresh)
+	{
+		bOwnsCacheRefresh = false;
+		if (UNexusSessionCacheSubsystem* Cache = CacheSubsystem.Get())
+		{
+			Cache->OnRefreshCompleted.Remove(CacheRefreshHandle);
+			Cache->AbandonRefresh(CacheKey);
+		}
+	}
+
+	// Nœud détruit avant la réponse : l'appel ne compte plus comme en vol
+	NexusTrace::EndOssCall(OssCallTime);
+	for (FSubQueryState& SubQuery : SubQueries)
+	{
+		if (SubQuery.bInFlight)
+		{
+			NexusTrace::EndOssCall(SubQuery.StartTime);
+		}
+	}
+	
+	Super::BeginDestroy();
+}
+
 // ──────────────────────────────────────────────
 // Activate : Lancement de la recherche
 // ──────────────────────────────────────────────
 void UAsyncTask_FindSessions::Activate()
 {
+	NEXUS_TRACE_SCOPE(NexusFindSessions_Activate);
+
 	if (!WorldContextObject)
 	{
-		UE_LOG(LogTemp, Error, TEXT("[FindSessions] Invalid WorldContextObject."));
-		OnCompleted.Broadcast(false, {});
+		UE_LOG(LogNexusOnline, Error, TEXT("[FindSessions] Invalid WorldContextObject."));
+		FinishSearch(false, {});
 		return;
 	}
 
 	UWorld* World = GEngine->GetWorldFromContextObjectChecked(WorldContextObject);
 	if (!World)
 	{
-		OnCompleted.Broadcast(false, {});
+		FinishSearch(false, {});
 		return;
 	}
 
 	APlayerController* PC = World->GetFirstPlayerController();
 	if (!PC)
 	{
-		OnCompleted.Broadcast(false, {});
+		FinishSearch(false, {});
 		return;
 	}
 
@@ -82,56 +189,77 @@ void UAsyncTask_FindSessions::Activate()
 
 	if (!PlayerID.IsValid())
 	{
-		UE_LOG(LogTemp, Warning, TEXT("[FindSessions] Invalid Player UniqueNetId. Proceeding, but Steam/EOS might fail."));
+		UE_LOG(LogNexusOnline, Verbose, TEXT("[FindSessions] Invalid Player UniqueNetId. Proceeding, but Steam/EOS might fail."));
 	}
 
 	RebuildResolvedFilters();
+	CompileResolvedFilters();
 
 	IOnlineSubsystem* Subsystem = Online::GetSubsystem(World);
 	if (!Subsystem)
 	{
-		OnCompleted.Broadcast(false, {});
+		FinishSearch(false, {});
 		return;
 	}
 
 	const FName SubsystemName = Subsystem->GetSubsystemName();
 	if (SubsystemName == TEXT("NULL") && !SearchSettings->bIsLanQuery)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("[FindSessions] 'NULL' subsystem detected. Forcing LAN query."));
+		UE_LOG(LogNexusOnline, Verbose, TEXT("[FindSessions] 'NULL' subsystem detected. Forcing LAN query."));
 		SearchSettings->bIsLanQuery = true;
 	}
 
 	IOnlineSessionPtr Session = Subsystem->GetSessionInterface();
 	if (!Session.IsValid())
 	{
-		OnCompleted.Broadcast(false, {});
+		FinishSearch(false, {});
+		return;
+	}
+
+	if (bMultiQuery)
+	{
+		SearchPlayerId = PlayerID;
+		StartSubQueries(*Session);
 		return;
 	}
 
-	ApplyQueryFilters();
+	if (bUseCache && TryServeFromCache(World))
+		return;
+
+	ApplyQueryFilters(*SearchSettings, DesiredType);
 
 	FindSessionsHandle = Session->AddOnFindSessionsCompleteDelegate_Handle
 	(
 		FOnFindSessionsCompleteDelegate::CreateUObject(this, &UAsyncTask_FindSessions::OnFindSessionsComplete)
 	);
 
-	UE_LOG(LogTemp, Log, TEXT("[FindSessions] Searching... (Type: %s, Max: %d, LAN: %s)"),
+	UE_LOG(LogNexusOnline, Log, TEXT("[FindSessions] Searching... (Type: %s, Max: %d, LAN: %s)"),
 		*NexusOnline::SessionTypeToName(DesiredType).ToString(),
 		SearchSettings->MaxSearchResults,
 		SearchSettings->bIsLanQuery ? TEXT("YES") : TEXT("NO"));
 	
+	OssCallTime = NexusTrace::BeginOssCall();
+
 	if (!Session->FindSessions(*PlayerID, SearchSettings.ToSharedRef()))
 	{
+		NexusTrace::EndOssCall(OssCallTime);
 		Session->ClearOnFindSessionsCompleteDelegate_Handle(FindSessionsHandle);
-		OnCompleted.Broadcast(false, {});
+		FinishSearch(false, {});
 	}
 }
 
 void UAsyncTask_FindSessions::OnFindSessionsComplete(bool bWasSuccessful)
 {
+	NEXUS_TRACE_SCOPE(NexusFindSessions_OnComplete);
+
+	const float OssWaitMs = NexusTrace::EndOssCall(OssCallTime);
+
 	UWorld* World = GEngine->GetWorldFromContextObjectChecked(WorldContextObject);
 	if (!World)
+	{
+		FinishSearch(false, {});
 		return;
+	}
 
 	IOnlineSessionPtr Session = NexusOnline::GetSessionInterface(World);
 	if (Session.IsValid())
@@ -141,131 +269,888 @@ void UAsyncTask_FindSessions::OnFindSessionsComplete(bool bWasSuccessful)
 
 	if (!bWasSuccessful || !SearchSettings.IsValid())
 	{
-		UE_LOG(LogTemp, Warning, TEXT("[FindSessions] Search failed or returned no results."));
-		OnCompleted.Broadcast(false, {});
+		UE_LOG(LogNexusOnline, Warning, TEXT("[FindSessions] Search failed or returned no results."));
+		FinishSearch(false, {});
 		return;
 	}
 
 	if (SearchSettings->SearchResults.Num() == 0)
 	{
-		UE_LOG(LogTemp, Log, TEXT("[FindSessions] Search successful but found 0 sessions."));
-		OnCompleted.Broadcast(true, {});
+		UE_LOG(LogNexusOnline, Log, TEXT("[FindSessions] Search successful but found 0 sessions."));
+		FinishSearch(true, {});
 		return;
 	}
 
-	UE_LOG(LogTemp, Log, TEXT("[FindSessions] Raw results found: %d. Processing filters..."), SearchSettings->SearchResults.Num());
+	UE_LOG(LogNexusOnline, Log, TEXT("[FindSessions] Raw results found: %d in %.1f ms. Processing filters..."), SearchSettings->SearchResults.Num(), OssWaitMs);
+
+	// Les résultats bruts ne sont plus copiés : filtrage et tri travaillent sur des indices dans l'ensemble partagé
+	ResultSet = MakeShared<FNexusSessionResultSet, ESPMode::ThreadSafe>();
+	ResultSet->Results = MoveTemp(SearchSettings->SearchResults);
 	
-	ProcessSearchResults(SearchSettings->SearchResults);
+	ProcessSearchResults();
 }
 
 // ──────────────────────────────────────────────
 // Traitement, Filtrage et Tri
 // ──────────────────────────────────────────────
-void UAsyncTask_FindSessions::ProcessSearchResults(const TArray<FOnlineSessionSearchResult>& InResults)
+void UAsyncTask_FindSessions::ProcessSearchResults()
 {
-	const FString DesiredTypeStr = NexusOnline::SessionTypeToName(DesiredType).ToString();
-	
-	bool bIsNullSubsystem = false;
-	if (UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+	NEXUS_TRACE_SCOPE(NexusFindSessions_Process);
+
+	// Les sondes partent avant le filtrage : les pings mesurés serviront aux prochaines recherches / UpdateResultPings
+	const UNexusSessionSearchConfig* SearchConfig = GetDefault<UNexusSessionSearchConfig>();
+	if (SearchConfig && SearchConfig->bAutoProbeResults)
 	{
-		if (IOnlineSubsystem* Subsystem = Online::GetSubsystem(World))
+		UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull);
+		UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+		if (UNexusPingProberSubsystem* Prober = GameInstance ? GameInstance->GetSubsystem<UNexusPingProberSubsystem>() : nullptr)
 		{
-			bIsNullSubsystem = (Subsystem->GetSubsystemName() == TEXT("NULL"));
+			Prober->ProbeRawResults(ResultSet->Results);
 		}
 	}
 
-	TArray<FOnlineSessionSearchResult> FilteredResults;
-	FilteredResults.Reserve(InResults.Num());
+	if (bStreaming)
+	{
+		StartStreaming();
+		return;
+	}
+
+	const TArray<FOnlineSessionSearchResult>& RawResults = ResultSet->Results;
+	const FString DesiredTypeStr = GetDesiredTypeFilter();
+	const bool bIsNullSubsystem = IsNullSubsystem();
+
+	TArray<int32> FilteredIndices;
+	FilteredIndices.Reserve(RawResults.Num());
 
 	// ---------------------------------------------------------
 	// PHASE 1 : FILTRAGE
 	// ---------------------------------------------------------
-	for (const FOnlineSessionSearchResult& Result : InResults)
+	const UNexusSessionSearchConfig* Config = GetDefault<UNexusSessionSearchConfig>();
+	if (Config && Config->bParallelFiltering && RawResults.Num() >= Config->ParallelFilterThreshold)
 	{
-		if (!Result.IsValid())
-			continue;
+		FilterResultsParallel(DesiredTypeStr, bIsNullSubsystem, FilteredIndices);
+	}
+	else
+	{
+		for (int32 Index = 0; Index < RawResults.Num(); ++Index)
+		{
+			if (PassesResultFilters(RawResults[Index], DesiredTypeStr, bIsNullSubsystem))
+			{
+				FilteredIndices.Add(Index);
+			}
+		}
+	}
 
-		FString FoundType;
-		Result.Session.SessionSettings.Get(TEXT("SESSION_TYPE_KEY"), FoundType);
+	// ---------------------------------------------------------
+	// PHASE 2 : TRI (ou sélection des K meilleurs scores)
+	// ---------------------------------------------------------
+	TArray<float> MatchScores;
+	if (!SelectBestScored(FilteredIndices, MatchScores))
+	{
+		SortSearchResults(FilteredIndices);
+	}
 
-		if (!FoundType.IsEmpty() && FoundType != DesiredTypeStr)
+	// ---------------------------------------------------------
+	// PHASE 3 : CONVERSION & SORTIE
+	// ---------------------------------------------------------
+	TArray<FOnlineSessionSearchResultData> FinalResults;
+	FinalResults.Reserve(FilteredIndices.Num());
+
+	for (int32 i = 0; i < FilteredIndices.Num(); ++i)
+	{
+		FOnlineSessionSearchResultData& Data = FinalResults.Add_GetRef(MakeResultData(FilteredIndices[i]));
+		if (MatchScores.IsValidIndex(i))
 		{
-			continue;
+			Data.MatchScore = MatchScores[i];
+		}
+	}
+
+	UE_LOG(LogNexusOnline, Log, TEXT("[FindSessions] Completed. %d sessions kept out of %d."), FinalResults.Num(), RawResults.Num());
+	FinishSearch(true, FinalResults);
+}
+
+bool UAsyncTask_FindSessions::PassesResultFilters(const FOnlineSessionSearchResult& Result, const FString& DesiredTypeStr, bool bIsNullSubsystem) const
+{
+	return PassesThreadSafeFilters(Result, DesiredTypeStr, bIsNullSubsystem) && PassesGameThreadRules(Result);
+}
+
+bool UAsyncTask_FindSessions::PassesThreadSafeFilters(const FOnlineSessionSearchResult& Result, const FString& DesiredTypeStr, bool bIsNullSubsystem) const
+{
+	if (!Result.IsValid())
+		return false;
+
+	// Type vide : déjà vérifié par requête lors de la fusion (mode multi)
+	if (!DesiredTypeStr.IsEmpty() && !PassesTypeFilter(Result, DesiredTypeStr, bIsNullSubsystem))
+		return false;
+
+	if (!NexusSessionFilterUtils::PassesAllCompiled(CompiledFilters, Result))
+		return false;
+	
+	for (const TObjectPtr<USessionFilterRule>& Rule : ThreadSafeRules)
+	{
+		if (!Rule->PassesFilter(Result))
+			return false;
+	}
+
+	return true;
+}
+
+bool UAsyncTask_FindSessions::PassesGameThreadRules(const FOnlineSessionSearchResult& Result) const
+{
+	for (const TObjectPtr<USessionFilterRule>& Rule : GameThreadRules)
+	{
+		if (!Rule->PassesFilter(Result))
+			return false;
+	}
+
+	return true;
+}
+
+void UAsyncTask_FindSessions::FilterResultsParallel(const FString& DesiredTypeStr, bool bIsNullSubsystem, TArray<int32>& OutIndices) const
+{
+	NEXUS_TRACE_SCOPE(NexusFindSessions_Filter);
+
+	const TArray<FOnlineSessionSearchResult>& InResults = ResultSet->Results;
+	const UNexusSessionSearchConfig* Config = GetDefault<UNexusSessionSearchConfig>();
+	const int32 Num = InResults.Num();
+
+	// Chunks alignés sur 32 : chaque tâche écrit ses propres mots du bitmap, sans contention
+	const int32 ChunkSize = Align(FMath::Max(Config ? Config->ParallelChunkSize : 256, 32), NumBitsPerDWORD);
+	const int32 NumChunks = FMath::DivideAndRoundUp(Num, ChunkSize);
+
+	TBitArray<> Survivors(false, Num);
+
+	ParallelFor(NumChunks, [&](int32 ChunkIndex)
+	{
+		NEXUS_TRACE_SCOPE(NexusFindSessions_FilterChunk);
+
+		const int32 Start = ChunkIndex * ChunkSize;
+		const int32 End = FMath::Min(Start + ChunkSize, Num);
+
+		for (int32 Index = Start; Index < End; ++Index)
+		{
+			if (PassesThreadSafeFilters(InResults[Index], DesiredTypeStr, bIsNullSubsystem))
+			{
+				Survivors[Index] = true;
+			}
+		}
+	});
+
+	// Compaction stable sur le game thread : l'ordre d'entrée est conservé, les règles Blueprint s'exécutent ici
+	for (TConstSetBitIterator<> It(Survivors); It; ++It)
+	{
+		if (PassesGameThreadRules(InResults[It.GetIndex()]))
+		{
+			OutIndices.Add(It.GetIndex());
+		}
+	}
+
+	UE_LOG(LogNexusOnline, Verbose, TEXT("[FindSessions] Parallel filtering : %d chunks of %d, %d / %d kept."), NumChunks, ChunkSize, OutIndices.Num(), Num);
+}
+
+void UAsyncTask_FindSessions::SortSearchResults(TArray<int32>& InOutIndices) const
+{
+	NEXUS_TRACE_SCOPE(NexusFindSessions_Sort);
+
+	if (ResolvedSortRules.IsEmpty() || InOutIndices.Num() < 2)
+		return;
+
+	// Tri stable : à clés égales, l'ordre du backend est conservé (et le mode streamé reste déterministe)
+	const TArray<FOnlineSessionSearchResult>& RawResults = ResultSet->Results;
+
+	TArray<int32> Order;
+	NexusSessionSortUtils::ComputeSortOrder(ResolvedSortRules, InOutIndices.Num(),
+		[&](int32 Position) -> const FOnlineSessionSearchResult& { return RawResults[InOutIndices[Position]]; }, Order);
+
+	TArray<int32> Sorted;
+	Sorted.Reserve(Order.Num());
+	for (const int32 Position : Order)
+	{
+		Sorted.Add(InOutIndices[Position]);
+	}
+
+	InOutIndices = MoveTemp(Sorted);
+}
+
+bool UAsyncTask_FindSessions::SelectBestScored(TArray<int32>& InOutIndices, TArray<float>& OutScores) const
+{
+	NEXUS_TRACE_SCOPE(NexusFindSessions_Score);
+
+	// Uniquement si la règle de score est la première règle active : les suivantes ne départageraient rien
+	const USessionSortRule_MatchScore* ScoreRule = nullptr;
+	for (const TObjectPtr<USessionSortRule>& Rule : ResolvedSortRules)
+	{
+		if (Rule && Rule->bEnabled)
+		{
+			ScoreRule = Cast<USessionSortRule_MatchScore>(Rule);
+			break;
+		}
+	}
+
+	if (!ScoreRule || ScoreRule->TopK <= 0)
+		return false;
+
+	const TArray<FOnlineSessionSearchResult>& RawResults = ResultSet->Results;
+
+	TArray<NexusMatchScoring::FScoredIndex> Best;
+	NexusMatchScoring::SelectTopK(ScoreRule->Scoring, InOutIndices.Num(),
+		[&](int32 Position) -> const FOnlineSessionSearchResult& { return RawResults[InOutIndices[Position]]; }, ScoreRule->TopK, Best);
+
+	TArray<int32> Selected;
+	Selected.Reserve(Best.Num());
+	OutScores.Reset(Best.Num());
+
+	for (const NexusMatchScoring::FScoredIndex& Entry : Best)
+	{
+		Selected.Add(InOutIndices[Entry.Index]);
+		OutScores.Add(Entry.Score);
+	}
+
+	UE_LOG(LogNexusOnline, Log, TEXT("[FindSessions] Match score : kept %d best of %d (top score %.3f)."),
+		Selected.Num(), InOutIndices.Num(), OutScores.Num() > 0 ? OutScores[0] : 0.f);
+
+	InOutIndices = MoveTemp(Selected);
+	return true;
+}
+
+FOnlineSessionSearchResultData UAsyncTask_FindSessions::MakeResultData(int32 ResultIndex) const
+{
+	return MakeResultData(ResultSet, ResultIndex);
+}
+
+FOnlineSessionSearchResultData UAsyncTask_FindSessions::MakeResultData(const FNexusSessionResultSetPtr& Results, int32 ResultIndex)
+{
+	const FOnlineSessionSearchResult& Result = Results->Results[ResultIndex];
+	FOnlineSessionSearchResultData Data;
+	
+	Result.Session.SessionSettings.Get(TEXT("SESSION_DISPLAY_NAME"), Data.SessionDisplayName);
+	Result.Session.SessionSettings.Get(TEXT("MAP_NAME_KEY"), Data.MapName);
+	Result.Session.SessionSettings.Get(TEXT("GAME_MODE_KEY"), Data.GameMode);
+	Result.Session.SessionSettings.Get(TEXT("SESSION_TYPE_KEY"), Data.SessionType);
+
+	Data.CurrentPlayers = Result.Session.SessionSettings.NumPublicConnections - Result.Session.NumOpenPublicConnections;
+	Data.MaxPlayers = Result.Session.SessionSettings.NumPublicConnections;
+	Data.Ping = FNexusPingCache::Get().GetEffectivePing(Result);
+	
+	Data.ResultSet = Results;
+	Data.ResultIndex = ResultIndex;
+	return Data;
+}
+
+bool UAsyncTask_FindSessions::PassesTypeFilter(const FOnlineSessionSearchResult& Result, const FString& DesiredTypeStr, bool bIsNullSubsystem)
+{
+	FString FoundType;
+	Result.Session.SessionSettings.Get(TEXT("SESSION_TYPE_KEY"), FoundType);
+
+	if (!FoundType.IsEmpty() && FoundType != DesiredTypeStr)
+		return false;
+	
+	if (FoundType.IsEmpty() && !bIsNullSubsystem)
+		return false;
+
+	return true;
+}
+
+FString UAsyncTask_FindSessions::GetDesiredTypeFilter() const
+{
+	return bMultiQuery ? FString() : NexusOnline::SessionTypeToName(DesiredType).ToString();
+}
+
+bool UAsyncTask_FindSessions::IsNullSubsystem() const
+{
+	if (UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+	{
+		if (IOnlineSubsystem* Subsystem = Online::GetSubsystem(World))
+		{
+			return Subsystem->GetSubsystemName() == TEXT("NULL");
+		}
+	}
+	return false;
+}
+
+// ──────────────────────────────────────────────
+// Streaming : traitement par chunks sur plusieurs frames
+// ──────────────────────────────────────────────
+void UAsyncTask_FindSessions::StartStreaming()
+{
+	StreamDesiredTypeStr = GetDesiredTypeFilter();
+	bStreamIsNullSubsystem = IsNullSubsystem();
+
+	// Le tri passe avant le filtrage : le filtre conserve l'ordre, chaque chunk sort donc déjà dans l'ordre final
+	const int32 NumRaw = ResultSet->Results.Num();
+	StreamOrder.SetNumUninitialized(NumRaw);
+	for (int32 Index = 0; Index < NumRaw; ++Index)
+	{
+		StreamOrder[Index] = Index;
+	}
+	SortSearchResults(StreamOrder);
+
+	StreamCursor = 0;
+	StreamedResults.Reset();
+	StreamedResults.Reserve(NumRaw);
+
+	// Premier chunk immédiatement, le reste au fil des frames
+	ProcessStreamChunk();
+	if (!bProcessingComplete)
+	{
+		StreamTickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UAsyncTask_FindSessions::TickStreaming));
+	}
+}
+
+bool UAsyncTask_FindSessions::TickStreaming(float DeltaTime)
+{
+	const UNexusSessionSearchConfig* Config = GetDefault<UNexusSessionSearchConfig>();
+	const double Budget = (Config ? Config->StreamTimeBudgetMs : 2.0f) / 1000.0;
+	const double StartTime = FPlatformTime::Seconds();
+
+	do
+	{
+		ProcessStreamChunk();
+	}
+	while (!bProcessingComplete && (FPlatformTime::Seconds() - StartTime) < Budget);
+
+	if (bProcessingComplete)
+	{
+		StreamTickHandle.Reset();
+		return false;
+	}
+	
+	return true;
+}
+
+void UAsyncTask_FindSessions::ProcessStreamChunk()
+{
+	NEXUS_TRACE_SCOPE(NexusFindSessions_StreamChunk);
+
+	const UNexusSessionSearchConfig* Config = GetDefault<UNexusSessionSearchConfig>();
+	const int32 ChunkSize = Config ? Config->StreamChunkSize : 16;
+	const int32 ChunkEnd = FMath::Min(StreamCursor + ChunkSize, StreamOrder.Num());
+
+	TArray<FOnlineSessionSearchResultData> NewResults;
+	for (; StreamCursor < ChunkEnd; ++StreamCursor)
+	{
+		const int32 Index = StreamOrder[StreamCursor];
+		if (PassesResultFilters(ResultSet->Results[Index], StreamDesiredTypeStr, bStreamIsNullSubsystem))
+		{
+			NewResults.Add(MakeResultData(Index));
+		}
+	}
+
+	StreamedResults.Append(NewResults);
+
+	if (NewResults.Num() > 0)
+	{
+		OnPartialResults.Broadcast(NewResults, StreamCursor, StreamOrder.Num());
+	}
+
+	// Le dernier chunk laisse FinishSearch envoyer la première page (NextCursor exact)
+	if (!bFirstPageSent && StreamedResults.Num() >= StreamPageSize && StreamCursor < StreamOrder.Num())
+	{
+		TArray<FOnlineSessionSearchResultData> Page;
+		int32 NextCursor = INDEX_NONE;
+		GetPage(0, StreamPageSize, Page, NextCursor);
+		
+		bFirstPageSent = true;
+		OnFirstPage.Broadcast(Page, NextCursor);
+	}
+
+	if (StreamCursor >= StreamOrder.Num())
+	{
+		StreamOrder.Empty();
+		
+		UE_LOG(LogNexusOnline, Log, TEXT("[FindSessions] Streaming completed. %d sessions kept."), StreamedResults.Num());
+		FinishSearch(true, StreamedResults);
+	}
+}
+
+bool UAsyncTask_FindSessions::GetPage(int32 Cursor, int32 Count, TArray<FOnlineSessionSearchResultData>& OutResults, int32& NextCursor) const
+{
+	OutResults.Reset();
+	NextCursor = Cursor;
+
+	if (Cursor < 0 || Count <= 0)
+		return false;
+
+	if (Cursor >= StreamedResults.Num())
+	{
+		if (bProcessingComplete)
+		{
+			NextCursor = INDEX_NONE;
+		}
+		return false;
+	}
+
+	const int32 End = FMath::Min(Cursor + Count, StreamedResults.Num());
+	OutResults.Append(StreamedResults.GetData() + Cursor, End - Cursor);
+
+	NextCursor = (End >= StreamedResults.Num() && bProcessingComplete) ? INDEX_NONE : End;
+	return true;
+}
+
+void UAsyncTask_FindSessions::FinishSearch(bool bWasSuccessful, const TArray<FOnlineSessionSearchResultData>& Results)
+{
+	NEXUS_TRACE_SCOPE(NexusFindSessions_Finish);
+
+	// Toute recherche réussie alimente l'index par id : invitations et suivis de groupe y répondent sans requête
+	if (bWasSuccessful && !Results.IsEmpty())
+	{
+		if (UNexusSessionCacheSubsystem* Cache = UNexusSessionCacheSubsystem::Get(WorldContextObject))
+		{
+			Cache->IndexResults(Results);
+		}
+	}
+
+	if (bMultiQuery)
+	{
+		OnCompleted.Broadcast(bWasSuccessful, Results);
+		SetReadyToDestroy();
+		return;
+	}
+
+	if (bStreaming)
+	{
+		bProcessingComplete = true;
+		
+		if (StreamedResults.Num() != Results.Num())
+		{
+			StreamedResults = Results;
+		}
+		
+		// Recherche vide ou échouée : l'UI attend quand même sa première page
+		if (!bFirstPageSent)
+		{
+			TArray<FOnlineSessionSearchResultData> Page;
+			int32 NextCursor = INDEX_NONE;
+			GetPage(0, StreamPageSize, Page, NextCursor);
+			
+			bFirstPageSent = true;
+			OnFirstPage.Broadcast(Page, NextCursor);
 		}
 		
-		if (FoundType.IsEmpty() && !bIsNullSubsystem)
+		OnCompleted.Broadcast(bWasSuccessful, Results);
+		SetReadyToDestroy();
+		return;
+	}
+
+	if (bOwnsCacheRefresh)
+	{
+		bOwnsCacheRefresh = false;
+		
+		if (UNexusSessionCacheSubsystem* Cache = CacheSubsystem.Get())
+		{
+			// Le cache notifie tous les nœuds en attente sur cette clé, y compris celui-ci
+			Cache->CompleteRefresh(CacheKey, bWasSuccessful, Results);
+			return;
+		}
+	}
+
+	if (bServedFromCache)
+	{
+		OnRefreshed.Broadcast(bWasSuccessful, Results, FNexusSessionResultDiff());
+	}
+	else
+	{
+		OnCompleted.Broadcast(bWasSuccessful, Results);
+	}
+
+	if (QuickMatchCompletion.IsBound())
+	{
+		FOnNexusQuickMatchComplete Completion = MoveTemp(QuickMatchCompletion);
+		QuickMatchCompletion.Unbind();
+		
+		Completion.Execute(bWasSuccessful, Results);
+		SetReadyToDestroy();
+	}
+}
+
+// ──────────────────────────────────────────────
+// Multi-query : scatter-gather sur plusieurs recherches
+// ──────────────────────────────────────────────
+void UAsyncTask_FindSessions::StartSubQueries(IOnlineSession& Session)
+{
+	if (SubQueries.IsEmpty())
+	{
+		UE_LOG(LogNexusOnline, Warning, TEXT("[FindSessions] Multi-query started without any sub-query."));
+		FinishSearch(true, {});
+		return;
+	}
+
+	const bool bForceLAN = IsNullSubsystem();
+
+	SubQueryReports.SetNum(SubQueries.Num());
+	for (int32 i = 0; i < SubQueries.Num(); ++i)
+	{
+		FSubQueryState& SubQuery = SubQueries[i];
+		if (bForceLAN)
+		{
+			SubQuery.Search->bIsLanQuery = true;
+		}
+
+		ApplyQueryFilters(*SubQuery.Search, SubQuery.SessionType);
+
+		SubQueryReports[i].SessionType = SubQuery.SessionType;
+		SubQueryReports[i].bIsLANQuery = SubQuery.Search->bIsLanQuery;
+	}
+
+	// Le delegate de fin de recherche est global à l'interface : un seul handle pour toutes les sous-requêtes
+	FindSessionsHandle = Session.AddOnFindSessionsCompleteDelegate_Handle
+	(
+		FOnFindSessionsCompleteDelegate::CreateUObject(this, &UAsyncTask_FindSessions::OnSubQuerySearchComplete)
+	);
+
+	const UNexusSessionSearchConfig* Config = GetDefault<UNexusSessionSearchConfig>();
+	SubQueryTimeoutHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateUObject(this, &UAsyncTask_FindSessions::TickSubQueryTimeout), Config ? Config->SubQueryTimeout : 20.0f);
+
+	UE_LOG(LogNexusOnline, Log, TEXT("[FindSessions] Multi-query : %d sub-queries."), SubQueries.Num());
+
+	LaunchPendingSubQueries(Session);
+}
+
+void UAsyncTask_FindSessions::LaunchPendingSubQueries(IOnlineSession& Session)
+{
+	for (int32 i = 0; i < SubQueries.Num(); ++i)
+	{
+		FSubQueryState& SubQuery = SubQueries[i];
+		if (SubQuery.bInFlight || SubQuery.bFinished)
+			continue;
+
+		SubQuery.bInFlight = true;
+		SubQuery.StartTime = NexusTrace::BeginOssCall();
+
+		const bool bAccepted = Session.FindSessions(*SearchPlayerId, SubQuery.Search.ToSharedRef());
+
+		// Le backend a pu répondre de façon synchrone pendant l'appel
+		if (SubQuery.bFinished)
+			continue;
+
+		// NULL / Steam ignorent une recherche tant qu'une autre est en cours (état inchangé) : elle repartira à la prochaine réponse
+		const bool bIgnored = SubQuery.Search->SearchState == EOnlineAsyncTaskState::NotStarted;
+		const bool bOthersInFlight = SubQueries.ContainsByPredicate([&SubQuery](const FSubQueryState& Other)
+		{
+			return &Other != &SubQuery && Other.bInFlight;
+		});
+
+		if (bIgnored && bOthersInFlight)
 		{
+			NexusTrace::EndOssCall(SubQuery.StartTime);
+			SubQuery.bInFlight = false;
+			UE_LOG(LogNexusOnline, Verbose, TEXT("[FindSessions] Sub-query %d deferred : another search is pending."), i);
 			continue;
 		}
 
-		if (!NexusSessionFilterUtils::PassesAllFilters(ResolvedSimpleFilters, Result))
+		if (!bAccepted)
 		{
+			FinishSubQuery(i, false);
+		}
+	}
+
+	const bool bAllFinished = !SubQueries.ContainsByPredicate([](const FSubQueryState& SubQuery) { return !SubQuery.bFinished; });
+	if (bAllFinished)
+	{
+		MergeSubQueryResults();
+	}
+}
+
+void UAsyncTask_FindSessions::OnSubQuerySearchComplete(bool bWasSuccessful)
+{
+	NEXUS_TRACE_SCOPE(NexusFindSessions_OnSubQueryComplete);
+
+	int32 NumInFlight = 0;
+	for (const FSubQueryState& SubQuery : SubQueries)
+	{
+		NumInFlight += SubQuery.bInFlight ? 1 : 0;
+	}
+
+	for (int32 i = 0; i < SubQueries.Num(); ++i)
+	{
+		const FSubQueryState& SubQuery = SubQueries[i];
+		if (!SubQuery.bInFlight)
+			continue;
+
+		const EOnlineAsyncTaskState::Type State = SubQuery.Search->SearchState;
+		if (State == EOnlineAsyncTaskState::InProgress)
+			continue;
+
+		// Backend qui ne suit pas SearchState : la réponse n'est attribuable que s'il n'y a qu'une recherche en vol
+		if (State == EOnlineAsyncTaskState::NotStarted)
+		{
+			if (NumInFlight == 1)
+			{
+				FinishSubQuery(i, bWasSuccessful);
+			}
 			continue;
 		}
-		
-		bool bRejected = false;
-		for (const TObjectPtr<USessionFilterRule>& Rule : ResolvedAdvancedRules)
+
+		FinishSubQuery(i, State == EOnlineAsyncTaskState::Done);
+	}
+
+	IOnlineSessionPtr Session;
+	if (UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+	{
+		Session = NexusOnline::GetSessionInterface(World);
+	}
+	
+	if (!Session.IsValid())
+	{
+		for (int32 i = 0; i < SubQueries.Num(); ++i)
 		{
-			if (Rule && Rule->bEnabled && !Rule->PassesFilter(Result))
+			if (!SubQueries[i].bFinished)
 			{
-				bRejected = true;
-				break;
+				FinishSubQuery(i, false);
 			}
 		}
-		if (bRejected)
-			continue;
+		
+		MergeSubQueryResults();
+		return;
+	}
+
+	LaunchPendingSubQueries(*Session);
+}
+
+void UAsyncTask_FindSessions::FinishSubQuery(int32 SubQueryIndex, bool bWasSuccessful)
+{
+	FSubQueryState& SubQuery = SubQueries[SubQueryIndex];
+	if (SubQuery.bFinished)
+		return;
+
+	SubQuery.bFinished = true;
+	SubQuery.bInFlight = false;
+
+	FNexusSessionSubQueryReport& Report = SubQueryReports[SubQueryIndex];
+	Report.bWasSuccessful = bWasSuccessful;
+	Report.RawResultCount = bWasSuccessful ? SubQuery.Search->SearchResults.Num() : 0;
+	Report.LatencyMs = NexusTrace::EndOssCall(SubQuery.StartTime);
+
+	UE_LOG(LogNexusOnline, Log, TEXT("[FindSessions] Sub-query %d (%s, LAN: %s) %s : %d raw results in %.1f ms."),
+		SubQueryIndex,
+		*NexusOnline::SessionTypeToName(Report.SessionType).ToString(),
+		Report.bIsLANQuery ? TEXT("YES") : TEXT("NO"),
+		bWasSuccessful ? TEXT("succeeded") : TEXT("failed"),
+		Report.RawResultCount, Report.LatencyMs);
 
-		FilteredResults.Add(Result);
+	OnSubQueryCompleted.Broadcast(SubQueryIndex, Report);
+}
+
+bool UAsyncTask_FindSessions::TickSubQueryTimeout(float DeltaTime)
+{
+	SubQueryTimeoutHandle.Reset();
+
+	UE_LOG(LogNexusOnline, Warning, TEXT("[FindSessions] Multi-query timed out. Merging the sub-queries that answered."));
+
+	for (int32 i = 0; i < SubQueries.Num(); ++i)
+	{
+		if (!SubQueries[i].bFinished)
+		{
+			FinishSubQuery(i, false);
+		}
 	}
 
-	// ---------------------------------------------------------
-	// PHASE 2 : TRI
-	// ---------------------------------------------------------
-	if (!ResolvedSortRules.IsEmpty() && FilteredResults.Num() > 1)
+	MergeSubQueryResults();
+	return false;
+}
+
+void UAsyncTask_FindSessions::MergeSubQueryResults()
+{
+	NEXUS_TRACE_SCOPE(NexusFindSessions_MergeSubQueries);
+
+	// Le handle reste valide de StartSubQueries jusqu'ici : protège des appels réentrants (réponse synchrone, timeout)
+	if (!FindSessionsHandle.IsValid())
+		return;
+
+	if (SubQueryTimeoutHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(SubQueryTimeoutHandle);
+		SubQueryTimeoutHandle.Reset();
+	}
+
+	if (UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
 	{
-		Algo::Sort(FilteredResults, [this](const FOnlineSessionSearchResult& A, const FOnlineSessionSearchResult& B)
+		if (IOnlineSessionPtr Session = NexusOnline::GetSessionInterface(World))
 		{
-			for (const TObjectPtr<USessionSortRule>& Rule : ResolvedSortRules)
+			Session->ClearOnFindSessionsCompleteDelegate_Handle(FindSessionsHandle);
+		}
+	}
+	FindSessionsHandle.Reset();
+
+	const bool bIsNull = IsNullSubsystem();
+	bool bAnySuccess = false;
+	int32 NumRaw = 0;
+	int32 NumDuplicates = 0;
+
+	ResultSet = MakeShared<FNexusSessionResultSet, ESPMode::ThreadSafe>();
+	TArray<FOnlineSessionSearchResult>& Merged = ResultSet->Results;
+	TMap<FString, int32> IndexById;
+
+	for (int32 i = 0; i < SubQueries.Num(); ++i)
+	{
+		if (!SubQueryReports[i].bWasSuccessful)
+			continue;
+
+		bAnySuccess = true;
+
+		// Le type est vérifié ici, par requête : le filtrage commun tourne ensuite sans type (GetDesiredTypeFilter)
+		const FString TypeStr = NexusOnline::SessionTypeToName(SubQueries[i].SessionType).ToString();
+		TArray<FOnlineSessionSearchResult>& SearchResults = SubQueries[i].Search->SearchResults;
+		NumRaw += SearchResults.Num();
+
+		for (FOnlineSessionSearchResult& Result : SearchResults)
+		{
+			if (!Result.IsValid() || !PassesTypeFilter(Result, TypeStr, bIsNull))
+				continue;
+
+			// Même session vue par plusieurs requêtes (LAN + online...) : on garde le meilleur ping
+			const FString Id = NexusOnline::GetSessionIdentity(Result);
+			if (!Id.IsEmpty())
 			{
-				if (!Rule || !Rule->bEnabled)
+				if (const int32* Existing = IndexById.Find(Id))
+				{
+					++NumDuplicates;
+					if (Result.PingInMs < Merged[*Existing].PingInMs)
+					{
+						Merged[*Existing] = MoveTemp(Result);
+					}
 					continue;
+				}
 
-				if (Rule->Compare(A, B))
-					
-					return true;
-				if (Rule->Compare(B, A))
-					return false;
+				IndexById.Add(Id, Merged.Num());
 			}
-			return false; 
-		});
+
+			Merged.Add(MoveTemp(Result));
+		}
+
+		SearchResults.Empty();
 	}
 
-	// ---------------------------------------------------------
-	// PHASE 3 : CONVERSION & SORTIE
-	// ---------------------------------------------------------
-	TArray<FOnlineSessionSearchResultData> FinalResults;
-	FinalResults.Reserve(FilteredResults.Num());
+	if (!bAnySuccess)
+	{
+		UE_LOG(LogNexusOnline, Warning, TEXT("[FindSessions] Multi-query : every sub-query failed."));
+		FinishSearch(false, {});
+		return;
+	}
+
+	UE_LOG(LogNexusOnline, Log, TEXT("[FindSessions] Multi-query merged : %d raw results, %d duplicates, %d unique."), NumRaw, NumDuplicates, Merged.Num());
 
-	for (const FOnlineSessionSearchResult& Result : FilteredResults)
+	if (Merged.IsEmpty())
 	{
-		FOnlineSessionSearchResultData Data;
-		
-		Result.Session.SessionSettings.Get(TEXT("SESSION_DISPLAY_NAME"), Data.SessionDisplayName);
-		Result.Session.SessionSettings.Get(TEXT("MAP_NAME_KEY"), Data.MapName);
-		Result.Session.SessionSettings.Get(TEXT("GAME_MODE_KEY"), Data.GameMode);
-		Result.Session.SessionSettings.Get(TEXT("SESSION_TYPE_KEY"), Data.SessionType);
-
-		Data.CurrentPlayers = Result.Session.SessionSettings.NumPublicConnections - Result.Session.NumOpenPublicConnections;
-		Data.MaxPlayers = Result.Session.SessionSettings.NumPublicConnections;
-		Data.Ping = Result.PingInMs;
-		
-		Data.RawResult = Result;
+		FinishSearch(true, {});
+		return;
+	}
+
+	ProcessSearchResults();
+}
+
+// ──────────────────────────────────────────────
+// Cache (stale-while-revalidate)
+// ──────────────────────────────────────────────
+bool UAsyncTask_FindSessions::TryServeFromCache(UWorld* World)
+{
+	NEXUS_TRACE_SCOPE(NexusFindSessions_ServeFromCache);
+
+	UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	UNexusSessionCacheSubsystem* Cache = GameInstance ? GameInstance->GetSubsystem<UNexusSessionCacheSubsystem>() : nullptr;
+	if (!Cache)
+		return false;
+
+	CacheSubsystem = Cache;
+	CacheKey = UNexusSessionCacheSubsystem::MakeCacheKey(DesiredType, SearchSettings->bIsLanQuery, SearchSettings->MaxSearchResults,
+		ResolvedSimpleFilters, ResolvedAdvancedRules, ResolvedSortRules);
+
+	const ENexusSessionCacheState State = Cache->GetEntryState(CacheKey);
+	if (State == ENexusSessionCacheState::Fresh || State == ENexusSessionCacheState::Stale)
+	{
+		TArray<FOnlineSessionSearchResultData> CachedResults;
+		float Age = 0.f;
+		Cache->GetCachedResults(CacheKey, CachedResults, Age);
+
+		UE_LOG(LogNexusOnline, Log, TEXT("[FindSessions] Served %d sessions from cache (age %.1fs, %s)."),
+			CachedResults.Num(), Age, State == ENexusSessionCacheState::Fresh ? TEXT("fresh") : TEXT("stale, refreshing"));
 
-		FinalResults.Add(MoveTemp(Data));
+		OnCompleted.Broadcast(true, CachedResults);
+
+		if (State == ENexusSessionCacheState::Fresh)
+			return true;
+
+		bServedFromCache = true;
+	}
+
+	CacheRefreshHandle = Cache->OnRefreshCompleted.AddUObject(this, &UAsyncTask_FindSessions::OnCacheRefreshCompleted);
+
+	if (!Cache->BeginRefresh(CacheKey))
+	{
+		UE_LOG(LogNexusOnline, Log, TEXT("[FindSessions] Search already in flight for this query. Waiting for it..."));
+
+		const UNexusSessionSearchConfig* Config = GetDefault<UNexusSessionSearchConfig>();
+		CacheWaitTimeoutHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateUObject(this, &UAsyncTask_FindSessions::TickCacheWaitTimeout), Config ? Config->RefreshTimeout : 30.0f);
+		return true;
+	}
+
+	bOwnsCacheRefresh = true;
+	return false;
+}
+
+void UAsyncTask_FindSessions::OnCacheRefreshCompleted(const FString& InCacheKey, bool bWasSuccessful, const FNexusSessionResultDiff& Diff)
+{
+	if (InCacheKey != CacheKey)
+		return;
+
+	if (CacheWaitTimeoutHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(CacheWaitTimeoutHandle);
+		CacheWaitTimeoutHandle.Reset();
+	}
+
+	UNexusSessionCacheSubsystem* Cache = CacheSubsystem.Get();
+	if (Cache)
+	{
+		Cache->OnRefreshCompleted.Remove(CacheRefreshHandle);
+	}
+
+	TArray<FOnlineSessionSearchResultData> Results;
+	if (bWasSuccessful && Cache)
+	{
+		if (const TArray<FOnlineSessionSearchResultData>* Stored = Cache->FindResults(CacheKey))
+		{
+			Results = *Stored;
+		}
+	}
+
+	if (bServedFromCache)
+	{
+		OnRefreshed.Broadcast(bWasSuccessful, Results, Diff);
+	}
+	else
+	{
+		OnCompleted.Broadcast(bWasSuccessful, Results);
+	}
+}
+
+bool UAsyncTask_FindSessions::TickCacheWaitTimeout(float DeltaTime)
+{
+	CacheWaitTimeoutHandle.Reset();
+
+	UNexusSessionCacheSubsystem* Cache = CacheSubsystem.Get();
+	if (Cache)
+	{
+		Cache->OnRefreshCompleted.Remove(CacheRefreshHandle);
 	}
 
-	UE_LOG(LogTemp, Log, TEXT("[FindSessions] Completed. %d sessions kept out of %d."), FinalResults.Num(), InResults.Num());
-	OnCompleted.Broadcast(true, FinalResults);
+	// Dernier contenu connu, même expiré : mieux qu'une liste vide
+	const TArray<FOnlineSessionSearchResultData>* Stored = Cache ? Cache->FindResults(CacheKey) : nullptr;
+	TArray<FOnlineSessionSearchResultData> Results = Stored ? *Stored : TArray<FOnlineSessionSearchResultData>();
+
+	UE_LOG(LogNexusOnline, Warning, TEXT("[FindSessions] Waited refresh timed out. Finishing with %d cached sessions."), Results.Num());
+
+	if (bServedFromCache)
+	{
+		OnRefreshed.Broadcast(false, Results, FNexusSessionResultDiff());
+	}
+	else
+	{
+		OnCompleted.Broadcast(Stored != nullptr, Results);
+	}
+	return false;
 }
 
 // ──────────────────────────────────────────────
@@ -299,12 +1184,39 @@ void UAsyncTask_FindSessions::RebuildResolvedFilters()
 	});
 }
 
-void UAsyncTask_FindSessions::ApplyQueryFilters()
+void UAsyncTask_FindSessions::CompileResolvedFilters()
 {
-	if (!SearchSettings.IsValid())
-		return;
-	
-	if (SearchSettings->bIsLanQuery)
+	CompiledFilters.Reset();
+	ThreadSafeRules.Reset();
+	GameThreadRules.Reset();
+
+	NexusSessionFilterUtils::CompileFilters(ResolvedSimpleFilters, CompiledFilters);
+
+	// Règles triées par priorité : les règles compilées passent devant (évaluation moins coûteuse, même résultat)
+	for (const TObjectPtr<USessionFilterRule>& Rule : ResolvedAdvancedRules)
+	{
+		if (!Rule || !Rule->bEnabled)
+			continue;
+
+		FNexusCompiledSessionFilter Compiled;
+		if (Rule->CompileFilter(Compiled))
+		{
+			CompiledFilters.Add(MoveTemp(Compiled));
+		}
+		else if (Rule->CanEvaluateOffGameThread())
+		{
+			ThreadSafeRules.Add(Rule);
+		}
+		else
+		{
+			GameThreadRules.Add(Rule);
+		}
+	}
+}
+
+void UAsyncTask_FindSessions::ApplyQueryFilters(FOnlineSessionSearch& Search, ENexusSessionType SessionType) const
+{
+	if (Search.bIsLanQuery)
 		return;
 	
 	auto SetDefaultIfMissing = [&](FName Key, const auto& Value, EOnlineComparisonOp::Type Op)
@@ -321,7 +1233,7 @@ void UAsyncTask_FindSessions::ApplyQueryFilters()
 
 		if(!bFound)
 		{
-			SearchSettings->QuerySettings.Set(Key, Value, Op);
+			Search.QuerySettings.Set(Key, Value, Op);
 		}
 	};
 
@@ -329,14 +1241,14 @@ void UAsyncTask_FindSessions::ApplyQueryFilters()
 	SetDefaultIfMissing(TEXT("SEARCH_LOBBIES"), true, EOnlineComparisonOp::Equals);
 	SetDefaultIfMissing(TEXT("LOBBYDISTANCE"), 3, EOnlineComparisonOp::Equals);
 
-	SearchSettings->QuerySettings.Set(TEXT("SESSION_TYPE_KEY"), NexusOnline::SessionTypeToName(DesiredType).ToString(), EOnlineComparisonOp::Equals);
-	NexusSessionFilterUtils::ApplyFiltersToSettings(ResolvedSimpleFilters, *SearchSettings);
+	Search.QuerySettings.Set(TEXT("SESSION_TYPE_KEY"), NexusOnline::SessionTypeToName(SessionType).ToString(), EOnlineComparisonOp::Equals);
+	NexusSessionFilterUtils::ApplyFiltersToSettings(ResolvedSimpleFilters, Search);
 
 	for (const TObjectPtr<USessionFilterRule>& Rule : ResolvedAdvancedRules)
 	{
 		if (Rule && Rule->bEnabled && Rule->bApplyToSearchQuery)
 		{
-			Rule->ConfigureSearchSettings(*SearchSettings);
+			Rule->ConfigureSearchSettings(Search);
 		}
 	}
 }
@@ -0,0 +1,352 @@
+﻿#include "Async/AsyncTask_JoinBestSession.h"
+#include "Async/AsyncTask_FindSessionById.h"
+#include "Interfaces/OnlineSessionInterface.h"
+#include "OnlineSessionSettings.h"
+#include "GameFramework/PlayerController.h"
+#include "Subsystems/NexusMapPreloadSubsystem.h"
+#include "Subsystems/NexusMigrationSubsystem.h"
+#include "Utils/NexusOnlineHelpers.h"
+#include "Utils/NexusTrace.h"
+#include "Engine/World.h"
+#include "Engine/Engine.h"
+
+#define LOCTEXT_NAMESPACE "NexusOnline|JoinBestSession"
+
+// ──────────────────────────────────────────────
+// Factory
+// ──────────────────────────────────────────────
+UAsyncTask_JoinBestSession* UAsyncTask_JoinBestSession::JoinBestSession(UObject* WorldContextObject, const TArray<FOnlineSessionSearchResultData>& Candidates,
+	int32 MaxAttempts, float AttemptTimeout, bool bRefreshCapacity, bool bAutoTravel, ENexusSessionType SessionType, bool bPreloadMap)
+{
+	UAsyncTask_JoinBestSession* Node = NewObject<UAsyncTask_JoinBestSession>();
+	Node->WorldContextObject = WorldContextObject;
+	Node->MaxAttempts = FMath::Max(1, MaxAttempts);
+	Node->AttemptTimeout = FMath::Max(0.f, AttemptTimeout);
+	Node->bRefreshCapacity = bRefreshCapacity;
+	Node->bShouldAutoTravel = bAutoTravel;
+	Node->DesiredType = SessionType;
+	Node->bPreloadMap = bPreloadMap;
+
+	// Seuls les résultats joignables comptent ; le rang d'origine est gardé pour le rapport
+	for (int32 Index = 0; Index < Candidates.Num(); ++Index)
+	{
+		if (Candidates[Index].HasRawResult())
+		{
+			Node->Candidates.Add(Candidates[Index]);
+			Node->CandidateRanks.Add(Index);
+		}
+	}
+
+	// Relecture puis tentatives successives, sur plusieurs frames : le nœud doit survivre au GC jusqu'à SetReadyToDestroy
+	Node->RegisterWithGameInstance(WorldContextObject);
+	return Node;
+}
+
+// ──────────────────────────────────────────────
+// Activate : Entry Point
+// ──────────────────────────────────────────────
+void UAsyncTask_JoinBestSession::Activate()
+{
+	NEXUS_TRACE_SCOPE(NexusJoinBestSession_Activate);
+
+	StartTime = FPlatformTime::Seconds();
+
+	UWorld* World = WorldContextObject ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	if (!World)
+	{
+		UE_LOG(LogNexusOnline, Error, TEXT("[JoinBestSession] Invalid WorldContextObject."));
+		Fail();
+		return;
+	}
+
+	if (Candidates.IsEmpty())
+	{
+		UE_LOG(LogNexusOnline, Warning, TEXT("[JoinBestSession] No joinable candidate."));
+		Fail();
+		return;
+	}
+
+	// La map du meilleur candidat se charge pendant le join (la mesure du temps jusqu'en jeu démarre ici)
+	if (UNexusMapPreloadSubsystem* Preload = UNexusMapPreloadSubsystem::Get(World))
+	{
+		Preload->BeginFlow(Candidates[0].MapName, bPreloadMap && bShouldAutoTravel);
+		bTravelFlowStarted = true;
+	}
+
+	if (bRefreshCapacity)
+	{
+		StartRefresh();
+		return;
+	}
+
+	DropFullCandidates();
+	TryNextCandidate();
+}
+
+// ──────────────────────────────────────────────
+// Step 1: Capacity refresh
+// ──────────────────────────────────────────────
+void UAsyncTask_JoinBestSession::StartRefresh()
+{
+	// Seuls les MaxAttempts premiers sont relus ; les suivants remplacent, avec les données de la recherche, ceux trouvés pleins
+	TArray<FString> SessionIds;
+	for (int32 Index = 0; Index < FMath::Min(Candidates.Num(), MaxAttempts); ++Index)
+	{
+		SessionIds.Add(NexusOnline::GetSessionIdentity(Candidates[Index].GetRawResult()));
+	}
+
+	bRefreshing = true;
+	RefreshStartTime = FPlatformTime::Seconds();
+
+	RefreshTask = UAsyncTask_FindSessionById::FindSessionsByIds(WorldContextObject, SessionIds, true);
+	RefreshTask->OnBulkCompleted.AddDynamic(this, &UAsyncTask_JoinBestSession::OnRefreshCompleted);
+
+	// Une requête filtrée par id, l'une après l'autre : chacune a droit au délai d'une tentative.
+	// Au-delà, on continue avec les données de la recherche
+	if (AttemptTimeout > 0.f)
+	{
+		RefreshTimeoutHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateUObject(this, &UAsyncTask_JoinBestSession::OnRefreshTimeout), AttemptTimeout * SessionIds.Num());
+	}
+
+	RefreshTask->Activate();
+}
+
+void UAsyncTask_JoinBestSession::OnRefreshCompleted(bool bAllFound, const TArray<FOnlineSessionSearchResultData>& Found, const TArray<FString>& MissingIds)
+{
+	NEXUS_TRACE_SCOPE(NexusJoinBestSession_OnRefresh);
+
+	if (!bRefreshing)
+		return;
+
+	TMap<FString, const FOnlineSessionSearchResultData*> FreshById;
+	for (const FOnlineSessionSearchResultData& Result : Found)
+	{
+		if (Result.HasRawResult())
+		{
+			FreshById.Add(NexusOnline::GetSessionIdentity(Result.GetRawResult()), &Result);
+		}
+	}
+
+	// Candidats absents de la réponse : gardés avec les données de la recherche, le join tranchera
+	for (FOnlineSessionSearchResultData& Candidate : Candidates)
+	{
+		if (const FOnlineSessionSearchResultData* const* Fresh = FreshById.Find(NexusOnline::GetSessionIdentity(Candidate.GetRawResult())))
+		{
+			Candidate = **Fresh;
+		}
+	}
+
+	FinishRefresh();
+}
+
+bool UAsyncTask_JoinBestSession::OnRefreshTimeout(float DeltaTime)
+{
+	RefreshTimeoutHandle.Reset();
+
+	if (bRefreshing)
+	{
+		UE_LOG(LogNexusOnline, Warning, TEXT("[JoinBestSession] Capacity refresh timed out, using the search data."));
+		FinishRefresh();
+	}
+
+	return false;
+}
+
+void UAsyncTask_JoinBestSession::FinishRefresh()
+{
+	bRefreshing = false;
+	Report.RefreshMs = static_cast<float>((FPlatformTime::Seconds() - RefreshStartTime) * 1000.0);
+
+	if (RefreshTimeoutHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(RefreshTimeoutHandle);
+		RefreshTimeoutHandle.Reset();
+	}
+
+	if (RefreshTask)
+	{
+		// Délai dépassé : plus aucune requête par id ne part à côté du premier join
+		RefreshTask->OnBulkCompleted.RemoveAll(this);
+		RefreshTask->Cancel();
+		RefreshTask = nullptr;
+	}
+
+	// Sans réponse, les données de la recherche servent à écarter les sessions pleines
+	DropFullCandidates();
+	TryNextCandidate();
+}
+
+void UAsyncTask_JoinBestSession::DropFullCandidates()
+{
+	for (int32 Index = Candidates.Num() - 1; Index >= 0; --Index)
+	{
+		if (LooksFull(Candidates[Index]))
+		{
+			UE_LOG(LogNexusOnline, Log, TEXT("[JoinBestSession] Candidate %d ('%s') is full, skipped."),
+				CandidateRanks[Index], *NexusOnline::GetSessionIdentity(Candidates[Index].GetRawResult()));
+			Candidates.RemoveAt(Index);
+			CandidateRanks.RemoveAt(Index);
+			++Report.SkippedFull;
+		}
+	}
+
+	// Au-delà de MaxAttempts, les candidats ne seront jamais essayés
+	if (Candidates.Num() > MaxAttempts)
+	{
+		Candidates.SetNum(MaxAttempts);
+		CandidateRanks.SetNum(MaxAttempts);
+	}
+}
+
+// ──────────────────────────────────────────────
+// Step 2: Attempts
+// ──────────────────────────────────────────────
+void UAsyncTask_JoinBestSession::TryNextCandidate()
+{
+	UNexusSessionOperationSubsystem* Operations = UNexusSessionOperationSubsystem::Get(WorldContextObject);
+	if (!Operations)
+	{
+		UE_LOG(LogNexusOnline, Error, TEXT("[JoinBestSession] Session operation subsystem unavailable."));
+		Fail();
+		return;
+	}
+
+	if (NextCandidate >= Candidates.Num())
+	{
+		UE_LOG(LogNexusOnline, Warning, TEXT("[JoinBestSession] No candidate left after %d attempt(s)."), Report.Attempts.Num());
+		Fail();
+		return;
+	}
+
+	const FOnlineSessionSearchResultData& Candidate = Candidates[NextCandidate];
+
+	FNexusJoinAttempt& Attempt = Report.Attempts.AddDefaulted_GetRef();
+	Attempt.SessionId = NexusOnline::GetSessionIdentity(Candidate.GetRawResult());
+	Attempt.CandidateIndex = CandidateRanks[NextCandidate];
+
+	FNexusSessionOperationRequest Request;
+	Request.Type = ENexusSessionOperationType::Join;
+	Request.SessionName = NexusOnline::SessionTypeToName(DesiredType);
+	Request.JoinTarget = Candidate;
+	Request.CoalesceKey = Attempt.SessionId;
+	Request.Timeout = AttemptTimeout;
+	Request.bDeadlineFromStart = true;
+
+	// Une tentative abandonnée ne retient pas la suivante plus d'un AttemptTimeout ; un join tardif est annulé par la file
+	Request.AbandonGrace = AttemptTimeout > 0.f ? AttemptTimeout : -1.f;
+
+	UE_LOG(LogNexusOnline, Log, TEXT("[JoinBestSession] Attempt %d : candidate %d ('%s')..."),
+		Report.Attempts.Num(), Attempt.CandidateIndex, *Attempt.SessionId);
+
+	++NextCandidate;
+	Operations->Enqueue(MoveTemp(Request), FOnNexusSessionOperationComplete::CreateUObject(this, &UAsyncTask_JoinBestSession::OnAttemptComplete));
+}
+
+void UAsyncTask_JoinBestSession::OnAttemptComplete(const FNexusSessionOperationResult& Result)
+{
+	NEXUS_TRACE_SCOPE(NexusJoinBestSession_OnAttempt);
+
+	if (bFinished || Report.Attempts.IsEmpty())
+		return;
+
+	FNexusJoinAttempt& Attempt = Report.Attempts.Last();
+	Attempt.Status = Result.Status;
+	Attempt.bSessionFull = Result.JoinResult == EOnJoinSessionCompleteResult::SessionIsFull;
+	Attempt.ElapsedMs = Result.ElapsedMs;
+
+	// Annulation explicite (CancelOperation / CancelAll) : on n'essaie pas les suivants
+	if (Result.Status == ENexusSessionOperationStatus::Cancelled)
+	{
+		Fail();
+		return;
+	}
+
+	if (!Result.WasSuccessful())
+	{
+		UE_LOG(LogNexusOnline, Log, TEXT("[JoinBestSession] Attempt %d %s (%.1f ms), failing over."),
+			Report.Attempts.Num(), *UEnum::GetValueAsString(Result.Status), Result.ElapsedMs);
+		TryNextCandidate();
+		return;
+	}
+
+	IOnlineSessionPtr Session = NexusOnline::GetSessionInterface(WorldContextObject);
+	FString ConnectString;
+	if (!Session.IsValid() || !Session->GetResolvedConnectString(Result.SessionName, ConnectString))
+	{
+		UE_LOG(LogNexusOnline, Error, TEXT("[JoinBestSession] Failed to resolve connect string (URL)."));
+		Fail();
+		return;
+	}
+
+	Succeed(ConnectString);
+}
+
+// ──────────────────────────────────────────────
+// Completion & Travel
+// ──────────────────────────────────────────────
+void UAsyncTask_JoinBestSession::Succeed(const FString& ConnectString)
+{
+	bFinished = true;
+
+	Report.WinningAttempt = Report.Attempts.Num();
+	Report.JoinedSession = Candidates[NextCandidate - 1];
+	Report.TotalMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+	UE_LOG(LogNexusOnline, Log, TEXT("[JoinBestSession] Joined '%s' on attempt %d in %.1f ms (refresh %.1f ms, %d full skipped). Connect String: %s"),
+		*Report.Attempts.Last().SessionId, Report.WinningAttempt, Report.TotalMs, Report.RefreshMs, Report.SkippedFull, *ConnectString);
+
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull);
+	if (UNexusMapPreloadSubsystem* Preload = UNexusMapPreloadSubsystem::Get(World))
+	{
+		Preload->NotifySessionReady();
+	}
+
+	OnSuccess.Broadcast(Report);
+
+	if (bShouldAutoTravel && World)
+	{
+		if (APlayerController* PC = World->GetFirstPlayerController())
+		{
+			// Capacités locales transmises à l'hôte pour le classement des héritiers
+			FString TravelURL = ConnectString;
+			if (const UNexusMigrationSubsystem* Migration = World->GetGameInstance() ? World->GetGameInstance()->GetSubsystem<UNexusMigrationSubsystem>() : nullptr)
+			{
+				TravelURL += Migration->GetHeirLoginOptions();
+			}
+
+			UE_LOG(LogNexusOnline, Log, TEXT("[JoinBestSession] Executing ClientTravel..."));
+			PC->ClientTravel(TravelURL, TRAVEL_Absolute);
+		}
+	}
+
+	SetReadyToDestroy();
+}
+
+void UAsyncTask_JoinBestSession::Fail()
+{
+	bFinished = true;
+	Report.TotalMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+	// Seul le flux lancé par ce nœud est annulé
+	if (bTravelFlowStarted)
+	{
+		bTravelFlowStarted = false;
+		if (UNexusMapPreloadSubsystem* Preload = UNexusMapPreloadSubsystem::Get(WorldContextObject))
+		{
+			Preload->CancelFlow();
+		}
+	}
+
+	OnFailure.Broadcast(Report);
+	SetReadyToDestroy();
+}
+
+bool UAsyncTask_JoinBestSession::LooksFull(const FOnlineSessionSearchResultData& Candidate)
+{
+	const FOnlineSessionSearchResult& RawResult = Candidate.GetRawResult();
+	const int32 MaxPublic = RawResult.Session.SessionSettings.NumPublicConnections;
+	return MaxPublic > 0 && RawResult.Session.NumOpenPublicConnections <= 0;
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -3,19 +3,24 @@
 #include "Interfaces/OnlineSessionInterface.h"
 #include "GameFramework/PlayerController.h"
 #include "Utils/NexusOnlineHelpers.h"
+#include "Utils/NexusTrace.h"
+#include "Subsystems/NexusMapPreloadSubsystem.h"
+#include "Subsystems/NexusMigrationSubsystem.h"
+#include "Subsystems/NexusSessionOperationSubsystem.h"
 
 #define LOCTEXT_NAMESPACE "NexusOnline|JoinSession"
 
 // ──────────────────────────────────────────────
 // Factory
 // ──────────────────────────────────────────────
-UAsyncTask_JoinSession* UAsyncTask_JoinSession::JoinSession( UObject* WorldContextObject, const FOnlineSessionSearchResultData& SessionResult, bool bAutoTravel, ENexusSessionType SessionType)
+UAsyncTask_JoinSession* UAsyncTask_JoinSession::JoinSession( UObject* WorldContextObject, const FOnlineSessionSearchResultData& SessionResult, bool bAutoTravel, ENexusSessionType SessionType, bool bPreloadMap)
 {
 	UAsyncTask_JoinSession* Node = NewObject<UAsyncTask_JoinSession>();
 	Node->WorldContextObject = WorldContextObject;
-	Node->RawResult = SessionResult.RawResult;
+	Node->SessionData = SessionResult;
 	Node->DesiredType = SessionType;
 	Node->bShouldAutoTravel = bAutoTravel;
+	Node->bPreloadMap = bPreloadMap;
 
 	return Node;
 }
@@ -25,169 +30,153 @@ UAsyncTask_JoinSession* UAsyncTask_JoinSession::JoinSession( UObject* WorldConte
 // ──────────────────────────────────────────────
 void UAsyncTask_JoinSession::Activate()
 {
+	NEXUS_TRACE_SCOPE(NexusJoinSession_Activate);
+
 	if (!WorldContextObject)
 	{
-		UE_LOG(LogTemp, Error, TEXT("[JoinSession] Invalid WorldContextObject."));
-		OnFailure.Broadcast();
+		UE_LOG(LogNexusOnline, Error, TEXT("[JoinSession] Invalid WorldContextObject."));
+		Fail();
 		return;
 	}
 
 	UWorld* World = GEngine->GetWorldFromContextObjectChecked(WorldContextObject);
 	if (!World)
 	{
-		OnFailure.Broadcast();
+		Fail();
 		return;
 	}
 
 	IOnlineSessionPtr Session = NexusOnline::GetSessionInterface(World);
 	if (!Session.IsValid())
 	{
-		UE_LOG(LogTemp, Error, TEXT("[JoinSession] Online session interface invalid."));
-		OnFailure.Broadcast();
+		UE_LOG(LogNexusOnline, Error, TEXT("[JoinSession] Online session interface invalid."));
+		Fail();
+		return;
+	}
+
+	if (!SessionData.HasRawResult())
+	{
+		UE_LOG(LogNexusOnline, Error, TEXT("[JoinSession] Session result has no backing search result."));
+		Fail();
 		return;
 	}
 
+	const FOnlineSessionSearchResult& RawResult = SessionData.GetRawResult();
 	const FName InternalSessionName = NexusOnline::SessionTypeToName(DesiredType);
 	const int32 MaxPublic = RawResult.Session.SessionSettings.NumPublicConnections;
 	const int32 OpenPublic = RawResult.Session.NumOpenPublicConnections;
 
 	if (MaxPublic > 0 && OpenPublic <= 0)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("[JoinSession] Session '%s' appears full (%d/%d). Aborting."),
+		UE_LOG(LogNexusOnline, Warning, TEXT("[JoinSession] Session '%s' appears full (%d/%d). Aborting."),
 			*InternalSessionName.ToString(),
 			(MaxPublic - OpenPublic),
 			MaxPublic);
 		
-		OnFailure.Broadcast();
-		return;
-	}
-	
-	if (Session->GetNamedSession(InternalSessionName))
-	{
-		UE_LOG(LogTemp, Warning, TEXT("[JoinSession] Existing session found. Leaving before joining new one..."));
-		
-		DestroyDelegateHandle = Session->AddOnDestroySessionCompleteDelegate_Handle(
-			FOnDestroySessionCompleteDelegate::CreateUObject(this, &UAsyncTask_JoinSession::OnOldSessionDestroyed)
-		);
-		
-		Session->DestroySession(InternalSessionName);
+		Fail();
 		return;
 	}
 
-	JoinSessionInternal();
-}
-
-// ──────────────────────────────────────────────
-// Step 1.5: Old Session Destroyed
-// ──────────────────────────────────────────────
-void UAsyncTask_JoinSession::OnOldSessionDestroyed(FName SessionName, bool bWasSuccessful)
-{
-	UWorld* World = GEngine->GetWorldFromContextObjectChecked(WorldContextObject);
-	IOnlineSessionPtr Session = NexusOnline::GetSessionInterface(World);
-	
-	if (Session.IsValid())
+	// La map annoncée se charge pendant le join (la mesure du temps jusqu'en jeu démarre ici)
+	if (UNexusMapPreloadSubsystem* Preload = UNexusMapPreloadSubsystem::Get(World))
 	{
-		Session->ClearOnDestroySessionCompleteDelegate_Handle(DestroyDelegateHandle);
+		FString MapName;
+		RawResult.Session.SessionSettings.Get(TEXT("MAP_NAME_KEY"), MapName);
+		Preload->BeginFlow(MapName, bPreloadMap && bShouldAutoTravel);
+		bTravelFlowStarted = true;
 	}
 	
-	JoinSessionInternal();
-}
-
-// ──────────────────────────────────────────────
-// Step 2: Internal Join Logic
-// ──────────────────────────────────────────────
-void UAsyncTask_JoinSession::JoinSessionInternal()
-{
-	UWorld* World = GEngine->GetWorldFromContextObjectChecked(WorldContextObject);
-	IOnlineSessionPtr Session = NexusOnline::GetSessionInterface(World);
-	if (!Session.IsValid())
+	UNexusSessionOperationSubsystem* Operations = UNexusSessionOperationSubsystem::Get(World);
+	if (!Operations)
 	{
-		OnFailure.Broadcast();
+		UE_LOG(LogNexusOnline, Error, TEXT("[JoinSession] Session operation subsystem unavailable."));
+		Fail();
 		return;
 	}
 
-	const FName InternalSessionName = NexusOnline::SessionTypeToName(DesiredType);
-
-	JoinDelegateHandle = Session->AddOnJoinSessionCompleteDelegate_Handle
-	(
-		FOnJoinSessionCompleteDelegate::CreateUObject(this, &UAsyncTask_JoinSession::OnJoinSessionComplete)
-	);
+	// La file de la session quitte l'éventuelle session en cours avant de rejoindre
+	FNexusSessionOperationRequest Request;
+	Request.Type = ENexusSessionOperationType::Join;
+	Request.SessionName = InternalSessionName;
+	Request.JoinTarget = SessionData;
+	Request.CoalesceKey = NexusOnline::GetSessionIdentity(RawResult);
 
-	UE_LOG(LogTemp, Log, TEXT("[JoinSession] Joining session '%s'..."), *InternalSessionName.ToString());
+	UE_LOG(LogNexusOnline, Log, TEXT("[JoinSession] Joining session '%s'..."), *InternalSessionName.ToString());
 
-	TSharedPtr<const FUniqueNetId> LocalPlayerId;
-	if (APlayerController* PC = World->GetFirstPlayerController())
-	{
-		if (ULocalPlayer* LP = PC->GetLocalPlayer())
-		{
-			LocalPlayerId = LP->GetPreferredUniqueNetId().GetUniqueNetId();
-		}
-	}
-
-	if (!LocalPlayerId.IsValid())
-	{
-		if (!Session->JoinSession(0, InternalSessionName, RawResult))
-		{
-			Session->ClearOnJoinSessionCompleteDelegate_Handle(JoinDelegateHandle);
-			OnFailure.Broadcast();
-		}
-	}
-	else
-	{
-		if (!Session->JoinSession(*LocalPlayerId, InternalSessionName, RawResult))
-		{
-			Session->ClearOnJoinSessionCompleteDelegate_Handle(JoinDelegateHandle);
-			OnFailure.Broadcast();
-		}
-	}
+	Operations->Enqueue(MoveTemp(Request), FOnNexusSessionOperationComplete::CreateUObject(this, &UAsyncTask_JoinSession::OnOperationComplete));
 }
 
 // ──────────────────────────────────────────────
-// Step 3: Completion & Travel
+// Completion & Travel
 // ──────────────────────────────────────────────
-void UAsyncTask_JoinSession::OnJoinSessionComplete(FName SessionName, EOnJoinSessionCompleteResult::Type Result)
+void UAsyncTask_JoinSession::OnOperationComplete(const FNexusSessionOperationResult& Result)
 {
-	UWorld* World = GEngine->GetWorldFromContextObjectChecked(WorldContextObject);
-	if (!World)
-		return; 
+	NEXUS_TRACE_SCOPE(NexusJoinSession_OnComplete);
 
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull);
 	IOnlineSessionPtr Session = NexusOnline::GetSessionInterface(World);
-	if (Session.IsValid())
+	if (!World || !Session.IsValid())
 	{
-		Session->ClearOnJoinSessionCompleteDelegate_Handle(JoinDelegateHandle);
-	}
-	else
-	{
-		OnFailure.Broadcast();
+		Fail();
 		return;
 	}
 
-	if (Result != EOnJoinSessionCompleteResult::Success)
+	if (!Result.WasSuccessful())
 	{
-		UE_LOG(LogTemp, Error, TEXT("[JoinSession] Failed with code %d."), static_cast<int32>(Result));
-		OnFailure.Broadcast();
+		UE_LOG(LogNexusOnline, Error, TEXT("[JoinSession] Failed (%s, code %d)."), *UEnum::GetValueAsString(Result.Status), static_cast<int32>(Result.JoinResult));
+		Fail();
 		return;
 	}
 
 	FString ConnectString;
-	if (!Session->GetResolvedConnectString(SessionName, ConnectString))
+	if (!Session->GetResolvedConnectString(Result.SessionName, ConnectString))
 	{
-		UE_LOG(LogTemp, Error, TEXT("[JoinSession] Failed to resolve connect string (URL)."));
-		OnFailure.Broadcast();
+		UE_LOG(LogNexusOnline, Error, TEXT("[JoinSession] Failed to resolve connect string (URL)."));
+		Fail();
 		return;
 	}
 	
-	UE_LOG(LogTemp, Log, TEXT("[JoinSession] Success. Connect String: %s"), *ConnectString);
+	UE_LOG(LogNexusOnline, Log, TEXT("[JoinSession] Success. Connect String: %s"), *ConnectString);
+
+	if (UNexusMapPreloadSubsystem* Preload = UNexusMapPreloadSubsystem::Get(World))
+	{
+		Preload->NotifySessionReady();
+	}
 
 	OnSuccess.Broadcast();
 	if (bShouldAutoTravel)
 	{
 		if (APlayerController* PC = World->GetFirstPlayerController())
 		{
-			UE_LOG(LogTemp, Log, TEXT("[JoinSession] Executing ClientTravel..."));
-			PC->ClientTravel(ConnectString, TRAVEL_Absolute);
+			// Capacités locales transmises à l'hôte pour le classement des héritiers
+			FString TravelURL = ConnectString;
+			if (const UNexusMigrationSubsystem* Migration = World->GetGameInstance() ? World->GetGameInstance()->GetSubsystem<UNexusMigrationSubsystem>() : nullptr)
+			{
+				TravelURL += Migration->GetHeirLoginOptions();
+			}
+
+			UE_LOG(LogNexusOnline, Log, TEXT("[JoinSession] Executing ClientTravel..."));
+			PC->ClientTravel(TravelURL, TRAVEL_Absolute);
+		}
+	}
+}
+
+// ──────────────────────────────────────────────
+// Failure
+// ──────────────────────────────────────────────
+void UAsyncTask_JoinSession::Fail()
+{
+	// Seul le flux lancé par ce nœud est annulé
+	if (bTravelFlowStarted)
+	{
+		bTravelFlowStarted = false;
+		if (UNexusMapPreloadSubsystem* Preload = UNexusMapPreloadSubsystem::Get(WorldContextObject))
+		{
+			Preload->CancelFlow();
 		}
 	}
+
+	OnFailure.Broadcast();
 }
 
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
@@ -0,0 +1,38 @@
+#include "Components/NexusSnapshotComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "Subsystems/NexusSnapshotSubsystem.h"
+
+
+UNexusSnapshotComponent::UNexusSnapshotComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+	SetIsReplicatedByDefault(true);
+}
+
+void UNexusSnapshotComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Côté héritier : signale que le canal existe, l'hôte commence par une image complète
+	const APlayerController* PC = Cast<APlayerController>(GetOwner());
+	if (PC && PC->IsLocalController() && !PC->HasAuthority())
+	{
+		Server_AckSnapshot(INDEX_NONE);
+	}
+}
+
+void UNexusSnapshotComponent::Client_ReceiveSnapshotChunk_Implementation(int32 Sequence, int32 BaselineSequence, int32 TotalSize, int32 Offset, const TArray<uint8>& Chunk)
+{
+	if (UNexusSnapshotSubsystem* Snapshots = UNexusSnapshotSubsystem::Get(this))
+	{
+		Snapshots->ReceiveChunk(this, Sequence, BaselineSequence, TotalSize, Offset, Chunk);
+	}
+}
+
+void UNexusSnapshotComponent::Server_AckSnapshot_Implementation(int32 Sequence)
+{
+	if (UNexusSnapshotSubsystem* Snapshots = UNexusSnapshotSubsystem::Get(this))
+	{
+		Snapshots->HandleAck(this, Sequence);
+	}
+}
@@ -10,4 +10,27 @@ UNexusMigrationConfig::UNexusMigrationConfig()
 	ClientSearchInterval = 5.0f;
     ClientRetryDelay = 3.0f;
     JoinFailureDelay = 2.0f;
+
+	HeirListSize = 3;
+	HeirRankInterval = 5.0f;
+	RttWeight = 0.4f;
+	PacketLossWeight = 0.3f;
+	UploadWeight = 0.2f;
+	HardwareWeight = 0.1f;
+	MaxHeirRttMs = 300.0f;
+	MaxHeirPacketLoss = 0.1f;
+	TargetUploadKbps = 10000;
+	HeirSwitchMargin = 0.05f;
+
+	bEnableHotStandby = true;
+	StandbyListenPort = 7778;
+	DirectReconnectDelay = 1.0f;
+	DirectReconnectInterval = 2.0f;
+	MaxDirectReconnectAttempts = 5;
+
+	bEnableSnapshots = true;
+	SnapshotInterval = 2.0f;
+	SnapshotBandwidthKBps = 32;
+	SnapshotChunkSize = 1024;
+	SnapshotKeyframeInterval = 30;
 }
@@ -0,0 +1,39 @@
+#include "Configs/NexusSessionSearchConfig.h"
+
+UNexusSessionSearchConfig::UNexusSessionSearchConfig()
+{
+	CategoryName = TEXT("Game");
+	SectionName = TEXT("Nexus Session Search");
+
+	bEnableCache = true;
+	CacheFreshTime = 10.0f;
+	CacheMaxStaleTime = 120.0f;
+	MaxCacheEntries = 16;
+	RefreshTimeout = 30.0f;
+
+	StreamChunkSize = 16;
+	StreamTimeBudgetMs = 2.0f;
+	DefaultPageSize = 10;
+
+	bParallelFiltering = false;
+	ParallelFilterThreshold = 1024;
+	ParallelChunkSize = 256;
+
+	SubQueryTimeout = 20.0f;
+
+	bAutoProbeResults = false;
+	bEnableEchoResponder = false;
+	ProbePort = 7787;
+	ProbesPerHost = 3;
+	ProbeSpacingMs = 20.0f;
+	ProbeTimeout = 1.0f;
+	MaxProbeHosts = 64;
+	RttSmoothing = 0.125f;
+	JitterSmoothing = 0.25f;
+	PingEstimateLifetime = 120.0f;
+
+	bEnableIdIndex = true;
+	IdIndexMaxAge = 30.0f;
+	MaxIndexedSessions = 1024;
+	BulkLookupMaxQueries = 32;
+}
@@ -0,0 +1,15 @@
+#include "Configs/NexusSessionUpdateConfig.h"
+
+UNexusSessionUpdateConfig::UNexusSessionUpdateConfig()
+{
+	CategoryName = TEXT("Game");
+	SectionName = TEXT("Nexus Session Updates");
+
+	bBatchUpdates = true;
+	CoalesceWindow = 1.0f;
+	MaxUpdateDelay = 3.0f;
+	bSkipUnchangedUpdates = true;
+
+	OperationTimeout = 30.0f;
+	AbandonedOperationGrace = 15.0f;
+}
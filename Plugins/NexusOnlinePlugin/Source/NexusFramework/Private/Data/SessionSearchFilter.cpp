@@ -349,3 +349,140 @@ bool NexusSessionFilterUtils::PassesAllFilters(const TArray<FSessionSearchFilter
 	
     return true;
 }
+
+
+// ──────────────────────────────────────────────
+// Prédicats compilés
+// ──────────────────────────────────────────────
+
+FNexusCompiledSessionFilter FNexusCompiledSessionFilter::Compile(const FSessionSearchFilter& Filter)
+{
+    FNexusCompiledSessionFilter Compiled;
+    Compiled.Key = Filter.Key;
+    Compiled.Op = Filter.ToOnlineOp();
+    Compiled.Type = Filter.Value.Type;
+    Compiled.bExists = (Filter.ComparisonOp == ENexusSessionComparisonOp::Exists);
+    Compiled.bMissingResult = (Filter.ComparisonOp == ENexusSessionComparisonOp::NotEquals);
+    Compiled.SourceValue = Filter.Value;
+
+    switch (Filter.Value.Type)
+    {
+    case ENexusSessionFilterValueType::String:
+        Compiled.StringOperand = Filter.Value.StringValue;
+        break;
+
+    case ENexusSessionFilterValueType::Int32:
+        Compiled.IntOperand = Filter.Value.IntValue;
+        Compiled.NumericOperand = Filter.Value.IntValue;
+        break;
+
+    case ENexusSessionFilterValueType::Float:
+        Compiled.NumericOperand = static_cast<double>(Filter.Value.FloatValue);
+        break;
+
+    case ENexusSessionFilterValueType::Bool:
+        Compiled.bBoolOperand = Filter.Value.bBoolValue;
+        break;
+
+    default:
+        break;
+    }
+
+    return Compiled;
+}
+
+bool FNexusCompiledSessionFilter::Matches(const FOnlineSessionSearchResult& Result) const
+{
+    const FOnlineSessionSetting* Setting = Result.Session.SessionSettings.Settings.Find(Key);
+    if (!Setting)
+        return bMissingResult;
+
+    if (bExists)
+        return true;
+
+    return MatchesData(Setting->Data);
+}
+
+bool FNexusCompiledSessionFilter::MatchesData(const FVariantData& Data) const
+{
+    const EOnlineKeyValuePairDataType::Type DataType = Data.GetType();
+
+    switch (Type)
+    {
+    case ENexusSessionFilterValueType::String:
+        if (Op != EOnlineComparisonOp::Equals && Op != EOnlineComparisonOp::NotEquals)
+            return false;
+
+        if (DataType == EOnlineKeyValuePairDataType::String)
+        {
+            FString Other;
+            Data.GetValue(Other);
+            return EvaluateString(Other, StringOperand, Op);
+        }
+        break;
+
+    case ENexusSessionFilterValueType::Int32:
+        if (DataType == EOnlineKeyValuePairDataType::Int32)
+        {
+            int32 IntVal = 0;
+            Data.GetValue(IntVal);
+            return EvaluateNumeric(IntVal, IntOperand, Op);
+        }
+        break;
+
+    case ENexusSessionFilterValueType::Float:
+        if (DataType == EOnlineKeyValuePairDataType::Double)
+        {
+            double DoubleVal = 0.0;
+            Data.GetValue(DoubleVal);
+            return EvaluateNumeric(DoubleVal, NumericOperand, Op);
+        }
+        if (DataType == EOnlineKeyValuePairDataType::Int32)
+        {
+            // LexToString(int32) -> Atod est exact : on saute l'aller-retour
+            int32 IntVal = 0;
+            Data.GetValue(IntVal);
+            return EvaluateNumeric(IntVal, NumericOperand, Op);
+        }
+        break;
+
+    case ENexusSessionFilterValueType::Bool:
+        if (DataType == EOnlineKeyValuePairDataType::Bool)
+        {
+            bool bVal = false;
+            Data.GetValue(bVal);
+            return EvaluateBool(bVal, bBoolOperand, Op);
+        }
+        break;
+
+    default:
+        return false;
+    }
+
+    // Types différents : chemin d'origine (conversion en chaîne)
+    return SourceValue.CompareVariant(Data, Op);
+}
+
+void NexusSessionFilterUtils::CompileFilters(const TArray<FSessionSearchFilter>& Filters, TArray<FNexusCompiledSessionFilter>& OutCompiled)
+{
+    OutCompiled.Reserve(OutCompiled.Num() + Filters.Num());
+
+    for (const FSessionSearchFilter& Filter : Filters)
+    {
+        if (!Filter.Key.IsNone())
+        {
+            OutCompiled.Add(FNexusCompiledSessionFilter::Compile(Filter));
+        }
+    }
+}
+
+bool NexusSessionFilterUtils::PassesAllCompiled(const TArray<FNexusCompiledSessionFilter>& Compiled, const FOnlineSessionSearchResult& Result)
+{
+    for (const FNexusCompiledSessionFilter& Filter : Compiled)
+    {
+        if (!Filter.Matches(Result))
+            return false;
+    }
+
+    return true;
+}
@@ -1,4 +1,5 @@
 #include "Filters/Rules/SessionFilterRule_KeyValue.h"
+#include "Utils/NexusTrace.h"
 
 
 void USessionFilterRule_KeyValue::ConfigureSearchSettings(FOnlineSessionSearch& SearchSettings) const
@@ -14,7 +15,7 @@ void USessionFilterRule_KeyValue::ConfigureSearchSettings(FOnlineSessionSearch&
 
     if (!Filter.ApplyToSearchSettings(SearchSettings))
     {
-    	UE_LOG(LogTemp, Verbose, TEXT("[NexusOnline|Filter] Unable to apply key/value filter %s"), *GetRuleDescription());
+    	UE_LOG(LogNexusOnline, Verbose, TEXT("[NexusOnline|Filter] Unable to apply key/value filter %s"), *GetRuleDescription());
     }
 }
 
@@ -32,12 +33,28 @@ bool USessionFilterRule_KeyValue::PassesFilter(const FOnlineSessionSearchResult&
     const bool bResult = Filter.MatchesResult(Result);
     if (!bResult)
     {
-    	UE_LOG(LogTemp, VeryVerbose, TEXT("[NexusOnline|Filter] Result filtered by %s"), *GetRuleDescription());
+    	UE_LOG(LogNexusOnline, VeryVerbose, TEXT("[NexusOnline|Filter] Result filtered by %s"), *GetRuleDescription());
     }
 
     return bResult;
 }
 
+bool USessionFilterRule_KeyValue::CompileFilter(FNexusCompiledSessionFilter& OutFilter) const
+{
+    // Une sous-classe peut surcharger PassesFilter : seule la classe de base est compilée
+    if (!bEnabled || Key.IsNone() || GetClass() != USessionFilterRule_KeyValue::StaticClass())
+        return false;
+
+    FSessionSearchFilter Filter;
+    Filter.Key = Key;
+    Filter.Value = ExpectedValue;
+    Filter.ComparisonOp = Comparison;
+    Filter.bApplyToQuerySettings = false;
+
+    OutFilter = FNexusCompiledSessionFilter::Compile(Filter);
+    return true;
+}
+
 FString USessionFilterRule_KeyValue::GetRuleDescription() const
 {
     const FString ValueString = ExpectedValue.ToDebugString();
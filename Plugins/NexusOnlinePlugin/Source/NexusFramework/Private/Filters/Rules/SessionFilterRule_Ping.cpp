@@ -1,5 +1,7 @@
 #include "Filters/Rules/SessionFilterRule_Ping.h"
 #include "OnlineSessionSettings.h"
+#include "Subsystems/NexusPingProberSubsystem.h"
+#include "Utils/NexusTrace.h"
 
 
 bool USessionFilterRule_Ping::PassesFilter(const FOnlineSessionSearchResult& Result) const
@@ -7,10 +9,11 @@ bool USessionFilterRule_Ping::PassesFilter(const FOnlineSessionSearchResult& Res
     if (!bEnabled)
 		return true;
 
-    const bool bValid = Result.PingInMs <= MaxPing;
+    const int32 Ping = bUseMeasuredPing ? FNexusPingCache::Get().GetEffectivePing(Result) : Result.PingInMs;
+    const bool bValid = Ping <= MaxPing;
     if (!bValid)
     {
-        UE_LOG(LogTemp, VeryVerbose, TEXT("[NexusOnline|Filter] Rejecting session with ping %d (max %d)"), Result.PingInMs, MaxPing);
+        UE_LOG(LogNexusOnline, VeryVerbose, TEXT("[NexusOnline|Filter] Rejecting session with ping %d (max %d)"), Ping, MaxPing);
     }
 
     return bValid;
@@ -18,6 +21,6 @@ bool USessionFilterRule_Ping::PassesFilter(const FOnlineSessionSearchResult& Res
 
 FString USessionFilterRule_Ping::GetRuleDescription() const
 {
-	return FString::Printf(TEXT("Ping <= %d"), MaxPing);
+	return FString::Printf(TEXT("Ping <= %d%s"), MaxPing, bUseMeasuredPing ? TEXT(" (measured)") : TEXT(""));
 }
 
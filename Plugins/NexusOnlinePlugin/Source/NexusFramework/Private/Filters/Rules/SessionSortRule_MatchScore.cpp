@@ -0,0 +1,25 @@
+#include "Filters/Rules/SessionSortRule_MatchScore.h"
+#include "OnlineSessionSettings.h"
+
+
+bool USessionSortRule_MatchScore::Compare(const FOnlineSessionSearchResult& A, const FOnlineSessionSearchResult& B) const
+{
+    if (!bEnabled)
+    {
+        return false;
+    }
+
+    return NexusMatchScoring::ScoreResult(Scoring, A) > NexusMatchScoring::ScoreResult(Scoring, B);
+}
+
+void USessionSortRule_MatchScore::ExtractSortKey(const FOnlineSessionSearchResult& Result, TArrayView<double> OutKey) const
+{
+    // Score négativé (tri croissant) ; les sessions écartées (score < 0) passent en dernier
+    const float Score = NexusMatchScoring::ScoreResult(Scoring, Result);
+    OutKey[0] = Score >= 0.f ? -Score : 1.0;
+}
+
+FString USessionSortRule_MatchScore::GetRuleDescription() const
+{
+    return FString::Printf(TEXT("MatchScore top %d (%s)"), TopK, *Scoring.ToDebugString());
+}
@@ -1,5 +1,6 @@
 #include "Filters/Rules/SessionSortRule_Ping.h"
 #include "OnlineSessionSettings.h"
+#include "Subsystems/NexusPingProberSubsystem.h"
 
 
 bool USessionSortRule_Ping::Compare(const FOnlineSessionSearchResult& A, const FOnlineSessionSearchResult& B) const
@@ -11,14 +12,25 @@ bool USessionSortRule_Ping::Compare(const FOnlineSessionSearchResult& A, const F
 
     if (bAscending)
     {
-        return A.PingInMs < B.PingInMs;
+        return GetPing(A) < GetPing(B);
     }
 
-    return A.PingInMs > B.PingInMs;
+    return GetPing(A) > GetPing(B);
+}
+
+void USessionSortRule_Ping::ExtractSortKey(const FOnlineSessionSearchResult& Result, TArrayView<double> OutKey) const
+{
+    const int32 Ping = GetPing(Result);
+    OutKey[0] = bAscending ? Ping : -Ping;
+}
+
+int32 USessionSortRule_Ping::GetPing(const FOnlineSessionSearchResult& Result) const
+{
+    return bUseMeasuredPing ? FNexusPingCache::Get().GetEffectivePing(Result) : Result.PingInMs;
 }
 
 FString USessionSortRule_Ping::GetRuleDescription() const
 {
-    return FString::Printf(TEXT("Ping %s"), bAscending ? TEXT("ASC") : TEXT("DESC"));
+    return FString::Printf(TEXT("Ping %s%s"), bAscending ? TEXT("ASC") : TEXT("DESC"), bUseMeasuredPing ? TEXT(" (measured)") : TEXT(""));
 }
 
@@ -14,6 +14,22 @@ bool USessionFilterRule::PassesFilter(const FOnlineSessionSearchResult& Result)
     return true;
 }
 
+bool USessionFilterRule::CompileFilter(FNexusCompiledSessionFilter& OutFilter) const
+{
+    (void)OutFilter;
+    return false;
+}
+
+bool USessionFilterRule::IsThreadSafe() const
+{
+    return false;
+}
+
+bool USessionFilterRule::CanEvaluateOffGameThread() const
+{
+    return IsThreadSafe() && !GetClass()->HasAnyClassFlags(CLASS_CompiledFromBlueprint);
+}
+
 FString USessionFilterRule::GetRuleDescription() const
 {
     return GetClass() ? GetClass()->GetName() : TEXT("SessionFilterRule");
@@ -0,0 +1,150 @@
+#include "Filters/SessionMatchScoring.h"
+#include "OnlineSessionSettings.h"
+#include "Algo/Sort.h"
+#include "Subsystems/NexusPingProberSubsystem.h"
+
+
+FString FNexusMatchScoringParams::ToDebugString() const
+{
+	return FString::Printf(TEXT("ping %.2f [%d..%d]%s, fill %.2f @%.2f%s, region %.2f %s=%s, build %.2f %s=%d%s, skill %.2f %s=%.2f+-%.2f"),
+		PingWeight, IdealPingMs, MaxPingMs, bUseMeasuredPing ? TEXT(" measured") : TEXT(""),
+		FillWeight, IdealFillRatio, bRejectFullSessions ? TEXT(" no-full") : TEXT(""),
+		RegionWeight, *RegionKey.ToString(), *PreferredRegion,
+		BuildWeight, *BuildKey.ToString(), BuildVersion, bRequireSameBuild ? TEXT(" required") : TEXT(""),
+		SkillWeight, *SkillKey.ToString(), PlayerSkill, SkillBandWidth);
+}
+
+
+namespace
+{
+	bool ReadNumber(const FOnlineSessionSettings& Settings, FName Key, double& OutValue)
+	{
+		const FOnlineSessionSetting* Setting = Settings.Settings.Find(Key);
+		if (!Setting)
+			return false;
+
+		const FVariantData& Data = Setting->Data;
+		switch (Data.GetType())
+		{
+			case EOnlineKeyValuePairDataType::Int32:  { int32 V = 0;  Data.GetValue(V); OutValue = V; return true; }
+			case EOnlineKeyValuePairDataType::UInt32: { uint32 V = 0; Data.GetValue(V); OutValue = V; return true; }
+			case EOnlineKeyValuePairDataType::Int64:  { int64 V = 0;  Data.GetValue(V); OutValue = static_cast<double>(V); return true; }
+			case EOnlineKeyValuePairDataType::UInt64: { uint64 V = 0; Data.GetValue(V); OutValue = static_cast<double>(V); return true; }
+			case EOnlineKeyValuePairDataType::Float:  { float V = 0;  Data.GetValue(V); OutValue = V; return true; }
+			case EOnlineKeyValuePairDataType::Double: { double V = 0; Data.GetValue(V); OutValue = V; return true; }
+			default: return false;
+		}
+	}
+
+	/** Ordre du tas : A est "pire" que B (score plus bas, ou même score mais arrivé après). */
+	bool IsWorse(const NexusMatchScoring::FScoredIndex& A, const NexusMatchScoring::FScoredIndex& B)
+	{
+		return A.Score < B.Score || (A.Score == B.Score && A.Index > B.Index);
+	}
+}
+
+
+float NexusMatchScoring::ScoreResult(const FNexusMatchScoringParams& Params, const FOnlineSessionSearchResult& Result)
+{
+	const FOnlineSessionSettings& Settings = Result.Session.SessionSettings;
+	const int32 MaxPlayers = Settings.NumPublicConnections;
+	const int32 OpenSlots = Result.Session.NumOpenPublicConnections;
+
+	if (Params.bRejectFullSessions && MaxPlayers > 0 && OpenSlots <= 0)
+		return -1.f;
+
+	float WeightedSum = 0.f;
+	float TotalWeight = 0.f;
+
+	auto AddCriterion = [&WeightedSum, &TotalWeight](float Weight, float Value)
+	{
+		if (Weight > 0.f)
+		{
+			WeightedSum += Weight * FMath::Clamp(Value, 0.f, 1.f);
+			TotalWeight += Weight;
+		}
+	};
+
+	// ---- Version (peut écarter la session : évaluée en premier)
+	if (Params.BuildWeight > 0.f || Params.bRequireSameBuild)
+	{
+		int32 Build = 0;
+		const bool bSameBuild = Settings.Get(Params.BuildKey, Build) && Build == Params.BuildVersion;
+		if (!bSameBuild && Params.bRequireSameBuild)
+			return -1.f;
+
+		AddCriterion(Params.BuildWeight, bSameBuild ? 1.f : 0.f);
+	}
+
+	// ---- Ping
+	if (Params.PingWeight > 0.f)
+	{
+		const int32 Ping = Params.bUseMeasuredPing ? FNexusPingCache::Get().GetEffectivePing(Result) : Result.PingInMs;
+		const float Range = static_cast<float>(FMath::Max(Params.MaxPingMs - Params.IdealPingMs, 1));
+		AddCriterion(Params.PingWeight, 1.f - static_cast<float>(Ping - Params.IdealPingMs) / Range);
+	}
+
+	// ---- Remplissage
+	if (Params.FillWeight > 0.f && MaxPlayers > 0)
+	{
+		const float Fill = static_cast<float>(MaxPlayers - OpenSlots) / MaxPlayers;
+		const float MaxDistance = FMath::Max(Params.IdealFillRatio, 1.f - Params.IdealFillRatio);
+		AddCriterion(Params.FillWeight, 1.f - FMath::Abs(Fill - Params.IdealFillRatio) / FMath::Max(MaxDistance, KINDA_SMALL_NUMBER));
+	}
+
+	// ---- Région
+	if (Params.RegionWeight > 0.f && !Params.PreferredRegion.IsEmpty())
+	{
+		FString Region;
+		Settings.Get(Params.RegionKey, Region);
+		AddCriterion(Params.RegionWeight, Region.Equals(Params.PreferredRegion, ESearchCase::IgnoreCase) ? 1.f : 0.f);
+	}
+
+	// ---- Niveau (clé absente = note nulle)
+	if (Params.SkillWeight > 0.f)
+	{
+		double Skill = 0.0;
+		const float Value = ReadNumber(Settings, Params.SkillKey, Skill)
+			? 1.f - FMath::Abs(static_cast<float>(Skill) - Params.PlayerSkill) / FMath::Max(Params.SkillBandWidth, KINDA_SMALL_NUMBER)
+			: 0.f;
+		AddCriterion(Params.SkillWeight, Value);
+	}
+
+	return TotalWeight > 0.f ? WeightedSum / TotalWeight : 0.f;
+}
+
+void NexusMatchScoring::SelectTopK(const FNexusMatchScoringParams& Params, int32 Num,
+	TFunctionRef<const FOnlineSessionSearchResult&(int32)> GetResult, int32 K, TArray<FScoredIndex>& OutBest)
+{
+	OutBest.Reset();
+	if (Num <= 0)
+		return;
+
+	const int32 Capacity = (K > 0) ? FMath::Min(K, Num) : Num;
+	OutBest.Reserve(Capacity);
+
+	// Tas min : HeapTop() est le pire des K gardés, seul élément à comparer pour chaque nouveau résultat
+	for (int32 i = 0; i < Num; ++i)
+	{
+		const float Score = ScoreResult(Params, GetResult(i));
+		if (Score < 0.f)
+			continue;
+
+		const FScoredIndex Candidate{ Score, i };
+		if (OutBest.Num() < Capacity)
+		{
+			OutBest.HeapPush(Candidate, IsWorse);
+		}
+		else if (IsWorse(OutBest.HeapTop(), Candidate))
+		{
+			OutBest.HeapPopDiscard(IsWorse, EAllowShrinking::No);
+			OutBest.HeapPush(Candidate, IsWorse);
+		}
+	}
+
+	// Seuls les K gagnants sont triés
+	Algo::Sort(OutBest, [](const FScoredIndex& A, const FScoredIndex& B)
+	{
+		return IsWorse(B, A);
+	});
+}
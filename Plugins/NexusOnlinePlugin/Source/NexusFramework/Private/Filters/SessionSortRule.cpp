@@ -1,4 +1,6 @@
 #include "Filters/SessionSortRule.h"
+#include "OnlineSessionSettings.h"
+#include "Algo/Sort.h"
 
 void USessionSortRule::ConfigureSearchSettings(FOnlineSessionSearch& SearchSettings) const
 {
@@ -12,8 +14,155 @@ bool USessionSortRule::Compare(const FOnlineSessionSearchResult& A, const FOnlin
     return false;
 }
 
+int32 USessionSortRule::GetSortKeyWidth() const
+{
+    return 0;
+}
+
+void USessionSortRule::ExtractSortKey(const FOnlineSessionSearchResult& Result, TArrayView<double> OutKey) const
+{
+    (void)Result;
+    for (double& Value : OutKey)
+    {
+        Value = 0.0;
+    }
+}
+
 FString USessionSortRule::GetRuleDescription() const
 {
     return GetClass() ? GetClass()->GetName() : TEXT("SessionSortRule");
 }
 
+
+
+// ──────────────────────────────────────────────
+// Tri par clés précalculées
+// ──────────────────────────────────────────────
+
+namespace
+{
+    struct FKeyedIndex
+    {
+        /** Première composante en ligne : la plupart des comparaisons s'arrêtent là. */
+        double Key0 = 0.0;
+        int32 Index = 0;
+    };
+}
+
+void NexusSessionSortUtils::ComputeSortOrder(const TArray<TObjectPtr<USessionSortRule>>& Rules, int32 Num,
+    TFunctionRef<const FOnlineSessionSearchResult&(int32)> GetResult, TArray<int32>& OutOrder)
+{
+    OutOrder.SetNumUninitialized(Num);
+    for (int32 i = 0; i < Num; ++i)
+    {
+        OutOrder[i] = i;
+    }
+
+    TArray<const USessionSortRule*, TInlineAllocator<8>> ActiveRules;
+    int32 KeyWidth = 0;
+    bool bAllKeyed = true;
+
+    for (const TObjectPtr<USessionSortRule>& Rule : Rules)
+    {
+        if (!Rule || !Rule->bEnabled)
+            continue;
+
+        ActiveRules.Add(Rule);
+
+        const int32 Width = Rule->GetSortKeyWidth();
+        bAllKeyed &= (Width > 0);
+        KeyWidth += FMath::Max(Width, 0);
+    }
+
+    if (ActiveRules.IsEmpty() || Num < 2)
+        return;
+
+    // ---------------------------------------------------------
+    // Fallback : comparaisons virtuelles deux à deux
+    // ---------------------------------------------------------
+    if (!bAllKeyed)
+    {
+        Algo::Sort(OutOrder, [&](int32 IndexA, int32 IndexB)
+        {
+            const FOnlineSessionSearchResult& A = GetResult(IndexA);
+            const FOnlineSessionSearchResult& B = GetResult(IndexB);
+
+            for (const USessionSortRule* Rule : ActiveRules)
+            {
+                if (Rule->Compare(A, B))
+                    return true;
+
+                if (Rule->Compare(B, A))
+                    return false;
+            }
+            return IndexA < IndexB;
+        });
+        return;
+    }
+
+    // ---------------------------------------------------------
+    // Extraction des clés : une fois par résultat
+    // ---------------------------------------------------------
+    TArray<double> Keys;
+    Keys.SetNumUninitialized(Num * KeyWidth);
+
+    TArray<FKeyedIndex> Entries;
+    Entries.SetNumUninitialized(Num);
+
+    for (int32 i = 0; i < Num; ++i)
+    {
+        const FOnlineSessionSearchResult& Result = GetResult(i);
+        double* Key = Keys.GetData() + i * KeyWidth;
+
+        int32 Offset = 0;
+        for (const USessionSortRule* Rule : ActiveRules)
+        {
+            const int32 Width = Rule->GetSortKeyWidth();
+            Rule->ExtractSortKey(Result, TArrayView<double>(Key + Offset, Width));
+            Offset += Width;
+        }
+
+        Entries[i].Key0 = Key[0];
+        Entries[i].Index = i;
+    }
+
+    Algo::Sort(Entries, [&Keys, KeyWidth](const FKeyedIndex& A, const FKeyedIndex& B)
+    {
+        if (A.Key0 != B.Key0)
+            return A.Key0 < B.Key0;
+
+        const double* KeyA = Keys.GetData() + A.Index * KeyWidth;
+        const double* KeyB = Keys.GetData() + B.Index * KeyWidth;
+        for (int32 k = 1; k < KeyWidth; ++k)
+        {
+            if (KeyA[k] != KeyB[k])
+                return KeyA[k] < KeyB[k];
+        }
+
+        return A.Index < B.Index;
+    });
+
+    for (int32 i = 0; i < Num; ++i)
+    {
+        OutOrder[i] = Entries[i].Index;
+    }
+}
+
+void NexusSessionSortUtils::SortResults(const TArray<TObjectPtr<USessionSortRule>>& Rules, TArray<FOnlineSessionSearchResult>& InOutResults)
+{
+    if (InOutResults.Num() < 2)
+        return;
+
+    TArray<int32> Order;
+    ComputeSortOrder(Rules, InOutResults.Num(), [&InOutResults](int32 Index) -> const FOnlineSessionSearchResult& { return InOutResults[Index]; }, Order);
+
+    // Réordonnancement unique : chaque résultat (et sa map de settings) n'est déplacé qu'une fois
+    TArray<FOnlineSessionSearchResult> Sorted;
+    Sorted.Reserve(InOutResults.Num());
+    for (const int32 Index : Order)
+    {
+        Sorted.Add(MoveTemp(InOutResults[Index]));
+    }
+
+    InOutResults = MoveTemp(Sorted);
+}
@@ -1,6 +1,8 @@
 #include "Interfaces/INexusSessionHandler.h"
 #include "Managers/OnlineSessionManager.h"
 #include "Utils/NexusOnlineHelpers.h"
+#include "Utils/NexusTrace.h"
+#include "Subsystems/NexusSessionUpdateSubsystem.h"
 #include "GameFramework/PlayerState.h"
 #include "Interfaces/OnlineSessionInterface.h"
 
@@ -10,9 +12,9 @@ void INexusSessionHandler::InitializeNexusSession(UObject* WorldContextObject, F
 	if (!WorldContextObject)
 		return;
 
-    UE_LOG(LogTemp, Log, TEXT("[NexusSessionHandler] Requesting OnlineSessionManager Spawn..."));
+    UE_LOG(LogNexusOnline, Log, TEXT("[NexusSessionHandler] Requesting OnlineSessionManager Spawn..."));
 	AOnlineSessionManager::Spawn(WorldContextObject, SessionName);
-	UE_LOG(LogTemp, Log, TEXT("[NexusSessionHandler] OnlineSessionManager initialized for session '%s'."), *SessionName.ToString());
+	UE_LOG(LogNexusOnline, Log, TEXT("[NexusSessionHandler] OnlineSessionManager initialized for session '%s'."), *SessionName.ToString());
 }
 
 void INexusSessionHandler::RegisterPlayerWithSession(UObject* WorldContextObject, APlayerController* Player, FName SessionName)
@@ -20,6 +22,13 @@ void INexusSessionHandler::RegisterPlayerWithSession(UObject* WorldContextObject
 	if (!Player || !Player->PlayerState)
 		return;
 
+	// Vagues de connexions : un seul RegisterPlayers + UpdateSession par fenêtre
+	if (UNexusSessionUpdateSubsystem* Updates = UNexusSessionUpdateSubsystem::Get(WorldContextObject))
+	{
+		Updates->QueueRegisterPlayer(SessionName, Player->PlayerState->GetUniqueId());
+		return;
+	}
+
 	IOnlineSessionPtr Session = NexusOnline::GetSessionInterface(WorldContextObject);
 	if (!Session.IsValid())
 		return;
@@ -41,6 +50,15 @@ void INexusSessionHandler::UnregisterPlayerFromSession(UObject* WorldContextObje
 	if (!Exiting)
 		return;
 
+	if (UNexusSessionUpdateSubsystem* Updates = UNexusSessionUpdateSubsystem::Get(WorldContextObject))
+	{
+		if (APlayerState* PS = Exiting->GetPlayerState<APlayerState>())
+		{
+			Updates->QueueUnregisterPlayer(SessionName, PS->GetUniqueId());
+		}
+		return;
+	}
+
 	IOnlineSessionPtr Session = NexusOnline::GetSessionInterface(WorldContextObject);
 	if (!Session.IsValid())
 		return;
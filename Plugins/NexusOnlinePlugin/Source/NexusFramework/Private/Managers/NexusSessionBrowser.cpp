@@ -0,0 +1,430 @@
+#include "Managers/NexusSessionBrowser.h"
+#include "Async/AsyncTask_FindSessions.h"
+#include "Data/SessionFilterPreset.h"
+#include "Filters/SessionFilterRule.h"
+#include "Filters/SessionSortRule.h"
+#include "Utils/NexusOnlineHelpers.h"
+#include "Utils/NexusTrace.h"
+#include "Algo/Sort.h"
+
+
+UNexusSessionBrowser* UNexusSessionBrowser::CreateSessionBrowser(UObject* WorldContextObject, ENexusSessionType SessionType, int32 MaxResults, bool bIsLANQuery,
+	const TArray<FSessionSearchFilter>& SimpleFilters, const TArray<USessionFilterRule*>& AdvancedRules,
+	const TArray<USessionSortRule*>& SortRules, USessionFilterPreset* Preset, float RefreshInterval)
+{
+	UNexusSessionBrowser* Browser = NewObject<UNexusSessionBrowser>(GetTransientPackage());
+	Browser->WorldContextObject = WorldContextObject;
+	Browser->SessionType = SessionType;
+	Browser->MaxResults = MaxResults;
+	Browser->bIsLANQuery = bIsLANQuery;
+	Browser->RefreshInterval = FMath::Max(RefreshInterval, 1.f);
+
+	// Les filtres du preset passent à la recherche ; ses règles de tri restent au navigateur
+	Browser->SimpleFilters = SimpleFilters;
+	for (USessionFilterRule* Rule : AdvancedRules)
+	{
+		if (Rule)
+			Browser->AdvancedRules.Add(Rule);
+	}
+
+	for (USessionSortRule* Rule : SortRules)
+	{
+		if (Rule)
+			Browser->SortRules.Add(Rule);
+	}
+
+	if (Preset)
+	{
+		Browser->SimpleFilters.Append(Preset->SimpleFilters);
+		for (USessionFilterRule* Rule : Preset->AdvancedRules)
+		{
+			if (Rule)
+				Browser->AdvancedRules.Add(Rule);
+		}
+
+		for (USessionSortRule* Rule : Preset->SortRules)
+		{
+			if (Rule)
+				Browser->SortRules.Add(Rule);
+		}
+	}
+
+	Browser->ResolveSortRules();
+	return Browser;
+}
+
+void UNexusSessionBrowser::BeginDestroy()
+{
+	if (TickHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+		TickHandle.Reset();
+	}
+
+	if (ActiveSearch)
+	{
+		ActiveSearch->OnCompleted.RemoveAll(this);
+		ActiveSearch = nullptr;
+	}
+
+	Super::BeginDestroy();
+}
+
+// ──────────────────────────────────────────────
+// CONTROL
+// ──────────────────────────────────────────────
+
+void UNexusSessionBrowser::Start()
+{
+	if (bRunning)
+		return;
+
+	bRunning = true;
+	NextRefreshTime = 0.0;
+
+	if (!TickHandle.IsValid())
+	{
+		TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UNexusSessionBrowser::TickRefresh), 0.25f);
+	}
+
+	RefreshNow();
+}
+
+void UNexusSessionBrowser::Stop()
+{
+	bRunning = false;
+
+	if (TickHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+		TickHandle.Reset();
+	}
+}
+
+void UNexusSessionBrowser::RefreshNow()
+{
+	if (ActiveSearch)
+		return;
+
+	if (!WorldContextObject)
+	{
+		UE_LOG(LogNexusOnline, Warning, TEXT("[NexusBrowser] No world context, refresh skipped."));
+		return;
+	}
+
+	// Pas de règles de tri : l'ordre est maintenu ici, ligne par ligne
+	TArray<USessionFilterRule*> Rules;
+	Rules.Reserve(AdvancedRules.Num());
+	for (const TObjectPtr<USessionFilterRule>& Rule : AdvancedRules)
+	{
+		Rules.Add(Rule);
+	}
+
+	ActiveSearch = UAsyncTask_FindSessions::FindSessions(WorldContextObject, SessionType, MaxResults, bIsLANQuery, SimpleFilters, Rules, {}, nullptr, false);
+	ActiveSearch->OnCompleted.AddDynamic(this, &UNexusSessionBrowser::HandleSearchCompleted);
+	ActiveSearch->Activate();
+}
+
+bool UNexusSessionBrowser::TickRefresh(float DeltaTime)
+{
+	if (bRunning && !ActiveSearch && FPlatformTime::Seconds() >= NextRefreshTime)
+	{
+		RefreshNow();
+	}
+	return true;
+}
+
+void UNexusSessionBrowser::HandleSearchCompleted(bool bWasSuccessful, const TArray<FOnlineSessionSearchResultData>& Results)
+{
+	if (ActiveSearch)
+	{
+		ActiveSearch->OnCompleted.RemoveAll(this);
+		ActiveSearch = nullptr;
+	}
+
+	NextRefreshTime = FPlatformTime::Seconds() + RefreshInterval;
+
+	int32 NumAdded = 0, NumRemoved = 0, NumUpdated = 0;
+
+	// Un échec (réseau, backend) ne vide pas la liste : on garde les lignes jusqu'au prochain refresh
+	if (bWasSuccessful)
+	{
+		ApplyResults(Results, NumAdded, NumRemoved, NumUpdated);
+	}
+
+	UE_LOG(LogNexusOnline, Verbose, TEXT("[NexusBrowser] Refresh %s : %d rows (+%d / -%d / ~%d)."),
+		bWasSuccessful ? TEXT("ok") : TEXT("failed"), Rows.Num(), NumAdded, NumRemoved, NumUpdated);
+
+	OnRefreshed.Broadcast(bWasSuccessful, NumAdded, NumRemoved, NumUpdated);
+}
+
+// ──────────────────────────────────────────────
+// DIFF
+// ──────────────────────────────────────────────
+
+void UNexusSessionBrowser::ApplyResults(const TArray<FOnlineSessionSearchResultData>& Results, int32& OutAdded, int32& OutRemoved, int32& OutUpdated)
+{
+	TMap<FString, const FOnlineSessionSearchResultData*> Incoming;
+	Incoming.Reserve(Results.Num());
+	for (const FOnlineSessionSearchResultData& Result : Results)
+	{
+		Incoming.Add(NexusOnline::GetSessionIdentity(Result.GetRawResult()), &Result);
+	}
+
+	// ---- PHASE 1 : suppressions (de la fin vers le début, chaque index reste valide à l'émission)
+	for (int32 i = Rows.Num() - 1; i >= 0; --i)
+	{
+		if (Incoming.Contains(Rows[i]->SessionId))
+			continue;
+
+		const FString SessionId = Rows[i]->SessionId;
+		Rows.RemoveAt(i);
+		++OutRemoved;
+
+		OnSessionRemoved.Broadcast(SessionId, i);
+	}
+
+	// ---- PHASE 2 : mises à jour (seule une ligne qui sort de l'ordre est déplacée)
+	TArray<FRow*, TInlineAllocator<64>> Existing;
+	Existing.Reserve(Rows.Num());
+	for (const TUniquePtr<FRow>& Row : Rows)
+	{
+		Existing.Add(Row.Get());
+	}
+
+	for (FRow* Row : Existing)
+	{
+		const FOnlineSessionSearchResultData* New = nullptr;
+		Incoming.RemoveAndCopyValue(Row->SessionId, New);
+		check(New);
+
+		const int32 ChangedFields = ComputeChangedFields(Row->Data, *New);
+		const TArray<double, TInlineAllocator<4>> OldKey = Row->SortKey;
+
+		// Données toujours remplacées : le résultat brut le plus récent sert au Join
+		Row->Data = *New;
+		ComputeSortKey(*Row);
+
+		if (ChangedFields == 0 && Row->SortKey == OldKey)
+			continue;
+
+		const int32 OldIndex = IndexOfRow(Row);
+		int32 NewIndex = OldIndex;
+
+		if (!IsInOrder(OldIndex))
+		{
+			TUniquePtr<FRow> Moved = MoveTemp(Rows[OldIndex]);
+			Rows.RemoveAt(OldIndex);
+
+			NewIndex = FindInsertIndex(*Moved);
+			Rows.Insert(MoveTemp(Moved), NewIndex);
+		}
+
+		if (ChangedFields == 0 && NewIndex == OldIndex)
+			continue;
+
+		FNexusSessionRowUpdate Update;
+		Update.SessionId = Row->SessionId;
+		Update.ChangedFields = ChangedFields;
+		Update.CurrentPlayers = Row->Data.CurrentPlayers;
+		Update.MaxPlayers = Row->Data.MaxPlayers;
+		Update.Ping = Row->Data.Ping;
+		Update.OldIndex = OldIndex;
+		Update.NewIndex = NewIndex;
+		++OutUpdated;
+
+		OnSessionUpdated.Broadcast(Update);
+	}
+
+	// ---- PHASE 3 : ajouts, insérés à leur place par recherche dichotomique
+	for (const FOnlineSessionSearchResultData& Result : Results)
+	{
+		const FString SessionId = NexusOnline::GetSessionIdentity(Result.GetRawResult());
+		const FOnlineSessionSearchResultData* const* Pending = Incoming.Find(SessionId);
+
+		// Les doublons d'identité ne gardent que la dernière occurrence
+		if (!Pending || *Pending != &Result)
+			continue;
+
+		Incoming.Remove(SessionId);
+
+		TUniquePtr<FRow> Row = MakeUnique<FRow>();
+		Row->SessionId = SessionId;
+		Row->Data = Result;
+		ComputeSortKey(*Row);
+
+		const int32 Index = FindInsertIndex(*Row);
+		Rows.Insert(MoveTemp(Row), Index);
+		++OutAdded;
+
+		OnSessionAdded.Broadcast(Rows[Index]->Data, Index);
+	}
+}
+
+int32 UNexusSessionBrowser::ComputeChangedFields(const FOnlineSessionSearchResultData& Old, const FOnlineSessionSearchResultData& New)
+{
+	int32 Fields = 0;
+
+	if (Old.CurrentPlayers != New.CurrentPlayers)
+		Fields |= static_cast<int32>(ENexusSessionChangedFields::Players);
+
+	if (Old.MaxPlayers != New.MaxPlayers)
+		Fields |= static_cast<int32>(ENexusSessionChangedFields::MaxPlayers);
+
+	if (Old.Ping != New.Ping)
+		Fields |= static_cast<int32>(ENexusSessionChangedFields::Ping);
+
+	if (Old.SessionDisplayName != New.SessionDisplayName || Old.MapName != New.MapName || Old.GameMode != New.GameMode)
+		Fields |= static_cast<int32>(ENexusSessionChangedFields::Metadata);
+
+	return Fields;
+}
+
+// ──────────────────────────────────────────────
+// ORDERING
+// ──────────────────────────────────────────────
+
+void UNexusSessionBrowser::ResolveSortRules()
+{
+	// Même ordre de priorité que UAsyncTask_FindSessions::RebuildResolvedFilters
+	Algo::Sort(SortRules, [](const TObjectPtr<USessionSortRule>& A, const TObjectPtr<USessionSortRule>& B)
+	{
+		return A && B ? (A->Priority > B->Priority) : (A != nullptr);
+	});
+
+	ActiveSortRules.Reset();
+	SortKeyWidth = 0;
+	bKeyedSort = true;
+
+	for (const TObjectPtr<USessionSortRule>& Rule : SortRules)
+	{
+		if (!Rule || !Rule->bEnabled)
+			continue;
+
+		ActiveSortRules.Add(Rule);
+
+		const int32 Width = Rule->GetSortKeyWidth();
+		bKeyedSort &= (Width > 0);
+		SortKeyWidth += FMath::Max(Width, 0);
+	}
+
+	bKeyedSort &= !ActiveSortRules.IsEmpty();
+}
+
+void UNexusSessionBrowser::ComputeSortKey(FRow& Row) const
+{
+	if (!bKeyedSort)
+		return;
+
+	// Extraite une fois par ligne et par refresh : les comparaisons de l'insertion n'appellent plus les règles
+	Row.SortKey.SetNumUninitialized(SortKeyWidth);
+
+	const FOnlineSessionSearchResult& Result = Row.Data.GetRawResult();
+	int32 Offset = 0;
+	for (const USessionSortRule* Rule : ActiveSortRules)
+	{
+		const int32 Width = Rule->GetSortKeyWidth();
+		Rule->ExtractSortKey(Result, TArrayView<double>(Row.SortKey.GetData() + Offset, Width));
+		Offset += Width;
+	}
+}
+
+bool UNexusSessionBrowser::IsRowBefore(const FRow& A, const FRow& B) const
+{
+	if (bKeyedSort)
+	{
+		for (int32 i = 0; i < SortKeyWidth; ++i)
+		{
+			if (A.SortKey[i] != B.SortKey[i])
+				return A.SortKey[i] < B.SortKey[i];
+		}
+	}
+	else
+	{
+		const FOnlineSessionSearchResult& RawA = A.Data.GetRawResult();
+		const FOnlineSessionSearchResult& RawB = B.Data.GetRawResult();
+
+		for (const USessionSortRule* Rule : ActiveSortRules)
+		{
+			if (Rule->Compare(RawA, RawB))
+				return true;
+
+			if (Rule->Compare(RawB, RawA))
+				return false;
+		}
+	}
+
+	// Départage par identité : l'ordre ne dépend pas de l'ordre de réponse du backend
+	return A.SessionId < B.SessionId;
+}
+
+bool UNexusSessionBrowser::IsInOrder(int32 Index) const
+{
+	const FRow& Row = *Rows[Index];
+	return (Index == 0 || IsRowBefore(*Rows[Index - 1], Row))
+		&& (Index == Rows.Num() - 1 || IsRowBefore(Row, *Rows[Index + 1]));
+}
+
+int32 UNexusSessionBrowser::FindInsertIndex(const FRow& Row) const
+{
+	int32 Low = 0;
+	int32 High = Rows.Num();
+
+	while (Low < High)
+	{
+		const int32 Mid = Low + (High - Low) / 2;
+		if (IsRowBefore(*Rows[Mid], Row))
+		{
+			Low = Mid + 1;
+		}
+		else
+		{
+			High = Mid;
+		}
+	}
+	return Low;
+}
+
+int32 UNexusSessionBrowser::IndexOfRow(const FRow* Row) const
+{
+	return Rows.IndexOfByPredicate([Row](const TUniquePtr<FRow>& Other) { return Other.Get() == Row; });
+}
+
+int32 UNexusSessionBrowser::IndexOfSession(const FString& SessionId) const
+{
+	return Rows.IndexOfByPredicate([&SessionId](const TUniquePtr<FRow>& Row) { return Row->SessionId == SessionId; });
+}
+
+// ──────────────────────────────────────────────
+// ROWS
+// ──────────────────────────────────────────────
+
+bool UNexusSessionBrowser::GetSessionAt(int32 Index, FOnlineSessionSearchResultData& OutSession) const
+{
+	if (!Rows.IsValidIndex(Index))
+		return false;
+
+	OutSession = Rows[Index]->Data;
+	return true;
+}
+
+bool UNexusSessionBrowser::FindSession(const FString& SessionId, FOnlineSessionSearchResultData& OutSession, int32& OutIndex) const
+{
+	OutIndex = IndexOfSession(SessionId);
+	if (OutIndex == INDEX_NONE)
+		return false;
+
+	OutSession = Rows[OutIndex]->Data;
+	return true;
+}
+
+TArray<FOnlineSessionSearchResultData> UNexusSessionBrowser::GetSessions() const
+{
+	TArray<FOnlineSessionSearchResultData> Sessions;
+	Sessions.Reserve(Rows.Num());
+	for (const TUniquePtr<FRow>& Row : Rows)
+	{
+		Sessions.Add(Row->Data);
+	}
+	return Sessions;
+}
@@ -4,12 +4,19 @@
 #include "EngineUtils.h"
 #include "Interfaces/OnlineSessionInterface.h"
 #include "Interfaces/OnlineIdentityInterface.h"
+#include "GameFramework/GameModeBase.h"
 #include "GameFramework/GameStateBase.h"
 #include "GameFramework/PlayerState.h"
 #include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
 #include "TimerManager.h"
 #include "Utils/NexusOnlineHelpers.h"
+#include "Utils/NexusTrace.h"
 #include "Subsystems/NexusMigrationSubsystem.h"
+#include "Configs/NexusMigrationConfig.h"
+#include "Engine/NetConnection.h"
+#include "Kismet/GameplayStatics.h"
+#include "Subsystems/NexusSessionUpdateSubsystem.h"
 
 
 AOnlineSessionManager::AOnlineSessionManager()
@@ -26,7 +33,7 @@ AOnlineSessionManager::AOnlineSessionManager()
 void AOnlineSessionManager::BeginPlay()
 {
     Super::BeginPlay();
-    UE_LOG(LogTemp, Warning, TEXT("[AOnlineSessionManager] BeginPlay Started. This: %p, World: %p"), this, GetWorld());
+    UE_LOG(LogNexusOnline, Verbose, TEXT("[AOnlineSessionManager] BeginPlay Started. This: %p, World: %p"), this, GetWorld());
 
     // Cache this instance for O(1) Get() access, keyed by world for PIE support
     if (UWorld* World = GetWorld())
@@ -38,12 +45,24 @@ void AOnlineSessionManager::BeginPlay()
     {
         BindSessionDelegates();
 
+        // Le compte suit les connexions / enregistrements ; le recomptage complet ne sert qu'à rattraper un événement manqué
+        PostLoginHandle = FGameModeEvents::GameModePostLoginEvent.AddUObject(this, &AOnlineSessionManager::OnGameModePostLogin);
+        LogoutHandle = FGameModeEvents::GameModeLogoutEvent.AddUObject(this, &AOnlineSessionManager::OnGameModeLogout);
+
         GetWorldTimerManager().SetTimerForNextTick(FTimerDelegate::CreateWeakLambda(this, [this]()
         {
-            RefreshPlayerCount();
+            ReconcilePlayerCount();
         }));
 
-        GetWorldTimerManager().SetTimer(TimerHandle_Refresh, this, &AOnlineSessionManager::RefreshPlayerCount, 10.f, true);
+        if (ReconcileInterval > 0.f)
+        {
+            GetWorldTimerManager().SetTimer(TimerHandle_Reconcile, this, &AOnlineSessionManager::ReconcilePlayerCount, ReconcileInterval, true);
+        }
+
+        // RTT et pertes évoluent sans événement : classement périodique, répliqué seulement s'il change
+        const UNexusMigrationConfig* MigrationConfig = GetDefault<UNexusMigrationConfig>();
+        const float RankInterval = MigrationConfig ? MigrationConfig->HeirRankInterval : 5.f;
+        GetWorldTimerManager().SetTimer(TimerHandle_HeirRank, this, &AOnlineSessionManager::UpdateHeir, RankInterval, true);
     }
     else
     {
@@ -52,7 +71,7 @@ void AOnlineSessionManager::BeginPlay()
             OnRep_PlayerCount();
         }
     }
-    UE_LOG(LogTemp, Warning, TEXT("[AOnlineSessionManager] BeginPlay Finished."));
+    UE_LOG(LogNexusOnline, Verbose, TEXT("[AOnlineSessionManager] BeginPlay Finished."));
 }
 
 void AOnlineSessionManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
@@ -69,7 +88,10 @@ void AOnlineSessionManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
     if (HasAuthority())
     {
         UnbindSessionDelegates();
-        GetWorldTimerManager().ClearTimer(TimerHandle_Refresh);
+        FGameModeEvents::GameModePostLoginEvent.Remove(PostLoginHandle);
+        FGameModeEvents::GameModeLogoutEvent.Remove(LogoutHandle);
+        GetWorldTimerManager().ClearTimer(TimerHandle_Reconcile);
+        GetWorldTimerManager().ClearTimer(TimerHandle_HeirRank);
     }
     
     Super::EndPlay(EndPlayReason);
@@ -78,9 +100,14 @@ void AOnlineSessionManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
 void AOnlineSessionManager::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
     Super::GetLifetimeReplicatedProps(OutLifetimeProps);
-    DOREPLIFETIME(AOnlineSessionManager, PlayerCount);
+
+    FDoRepLifetimeParams PushParams;
+    PushParams.bIsPushBased = true;
+    DOREPLIFETIME_WITH_PARAMS_FAST(AOnlineSessionManager, PlayerCount, PushParams);
+
     DOREPLIFETIME(AOnlineSessionManager, TrackedSessionName);
-    DOREPLIFETIME(AOnlineSessionManager, NextHostUniqueId);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AOnlineSessionManager, HeirList, PushParams);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AOnlineSessionManager, HeirAddresses, PushParams);
 }
 
 // ──────────────────────────────────────────────
@@ -100,38 +127,37 @@ void AOnlineSessionManager::ForceUpdatePlayerCount()
 {
     if (HasAuthority())
     {
-        RefreshPlayerCount();
+        ReconcilePlayerCount();
     }
 }
 
-void AOnlineSessionManager::RefreshPlayerCount()
+void AOnlineSessionManager::ReconcilePlayerCount()
 {
-    UE_LOG(LogTemp, Verbose, TEXT("[AOnlineSessionManager] RefreshPlayerCount Called."));
-    if (!HasAuthority())
+	NEXUS_TRACE_SCOPE(NexusSessionManager_Reconcile);
+
+	if (!HasAuthority())
 		return;
 
 	UWorld* World = GetWorld();
 	if (!World)
 		return;
 
-	int32 SessionCount = 0;
-	int32 GameStateCount = 0;
-
-	// 1. Check Session Count
+	// 1. Session Count
+	RegisteredPlayerCount = 0;
 	if (IOnlineSessionPtr Session = NexusOnline::GetSessionInterface(World))
 	{
 		if (FNamedOnlineSession* NamedSession = Session->GetNamedSession(TrackedSessionName))
 		{
-			SessionCount = NamedSession->RegisteredPlayers.Num();
+			RegisteredPlayerCount = NamedSession->RegisteredPlayers.Num();
 			
 			// Auto-register host fix (unchanged)
-			if (SessionCount == 0 && !World->IsNetMode(NM_Client) && !World->IsNetMode(NM_DedicatedServer))
+			if (RegisteredPlayerCount == 0 && !World->IsNetMode(NM_Client) && !World->IsNetMode(NM_DedicatedServer))
 			{
 				 if (IOnlineIdentityPtr Identity = NexusOnline::GetIdentityInterface(World))
 				 {
 					 if (TSharedPtr<const FUniqueNetId> LocalId = Identity->GetUniquePlayerId(0))
 					 {
-						 UE_LOG(LogTemp, Log, TEXT("[SessionManager] Auto-registering host..."));
+						 UE_LOG(LogNexusOnline, Log, TEXT("[SessionManager] Auto-registering host..."));
 						 TArray<FUniqueNetIdRef> Arr;
 						 Arr.Add(LocalId.ToSharedRef());
 						 Session->RegisterPlayers(TrackedSessionName, Arr, false);
@@ -142,138 +168,238 @@ void AOnlineSessionManager::RefreshPlayerCount()
 		}
 	}
 
-	// 2. Check GameState Count
-	if (World->GetGameState())
+	// 2. Connected Controllers (rebuilt : a missed PostLogin / Logout is corrected here)
+	const int32 TrackedBefore = ConnectedControllers.Num();
+	ConnectedControllers.Reset();
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
 	{
-		GameStateCount = World->GetGameState()->PlayerArray.Num();
+		if (APlayerController* PC = It->Get())
+		{
+			ConnectedControllers.Add(PC);
+		}
 	}
 
-	// 3. Take logic MAX to be safe
-	int32 NewCount = FMath::Max(SessionCount, GameStateCount);
-
-	UE_LOG(LogTemp, Log, TEXT("[SessionManager] Refreshing. Session: %d, GameState: %d -> Final: %d"), SessionCount, GameStateCount, NewCount);
-
-	if (PlayerCount != NewCount)
+	if (TrackedBefore != ConnectedControllers.Num())
 	{
-		PlayerCount = NewCount;
-		OnRep_PlayerCount();
+		UE_LOG(LogNexusOnline, Verbose, TEXT("[SessionManager] Reconcile corrected connected players : %d -> %d."), TrackedBefore, ConnectedControllers.Num());
 	}
-	
+
+	UpdatePlayerCount();
 	UpdateHeir();
 }
 
+void AOnlineSessionManager::UpdatePlayerCount()
+{
+	NEXUS_TRACE_SCOPE(NexusSessionManager_UpdatePlayerCount);
+
+	// Même règle qu'avant : le max des deux sources
+	const int32 NewCount = FMath::Max(RegisteredPlayerCount, ConnectedControllers.Num());
+	if (PlayerCount == NewCount)
+		return;
+
+	UE_LOG(LogNexusOnline, Verbose, TEXT("[SessionManager] Player count %d -> %d (Session: %d, Connected: %d)."),
+		PlayerCount, NewCount, RegisteredPlayerCount, ConnectedControllers.Num());
+
+	PlayerCount = NewCount;
+	MARK_PROPERTY_DIRTY_FROM_NAME(AOnlineSessionManager, PlayerCount, this);
+	OnRep_PlayerCount();
+}
+
+namespace
+{
+    float ScoreHeirCandidate(const FNexusHeirScore& Candidate, const UNexusMigrationConfig& Config)
+    {
+        // Chaque critère est ramené entre 0 et 1 ; une valeur non rapportée compte pour la moyenne.
+        // Bornes à 0 dans la config : divisées par un minimum, pas de score infini / NaN
+        const float MaxRttMs = FMath::Max(Config.MaxHeirRttMs, KINDA_SMALL_NUMBER);
+        const float MaxPacketLoss = FMath::Max(Config.MaxHeirPacketLoss, KINDA_SMALL_NUMBER);
+        const float TargetUploadKbps = FMath::Max(static_cast<float>(Config.TargetUploadKbps), KINDA_SMALL_NUMBER);
+
+        const float RttScore = 1.f - FMath::Clamp(Candidate.RttMs / MaxRttMs, 0.f, 1.f);
+        const float LossScore = 1.f - FMath::Clamp(Candidate.PacketLoss / MaxPacketLoss, 0.f, 1.f);
+        const float UploadScore = Candidate.UploadKbps > 0 ? FMath::Clamp(static_cast<float>(Candidate.UploadKbps) / TargetUploadKbps, 0.f, 1.f) : 0.5f;
+        const float HardwareScore = Candidate.HardwareTier >= 0 ? FMath::Clamp(Candidate.HardwareTier / 3.f, 0.f, 1.f) : 0.5f;
+
+        const float TotalWeight = Config.RttWeight + Config.PacketLossWeight + Config.UploadWeight + Config.HardwareWeight;
+        if (TotalWeight <= 0.f)
+            return 0.f;
+
+        return (RttScore * Config.RttWeight + LossScore * Config.PacketLossWeight
+            + UploadScore * Config.UploadWeight + HardwareScore * Config.HardwareWeight) / TotalWeight;
+    }
+}
+
 void AOnlineSessionManager::UpdateHeir()
 {
-    UE_LOG(LogTemp, Warning, TEXT("[AOnlineSessionManager] UpdateHeir Called."));
+    NEXUS_TRACE_SCOPE(NexusSessionManager_UpdateHeir);
+
     if (!HasAuthority())
         return;
 
-    IOnlineSessionPtr Session = NexusOnline::GetSessionInterface(GetWorld());
-    if (!Session)
+    UWorld* World = GetWorld();
+    const UNexusMigrationConfig* Config = GetDefault<UNexusMigrationConfig>();
+    if (!World || !Config)
         return;
 
-    FNamedOnlineSession* NamedSession = Session->GetNamedSession(TrackedSessionName);
-    if (!NamedSession)
-    {
-        UE_LOG(LogTemp, Warning, TEXT("[AOnlineSessionManager] UpdateHeir: NamedSession not found."));
-        return;
-    }
+    IOnlineSessionPtr Session = NexusOnline::GetSessionInterface(World);
+    const FNamedOnlineSession* NamedSession = Session ? Session->GetNamedSession(TrackedSessionName) : nullptr;
 
     // Get Host ID
     TSharedPtr<const FUniqueNetId> HostId;
-    if (IOnlineIdentityPtr Identity = NexusOnline::GetIdentityInterface(GetWorld()))
+    if (IOnlineIdentityPtr Identity = NexusOnline::GetIdentityInterface(World))
     {
         HostId = Identity->GetUniquePlayerId(0);
     }
 
-    FString BestHeirId;
+    // ---- Candidats : joueurs distants connectés (l'hôte local est exclu)
+    TArray<FNexusHeirScore> Ranking;
+    TArray<FUniqueNetIdRepl> RankingIds;
 
-    // Cache GameState players for O(N) lookup
-    TSet<FString> ActivePlayers;
-    if (AGameStateBase* GS = GetWorld()->GetGameState())
+    for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
     {
-        for (APlayerState* PS : GS->PlayerArray)
+        // Contrôleur en cours de Logout : déjà retiré de ConnectedControllers
+        APlayerController* PC = It->Get();
+        if (!PC || PC->IsLocalController() || !PC->PlayerState || !ConnectedControllers.Contains(PC))
+            continue;
+
+        const FUniqueNetIdRepl& PlayerId = PC->PlayerState->GetUniqueId();
+        if (!PlayerId.IsValid() || (HostId.IsValid() && *PlayerId == *HostId))
+            continue;
+
+        FNexusHeirScore& Entry = Ranking.AddDefaulted_GetRef();
+        RankingIds.Add(PlayerId);
+
+        Entry.PlayerId = PlayerId.ToString();
+        Entry.RttMs = PC->PlayerState->GetPingInMilliseconds();
+        Entry.bRegistered = NamedSession && NamedSession->RegisteredPlayers.ContainsByPredicate(
+            [&PlayerId](const FUniqueNetIdRef& Registered) { return *Registered == *PlayerId; });
+
+        const FReportedCapabilities& Capabilities = GetReportedCapabilities(PC);
+        Entry.UploadKbps = Capabilities.UploadKbps;
+        Entry.HardwareTier = Capabilities.HardwareTier;
+
+        if (UNetConnection* Connection = PC->GetNetConnection())
         {
-            if (PS && PS->GetUniqueId().IsValid())
+            Entry.PacketLoss = Connection->GetInLossPercentage().GetAvgLossPercentage();
+
+            // Adresse vue par l'hôte + port de veille annoncé : cible de la reconnexion directe
+            if (Capabilities.StandbyPort > 0)
             {
-                ActivePlayers.Add(PS->GetUniqueId().ToString());
+                Entry.StandbyAddress = FString::Printf(TEXT("%s:%d"), *Connection->LowLevelGetRemoteAddress(false), Capabilities.StandbyPort);
             }
         }
+
+        Entry.Score = ScoreHeirCandidate(Entry, *Config);
     }
 
-    UE_LOG(LogTemp, Warning, TEXT("[AOnlineSessionManager] Checking %d Registered Players..."), NamedSession->RegisteredPlayers.Num());
+    // ---- Classement : inscrits à la session d'abord, puis par score
+    TArray<int32> Order;
+    Order.Reserve(Ranking.Num());
+    for (int32 Index = 0; Index < Ranking.Num(); ++Index)
+    {
+        Order.Add(Index);
+    }
 
-	for (const FUniqueNetIdRef& PlayerId : NamedSession->RegisteredPlayers)
-	{
-        FString CandidateId = PlayerId->ToString();
-        UE_LOG(LogTemp, Warning, TEXT("  - Candidate: %s"), *CandidateId);
+    Order.StableSort([&Ranking](int32 A, int32 B)
+    {
+        if (Ranking[A].bRegistered != Ranking[B].bRegistered)
+            return Ranking[A].bRegistered;
+
+        return Ranking[A].Score > Ranking[B].Score;
+    });
 
-		// Skip Host
-		if (HostId.IsValid() && *PlayerId == *HostId)
+    // L'héritier en place garde la tête tant que le meilleur ne le dépasse pas de HeirSwitchMargin
+    if (HeirList.Num() > 0 && Order.Num() > 1)
+    {
+        const int32 CurrentPos = Order.IndexOfByPredicate([&](int32 Index) { return RankingIds[Index] == HeirList[0]; });
+        if (CurrentPos > 0)
         {
-            UE_LOG(LogTemp, Warning, TEXT("    -> Is Host. Skipping."));
-			continue;
+            const FNexusHeirScore& Best = Ranking[Order[0]];
+            const FNexusHeirScore& Current = Ranking[Order[CurrentPos]];
+            if (Best.bRegistered == Current.bRegistered && Best.Score < Current.Score + Config->HeirSwitchMargin)
+            {
+                const int32 CurrentIndex = Order[CurrentPos];
+                Order.RemoveAt(CurrentPos);
+                Order.Insert(CurrentIndex, 0);
+            }
         }
+    }
 
-		// Skip invalid
-		if (!PlayerId->IsValid())
-			continue;
-
-        // Cross-reference with GameState to ensure they haven't timed out/disconnected
-        if (ActivePlayers.Contains(CandidateId))
+    TArray<FUniqueNetIdRepl> NewHeirList;
+    TArray<FString> NewHeirAddresses;
+    LastHeirRanking.Reset(Order.Num());
+    for (const int32 Index : Order)
+    {
+        LastHeirRanking.Add(Ranking[Index]);
+        if (NewHeirList.Num() < Config->HeirListSize)
         {
-		    BestHeirId = CandidateId;
-		    UE_LOG(LogTemp, Warning, TEXT("[SessionManager] Heir elected via Session+GameState: %s"), *BestHeirId);
-		    break;
+            NewHeirList.Add(RankingIds[Index]);
+            NewHeirAddresses.Add(Ranking[Index].StandbyAddress);
         }
-	}
+    }
 
-	// Fallback: Check GameState if Session list didn't yield an heir
-	if (BestHeirId.IsEmpty() && GetWorld()->GetGameState())
-	{
-        UE_LOG(LogTemp, Warning, TEXT("[AOnlineSessionManager] Using Fallback GameState Loop..."));
-		for (APlayerState* PS : GetWorld()->GetGameState()->PlayerArray)
-		{
-			if (!PS) continue;
-			
-			// Skip Host (Local Player) using HostId captured earlier
-			if (HostId.IsValid() && PS->GetUniqueId().IsValid() && *PS->GetUniqueId() == *HostId)
-				continue;
+    // ---- Réplication uniquement si l'ordre (ou une adresse) a changé
+    if (NewHeirList == HeirList && NewHeirAddresses == HeirAddresses)
+        return;
 
-			if (PS->GetUniqueId().IsValid())
-			{
-				BestHeirId = PS->GetUniqueId().ToString();
-				UE_LOG(LogTemp, Warning, TEXT("[SessionManager] Heir elected via GameState (Fallback): %s"), *BestHeirId);
-				break;
-			}
-		}
-	}
+    HeirList = MoveTemp(NewHeirList);
+    HeirAddresses = MoveTemp(NewHeirAddresses);
+    MARK_PROPERTY_DIRTY_FROM_NAME(AOnlineSessionManager, HeirList, this);
+    MARK_PROPERTY_DIRTY_FROM_NAME(AOnlineSessionManager, HeirAddresses, this);
 
-    if (NextHostUniqueId != BestHeirId)
+    if (LastHeirRanking.Num() > 0)
     {
-        NextHostUniqueId = BestHeirId;
-        UE_LOG(LogTemp, Warning, TEXT("[AOnlineSessionManager] New Heir Selected: %s"), *NextHostUniqueId);
-        
-        // Cache on Server (for local migration subsystem awareness)
-        if (UGameInstance* GI = GetGameInstance())
-        {
-             if (UNexusMigrationSubsystem* Subsystem = GI->GetSubsystem<UNexusMigrationSubsystem>())
-             {
-                 Subsystem->SetCachedNextHostId(NextHostUniqueId);
-             }
-        }
+        UE_LOG(LogNexusOnline, Log, TEXT("[SessionManager] Heir ranking changed (%d candidate(s)). Best: %s (score %.2f, rtt %.0f ms, loss %.1f%%, up %d kbps, tier %d)."),
+            LastHeirRanking.Num(), *LastHeirRanking[0].PlayerId, LastHeirRanking[0].Score, LastHeirRanking[0].RttMs,
+            LastHeirRanking[0].PacketLoss * 100.f, LastHeirRanking[0].UploadKbps, LastHeirRanking[0].HardwareTier);
+    }
+    else
+    {
+        UE_LOG(LogNexusOnline, Log, TEXT("[SessionManager] No heir candidate left."));
+    }
+
+    // Cache on Server (for local migration subsystem awareness)
+    OnRep_HeirList();
+}
+
+const AOnlineSessionManager::FReportedCapabilities& AOnlineSessionManager::GetReportedCapabilities(APlayerController* PC)
+{
+    if (const FReportedCapabilities* Cached = ReportedCapabilities.Find(PC))
+        return *Cached;
+
+    // Options de l'URL de login (UNexusMigrationSubsystem::GetHeirLoginOptions côté client)
+    FReportedCapabilities Capabilities;
+    if (UNetConnection* Connection = PC->GetNetConnection())
+    {
+        Capabilities.UploadKbps = FMath::Max(0, UGameplayStatics::GetIntOption(Connection->RequestURL, NexusOnline::LOGIN_OPTION_UPLOAD_KBPS, 0));
+        Capabilities.HardwareTier = UGameplayStatics::GetIntOption(Connection->RequestURL, NexusOnline::LOGIN_OPTION_HARDWARE_TIER, -1);
+        Capabilities.StandbyPort = FMath::Clamp(UGameplayStatics::GetIntOption(Connection->RequestURL, NexusOnline::LOGIN_OPTION_STANDBY_PORT, 0), 0, 65535);
     }
-    UE_LOG(LogTemp, Warning, TEXT("[AOnlineSessionManager] UpdateHeir Finished."));
+
+    return ReportedCapabilities.Add(PC, Capabilities);
 }
 
-void AOnlineSessionManager::OnRep_NextHostUniqueId()
+TArray<FString> AOnlineSessionManager::GetHeirList() const
 {
-    // Cache on Client (local)
+    TArray<FString> HeirIds;
+    HeirIds.Reserve(HeirList.Num());
+    for (const FUniqueNetIdRepl& HeirId : HeirList)
+    {
+        HeirIds.Add(HeirId.ToString());
+    }
+    return HeirIds;
+}
+
+void AOnlineSessionManager::OnRep_HeirList()
+{
+    NextHostUniqueId = HeirList.Num() > 0 ? HeirList[0].ToString() : FString();
+
+    // Cache local (client et serveur) : survit à la perte de l'hôte
     if (UGameInstance* GI = GetGameInstance())
     {
          if (UNexusMigrationSubsystem* Subsystem = GI->GetSubsystem<UNexusMigrationSubsystem>())
          {
-             Subsystem->SetCachedNextHostId(NextHostUniqueId);
+             Subsystem->SetCachedHeirList(GetHeirList(), HeirAddresses);
          }
     }
 }
@@ -311,7 +437,14 @@ void AOnlineSessionManager::OnPlayersRegistered(FName SessionName, const TArray<
     if (SessionName != TrackedSessionName)
         return;
     
-    RefreshPlayerCount();
+    if (IOnlineSessionPtr Session = NexusOnline::GetSessionInterface(GetWorld()))
+    {
+        const FNamedOnlineSession* NamedSession = Session->GetNamedSession(TrackedSessionName);
+        RegisteredPlayerCount = NamedSession ? NamedSession->RegisteredPlayers.Num() : 0;
+    }
+
+    UpdatePlayerCount();
+    UpdateHeir();
 
     if (bWasSuccessful)
     {
@@ -328,7 +461,14 @@ void AOnlineSessionManager::OnPlayersUnregistered(FName SessionName, const TArra
     if (SessionName != TrackedSessionName)
         return;
 
-    RefreshPlayerCount();
+    if (IOnlineSessionPtr Session = NexusOnline::GetSessionInterface(GetWorld()))
+    {
+        const FNamedOnlineSession* NamedSession = Session->GetNamedSession(TrackedSessionName);
+        RegisteredPlayerCount = NamedSession ? NamedSession->RegisteredPlayers.Num() : 0;
+    }
+
+    UpdatePlayerCount();
+    UpdateHeir();
 
     if (bWasSuccessful)
     {
@@ -340,6 +480,48 @@ void AOnlineSessionManager::OnPlayersUnregistered(FName SessionName, const TArra
     }
 }
 
+void AOnlineSessionManager::OnGameModePostLogin(AGameModeBase* GameMode, APlayerController* NewPlayer)
+{
+    NEXUS_TRACE_SCOPE(NexusSessionManager_PostLogin);
+
+    if (!GameMode || GameMode->GetWorld() != GetWorld() || !NewPlayer)
+        return;
+
+    ConnectedControllers.Add(NewPlayer);
+    UpdatePlayerCount();
+    UpdateHeir();
+}
+
+void AOnlineSessionManager::OnGameModeLogout(AGameModeBase* GameMode, AController* Exiting)
+{
+    NEXUS_TRACE_SCOPE(NexusSessionManager_Logout);
+
+    if (!GameMode || GameMode->GetWorld() != GetWorld() || !Exiting)
+        return;
+
+    // Les entrées mortes (contrôleurs détruits sans Logout) partent avec
+    ConnectedControllers.Remove(Exiting);
+    for (auto It = ConnectedControllers.CreateIterator(); It; ++It)
+    {
+        if (!It->IsValid())
+        {
+            It.RemoveCurrent();
+        }
+    }
+
+    ReportedCapabilities.Remove(Exiting);
+    for (auto It = ReportedCapabilities.CreateIterator(); It; ++It)
+    {
+        if (!It->Key.IsValid())
+        {
+            It.RemoveCurrent();
+        }
+    }
+
+    UpdatePlayerCount();
+    UpdateHeir();
+}
+
 // ──────────────────────────────────────────────
 // UTILS
 // ──────────────────────────────────────────────
@@ -487,11 +669,18 @@ void AOnlineSessionManager::TryRegisterHost()
 		if (Session->GetSessionState(TrackedSessionName) == EOnlineSessionState::Pending)
 		{
 			Session->StartSession(TrackedSessionName);
-			UE_LOG(LogTemp, Log, TEXT("[SessionManager] Session Started after Host Registration."));
+			UE_LOG(LogNexusOnline, Log, TEXT("[SessionManager] Session Started after Host Registration."));
 		}
 
-		Session->UpdateSession(TrackedSessionName, Named->SessionSettings, true);
-		UE_LOG(LogTemp, Log, TEXT("[SessionManager] Host Registered: %s"), *HostId.ToString());
+		if (UNexusSessionUpdateSubsystem* Updates = UNexusSessionUpdateSubsystem::Get(this))
+		{
+			Updates->RequestSessionUpdate(TrackedSessionName);
+		}
+		else
+		{
+			Session->UpdateSession(TrackedSessionName, Named->SessionSettings, true);
+		}
+		UE_LOG(LogNexusOnline, Log, TEXT("[SessionManager] Host Registered: %s"), *HostId.ToString());
 		
 		GetWorldTimerManager().ClearTimer(TimerHandle_RetryRegister);
 	}
@@ -500,12 +689,12 @@ void AOnlineSessionManager::TryRegisterHost()
 		RegisterHostRetries++;
 		if (RegisterHostRetries < MAX_REGISTER_RETRIES)
 		{
-			UE_LOG(LogTemp, Verbose, TEXT("[SessionManager] Host ID not ready, retrying... (%d/%d)"), RegisterHostRetries, MAX_REGISTER_RETRIES);
+			UE_LOG(LogNexusOnline, Verbose, TEXT("[SessionManager] Host ID not ready, retrying... (%d/%d)"), RegisterHostRetries, MAX_REGISTER_RETRIES);
 			GetWorldTimerManager().SetTimer(TimerHandle_RetryRegister, this, &AOnlineSessionManager::TryRegisterHost, 0.5f, false);
 		}
 		else
 		{
-			UE_LOG(LogTemp, Warning, TEXT("[SessionManager] Failed to register host after %d retries. Session might not be visible correctly."), MAX_REGISTER_RETRIES);
+			UE_LOG(LogNexusOnline, Warning, TEXT("[SessionManager] Failed to register host after %d retries. Session might not be visible correctly."), MAX_REGISTER_RETRIES);
 		}
 	}
 }
@@ -1,15 +1,16 @@
 ﻿#include "NexusFramework.h"
+#include "Utils/NexusTrace.h"
 
 #define LOCTEXT_NAMESPACE "FNexusFrameworkModule"
 
 void FNexusFrameworkModule::StartupModule()
 {
-	UE_LOG(LogTemp, Log, TEXT("[NexusOnlineFramework] Module started"));
+	UE_LOG(LogNexusOnline, Log, TEXT("[NexusOnlineFramework] Module started"));
 }
 
 void FNexusFrameworkModule::ShutdownModule()
 {
-	UE_LOG(LogTemp, Log, TEXT("[NexusOnlineFramework] Module shutdown"));
+	UE_LOG(LogNexusOnline, Log, TEXT("[NexusOnlineFramework] Module shutdown"));
 }
 
 #undef LOCTEXT_NAMESPACE
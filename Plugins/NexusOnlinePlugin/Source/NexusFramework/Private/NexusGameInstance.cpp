@@ -5,13 +5,14 @@
 #include "OnlineSubsystemUtils.h"
 #include "Configs/NexusMigrationConfig.h"
 #include "Kismet/GameplayStatics.h"
+#include "Utils/NexusTrace.h"
 
 
 void UNexusGameInstance::Init()
 {
 	Super::Init();
 
-	UE_LOG(LogTemp, Display, TEXT("[GameInstance] Init called."));
+	UE_LOG(LogNexusOnline, Display, TEXT("[GameInstance] Init called."));
 	GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Green, TEXT("✅ GameInstance initialized"));
 	
 	if (GEngine)
@@ -34,12 +35,12 @@ void UNexusGameInstance::HandleNetworkFailure(UWorld* World, UNetDriver* NetDriv
 	{
 		if (MigSub->ShouldSuppressNetworkFailure(World, NetDriver, FailureType, ErrorString))
 		{
-			UE_LOG(LogTemp, Warning, TEXT("[NexusGameInstance] Suppressing Network Failure Handling due to active Host Migration/Recovery rules. Error: %s"), *ErrorString);
+			UE_LOG(LogNexusMigration, Warning, TEXT("[NexusGameInstance] Suppressing Network Failure Handling due to active Host Migration/Recovery rules. Error: %s"), *ErrorString);
 			return;
 		}
 	}
 	
-	UE_LOG(LogTemp, Error, TEXT("[NexusGameInstance] Network Failure: %s. Returning to MainMenu..."), *ErrorString);
+	UE_LOG(LogNexusOnline, Error, TEXT("[NexusGameInstance] Network Failure: %s. Returning to MainMenu..."), *ErrorString);
 	
 	if (World)
 	{
@@ -65,24 +66,24 @@ void UNexusGameInstance::LogOnlineSubsystemStatus()
 	IOnlineSubsystem* Subsystem = Online::GetSubsystem(GetWorld());
 	if (!Subsystem)
 	{
-		UE_LOG(LogTemp, Error, TEXT("❌ No OnlineSubsystem loaded!"));
+		UE_LOG(LogNexusOnline, Error, TEXT("❌ No OnlineSubsystem loaded!"));
 		GEngine->AddOnScreenDebugMessage(-1, 10.f, FColor::Red, TEXT("❌ No OnlineSubsystem loaded"));
 		return;
 	}
 
 	FString SubsystemName = Subsystem->GetSubsystemName().ToString();
-	UE_LOG(LogTemp, Display, TEXT("✅ OnlineSubsystem: %s"), *SubsystemName);
+	UE_LOG(LogNexusOnline, Display, TEXT("✅ OnlineSubsystem: %s"), *SubsystemName);
 	GEngine->AddOnScreenDebugMessage(-1, 10.f, FColor::Cyan, FString::Printf(TEXT("✅ Subsystem: %s"), *SubsystemName));
 
 	IOnlineSessionPtr SessionInterface = Subsystem->GetSessionInterface();
 	if (!SessionInterface.IsValid())
 	{
-		UE_LOG(LogTemp, Warning, TEXT("⚠️ Session interface is NULL for subsystem %s"), *SubsystemName);
+		UE_LOG(LogNexusOnline, Warning, TEXT("⚠️ Session interface is NULL for subsystem %s"), *SubsystemName);
 		GEngine->AddOnScreenDebugMessage(-1, 10.f, FColor::Yellow, TEXT("⚠️ SessionInterface is null"));
 	}
 	else
 	{
-		UE_LOG(LogTemp, Display, TEXT("✅ Session interface valid for subsystem %s"), *SubsystemName);
+		UE_LOG(LogNexusOnline, Display, TEXT("✅ Session interface valid for subsystem %s"), *SubsystemName);
 		GEngine->AddOnScreenDebugMessage(-1, 10.f, FColor::Green, TEXT("✅ SessionInterface valid"));
 	}
 }
@@ -10,6 +10,7 @@
 #include "Subsystems/NexusBanSubsystem.h"
 #include "Managers/OnlineSessionManager.h"
 #include "Utils/NexusOnlineHelpers.h"
+#include "Utils/NexusTrace.h"
 
 
 ANexusGameMode::ANexusGameMode()
@@ -65,7 +66,10 @@ void ANexusGameMode::PreLogin(const FString& Options, const FString& Address, co
 		{
 			FString BanReason;
 			FDateTime BanExpiration;
-			if (BanSub->IsBanned(UniqueId.ToString(), BanReason, BanExpiration))
+			const bool bBanned = BanSub->IsBanned(UniqueId.ToString(), BanReason, BanExpiration);
+			NexusTrace::RecordBanCheck(bBanned);
+
+			if (bBanned)
 			{
 				if (BanExpiration == FDateTime::MaxValue())
 				{
@@ -76,7 +80,7 @@ void ANexusGameMode::PreLogin(const FString& Options, const FString& Address, co
 					const FTimespan Remaining = BanExpiration - FDateTime::UtcNow();
 					ErrorMessage = FString::Printf(TEXT("TempBan remaining: %d minutes. Reason: %s"), (int32)Remaining.GetTotalMinutes(), *BanReason);
 				}
-				UE_LOG(LogTemp, Warning, TEXT("[NexusGameMode] Rejecting banned player %s: %s"), *UniqueId.ToString(), *ErrorMessage);
+				UE_LOG(LogNexusOnline, Warning, TEXT("[NexusGameMode] Rejecting banned player %s: %s"), *UniqueId.ToString(), *ErrorMessage);
 				return;
 			}
 		}
@@ -96,7 +100,7 @@ void ANexusGameMode::PreLogin(const FString& Options, const FString& Address, co
 	const bool bHasSpace = (NamedSession->NumOpenPublicConnections > 0) || (NamedSession->NumOpenPrivateConnections > 0);
 	if (!bHasSpace)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("[NexusGameMode] Rejecting login: Session Full (%d/%d)."), 
+		UE_LOG(LogNexusOnline, Log, TEXT("[NexusGameMode] Rejecting login: Session Full (%d/%d)."), 
 			(MaxPublic + MaxPrivate) - (NamedSession->NumOpenPublicConnections + NamedSession->NumOpenPrivateConnections),
 			(MaxPublic + MaxPrivate));
 		
@@ -2,6 +2,7 @@
 #include "Subsystems/NexusMigrationSubsystem.h"
 #include "Engine/GameInstance.h"
 #include "Engine/World.h"
+#include "Utils/NexusTrace.h"
 
 void UNexusOnlineSession::HandleDisconnect(UWorld* World, UNetDriver* NetDriver)
 {
@@ -13,7 +14,7 @@ void UNexusOnlineSession::HandleDisconnect(UWorld* World, UNetDriver* NetDriver)
 			{
 				if (MigSub->IsMigrating())
 				{
-					UE_LOG(LogTemp, Log, TEXT("[NexusOnlineSession] Suppressing HandleDisconnect — migration in progress."));
+					UE_LOG(LogNexusMigration, Log, TEXT("[NexusOnlineSession] Suppressing HandleDisconnect — migration in progress."));
 					return;
 				}
 			}
@@ -1,4 +1,5 @@
 #include "Subsystems/NexusBanSubsystem.h"
+#include "Utils/NexusTrace.h"
 #include "Kismet/GameplayStatics.h"
 #include "GameFramework/GameModeBase.h"
 #include "GameFramework/GameSession.h"
@@ -41,6 +42,8 @@ void UNexusBanSubsystem::SaveBanList()
 
 void UNexusBanSubsystem::CleanupExpiredBans()
 {
+	NEXUS_TRACE_SCOPE(NexusBan_CleanupExpired);
+
 	if (!IsValid(CachedBanSave))
 		return;
 
@@ -60,7 +63,7 @@ void UNexusBanSubsystem::CleanupExpiredBans()
 		for (const FString& Id : ExpiredIds)
 		{
 			CachedBanSave->BannedPlayers.Remove(Id);
-			UE_LOG(LogTemp, Log, TEXT("[NexusBanSubsystem] Cleaned up expired ban for player %s."), *Id);
+			UE_LOG(LogNexusOnline, Log, TEXT("[NexusBanSubsystem] Cleaned up expired ban for player %s."), *Id);
 		}
 		SaveBanList();
 	}
@@ -72,6 +75,8 @@ void UNexusBanSubsystem::CleanupExpiredBans()
 
 bool UNexusBanSubsystem::IsBanned(const FString& PlayerId, FString& OutReason, FDateTime& OutExpiration) const
 {
+	NEXUS_TRACE_SCOPE(NexusBan_IsBanned);
+
 	if (!IsValid(CachedBanSave) || PlayerId.IsEmpty())
 		return false;
 
@@ -118,7 +123,7 @@ bool UNexusBanSubsystem::TempBanPlayer(const FString& PlayerId, float DurationHo
 	CachedBanSave->BannedPlayers.Add(PlayerId, NewBan);
 	SaveBanList();
 
-	UE_LOG(LogTemp, Log, TEXT("[NexusBanSubsystem] Banned player %s. Expiration: %s"), *PlayerId, *NewBan.ExpirationTimestamp.ToString());
+	UE_LOG(LogNexusOnline, Log, TEXT("[NexusBanSubsystem] Banned player %s. Expiration: %s"), *PlayerId, *NewBan.ExpirationTimestamp.ToString());
 
 	OnPlayerBanned.Broadcast(PlayerId, NewBan.Reason);
 
@@ -153,7 +158,7 @@ bool UNexusBanSubsystem::KickPlayer(APlayerController* Target, const FText& Reas
 	// For now, let's keep the safety against Listen Server Host.
 	if (Target->IsLocalController())
 	{
-		UE_LOG(LogTemp, Warning, TEXT("[NexusBanSubsystem] Cannot kick Host/LocalPlayer."));
+		UE_LOG(LogNexusOnline, Warning, TEXT("[NexusBanSubsystem] Cannot kick Host/LocalPlayer."));
 		return false;
 	}
 
@@ -170,7 +175,7 @@ bool UNexusBanSubsystem::KickPlayer(APlayerController* Target, const FText& Reas
 		}
 	}
 	
-	UE_LOG(LogTemp, Log, TEXT("[NexusBanSubsystem] Kicked player %s. Reason: %s"), *Target->GetName(), *Reason.ToString());
+	UE_LOG(LogNexusOnline, Log, TEXT("[NexusBanSubsystem] Kicked player %s. Reason: %s"), *Target->GetName(), *Reason.ToString());
 	return true;
 }
 
@@ -182,7 +187,7 @@ bool UNexusBanSubsystem::UnbanPlayer(const FString& PlayerId)
 	if (CachedBanSave->BannedPlayers.Remove(PlayerId) > 0)
 	{
 		SaveBanList();
-		UE_LOG(LogTemp, Log, TEXT("[NexusBanSubsystem] Unbanned player %s."), *PlayerId);
+		UE_LOG(LogNexusOnline, Log, TEXT("[NexusBanSubsystem] Unbanned player %s."), *PlayerId);
 		OnPlayerUnbanned.Broadcast(PlayerId);
 		return true;
 	}
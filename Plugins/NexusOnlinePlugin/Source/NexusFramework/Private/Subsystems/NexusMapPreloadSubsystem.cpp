@@ -0,0 +1,190 @@
+#include "Subsystems/NexusMapPreloadSubsystem.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "Utils/NexusTrace.h"
+
+
+void UNexusMapPreloadSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &UNexusMapPreloadSubsystem::OnPostLoadMap);
+}
+
+void UNexusMapPreloadSubsystem::Deinitialize()
+{
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+
+	ReleasePreload();
+	Flow = FFlowState();
+
+	Super::Deinitialize();
+}
+
+UNexusMapPreloadSubsystem* UNexusMapPreloadSubsystem::Get(const UObject* WorldContextObject)
+{
+	UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	return GameInstance ? GameInstance->GetSubsystem<UNexusMapPreloadSubsystem>() : nullptr;
+}
+
+// ──────────────────────────────────────────────
+// FLOW
+// ──────────────────────────────────────────────
+
+void UNexusMapPreloadSubsystem::BeginFlow(const FString& MapName, bool bPreload)
+{
+	// Un nouveau flux remplace le précédent (ex : deuxième clic sur Join)
+	ReleasePreload();
+
+	Flow = FFlowState();
+	Flow.bActive = true;
+	Flow.MapName = MapName;
+	Flow.CommitTime = FPlatformTime::Seconds();
+
+	if (bPreload)
+	{
+		StartPreload(MapName);
+	}
+}
+
+void UNexusMapPreloadSubsystem::NotifySessionReady()
+{
+	if (Flow.bActive)
+	{
+		Flow.SessionReadyTime = FPlatformTime::Seconds();
+	}
+}
+
+void UNexusMapPreloadSubsystem::CancelFlow()
+{
+	ReleasePreload();
+	Flow = FFlowState();
+}
+
+void UNexusMapPreloadSubsystem::ReleasePreload()
+{
+	// Le chargement en vol se termine quand même ; son callback l'ignorera
+	PreloadRequestId = INDEX_NONE;
+	PreloadedPackage = nullptr;
+}
+
+// ──────────────────────────────────────────────
+// PRELOAD
+// ──────────────────────────────────────────────
+
+void UNexusMapPreloadSubsystem::StartPreload(const FString& MapName)
+{
+	// En PIE, LoadMap cherche un package préfixé (UEDPIE_) : précharger l'original ne servirait à rien
+	const UWorld* World = GetGameInstance() ? GetGameInstance()->GetWorld() : nullptr;
+	if (World && World->IsPlayInEditor())
+	{
+		UE_LOG(LogNexusOnline, Verbose, TEXT("[NexusMapPreload] Play In Editor : preload of '%s' skipped."), *MapName);
+		return;
+	}
+
+	FString PackageName;
+	if (!ResolveMapPackage(MapName, PackageName))
+	{
+		UE_LOG(LogNexusOnline, Warning, TEXT("[NexusMapPreload] Map '%s' not found, no preload."), *MapName);
+		return;
+	}
+
+	Flow.PackageName = PackageName;
+	Flow.PreloadStartTime = FPlatformTime::Seconds();
+
+	PreloadRequestId = LoadPackageAsync(PackageName, FLoadPackageAsyncDelegate::CreateUObject(this, &UNexusMapPreloadSubsystem::OnPreloadCompleted));
+
+	UE_LOG(LogNexusOnline, Log, TEXT("[NexusMapPreload] Preloading '%s'..."), *PackageName);
+}
+
+void UNexusMapPreloadSubsystem::OnPreloadCompleted(const FName& PackageName, UPackage* Package, EAsyncLoadingResult::Type Result)
+{
+	// Flux annulé ou remplacé entre-temps
+	if (PreloadRequestId == INDEX_NONE || !Flow.bActive || PackageName.ToString() != Flow.PackageName)
+		return;
+
+	PreloadRequestId = INDEX_NONE;
+	Flow.PreloadEndTime = FPlatformTime::Seconds();
+
+	if (Result != EAsyncLoadingResult::Succeeded || !Package)
+	{
+		UE_LOG(LogNexusOnline, Warning, TEXT("[NexusMapPreload] Preload of '%s' failed."), *Flow.PackageName);
+		return;
+	}
+
+	PreloadedPackage = Package;
+
+	UE_LOG(LogNexusOnline, Log, TEXT("[NexusMapPreload] '%s' preloaded in %.1f ms."),
+		*Flow.PackageName, (Flow.PreloadEndTime - Flow.PreloadStartTime) * 1000.0);
+}
+
+bool UNexusMapPreloadSubsystem::ResolveMapPackage(const FString& MapName, FString& OutPackageName)
+{
+	// Les options d'URL ("Map?listen") ne font pas partie du nom de package
+	FString Name;
+	if (!MapName.Split(TEXT("?"), &Name, nullptr))
+	{
+		Name = MapName;
+	}
+	Name.TrimStartAndEndInline();
+
+	if (Name.IsEmpty())
+		return false;
+
+	if (FPackageName::IsValidLongPackageName(Name))
+	{
+		OutPackageName = Name;
+		return FPackageName::DoesPackageExist(Name);
+	}
+
+	// Nom court, comme pour OpenLevel
+	return FPackageName::SearchForPackageOnDisk(Name + FPackageName::GetMapPackageExtension(), &OutPackageName);
+}
+
+// ──────────────────────────────────────────────
+// METRICS
+// ──────────────────────────────────────────────
+
+void UNexusMapPreloadSubsystem::OnPostLoadMap(UWorld* LoadedWorld)
+{
+	// Chargement de map sans lien avec un flux (retour au menu, ou Join sans AutoTravel avant le voyage)
+	if (!Flow.bActive || Flow.SessionReadyTime <= 0.0)
+		return;
+
+	const double Now = FPlatformTime::Seconds();
+	const bool bPreloadStarted = Flow.PreloadStartTime > 0.0;
+	const bool bPreloadFinished = Flow.PreloadEndTime > 0.0;
+
+	FNexusTravelMetrics Metrics;
+	Metrics.MapName = Flow.MapName;
+	Metrics.bPreloaded = bPreloadStarted;
+	Metrics.SessionMs = static_cast<float>((Flow.SessionReadyTime - Flow.CommitTime) * 1000.0);
+	Metrics.TravelMs = static_cast<float>((Now - Flow.SessionReadyTime) * 1000.0);
+	Metrics.TimeToInGameMs = static_cast<float>((Now - Flow.CommitTime) * 1000.0);
+
+	if (bPreloadFinished)
+	{
+		Metrics.PreloadMs = static_cast<float>((Flow.PreloadEndTime - Flow.PreloadStartTime) * 1000.0);
+	}
+
+	if (bPreloadStarted)
+	{
+		// Seule la partie du chargement faite avant le début du voyage est gagnée
+		const double OverlapEnd = bPreloadFinished ? FMath::Min(Flow.PreloadEndTime, Flow.SessionReadyTime) : Flow.SessionReadyTime;
+		Metrics.OverlapMs = static_cast<float>(FMath::Max(OverlapEnd - Flow.PreloadStartTime, 0.0) * 1000.0);
+	}
+
+	UE_LOG(LogNexusOnline, Log, TEXT("[NexusMapPreload] '%s' in game after %.1f ms (session %.1f ms, travel %.1f ms, preload %s, overlap %.1f ms)."),
+		*Metrics.MapName, Metrics.TimeToInGameMs, Metrics.SessionMs, Metrics.TravelMs,
+		Metrics.bPreloaded ? TEXT("yes") : TEXT("no"), Metrics.OverlapMs);
+
+	LastMetrics = Metrics;
+	ReleasePreload();
+	Flow = FFlowState();
+
+	OnTravelMetrics.Broadcast(Metrics);
+}
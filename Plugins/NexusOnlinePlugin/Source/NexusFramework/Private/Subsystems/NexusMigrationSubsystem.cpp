@@ -5,9 +5,18 @@
 #include "Async/AsyncTask_FindSessions.h"
 #include "Async/AsyncTask_JoinSession.h"
 #include "Utils/NexusOnlineHelpers.h"
+#include "Utils/NexusTrace.h"
 #include "Interfaces/OnlineIdentityInterface.h"
 #include "Kismet/GameplayStatics.h"
 #include "Configs/NexusMigrationConfig.h"
+#include "Configs/NexusSessionSearchConfig.h"
+#include "Subsystems/NexusPingProberSubsystem.h"
+#include "Subsystems/NexusSessionOperationSubsystem.h"
+#include "Subsystems/NexusSnapshotSubsystem.h"
+#include "TimerManager.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+#include "IPAddress.h"
 
 
 void UNexusMigrationSubsystem::Initialize(FSubsystemCollectionBase& Collection)
@@ -32,23 +41,48 @@ void UNexusMigrationSubsystem::Deinitialize()
 	}
     
 	FCoreUObjectDelegates::PostLoadMapWithWorld.RemoveAll(this);
+
+	LeaveStandby();
 	
 	Super::Deinitialize();
 }
 
 void UNexusMigrationSubsystem::OnMapLoadComplete(UWorld* World)
 {
+	// Reconnexion directe (ou join après recherche) aboutie : le client est chez le nouvel hôte
+	if (RecoveryStartTime > 0.0 && !PendingMetrics.bAsHost && World && World->GetNetMode() == NM_Client)
+	{
+		if (bDirectReconnecting)
+		{
+			UE_LOG(LogNexusMigration, Log, TEXT("[NexusMigration] Direct reconnect to %s succeeded (attempt %d)."), *CachedNextHostAddress, DirectReconnectAttempts);
+			bDirectReconnecting = false;
+			bDirectReconnectInFlight = false;
+			bIsMigrating = false;
+			World->GetTimerManager().ClearTimer(TimerHandle_DirectReconnect);
+
+			// Connecté sans session locale (détruite au départ) : rejoint celle du nouvel hôte, sans voyage
+			ReconnectedSessionSearches = 0;
+			ReconnectedSessionGeneration = MigrationGeneration;
+			JoinReconnectedSession();
+		}
+
+		NexusTrace::MigrationPhase(TEXT("Client : in game"), MigrationGeneration);
+		PendingMetrics.MapLoadedMs = GetRecoveryElapsedMs();
+		CompleteMigrationMetrics();
+		return;
+	}
+
 	if (bRecoveringHost)
 	{
-		UE_LOG(LogTemp, Log, TEXT("[NexusMigration] Map Loaded. Finishing Host Recovery (Creating Session)..."));
+		UE_LOG(LogNexusMigration, Log, TEXT("[NexusMigration] Map Loaded. Finishing Host Recovery (Creating Session)..."));
 		
 		if (World->GetNetDriver())
 		{
-			UE_LOG(LogTemp, Log, TEXT("[NexusMigration] NetDriver found. Creating Session..."));
+			UE_LOG(LogNexusMigration, Log, TEXT("[NexusMigration] NetDriver found. Creating Session..."));
 		}
-		else
+		else if (!bHotStandbyRecovery) // Hot standby : l'écoute démarre dans FinishHostRecovery
 		{
-			UE_LOG(LogTemp, Warning, TEXT("[NexusMigration] NetDriver NOT found immediately after load."));
+			UE_LOG(LogNexusMigration, Warning, TEXT("[NexusMigration] NetDriver NOT found immediately after load."));
 		}
 
 		FinishHostRecovery(World);
@@ -66,22 +100,108 @@ void UNexusMigrationSubsystem::CacheSessionSettings(const FSessionSettingsData&
 	bIntentionalLeave = false;
 	MigrationGeneration = 0;
 	CachedNextHostId.Empty();
+	CachedNextHostAddress.Empty();
+	CachedHeirList.Empty();
+	LeaveStandby();
+
+	// Snapshot d'une partie précédente : inutilisable dans cette session
+	if (UNexusSnapshotSubsystem* Snapshots = GetGameInstance()->GetSubsystem<UNexusSnapshotSubsystem>())
+	{
+		Snapshots->ClearHeldSnapshot();
+	}
 	
-	UE_LOG(LogTemp, Log, TEXT("[NexusMigration] Session cached. MigrationID: %s"), *CachedSessionSettings.MigrationSessionID);
+	UE_LOG(LogNexusMigration, Log, TEXT("[NexusMigration] Session cached. MigrationID: %s"), *CachedSessionSettings.MigrationSessionID);
+}
+
+void UNexusMigrationSubsystem::SetCachedHeirList(const TArray<FString>& HeirIds, const TArray<FString>& HeirAddresses)
+{
+	CachedHeirList = HeirIds;
+	CachedNextHostId = HeirIds.Num() > 0 ? HeirIds[0] : FString();
+	CachedNextHostAddress = HeirAddresses.Num() > 0 ? HeirAddresses[0] : FString();
+
+	UpdateStandby();
+}
+
+int32 UNexusMigrationSubsystem::GetLocalHardwareTier()
+{
+	const int32 Cores = FPlatformMisc::NumberOfCoresIncludingHyperthreads();
+	const uint32 MemoryGB = FPlatformMemory::GetPhysicalGBRam();
+
+	// Le plus faible des deux critères fixe le palier
+	const int32 CoreTier = Cores >= 16 ? 3 : Cores >= 8 ? 2 : Cores >= 4 ? 1 : 0;
+	const int32 MemoryTier = MemoryGB >= 32 ? 3 : MemoryGB >= 16 ? 2 : MemoryGB >= 8 ? 1 : 0;
+	return FMath::Min(CoreTier, MemoryTier);
+}
+
+FString UNexusMigrationSubsystem::GetHeirLoginOptions() const
+{
+	FString Options = FString::Printf(TEXT("?%s=%d?%s=%d"),
+		*NexusOnline::LOGIN_OPTION_UPLOAD_KBPS, LocalUploadKbps,
+		*NexusOnline::LOGIN_OPTION_HARDWARE_TIER, GetLocalHardwareTier());
+
+	// Port de veille : l'hôte en déduit l'adresse de reconnexion directe si ce client devient héritier
+	const UNexusMigrationConfig* Config = GetDefault<UNexusMigrationConfig>();
+	if (Config && Config->bEnableHotStandby)
+	{
+		Options += FString::Printf(TEXT("?%s=%d"), *NexusOnline::LOGIN_OPTION_STANDBY_PORT, GetStandbyPort());
+	}
+
+	return Options;
+}
+
+int32 UNexusMigrationSubsystem::GetStandbyPort()
+{
+	const UNexusMigrationConfig* Config = GetDefault<UNexusMigrationConfig>();
+	return (Config && Config->StandbyListenPort > 0) ? Config->StandbyListenPort : FURL::UrlConfig.DefaultPort;
 }
 
 FString UNexusMigrationSubsystem::GetEffectiveMigrationId() const
 {
-	if (MigrationGeneration == 0)
+	return GetMigrationIdForGeneration(MigrationGeneration);
+}
+
+FString UNexusMigrationSubsystem::GetMigrationIdForGeneration(int32 Generation) const
+{
+	if (Generation == 0)
 	{
 		return CachedSessionSettings.MigrationSessionID;
 	}
 	
-	return FString::Printf(TEXT("%s_%d"), *CachedSessionSettings.MigrationSessionID, MigrationGeneration);
+	return FString::Printf(TEXT("%s_%d"), *CachedSessionSettings.MigrationSessionID, Generation);
+}
+
+FString UNexusMigrationSubsystem::GetLocalPlayerId() const
+{
+	if (IOnlineIdentityPtr Identity = NexusOnline::GetIdentityInterface(GetWorld()))
+	{
+		if (TSharedPtr<const FUniqueNetId> LocalId = Identity->GetUniquePlayerId(0))
+		{
+			return LocalId->ToString();
+		}
+	}
+
+	return FString();
+}
+
+UAsyncTask_CreateSession* UNexusMigrationSubsystem::MakeRecoveryCreateTask(UObject* WorldContext, const FString& EffectiveId)
+{
+	FSessionSearchFilter MigrationFilter;
+	MigrationFilter.Key = FName("MIGRATION_ID_KEY");
+	MigrationFilter.Value.Type = ENexusSessionFilterValueType::String;
+	MigrationFilter.Value.StringValue = EffectiveId;
+
+	TArray<FSessionSearchFilter> ExtraSettings;
+	ExtraSettings.Add(MigrationFilter);
+
+	return UAsyncTask_CreateSession::CreateSession(WorldContext, CachedSessionSettings, ExtraSettings, false, nullptr);
 }
 
 bool UNexusMigrationSubsystem::ShouldSuppressNetworkFailure(UWorld* World, UNetDriver* NetDriver, ENetworkFailure::Type FailureType, const FString& ErrorString)
 {
+	// Échec d'une tentative de reconnexion directe : la suivante est planifiée
+	if (bDirectReconnecting)
+		return HandleNetworkFailureMigration(World, NetDriver, FailureType, ErrorString);
+
 	if (bIsMigrating)
 		return true;
 
@@ -101,10 +221,19 @@ void UNexusMigrationSubsystem::OnNetworkFailure(UWorld* World, UNetDriver* NetDr
 
 void UNexusMigrationSubsystem::OnTravelFailure(UWorld* World, ETravelFailure::Type FailureType, const FString& ErrorString)
 {
+	// L'héritier n'écoute pas encore : la tentative suivante (ou la recherche) prend le relais
+	if (bDirectReconnecting)
+	{
+		OnDirectReconnectFailed(ErrorString);
+		return;
+	}
+
 	if (bIsMigrating)
 	{
-		UE_LOG(LogTemp, Error, TEXT("[NexusMigration] Travel Failure during Migration: %s. Aborting Migration to prevent infinite loop."), *ErrorString);
+		UE_LOG(LogNexusMigration, Error, TEXT("[NexusMigration] Travel Failure during Migration: %s. Aborting Migration to prevent infinite loop."), *ErrorString);
+		NexusTrace::MigrationPhase(TEXT("Aborted (travel failure)"), MigrationGeneration);
 		bIsMigrating = false;
+		RecoveryStartTime = 0.0;
 		
 		LastMigrationFailureTime = FPlatformTime::Seconds();
 
@@ -121,6 +250,16 @@ void UNexusMigrationSubsystem::OnTravelFailure(UWorld* World, ETravelFailure::Ty
 
 bool UNexusMigrationSubsystem::HandleNetworkFailureMigration(UWorld* World, UNetDriver* NetDriver, ENetworkFailure::Type FailureType, const FString& ErrorString)
 {
+	if (bDirectReconnecting)
+	{
+		// Seul le NetDriver de la tentative compte : celui de l'ancien hôte peut encore signaler sa perte
+		if (NetDriver && NetDriver->NetDriverName == NAME_PendingNetDriver)
+		{
+			OnDirectReconnectFailed(ErrorString);
+		}
+		return true;
+	}
+
 	if (bIsMigrating)
 		return true;
 
@@ -143,12 +282,12 @@ bool UNexusMigrationSubsystem::HandleNetworkFailureMigration(UWorld* World, UNet
 	{
 		if (World && World->GetNetMode() == NM_Client)
 		{
-			UE_LOG(LogTemp, Warning, TEXT("[NexusMigration] Network Failure detected. Attempting Migration..."));
+			UE_LOG(LogNexusMigration, Warning, TEXT("[NexusMigration] Network Failure detected. Attempting Migration..."));
 			
 			const double CurrentTime = FPlatformTime::Seconds();
 			if ((CurrentTime - LastMigrationFailureTime) < 5.0)
 			{
-				UE_LOG(LogTemp, Warning, TEXT("[NexusMigration] Suppressing Migration Request due to recent failure (%.1f seconds ago)."), (CurrentTime - LastMigrationFailureTime));
+				UE_LOG(LogNexusMigration, Warning, TEXT("[NexusMigration] Suppressing Migration Request due to recent failure (%.1f seconds ago)."), (CurrentTime - LastMigrationFailureTime));
 				return false;
 			}
 
@@ -163,39 +302,178 @@ bool UNexusMigrationSubsystem::HandleNetworkFailureMigration(UWorld* World, UNet
 
 void UNexusMigrationSubsystem::HandleSessionRecovery()
 {
+	NEXUS_TRACE_SCOPE(NexusMigration_HandleSessionRecovery);
+
 	bIntentionalLeave = false;
 	
 	MigrationGeneration++;
-	UE_LOG(LogTemp, Log, TEXT("[NexusMigration] Migration generation: %d. Effective ID: %s"), MigrationGeneration, *GetEffectiveMigrationId());
+	NexusTrace::MigrationPhase(TEXT("Recovery started"), MigrationGeneration);
+	UE_LOG(LogNexusMigration, Log, TEXT("[NexusMigration] Migration generation: %d. Effective ID: %s"), MigrationGeneration, *GetEffectiveMigrationId());
 
 	if (CachedNextHostId.IsEmpty())
 	{
-		UE_LOG(LogTemp, Warning, TEXT("[NexusMigration] No Heir elected. Returning to menu."));
+		UE_LOG(LogNexusMigration, Warning, TEXT("[NexusMigration] No Heir elected. Returning to menu."));
 		bIsMigrating = false;
+		LeaveStandby();
 		return;
 	}
 
-	FString MyId;
-	if (IOnlineIdentityPtr Identity = NexusOnline::GetIdentityInterface(GetWorld()))
+	const FString MyId = GetLocalPlayerId();
+	const UNexusMigrationConfig* Config = GetDefault<UNexusMigrationConfig>();
+	const bool bHotStandby = Config && Config->bEnableHotStandby;
+
+	UE_LOG(LogNexusMigration, Log, TEXT("[NexusMigration] HandleSessionRecovery: MyID='%s', CachedNextHostID='%s'"), *MyId, *CachedNextHostId);
+
+	// Chrono de bout en bout : détection de la panne -> retour en jeu
+	RecoveryStartTime = FPlatformTime::Seconds();
+	PendingMetrics = FNexusMigrationMetrics();
+	PendingMetrics.Generation = MigrationGeneration;
+	PendingMetrics.bAsHost = (MyId == CachedNextHostId);
+
+	if (PendingMetrics.bAsHost)
 	{
-		if (TSharedPtr<const FUniqueNetId> LocalId = Identity->GetUniquePlayerId(0))
+		UE_LOG(LogNexusMigration, Log, TEXT("[NexusMigration] I AM THE NEW HOST! Starting recovery..."));
+		PendingMetrics.bHotStandby = bInStandby;
+		StartHostRecovery();
+	}
+	else if (bHotStandby && !CachedNextHostAddress.IsEmpty())
+	{
+		UE_LOG(LogNexusMigration, Log, TEXT("[NexusMigration] Reconnecting directly to new host (%s at %s)..."), *CachedNextHostId, *CachedNextHostAddress);
+		PendingMetrics.bHotStandby = true;
+		StartDirectReconnect();
+	}
+	else
+	{
+		UE_LOG(LogNexusMigration, Log, TEXT("[NexusMigration] Waiting for new host (%s)..."), *CachedNextHostId);
+		StartClientRecovery();
+	}
+}
+
+// ──────────────────────────────────────────────
+// HOT STANDBY
+// ──────────────────────────────────────────────
+void UNexusMigrationSubsystem::UpdateStandby()
+{
+	// Pendant une migration, la veille est consommée par StartHostRecovery
+	if (bIsMigrating)
+		return;
+
+	const UNexusMigrationConfig* Config = GetDefault<UNexusMigrationConfig>();
+	const UWorld* World = GetWorld();
+
+	const bool bShouldStandby = Config && Config->bEnableMigration && Config->bEnableHotStandby
+		&& CachedSessionSettings.bAllowHostMigration
+		&& World && World->GetNetMode() == NM_Client
+		&& !CachedNextHostId.IsEmpty() && CachedNextHostId == GetLocalPlayerId();
+
+	if (bShouldStandby)
+	{
+		EnterStandby();
+	}
+	else
+	{
+		LeaveStandby();
+	}
+}
+
+void UNexusMigrationSubsystem::EnterStandby()
+{
+	NEXUS_TRACE_SCOPE(NexusMigration_EnterStandby);
+
+	// Génération suivante : celle que les clients chercheront si l'hôte tombe
+	const FString NextId = GetMigrationIdForGeneration(MigrationGeneration + 1);
+	if (bInStandby && StandbyMigrationId == NextId)
+		return;
+
+	if (!bInStandby)
+	{
+		// Réserve le port d'écoute jusqu'à la bascule ; il ne répond aux sondes de ping que si le répondeur est activé
+		const UNexusSessionSearchConfig* SearchConfig = GetDefault<UNexusSessionSearchConfig>();
+		UNexusPingProberSubsystem* Prober = GetGameInstance()->GetSubsystem<UNexusPingProberSubsystem>();
+		bool bReserved = false;
+
+		if (SearchConfig && SearchConfig->bEnableEchoResponder && Prober)
+		{
+			bStandbyOwnsEcho = !Prober->IsEchoResponderRunning() && Prober->StartEchoResponder(GetStandbyPort());
+			bReserved = bStandbyOwnsEcho || Prober->GetEchoResponderPort() == GetStandbyPort();
+		}
+		else
 		{
-			MyId = LocalId->ToString();
+			bReserved = ReserveStandbyPort();
 		}
+
+		if (!bReserved)
+		{
+			UE_LOG(LogNexusMigration, Warning, TEXT("[NexusMigration] Standby port %d unavailable : failover listen may fail."), GetStandbyPort());
+		}
+	}
+
+	StandbyMigrationId = NextId;
+	StandbyCreateTask = MakeRecoveryCreateTask(GetGameInstance(), StandbyMigrationId);
+	bInStandby = true;
+
+	UE_LOG(LogNexusMigration, Log, TEXT("[NexusMigration] Hot standby : next host. Port %d reserved, session prepared (MigrationID %s)."), GetStandbyPort(), *StandbyMigrationId);
+}
+
+bool UNexusMigrationSubsystem::ReserveStandbyPort()
+{
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+	if (!SocketSubsystem || StandbyPortSocket)
+		return StandbyPortSocket != nullptr;
+
+	// Socket lié mais jamais lu : il n'occupe que le port
+	StandbyPortSocket = SocketSubsystem->CreateSocket(NAME_DGram, TEXT("NexusStandbyPort"), FNetworkProtocolTypes::IPv4);
+	if (!StandbyPortSocket)
+		return false;
+
+	TSharedRef<FInternetAddr> LocalAddr = SocketSubsystem->CreateInternetAddr(FNetworkProtocolTypes::IPv4);
+	LocalAddr->SetAnyAddress();
+	LocalAddr->SetPort(GetStandbyPort());
+
+	if (!StandbyPortSocket->Bind(*LocalAddr))
+	{
+		SocketSubsystem->DestroySocket(StandbyPortSocket);
+		StandbyPortSocket = nullptr;
+		return false;
 	}
 
-	UE_LOG(LogTemp, Log, TEXT("[NexusMigration] HandleSessionRecovery: MyID='%s', CachedNextHostID='%s'"), *MyId, *CachedNextHostId);
+	return true;
+}
 
-	if (MyId == CachedNextHostId)
+void UNexusMigrationSubsystem::ReleaseStandbyPort()
+{
+	if (!StandbyPortSocket)
+		return;
+
+	StandbyPortSocket->Close();
+	if (ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM))
 	{
-		UE_LOG(LogTemp, Log, TEXT("[NexusMigration] I AM THE NEW HOST! Starting recovery..."));
-		StartHostRecovery();
+		SocketSubsystem->DestroySocket(StandbyPortSocket);
 	}
-	else
+	StandbyPortSocket = nullptr;
+}
+
+void UNexusMigrationSubsystem::LeaveStandby()
+{
+	if (!bInStandby)
+		return;
+
+	if (bStandbyOwnsEcho)
 	{
-		UE_LOG(LogTemp, Log, TEXT("[NexusMigration] Waiting for new host (%s)..."), *CachedNextHostId);
-		StartClientRecovery();
+		if (UNexusPingProberSubsystem* Prober = GetGameInstance()->GetSubsystem<UNexusPingProberSubsystem>())
+		{
+			Prober->StopEchoResponder();
+		}
+		bStandbyOwnsEcho = false;
 	}
+
+	ReleaseStandbyPort();
+
+	StandbyCreateTask = nullptr;
+	StandbyMigrationId.Empty();
+	bInStandby = false;
+
+	UE_LOG(LogNexusMigration, Log, TEXT("[NexusMigration] Hot standby released."));
 }
 
 // ──────────────────────────────────────────────
@@ -203,18 +481,39 @@ void UNexusMigrationSubsystem::HandleSessionRecovery()
 // ──────────────────────────────────────────────
 void UNexusMigrationSubsystem::StartHostRecovery()
 {
-	IOnlineSessionPtr SessionInt = NexusOnline::GetSessionInterface(GetWorld());
-	if (SessionInt.IsValid())
+	NEXUS_TRACE_SCOPE(NexusMigration_StartHostRecovery);
+	NexusTrace::MigrationPhase(TEXT("Host : reopening map"), MigrationGeneration);
+
+	bHostSessionReady = false;
+	bHostMapReady = false;
+	bHotStandbyRecovery = bInStandby;
+
+	if (bHotStandbyRecovery)
 	{
-		SessionInt->DestroySession(NexusOnline::SessionTypeToName(CachedSessionSettings.SessionType));
+		// Session préparée en veille (reconstruite si la génération a changé depuis)
+		const FString EffectiveId = GetEffectiveMigrationId();
+		CurrentCreateTask = (StandbyMigrationId == EffectiveId) ? StandbyCreateTask : MakeRecoveryCreateTask(GetGameInstance(), EffectiveId);
+
+		// Libère le port réservé : le NetDriver l'ouvrira une fois la map chargée
+		LeaveStandby();
+
+		// Activée par FinishHostRecovery une fois l'écoute ouverte : l'OSS annonce le port réellement lié
+		UE_LOG(LogNexusMigration, Log, TEXT("[NexusMigration] StartHostRecovery (hot standby). Session %s prepared, reopening '%s'."), *EffectiveId, *CachedSessionSettings.MapName);
+
+		if (CurrentCreateTask)
+		{
+			CurrentCreateTask->OnSuccess.AddDynamic(this, &UNexusMigrationSubsystem::OnRecoveryCreateSuccess);
+			CurrentCreateTask->OnFailure.AddDynamic(this, &UNexusMigrationSubsystem::OnStandbyCreateFailure);
+		}
+
+		bRecoveringHost = true;
+		UGameplayStatics::OpenLevel(GetWorld(), FName(*CachedSessionSettings.MapName), true);
+		return;
 	}
 
+	// L'ancienne session (rejointe en client) est détruite par la file d'opérations : la création qui suit la remplace (bReplaceExisting)
 	const FString URL = FString::Printf(TEXT("%s?listen"), *CachedSessionSettings.MapName);
-	UE_LOG(LogTemp, Log, TEXT("[NexusMigration] StartHostRecovery. Traveling to Listen Server first: '%s'"), *URL);
-
-	UGameplayStatics::OpenLevel(GetWorld(), FName(*CachedSessionSettings.MapName), true, "listen");
-	
-	bRecoveringHost = true;
+	UE_LOG(LogNexusMigration, Log, TEXT("[NexusMigration] StartHostRecovery. Traveling to Listen Server first: '%s'"), *URL);
 
 	bRecoveringHost = true;
 	UGameplayStatics::OpenLevel(GetWorld(), FName(*CachedSessionSettings.MapName), true, "listen");
@@ -222,21 +521,60 @@ void UNexusMigrationSubsystem::StartHostRecovery()
 
 void UNexusMigrationSubsystem::FinishHostRecovery(UWorld* World)
 {
+	NEXUS_TRACE_SCOPE(NexusMigration_FinishHostRecovery);
+
 	bRecoveringHost = false;
+	bHostMapReady = true;
+	PendingMetrics.MapLoadedMs = GetRecoveryElapsedMs();
 
-	FString EffectiveId = GetEffectiveMigrationId();
+	// État de jeu reçu de l'ancien hôte, réappliqué avant que les clients puissent revenir
+	if (UNexusSnapshotSubsystem* Snapshots = GetGameInstance()->GetSubsystem<UNexusSnapshotSubsystem>())
+	{
+		if (Snapshots->GetHeldSequence() != INDEX_NONE)
+		{
+			PendingMetrics.RestoredObjects = Snapshots->RestoreLatestSnapshot(World);
+			NexusTrace::MigrationPhase(TEXT("Host : state restored"), MigrationGeneration);
+		}
+		else
+		{
+			UE_LOG(LogNexusMigration, Log, TEXT("[NexusMigration] No game state snapshot received from the previous host."));
+		}
+	}
 
-	FSessionSearchFilter MigrationFilter;
-	MigrationFilter.Key = FName("MIGRATION_ID_KEY");
-	MigrationFilter.Value.Type = ENexusSessionFilterValueType::String;
-	MigrationFilter.Value.StringValue = EffectiveId;
+	if (bHotStandbyRecovery)
+	{
+		// Écoute sur le port annoncé aux clients : ils s'y reconnectent sans recherche
+		NexusTrace::MigrationPhase(TEXT("Host : listening"), MigrationGeneration);
+		if (!GetGameInstance()->EnableListenServer(true, GetStandbyPort()))
+		{
+			UE_LOG(LogNexusMigration, Error, TEXT("[NexusMigration] Could not listen on standby port %d. Clients will fall back to the session search."), GetStandbyPort());
 
-	TArray<FSessionSearchFilter> ExtraSettings;
-	ExtraSettings.Add(MigrationFilter);
+			// Port par défaut : la session annoncée ci-dessous pointe vers celui-ci
+			if (!GetGameInstance()->EnableListenServer(true))
+			{
+				UE_LOG(LogNexusMigration, Error, TEXT("[NexusMigration] Could not listen on the default port either."));
+			}
+		}
+
+		// Création après l'ouverture de l'écoute (destruction de l'ancienne session comprise)
+		NexusTrace::MigrationPhase(TEXT("Host : creating session"), MigrationGeneration);
+		if (CurrentCreateTask)
+		{
+			CurrentCreateTask->Activate();
+		}
+		else
+		{
+			OnStandbyCreateFailure();
+		}
+		return;
+	}
 
-	UE_LOG(LogTemp, Log, TEXT("[NexusMigration] Creating Re-Hosted Session. EffectiveID: %s"), *EffectiveId);
+	NexusTrace::MigrationPhase(TEXT("Host : creating session"), MigrationGeneration);
+
+	FString EffectiveId = GetEffectiveMigrationId();
+	UE_LOG(LogNexusMigration, Log, TEXT("[NexusMigration] Creating Re-Hosted Session. EffectiveID: %s"), *EffectiveId);
 
-	CurrentCreateTask = UAsyncTask_CreateSession::CreateSession(World, CachedSessionSettings, ExtraSettings, false, nullptr);
+	CurrentCreateTask = MakeRecoveryCreateTask(World, EffectiveId);
 
 	if (CurrentCreateTask)
 	{
@@ -247,17 +585,172 @@ void UNexusMigrationSubsystem::FinishHostRecovery(UWorld* World)
 
 void UNexusMigrationSubsystem::OnRecoveryCreateSuccess()
 {
-	UE_LOG(LogTemp, Log, TEXT("[NexusMigration] Host Recovery Successful. Session recreated."));
-	bIsMigrating = false;
+	UE_LOG(LogNexusMigration, Log, TEXT("[NexusMigration] Session recreated."));
+	CurrentCreateTask = nullptr;
+	bHostSessionReady = true;
+	PendingMetrics.SessionReadyMs = GetRecoveryElapsedMs();
+
+	TryCompleteHostRecovery();
+}
+
+void UNexusMigrationSubsystem::OnStandbyCreateFailure()
+{
+	UE_LOG(LogNexusMigration, Warning, TEXT("[NexusMigration] Prepared session could not be created. Retrying with a fresh one."));
 	CurrentCreateTask = nullptr;
+
+	// Repli sur le chemin classique : création depuis FinishHostRecovery
+	bHotStandbyRecovery = false;
+	if (bHostMapReady)
+	{
+		CurrentCreateTask = MakeRecoveryCreateTask(GetGameInstance(), GetEffectiveMigrationId());
+		if (CurrentCreateTask)
+		{
+			CurrentCreateTask->OnSuccess.AddDynamic(this, &UNexusMigrationSubsystem::OnRecoveryCreateSuccess);
+			CurrentCreateTask->Activate();
+		}
+	}
+}
+
+void UNexusMigrationSubsystem::TryCompleteHostRecovery()
+{
+	// Session et map prêtes, dans n'importe quel ordre
+	if (!bHostSessionReady || !bHostMapReady)
+		return;
+
+	UE_LOG(LogNexusMigration, Log, TEXT("[NexusMigration] Host Recovery Successful. Session recreated."));
+	NexusTrace::MigrationPhase(TEXT("Host : recovered"), MigrationGeneration);
+	bIsMigrating = false;
+	bHotStandbyRecovery = false;
+
+	CompleteMigrationMetrics();
+}
+
+// ──────────────────────────────────────────────
+// METRICS
+// ──────────────────────────────────────────────
+float UNexusMigrationSubsystem::GetRecoveryElapsedMs() const
+{
+	return RecoveryStartTime > 0.0 ? static_cast<float>((FPlatformTime::Seconds() - RecoveryStartTime) * 1000.0) : 0.f;
+}
+
+void UNexusMigrationSubsystem::CompleteMigrationMetrics()
+{
+	if (RecoveryStartTime <= 0.0)
+		return;
+
+	PendingMetrics.TotalMs = GetRecoveryElapsedMs();
+	RecoveryStartTime = 0.0;
+	LastMigrationMetrics = PendingMetrics;
+
+	UE_LOG(LogNexusMigration, Log, TEXT("[NexusMigration] Migration #%d recovered in %.0f ms (%s, %s) : session %.0f ms, map %.0f ms, direct attempts %d, restored objects %d."),
+		LastMigrationMetrics.Generation, LastMigrationMetrics.TotalMs,
+		LastMigrationMetrics.bAsHost ? TEXT("host") : TEXT("client"),
+		LastMigrationMetrics.bHotStandby ? TEXT("hot standby") : TEXT("search"),
+		LastMigrationMetrics.SessionReadyMs, LastMigrationMetrics.MapLoadedMs, LastMigrationMetrics.DirectAttempts,
+		LastMigrationMetrics.RestoredObjects);
+
+	NexusTrace::RecordMigrationRecovery(LastMigrationMetrics.TotalMs);
+	OnMigrationCompleted.Broadcast(LastMigrationMetrics);
 }
 
 // ──────────────────────────────────────────────
 // CLIENT RECOVERY
 // ──────────────────────────────────────────────
+void UNexusMigrationSubsystem::StartDirectReconnect()
+{
+	NexusTrace::MigrationPhase(TEXT("Client : direct reconnect"), MigrationGeneration);
+
+	bDirectReconnecting = true;
+	bDirectReconnectInFlight = false;
+	DirectReconnectAttempts = 0;
+
+	// La session locale pointe vers l'ancien hôte : la recherche la remplaçait au join, ici on la détruit
+	if (UNexusSessionOperationSubsystem* Operations = GetGameInstance()->GetSubsystem<UNexusSessionOperationSubsystem>())
+	{
+		FNexusSessionOperationRequest Request;
+		Request.Type = ENexusSessionOperationType::Destroy;
+		Request.SessionName = NexusOnline::SessionTypeToName(CachedSessionSettings.SessionType);
+		Operations->Enqueue(MoveTemp(Request), FOnNexusSessionOperationComplete());
+	}
+
+	const UNexusMigrationConfig* Config = GetDefault<UNexusMigrationConfig>();
+	const float Delay = Config ? Config->DirectReconnectDelay : 1.0f;
+
+	if (Delay > 0.f)
+	{
+		GetWorld()->GetTimerManager().SetTimer(TimerHandle_DirectReconnect, this, &UNexusMigrationSubsystem::AttemptDirectReconnect, Delay, false);
+	}
+	else
+	{
+		AttemptDirectReconnect();
+	}
+}
+
+void UNexusMigrationSubsystem::AttemptDirectReconnect()
+{
+	NEXUS_TRACE_SCOPE(NexusMigration_DirectReconnect);
+
+	if (!bDirectReconnecting)
+		return;
+
+	const UNexusMigrationConfig* Config = GetDefault<UNexusMigrationConfig>();
+	const int32 MaxAttempts = Config ? Config->MaxDirectReconnectAttempts : 5;
+	const float Interval = Config ? Config->DirectReconnectInterval : 2.0f;
+
+	// Connexion encore en négociation : relancer le voyage l'annulerait, son échec planifiera la suite
+	if (IsDirectReconnectPending())
+	{
+		GetWorld()->GetTimerManager().SetTimer(TimerHandle_DirectReconnect, this, &UNexusMigrationSubsystem::AttemptDirectReconnect, Interval, false);
+		return;
+	}
+
+	if (DirectReconnectAttempts >= MaxAttempts)
+	{
+		UE_LOG(LogNexusMigration, Warning, TEXT("[NexusMigration] New host unreachable at %s after %d attempts. Falling back to session search."), *CachedNextHostAddress, DirectReconnectAttempts);
+		bDirectReconnecting = false;
+		bDirectReconnectInFlight = false;
+		StartClientRecovery();
+		return;
+	}
+
+	++DirectReconnectAttempts;
+	PendingMetrics.DirectAttempts = DirectReconnectAttempts;
+	bDirectReconnectInFlight = true;
+
+	const FString TravelURL = CachedNextHostAddress + GetHeirLoginOptions();
+	UE_LOG(LogNexusMigration, Log, TEXT("[NexusMigration] Direct reconnect %d/%d to %s..."), DirectReconnectAttempts, MaxAttempts, *CachedNextHostAddress);
+	GEngine->SetClientTravel(GetWorld(), *TravelURL, TRAVEL_Absolute);
+
+	// Filet de sécurité si aucun échec n'est signalé : ne relance qu'une fois la connexion abandonnée
+	GetWorld()->GetTimerManager().SetTimer(TimerHandle_DirectReconnect, this, &UNexusMigrationSubsystem::AttemptDirectReconnect, Interval, false);
+}
+
+void UNexusMigrationSubsystem::OnDirectReconnectFailed(const FString& ErrorString)
+{
+	// Une même tentative peut échouer deux fois (erreur réseau puis échec du voyage)
+	if (!bDirectReconnectInFlight)
+		return;
+
+	bDirectReconnectInFlight = false;
+
+	const UNexusMigrationConfig* Config = GetDefault<UNexusMigrationConfig>();
+	const float Interval = Config ? Config->DirectReconnectInterval : 2.0f;
+
+	UE_LOG(LogNexusMigration, Log, TEXT("[NexusMigration] Direct reconnect attempt %d failed: %s. Next attempt in %.1fs."), DirectReconnectAttempts, *ErrorString, Interval);
+	GetWorld()->GetTimerManager().SetTimer(TimerHandle_DirectReconnect, this, &UNexusMigrationSubsystem::AttemptDirectReconnect, Interval, false);
+}
+
+bool UNexusMigrationSubsystem::IsDirectReconnectPending() const
+{
+	// Voyage demandé mais pas encore traité, ou connexion au nouvel hôte en cours
+	const FWorldContext* Context = GEngine ? GEngine->GetWorldContextFromWorld(GetWorld()) : nullptr;
+	return Context && (Context->PendingNetGame != nullptr || !Context->TravelURL.IsEmpty());
+}
+
 void UNexusMigrationSubsystem::StartClientRecovery()
 {
 	MigrationRetries = 0;
+	NexusTrace::MigrationPhase(TEXT("Client : searching new host"), MigrationGeneration);
 
 	float SearchInterval = 5.0f;
 	if (const UNexusMigrationConfig* Config = GetDefault<UNexusMigrationConfig>())
@@ -271,23 +764,14 @@ void UNexusMigrationSubsystem::StartClientRecovery()
 
 void UNexusMigrationSubsystem::PerformClientSearch()
 {
-	FString EffectiveId = GetEffectiveMigrationId();
-
-	FSessionSearchFilter MigrationFilter;
-	MigrationFilter.Key = FName("MIGRATION_ID_KEY");
-	MigrationFilter.Value.Type = ENexusSessionFilterValueType::String;
-	MigrationFilter.Value.StringValue = EffectiveId;
-	MigrationFilter.ComparisonOp = ENexusSessionComparisonOp::Equals;
-
-	TArray<FSessionSearchFilter> SimpleFilters;
-	SimpleFilters.Add(MigrationFilter);
+	NEXUS_TRACE_SCOPE(NexusMigration_ClientSearch);
 
 	CurrentFindTask = UAsyncTask_FindSessions::FindSessions(
 		GetWorld(), 
 		CachedSessionSettings.SessionType, 
 		20, 
 		false, 
-		SimpleFilters,
+		MakeMigrationSearchFilters(),
 		{}, {}, nullptr
 	);
 
@@ -298,15 +782,31 @@ void UNexusMigrationSubsystem::PerformClientSearch()
 	}
 }
 
+TArray<FSessionSearchFilter> UNexusMigrationSubsystem::MakeMigrationSearchFilters() const
+{
+	FSessionSearchFilter MigrationFilter;
+	MigrationFilter.Key = FName("MIGRATION_ID_KEY");
+	MigrationFilter.Value.Type = ENexusSessionFilterValueType::String;
+	MigrationFilter.Value.StringValue = GetEffectiveMigrationId();
+	MigrationFilter.ComparisonOp = ENexusSessionComparisonOp::Equals;
+
+	TArray<FSessionSearchFilter> SimpleFilters;
+	SimpleFilters.Add(MigrationFilter);
+	return SimpleFilters;
+}
+
 void UNexusMigrationSubsystem::OnRecoveryFindComplete(bool bWasSuccessful, const TArray<FOnlineSessionSearchResultData>& Results)
 {
+	NEXUS_TRACE_SCOPE(NexusMigration_OnClientSearchComplete);
+
 	const UNexusMigrationConfig* Config = GetDefault<UNexusMigrationConfig>();
 	const int32 MaxRetries = Config ? Config->MaxMigrationRetries : 15;
 	const float RetryDelay = Config ? Config->ClientRetryDelay : 3.0f;
 
 	if (bWasSuccessful && Results.Num() > 0)
 	{
-		UE_LOG(LogTemp, Log, TEXT("[NexusMigration] FOUND MATCH! Joining..."));
+		UE_LOG(LogNexusMigration, Log, TEXT("[NexusMigration] FOUND MATCH! Joining..."));
+		NexusTrace::MigrationPhase(TEXT("Client : joining new host"), MigrationGeneration);
 
 		CurrentJoinTask = UAsyncTask_JoinSession::JoinSession(GetWorld(), Results[0], true, CachedSessionSettings.SessionType);
 
@@ -322,8 +822,10 @@ void UNexusMigrationSubsystem::OnRecoveryFindComplete(bool bWasSuccessful, const
 		MigrationRetries++;
 		if (MigrationRetries >= 20)
 		{
-			UE_LOG(LogTemp, Error, TEXT("[NexusMigration] Timeout after %d attempts."), MigrationRetries);
+			UE_LOG(LogNexusMigration, Error, TEXT("[NexusMigration] Timeout after %d attempts."), MigrationRetries);
+			NexusTrace::MigrationPhase(TEXT("Client : timed out"), MigrationGeneration);
 			bIsMigrating = false;
+			RecoveryStartTime = 0.0;
 			LastMigrationFailureTime = FPlatformTime::Seconds();
 			OnMigrationFailed.Broadcast(TEXT("Migration Timed Out"));
 			
@@ -337,7 +839,7 @@ void UNexusMigrationSubsystem::OnRecoveryFindComplete(bool bWasSuccessful, const
 			return;
 		}
 
-		UE_LOG(LogTemp, Warning, TEXT("[NexusMigration] Match not found (%d/%d). Retrying in %.1fs..."), MigrationRetries, MaxRetries, RetryDelay);
+		UE_LOG(LogNexusMigration, Log, TEXT("[NexusMigration] Match not found (%d/%d). Retrying in %.1fs..."), MigrationRetries, MaxRetries, RetryDelay);
 		
 		FTimerHandle RetryHandle;
 		GetWorld()->GetTimerManager().SetTimer(RetryHandle, this, &UNexusMigrationSubsystem::PerformClientSearch, RetryDelay, false);
@@ -346,14 +848,16 @@ void UNexusMigrationSubsystem::OnRecoveryFindComplete(bool bWasSuccessful, const
 
 void UNexusMigrationSubsystem::OnRecoveryJoinSuccess()
 {
-	UE_LOG(LogTemp, Log, TEXT("[NexusMigration] Client Recovery Successful. Joined new host."));
+	UE_LOG(LogNexusMigration, Log, TEXT("[NexusMigration] Client Recovery Successful. Joined new host."));
+	NexusTrace::MigrationPhase(TEXT("Client : recovered"), MigrationGeneration);
 	bIsMigrating = false;
 	CurrentJoinTask = nullptr;
 }
 
 void UNexusMigrationSubsystem::OnRecoveryJoinFailure()
 {
-	UE_LOG(LogTemp, Error, TEXT("[NexusMigration] Failed to join recovered session. Retrying..."));
+	UE_LOG(LogNexusMigration, Error, TEXT("[NexusMigration] Failed to join recovered session. Retrying..."));
+	NexusTrace::MigrationPhase(TEXT("Client : join failed"), MigrationGeneration);
 	
 	float FailureDelay = 2.0f;
 	if (const UNexusMigrationConfig* Config = GetDefault<UNexusMigrationConfig>())
@@ -363,4 +867,73 @@ void UNexusMigrationSubsystem::OnRecoveryJoinFailure()
 
 	FTimerHandle RetryHandle;
 	GetWorld()->GetTimerManager().SetTimer(RetryHandle, this, &UNexusMigrationSubsystem::PerformClientSearch, FailureDelay, false);
+}
+
+// ──────────────────────────────────────────────
+// SESSION AFTER DIRECT RECONNECT
+// ──────────────────────────────────────────────
+void UNexusMigrationSubsystem::JoinReconnectedSession()
+{
+	NEXUS_TRACE_SCOPE(NexusMigration_JoinReconnectedSession);
+
+	// Nouvelle migration entre-temps : elle gère sa propre session
+	if (bIsMigrating || ReconnectedSessionGeneration != MigrationGeneration)
+		return;
+
+	CurrentFindTask = UAsyncTask_FindSessions::FindSessions(GetWorld(), CachedSessionSettings.SessionType, 20, false, MakeMigrationSearchFilters(), {}, {}, nullptr);
+
+	if (CurrentFindTask)
+	{
+		CurrentFindTask->OnCompleted.AddDynamic(this, &UNexusMigrationSubsystem::OnReconnectedSessionFound);
+		CurrentFindTask->Activate();
+	}
+}
+
+void UNexusMigrationSubsystem::OnReconnectedSessionFound(bool bWasSuccessful, const TArray<FOnlineSessionSearchResultData>& Results)
+{
+	CurrentFindTask = nullptr;
+
+	if (bIsMigrating || ReconnectedSessionGeneration != MigrationGeneration)
+		return;
+
+	if (!bWasSuccessful || Results.Num() == 0)
+	{
+		// L'hôte annonce sa session après avoir ouvert l'écoute : elle peut arriver après nous
+		const UNexusMigrationConfig* Config = GetDefault<UNexusMigrationConfig>();
+		const int32 MaxSearches = Config ? Config->MaxMigrationRetries : 15;
+		const float RetryDelay = Config ? Config->ClientRetryDelay : 3.0f;
+
+		if (++ReconnectedSessionSearches >= MaxSearches)
+		{
+			UE_LOG(LogNexusMigration, Warning, TEXT("[NexusMigration] Session %s of the new host not found after %d searches. Staying connected without it."), *GetEffectiveMigrationId(), ReconnectedSessionSearches);
+			return;
+		}
+
+		FTimerHandle RetryHandle;
+		GetWorld()->GetTimerManager().SetTimer(RetryHandle, this, &UNexusMigrationSubsystem::JoinReconnectedSession, RetryDelay, false);
+		return;
+	}
+
+	UNexusSessionOperationSubsystem* Operations = GetGameInstance()->GetSubsystem<UNexusSessionOperationSubsystem>();
+	if (!Operations)
+		return;
+
+	// Déjà connecté au serveur : la file rejoint la session sans voyage
+	FNexusSessionOperationRequest Request;
+	Request.Type = ENexusSessionOperationType::Join;
+	Request.SessionName = NexusOnline::SessionTypeToName(CachedSessionSettings.SessionType);
+	Request.JoinTarget = Results[0];
+	Operations->Enqueue(MoveTemp(Request), FOnNexusSessionOperationComplete::CreateUObject(this, &UNexusMigrationSubsystem::OnReconnectedSessionJoined));
+}
+
+void UNexusMigrationSubsystem::OnReconnectedSessionJoined(const FNexusSessionOperationResult& Result)
+{
+	if (Result.WasSuccessful())
+	{
+		UE_LOG(LogNexusMigration, Log, TEXT("[NexusMigration] Joined the new host's session %s."), *GetEffectiveMigrationId());
+	}
+	else
+	{
+		UE_LOG(LogNexusMigration, Warning, TEXT("[NexusMigration] Could not join the new host's session %s (result %d)."), *GetEffectiveMigrationId(), static_cast<int32>(Result.JoinResult));
+	}
 }
\ No newline at end of file
@@ -0,0 +1,735 @@
+#include "Subsystems/NexusPingProberSubsystem.h"
+#include "Configs/NexusSessionSearchConfig.h"
+#include "Utils/NexusOnlineHelpers.h"
+#include "Utils/NexusTrace.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "HAL/Event.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Containers/Queue.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+#include "IPAddress.h"
+#include "OnlineSessionSettings.h"
+#include "Interfaces/OnlineSessionInterface.h"
+
+
+// ──────────────────────────────────────────────
+// Protocole : 16 octets renvoyés tels quels par l'hôte
+// Magic (4) | Sequence (4) | Cookie (8)
+// ──────────────────────────────────────────────
+namespace NexusPingProbe
+{
+	constexpr uint32 Magic = 0x4E585047; // "NXPG"
+	constexpr int32 PacketSize = 16;
+
+	struct FRequest
+	{
+		FString HostAddress;
+		TSharedPtr<FInternetAddr> Addr;
+		int32 NumProbes = 1;
+	};
+
+	struct FSample
+	{
+		FString HostAddress;
+		float RttMs = 0.f;
+		bool bLost = false;
+	};
+
+	static void WritePacket(uint8* Buffer, uint32 Sequence, uint64 Cookie)
+	{
+		FMemory::Memcpy(Buffer, &Magic, 4);
+		FMemory::Memcpy(Buffer + 4, &Sequence, 4);
+		FMemory::Memcpy(Buffer + 8, &Cookie, 8);
+	}
+
+	static bool HasMagic(const uint8* Buffer, int32 Size)
+	{
+		uint32 Value = 0;
+		if (Size != PacketSize)
+			return false;
+
+		FMemory::Memcpy(&Value, Buffer, 4);
+		return Value == Magic;
+	}
+
+	static FSocket* CreateUdpSocket(const TCHAR* Description, int32 BindPort)
+	{
+		ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+		if (!SocketSubsystem)
+			return nullptr;
+
+		FSocket* Socket = SocketSubsystem->CreateSocket(NAME_DGram, Description, FNetworkProtocolTypes::IPv4);
+		if (!Socket)
+			return nullptr;
+
+		TSharedRef<FInternetAddr> LocalAddr = SocketSubsystem->CreateInternetAddr(FNetworkProtocolTypes::IPv4);
+		LocalAddr->SetAnyAddress();
+		LocalAddr->SetPort(BindPort);
+
+		Socket->SetNonBlocking(true);
+		if (!Socket->Bind(*LocalAddr))
+		{
+			SocketSubsystem->DestroySocket(Socket);
+			return nullptr;
+		}
+
+		return Socket;
+	}
+
+	static void DestroySocket(FSocket*& Socket)
+	{
+		if (!Socket)
+			return;
+
+		Socket->Close();
+		if (ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM))
+		{
+			SocketSubsystem->DestroySocket(Socket);
+		}
+		Socket = nullptr;
+	}
+}
+
+using namespace NexusPingProbe;
+
+
+// ──────────────────────────────────────────────
+// Worker : envoi des sondes et horodatage des réponses hors game thread
+// ──────────────────────────────────────────────
+class FNexusPingProbeWorker : public FRunnable
+{
+public:
+	FNexusPingProbeWorker(double InSpacing, double InTimeout)
+		: Spacing(InSpacing)
+		, Timeout(InTimeout)
+		, Cookie((static_cast<uint64>(FPlatformTime::Cycles()) << 32) | static_cast<uint64>(FMath::Rand()))
+	{
+	}
+
+	virtual ~FNexusPingProbeWorker() override
+	{
+		if (Thread)
+		{
+			Thread->Kill(true);
+			delete Thread;
+			Thread = nullptr;
+		}
+
+		if (WakeEvent)
+		{
+			FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+			WakeEvent = nullptr;
+		}
+
+		DestroySocket(Socket);
+	}
+
+	bool Start()
+	{
+		Socket = CreateUdpSocket(TEXT("NexusPingProbe"), 0);
+		if (!Socket)
+			return false;
+
+		WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+		Thread = FRunnableThread::Create(this, TEXT("NexusPingProbe"), 0, TPri_AboveNormal);
+		return Thread != nullptr;
+	}
+
+	void Enqueue(FRequest&& Request)
+	{
+		Requests.Enqueue(MoveTemp(Request));
+		WakeEvent->Trigger();
+	}
+
+	bool DequeueSample(FSample& OutSample)
+	{
+		return Samples.Dequeue(OutSample);
+	}
+
+	virtual uint32 Run() override
+	{
+		while (!bStopping)
+		{
+			FRequest Request;
+			while (Requests.Dequeue(Request))
+			{
+				FTarget& Target = Targets.AddDefaulted_GetRef();
+				Target.HostAddress = MoveTemp(Request.HostAddress);
+				Target.Addr = Request.Addr;
+				Target.Remaining = Request.NumProbes;
+			}
+
+			if (Targets.IsEmpty() && InFlight.IsEmpty())
+			{
+				WakeEvent->Wait(FTimespan::FromMilliseconds(100));
+				continue;
+			}
+
+			SendDueProbes(FPlatformTime::Seconds());
+
+			// Attente courte sur le socket : la réponse est horodatée dès son arrivée
+			Socket->Wait(ESocketWaitConditions::WaitForRead, FTimespan::FromMilliseconds(1));
+			ReceiveReplies();
+			ExpireProbes(FPlatformTime::Seconds());
+		}
+
+		return 0;
+	}
+
+	virtual void Stop() override
+	{
+		bStopping = true;
+		if (WakeEvent)
+		{
+			WakeEvent->Trigger();
+		}
+	}
+
+private:
+	struct FTarget
+	{
+		FString HostAddress;
+		TSharedPtr<FInternetAddr> Addr;
+		int32 Remaining = 0;
+		double NextSendTime = 0.0;
+	};
+
+	struct FInFlight
+	{
+		FString HostAddress;
+		double SendTime = 0.0;
+	};
+
+	void SendDueProbes(double Now)
+	{
+		uint8 Buffer[PacketSize];
+
+		for (int32 i = Targets.Num() - 1; i >= 0; --i)
+		{
+			FTarget& Target = Targets[i];
+			if (Target.NextSendTime > Now)
+				continue;
+
+			const uint32 Sequence = NextSequence++;
+			WritePacket(Buffer, Sequence, Cookie);
+
+			int32 BytesSent = 0;
+			const double SendTime = FPlatformTime::Seconds();
+			if (Socket->SendTo(Buffer, PacketSize, BytesSent, *Target.Addr) && BytesSent == PacketSize)
+			{
+				InFlight.Add(Sequence, { Target.HostAddress, SendTime });
+			}
+			else
+			{
+				Samples.Enqueue({ Target.HostAddress, 0.f, true });
+			}
+
+			Target.NextSendTime = Now + Spacing;
+			if (--Target.Remaining <= 0)
+			{
+				Targets.RemoveAtSwap(i);
+			}
+		}
+	}
+
+	void ReceiveReplies()
+	{
+		ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+		TSharedRef<FInternetAddr> FromAddr = SocketSubsystem->CreateInternetAddr();
+
+		uint8 Buffer[64];
+		int32 BytesRead = 0;
+
+		while (Socket->RecvFrom(Buffer, sizeof(Buffer), BytesRead, *FromAddr) && BytesRead > 0)
+		{
+			const double ReceiveTime = FPlatformTime::Seconds();
+			if (!HasMagic(Buffer, BytesRead))
+				continue;
+
+			uint32 Sequence = 0;
+			uint64 ReplyCookie = 0;
+			FMemory::Memcpy(&Sequence, Buffer + 4, 4);
+			FMemory::Memcpy(&ReplyCookie, Buffer + 8, 8);
+
+			// Réponse d'une instance précédente ou arrivée après son timeout : ignorée
+			FInFlight Probe;
+			if (ReplyCookie != Cookie || !InFlight.RemoveAndCopyValue(Sequence, Probe))
+				continue;
+
+			Samples.Enqueue({ MoveTemp(Probe.HostAddress), static_cast<float>((ReceiveTime - Probe.SendTime) * 1000.0), false });
+		}
+	}
+
+	void ExpireProbes(double Now)
+	{
+		for (auto It = InFlight.CreateIterator(); It; ++It)
+		{
+			if (Now - It.Value().SendTime > Timeout)
+			{
+				Samples.Enqueue({ It.Value().HostAddress, 0.f, true });
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	const double Spacing;
+	const double Timeout;
+	const uint64 Cookie;
+
+	FSocket* Socket = nullptr;
+	FRunnableThread* Thread = nullptr;
+	FEvent* WakeEvent = nullptr;
+	FThreadSafeBool bStopping = false;
+
+	TQueue<FRequest, EQueueMode::Mpsc> Requests;
+	TQueue<FSample, EQueueMode::Spsc> Samples;
+
+	// Worker thread only
+	TArray<FTarget> Targets;
+	TMap<uint32, FInFlight> InFlight;
+	uint32 NextSequence = 0;
+};
+
+
+// ──────────────────────────────────────────────
+// Echo : côté hôte (ou stand-in local), renvoie les sondes telles quelles
+// ──────────────────────────────────────────────
+class FNexusPingEchoWorker : public FRunnable
+{
+public:
+	virtual ~FNexusPingEchoWorker() override
+	{
+		if (Thread)
+		{
+			Thread->Kill(true);
+			delete Thread;
+			Thread = nullptr;
+		}
+
+		DestroySocket(Socket);
+	}
+
+	bool Start(int32 Port)
+	{
+		Socket = CreateUdpSocket(TEXT("NexusPingEcho"), Port);
+		if (!Socket)
+			return false;
+
+		Thread = FRunnableThread::Create(this, TEXT("NexusPingEcho"), 0, TPri_AboveNormal);
+		return Thread != nullptr;
+	}
+
+	virtual uint32 Run() override
+	{
+		ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+		TSharedRef<FInternetAddr> FromAddr = SocketSubsystem->CreateInternetAddr();
+
+		uint8 Buffer[64];
+		int32 BytesRead = 0;
+
+		while (!bStopping)
+		{
+			if (!Socket->Wait(ESocketWaitConditions::WaitForRead, FTimespan::FromMilliseconds(50)))
+				continue;
+
+			while (Socket->RecvFrom(Buffer, sizeof(Buffer), BytesRead, *FromAddr) && BytesRead > 0)
+			{
+				// Réponse de même taille que la requête, uniquement pour nos sondes : pas d'amplification possible
+				if (!HasMagic(Buffer, BytesRead))
+					continue;
+
+				int32 BytesSent = 0;
+				Socket->SendTo(Buffer, BytesRead, BytesSent, *FromAddr);
+			}
+		}
+
+		return 0;
+	}
+
+	virtual void Stop() override
+	{
+		bStopping = true;
+	}
+
+private:
+	FSocket* Socket = nullptr;
+	FRunnableThread* Thread = nullptr;
+	FThreadSafeBool bStopping = false;
+};
+
+
+// ──────────────────────────────────────────────
+// CACHE
+// ──────────────────────────────────────────────
+
+FNexusPingCache& FNexusPingCache::Get()
+{
+	static FNexusPingCache Instance;
+	return Instance;
+}
+
+void FNexusPingCache::RecordSample(const FString& HostAddress, float RttMs)
+{
+	const UNexusSessionSearchConfig* Config = GetDefault<UNexusSessionSearchConfig>();
+	const float Alpha = Config ? Config->RttSmoothing : 0.125f;
+	const float Beta = Config ? Config->JitterSmoothing : 0.25f;
+
+	FWriteScopeLock WriteLock(Lock);
+	FNexusPingEstimate& Estimate = EstimatesByHost.FindOrAdd(HostAddress);
+
+	// RFC 6298 : premier échantillon -> SRTT = R, RTTVAR = R / 2
+	if (Estimate.NumSamples == 0)
+	{
+		Estimate.SmoothedRttMs = RttMs;
+		Estimate.JitterMs = RttMs * 0.5f;
+	}
+	else
+	{
+		Estimate.JitterMs = (1.f - Beta) * Estimate.JitterMs + Beta * FMath::Abs(Estimate.SmoothedRttMs - RttMs);
+		Estimate.SmoothedRttMs = (1.f - Alpha) * Estimate.SmoothedRttMs + Alpha * RttMs;
+	}
+
+	Estimate.LastRttMs = RttMs;
+	Estimate.NumSamples++;
+	Estimate.LastUpdateTime = FPlatformTime::Seconds();
+}
+
+void FNexusPingCache::RecordLoss(const FString& HostAddress)
+{
+	FWriteScopeLock WriteLock(Lock);
+	FNexusPingEstimate& Estimate = EstimatesByHost.FindOrAdd(HostAddress);
+	Estimate.NumLost++;
+	Estimate.LastUpdateTime = FPlatformTime::Seconds();
+}
+
+void FNexusPingCache::BindSession(const FString& SessionId, const FString& HostAddress)
+{
+	if (SessionId.IsEmpty())
+		return;
+
+	FWriteScopeLock WriteLock(Lock);
+	HostBySession.Add(SessionId, HostAddress);
+}
+
+bool FNexusPingCache::FindByHost(const FString& HostAddress, FNexusPingEstimate& OutEstimate) const
+{
+	FReadScopeLock ReadLock(Lock);
+	if (const FNexusPingEstimate* Estimate = EstimatesByHost.Find(HostAddress))
+	{
+		OutEstimate = *Estimate;
+		return true;
+	}
+	return false;
+}
+
+bool FNexusPingCache::FindBySession(const FString& SessionId, FNexusPingEstimate& OutEstimate) const
+{
+	FReadScopeLock ReadLock(Lock);
+	const FString* HostAddress = HostBySession.Find(SessionId);
+	const FNexusPingEstimate* Estimate = HostAddress ? EstimatesByHost.Find(*HostAddress) : nullptr;
+	if (!Estimate)
+		return false;
+
+	OutEstimate = *Estimate;
+	return true;
+}
+
+int32 FNexusPingCache::GetEffectivePing(const FOnlineSessionSearchResult& Result) const
+{
+	FNexusPingEstimate Estimate;
+	if (FindBySession(NexusOnline::GetSessionIdentity(Result), Estimate) && IsUsable(Estimate))
+	{
+		return FMath::RoundToInt(Estimate.SmoothedRttMs);
+	}
+
+	return Result.PingInMs;
+}
+
+void FNexusPingCache::Reset()
+{
+	FWriteScopeLock WriteLock(Lock);
+	EstimatesByHost.Empty();
+	HostBySession.Empty();
+}
+
+bool FNexusPingCache::IsUsable(const FNexusPingEstimate& Estimate) const
+{
+	const UNexusSessionSearchConfig* Config = GetDefault<UNexusSessionSearchConfig>();
+	const double Lifetime = Config ? Config->PingEstimateLifetime : 120.0;
+	return Estimate.NumSamples > 0 && (FPlatformTime::Seconds() - Estimate.LastUpdateTime) <= Lifetime;
+}
+
+
+// ──────────────────────────────────────────────
+// LIFECYCLE
+// ──────────────────────────────────────────────
+
+void UNexusPingProberSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UNexusPingProberSubsystem::Tick));
+}
+
+void UNexusPingProberSubsystem::Deinitialize()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+
+	StopEchoResponder();
+
+	delete ProbeWorker;
+	ProbeWorker = nullptr;
+	PendingProbeCount = 0;
+
+	Super::Deinitialize();
+}
+
+bool UNexusPingProberSubsystem::IsServerWorld() const
+{
+	const UWorld* World = GetGameInstance() ? GetGameInstance()->GetWorld() : nullptr;
+	if (!World)
+		return false;
+
+	const ENetMode NetMode = World->GetNetMode();
+	return NetMode == NM_ListenServer || NetMode == NM_DedicatedServer;
+}
+
+bool UNexusPingProberSubsystem::Tick(float DeltaTime)
+{
+	const UNexusSessionSearchConfig* Config = GetDefault<UNexusSessionSearchConfig>();
+	if (Config && Config->bEnableEchoResponder && !EchoWorker && !bEchoAutoStartAttempted && IsServerWorld())
+	{
+		bEchoAutoStartAttempted = true;
+		StartEchoResponder(0);
+	}
+
+	if (!ProbeWorker)
+		return true;
+
+	FNexusPingCache& Cache = FNexusPingCache::Get();
+
+	FSample Sample;
+	while (ProbeWorker->DequeueSample(Sample))
+	{
+		PendingProbeCount = FMath::Max(0, PendingProbeCount - 1);
+
+		if (Sample.bLost)
+		{
+			Cache.RecordLoss(Sample.HostAddress);
+		}
+		else
+		{
+			Cache.RecordSample(Sample.HostAddress, Sample.RttMs);
+		}
+
+		FNexusPingEstimate Estimate;
+		if (Cache.FindByHost(Sample.HostAddress, Estimate))
+		{
+			UE_LOG(LogNexusOnline, Verbose, TEXT("[NexusPing] %s : %s (srtt %.1f ms, jitter %.1f ms, %d lost)."),
+				*Sample.HostAddress, Sample.bLost ? TEXT("lost") : *FString::Printf(TEXT("%.1f ms"), Sample.RttMs),
+				Estimate.SmoothedRttMs, Estimate.JitterMs, Estimate.NumLost);
+
+			OnPingUpdated.Broadcast(Sample.HostAddress, Estimate);
+		}
+	}
+
+	return true;
+}
+
+// ──────────────────────────────────────────────
+// PROBING
+// ──────────────────────────────────────────────
+
+bool UNexusPingProberSubsystem::EnsureProbeWorker()
+{
+	if (ProbeWorker)
+		return true;
+
+	const UNexusSessionSearchConfig* Config = GetDefault<UNexusSessionSearchConfig>();
+	const double Spacing = (Config ? Config->ProbeSpacingMs : 20.0f) / 1000.0;
+	const double Timeout = Config ? Config->ProbeTimeout : 1.0f;
+
+	ProbeWorker = new FNexusPingProbeWorker(Spacing, Timeout);
+	if (!ProbeWorker->Start())
+	{
+		UE_LOG(LogNexusOnline, Warning, TEXT("[NexusPing] Could not create the probe socket."));
+		delete ProbeWorker;
+		ProbeWorker = nullptr;
+		return false;
+	}
+
+	return true;
+}
+
+bool UNexusPingProberSubsystem::ProbeAddress(const FString& HostAddress, int32 NumProbes)
+{
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+	if (!SocketSubsystem)
+		return false;
+
+	TSharedPtr<FInternetAddr> Addr = SocketSubsystem->GetAddressFromString(HostAddress);
+	if (!Addr.IsValid() || !Addr->IsValid() || Addr->GetPort() == 0)
+	{
+		UE_LOG(LogNexusOnline, Warning, TEXT("[NexusPing] Invalid probe address '%s' (expected ip:port)."), *HostAddress);
+		return false;
+	}
+
+	if (!EnsureProbeWorker())
+		return false;
+
+	const UNexusSessionSearchConfig* Config = GetDefault<UNexusSessionSearchConfig>();
+
+	FRequest Request;
+	Request.HostAddress = HostAddress;
+	Request.Addr = Addr;
+	Request.NumProbes = (NumProbes > 0) ? NumProbes : (Config ? Config->ProbesPerHost : 3);
+
+	PendingProbeCount += Request.NumProbes;
+	ProbeWorker->Enqueue(MoveTemp(Request));
+	return true;
+}
+
+int32 UNexusPingProberSubsystem::ProbeSearchResults(const TArray<FOnlineSessionSearchResultData>& Results)
+{
+	TArray<FOnlineSessionSearchResult> RawResults;
+	RawResults.Reserve(Results.Num());
+
+	for (const FOnlineSessionSearchResultData& Result : Results)
+	{
+		if (Result.HasRawResult())
+		{
+			RawResults.Add(Result.GetRawResult());
+		}
+	}
+
+	return ProbeRawResults(RawResults);
+}
+
+int32 UNexusPingProberSubsystem::ProbeRawResults(const TArray<FOnlineSessionSearchResult>& Results)
+{
+	const UNexusSessionSearchConfig* Config = GetDefault<UNexusSessionSearchConfig>();
+	const int32 MaxHosts = Config ? Config->MaxProbeHosts : 64;
+
+	TSet<FString> QueuedHosts;
+	FNexusPingCache& Cache = FNexusPingCache::Get();
+
+	for (const FOnlineSessionSearchResult& Result : Results)
+	{
+		FString HostAddress;
+		if (!ResolveProbeAddress(Result, HostAddress))
+			continue;
+
+		Cache.BindSession(NexusOnline::GetSessionIdentity(Result), HostAddress);
+
+		// Plusieurs sessions sur le même hôte : une seule série de sondes
+		if (QueuedHosts.Contains(HostAddress) || QueuedHosts.Num() >= MaxHosts)
+			continue;
+
+		if (ProbeAddress(HostAddress))
+		{
+			QueuedHosts.Add(HostAddress);
+		}
+	}
+
+	UE_LOG(LogNexusOnline, Log, TEXT("[NexusPing] Probing %d hosts for %d results."), QueuedHosts.Num(), Results.Num());
+	return QueuedHosts.Num();
+}
+
+bool UNexusPingProberSubsystem::ResolveProbeAddress(const FOnlineSessionSearchResult& Result, FString& OutHostAddress) const
+{
+	IOnlineSessionPtr Session = NexusOnline::GetSessionInterface(GetGameInstance());
+	if (!Session.IsValid() || !Result.IsValid())
+		return false;
+
+	FString ConnectInfo;
+	if (!Session->GetResolvedConnectString(Result, NAME_GamePort, ConnectInfo))
+		return false;
+
+	// Connexions P2P (steam.xxx, EOS...) : pas d'IP à sonder
+	FString Ip = ConnectInfo;
+	FString PortStr;
+	ConnectInfo.Split(TEXT(":"), &Ip, &PortStr, ESearchCase::IgnoreCase, ESearchDir::FromEnd);
+
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+	if (!SocketSubsystem)
+		return false;
+
+	bool bIsValid = false;
+	TSharedRef<FInternetAddr> Addr = SocketSubsystem->CreateInternetAddr();
+	Addr->SetIp(*Ip, bIsValid);
+	if (!bIsValid)
+		return false;
+
+	const UNexusSessionSearchConfig* Config = GetDefault<UNexusSessionSearchConfig>();
+	int32 ProbePort = Config ? Config->ProbePort : 7787;
+	Result.Session.SessionSettings.Get(TEXT("PING_PORT_KEY"), ProbePort);
+
+	OutHostAddress = FString::Printf(TEXT("%s:%d"), *Ip, ProbePort);
+	return true;
+}
+
+bool UNexusPingProberSubsystem::GetEstimate(const FString& HostAddress, FNexusPingEstimate& OutEstimate) const
+{
+	return FNexusPingCache::Get().FindByHost(HostAddress, OutEstimate);
+}
+
+bool UNexusPingProberSubsystem::GetSessionEstimate(const FOnlineSessionSearchResultData& Result, FNexusPingEstimate& OutEstimate) const
+{
+	return Result.HasRawResult() && FNexusPingCache::Get().FindBySession(NexusOnline::GetSessionIdentity(Result.GetRawResult()), OutEstimate);
+}
+
+int32 UNexusPingProberSubsystem::UpdateResultPings(TArray<FOnlineSessionSearchResultData>& Results) const
+{
+	const FNexusPingCache& Cache = FNexusPingCache::Get();
+	int32 NumChanged = 0;
+
+	for (FOnlineSessionSearchResultData& Result : Results)
+	{
+		if (!Result.HasRawResult())
+			continue;
+
+		const int32 Ping = Cache.GetEffectivePing(Result.GetRawResult());
+		if (Ping != Result.Ping)
+		{
+			Result.Ping = Ping;
+			NumChanged++;
+		}
+	}
+
+	return NumChanged;
+}
+
+// ──────────────────────────────────────────────
+// ECHO RESPONDER
+// ──────────────────────────────────────────────
+
+bool UNexusPingProberSubsystem::StartEchoResponder(int32 Port)
+{
+	if (EchoWorker)
+		return true;
+
+	const UNexusSessionSearchConfig* Config = GetDefault<UNexusSessionSearchConfig>();
+	EchoPort = (Port > 0) ? Port : (Config ? Config->ProbePort : 7787);
+
+	EchoWorker = new FNexusPingEchoWorker();
+	if (!EchoWorker->Start(EchoPort))
+	{
+		UE_LOG(LogNexusOnline, Warning, TEXT("[NexusPing] Could not start the echo responder on UDP port %d."), EchoPort);
+		delete EchoWorker;
+		EchoWorker = nullptr;
+		return false;
+	}
+
+	UE_LOG(LogNexusOnline, Log, TEXT("[NexusPing] Echo responder listening on UDP port %d."), EchoPort);
+	return true;
+}
+
+void UNexusPingProberSubsystem::StopEchoResponder()
+{
+	delete EchoWorker;
+	EchoWorker = nullptr;
+}
@@ -0,0 +1,409 @@
+#include "Subsystems/NexusSessionCacheSubsystem.h"
+#include "Configs/NexusSessionSearchConfig.h"
+#include "Data/SessionSearchFilter.h"
+#include "Filters/SessionFilterRule.h"
+#include "Filters/SessionSortRule.h"
+#include "Utils/NexusOnlineHelpers.h"
+#include "Utils/NexusTrace.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "UObject/UnrealType.h"
+
+
+namespace
+{
+	/** Classe + valeurs des propriétés : deux règles de même classe aux paramètres différents n'ont pas la même clé. */
+	FString DescribeRule(const UObject* Rule)
+	{
+		FString Description = Rule->GetClass()->GetPathName();
+
+		for (TFieldIterator<FProperty> It(Rule->GetClass()); It; ++It)
+		{
+			const FProperty* Property = *It;
+			if (Property->HasAnyPropertyFlags(CPF_Transient | CPF_DuplicateTransient))
+				continue;
+
+			FString Value;
+			Property->ExportTextItem_InContainer(Value, Rule, nullptr, nullptr, PPF_None);
+			Description += FString::Printf(TEXT(":%s=%s"), *Property->GetName(), *Value);
+		}
+
+		return Description;
+	}
+}
+
+
+void UNexusSessionCacheSubsystem::Deinitialize()
+{
+	Entries.Empty();
+	SessionIndex.Empty();
+	OnRefreshCompleted.Clear();
+
+	Super::Deinitialize();
+}
+
+UNexusSessionCacheSubsystem* UNexusSessionCacheSubsystem::Get(const UObject* WorldContextObject)
+{
+	UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	return GameInstance ? GameInstance->GetSubsystem<UNexusSessionCacheSubsystem>() : nullptr;
+}
+
+// ──────────────────────────────────────────────
+// KEYS
+// ──────────────────────────────────────────────
+
+FString UNexusSessionCacheSubsystem::MakeCacheKey(ENexusSessionType SessionType, bool bIsLAN, int32 MaxResults,
+	const TArray<FSessionSearchFilter>& SimpleFilters,
+	const TArray<TObjectPtr<USessionFilterRule>>& AdvancedRules,
+	const TArray<TObjectPtr<USessionSortRule>>& SortRules)
+{
+	// Filtres et règles de filtrage : l'ordre n'a pas d'effet sur le résultat -> triés
+	TArray<FString> FilterParts;
+	FilterParts.Reserve(SimpleFilters.Num() + AdvancedRules.Num());
+
+	for (const FSessionSearchFilter& Filter : SimpleFilters)
+	{
+		if (Filter.Key.IsNone())
+			continue;
+
+		FString Value = Filter.Value.ToDebugString();
+		if (Filter.Value.Type == ENexusSessionFilterValueType::String)
+		{
+			Value.ToLowerInline();
+		}
+
+		FilterParts.Add(FString::Printf(TEXT("%s|%d|%d|%s"), *Filter.Key.ToString().ToLower(),
+			static_cast<int32>(Filter.ComparisonOp), static_cast<int32>(Filter.Value.Type), *Value));
+	}
+
+	for (const TObjectPtr<USessionFilterRule>& Rule : AdvancedRules)
+	{
+		if (Rule && Rule->bEnabled)
+		{
+			FilterParts.Add(TEXT("R:") + DescribeRule(Rule));
+		}
+	}
+
+	FilterParts.Sort();
+
+	// Règles de tri : l'ordre compte (déjà trié par priorité)
+	TArray<FString> SortParts;
+	for (const TObjectPtr<USessionSortRule>& Rule : SortRules)
+	{
+		if (Rule && Rule->bEnabled)
+		{
+			SortParts.Add(DescribeRule(Rule));
+		}
+	}
+
+	return FString::Printf(TEXT("%s|%s|%d#%s#%s"),
+		*NexusOnline::SessionTypeToName(SessionType).ToString(),
+		bIsLAN ? TEXT("LAN") : TEXT("WAN"),
+		MaxResults,
+		*FString::Join(FilterParts, TEXT(";")),
+		*FString::Join(SortParts, TEXT(";")));
+}
+
+// ──────────────────────────────────────────────
+// LOOKUP
+// ──────────────────────────────────────────────
+
+ENexusSessionCacheState UNexusSessionCacheSubsystem::GetEntryState(const FString& CacheKey) const
+{
+	const UNexusSessionSearchConfig* Config = GetDefault<UNexusSessionSearchConfig>();
+	if (!Config || !Config->bEnableCache)
+		return ENexusSessionCacheState::Missing;
+
+	const FCacheEntry* Entry = Entries.Find(CacheKey);
+	if (!Entry || !Entry->bHasData)
+		return ENexusSessionCacheState::Missing;
+
+	const double Age = FPlatformTime::Seconds() - Entry->FetchTime;
+	if (Age <= Config->CacheFreshTime)
+		return ENexusSessionCacheState::Fresh;
+
+	if (Age <= Config->CacheMaxStaleTime)
+		return ENexusSessionCacheState::Stale;
+
+	return ENexusSessionCacheState::Expired;
+}
+
+bool UNexusSessionCacheSubsystem::GetCachedResults(const FString& CacheKey, TArray<FOnlineSessionSearchResultData>& OutResults, float& OutAge)
+{
+	const ENexusSessionCacheState State = GetEntryState(CacheKey);
+	if (State != ENexusSessionCacheState::Fresh && State != ENexusSessionCacheState::Stale)
+		return false;
+
+	FCacheEntry& Entry = Entries.FindChecked(CacheKey);
+	const double Now = FPlatformTime::Seconds();
+
+	Entry.LastAccessTime = Now;
+	OutResults = Entry.Results;
+	OutAge = static_cast<float>(Now - Entry.FetchTime);
+	return true;
+}
+
+const TArray<FOnlineSessionSearchResultData>* UNexusSessionCacheSubsystem::FindResults(const FString& CacheKey) const
+{
+	const FCacheEntry* Entry = Entries.Find(CacheKey);
+	return (Entry && Entry->bHasData) ? &Entry->Results : nullptr;
+}
+
+bool UNexusSessionCacheSubsystem::IsRefreshInFlight(const FString& CacheKey) const
+{
+	const FCacheEntry* Entry = Entries.Find(CacheKey);
+	if (!Entry || !Entry->bRefreshInFlight)
+		return false;
+
+	// Une recherche détruite en cours de route (changement de map...) ne doit pas bloquer la clé indéfiniment
+	const UNexusSessionSearchConfig* Config = GetDefault<UNexusSessionSearchConfig>();
+	const double Timeout = Config ? Config->RefreshTimeout : 30.0;
+	return (FPlatformTime::Seconds() - Entry->RefreshStartTime) < Timeout;
+}
+
+// ──────────────────────────────────────────────
+// REFRESH
+// ──────────────────────────────────────────────
+
+bool UNexusSessionCacheSubsystem::BeginRefresh(const FString& CacheKey)
+{
+	if (IsRefreshInFlight(CacheKey))
+		return false;
+
+	const double Now = FPlatformTime::Seconds();
+
+	FCacheEntry& Entry = Entries.FindOrAdd(CacheKey);
+	Entry.bRefreshInFlight = true;
+	Entry.RefreshStartTime = Now;
+	Entry.LastAccessTime = Now;
+
+	TrimEntries();
+	return true;
+}
+
+void UNexusSessionCacheSubsystem::CompleteRefresh(const FString& CacheKey, bool bWasSuccessful, const TArray<FOnlineSessionSearchResultData>& Results)
+{
+	FNexusSessionResultDiff Diff;
+
+	FCacheEntry& Entry = Entries.FindOrAdd(CacheKey);
+	Entry.bRefreshInFlight = false;
+
+	if (bWasSuccessful)
+	{
+		// Premier remplissage : pas de diff, les résultats sont livrés par OnCompleted
+		if (Entry.bHasData)
+		{
+			Diff = ComputeDiff(Entry.Results, Results);
+		}
+
+		Entry.Results = Results;
+		Entry.FetchTime = FPlatformTime::Seconds();
+		Entry.bHasData = true;
+
+		UE_LOG(LogNexusOnline, Verbose, TEXT("[NexusSessionCache] Refreshed '%s' : %d results (+%d / -%d / ~%d)."),
+			*CacheKey, Results.Num(), Diff.Added.Num(), Diff.Removed.Num(), Diff.Updated.Num());
+	}
+
+	OnRefreshCompleted.Broadcast(CacheKey, bWasSuccessful, Diff);
+
+	if (!Diff.IsEmpty())
+	{
+		OnCacheUpdated.Broadcast(CacheKey, Diff);
+	}
+}
+
+void UNexusSessionCacheSubsystem::AbandonRefresh(const FString& CacheKey)
+{
+	FCacheEntry* Entry = Entries.Find(CacheKey);
+	if (!Entry || !Entry->bRefreshInFlight)
+		return;
+
+	Entry->bRefreshInFlight = false;
+
+	UE_LOG(LogNexusOnline, Verbose, TEXT("[NexusSessionCache] Refresh of '%s' abandoned by its search."), *CacheKey);
+	OnRefreshCompleted.Broadcast(CacheKey, false, FNexusSessionResultDiff());
+}
+
+// ──────────────────────────────────────────────
+// SESSION ID INDEX
+// ──────────────────────────────────────────────
+
+void UNexusSessionCacheSubsystem::IndexResults(const TArray<FOnlineSessionSearchResultData>& Results)
+{
+	const UNexusSessionSearchConfig* Config = GetDefault<UNexusSessionSearchConfig>();
+	if (!Config || !Config->bEnableIdIndex || Results.IsEmpty())
+		return;
+
+	const double Now = FPlatformTime::Seconds();
+	for (const FOnlineSessionSearchResultData& Result : Results)
+	{
+		if (!Result.HasRawResult())
+			continue;
+
+		// Résultat sans identité exploitable : toutes ces sessions partageraient la même entrée
+		const FString SessionId = NexusOnline::GetSessionIdentity(Result.GetRawResult());
+		if (SessionId.IsEmpty() || SessionId == TEXT("InvalidSession"))
+			continue;
+
+		FIndexedSession& Entry = SessionIndex.FindOrAdd(SessionId);
+		Entry.Result = Result;
+		Entry.IndexTime = Now;
+	}
+
+	TrimIndex();
+}
+
+bool UNexusSessionCacheSubsystem::FindIndexedSession(const FString& SessionId, FOnlineSessionSearchResultData& OutResult) const
+{
+	const UNexusSessionSearchConfig* Config = GetDefault<UNexusSessionSearchConfig>();
+	if (!Config || !Config->bEnableIdIndex)
+		return false;
+
+	const FIndexedSession* Entry = SessionIndex.Find(SessionId);
+	if (!Entry || (FPlatformTime::Seconds() - Entry->IndexTime) > Config->IdIndexMaxAge)
+		return false;
+
+	OutResult = Entry->Result;
+	return true;
+}
+
+void UNexusSessionCacheSubsystem::RemoveIndexedSession(const FString& SessionId)
+{
+	SessionIndex.Remove(SessionId);
+}
+
+void UNexusSessionCacheSubsystem::TrimIndex()
+{
+	const UNexusSessionSearchConfig* Config = GetDefault<UNexusSessionSearchConfig>();
+	const int32 MaxIndexed = Config ? Config->MaxIndexedSessions : 1024;
+	const double MaxAge = Config ? Config->IdIndexMaxAge : 30.0;
+
+	if (SessionIndex.Num() <= MaxIndexed)
+		return;
+
+	// Les entrées périmées d'abord : elles ne répondraient plus à aucune recherche
+	const double Now = FPlatformTime::Seconds();
+	for (auto It = SessionIndex.CreateIterator(); It; ++It)
+	{
+		if ((Now - It->Value.IndexTime) > MaxAge)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	if (SessionIndex.Num() <= MaxIndexed)
+		return;
+
+	SessionIndex.ValueSort([](const FIndexedSession& A, const FIndexedSession& B)
+	{
+		return A.IndexTime > B.IndexTime;
+	});
+
+	TArray<FString> Evicted;
+	int32 Position = 0;
+	for (const TPair<FString, FIndexedSession>& Pair : SessionIndex)
+	{
+		if (Position++ >= MaxIndexed)
+		{
+			Evicted.Add(Pair.Key);
+		}
+	}
+
+	for (const FString& SessionId : Evicted)
+	{
+		SessionIndex.Remove(SessionId);
+	}
+}
+
+// ──────────────────────────────────────────────
+// INVALIDATION
+// ──────────────────────────────────────────────
+
+void UNexusSessionCacheSubsystem::InvalidateAll()
+{
+	// Entrées gardées : une recherche en vol doit pouvoir les compléter
+	for (TPair<FString, FCacheEntry>& Pair : Entries)
+	{
+		Pair.Value.bHasData = false;
+		Pair.Value.Results.Empty();
+	}
+
+	SessionIndex.Empty();
+}
+
+void UNexusSessionCacheSubsystem::TrimEntries()
+{
+	const UNexusSessionSearchConfig* Config = GetDefault<UNexusSessionSearchConfig>();
+	const int32 MaxEntries = Config ? Config->MaxCacheEntries : 16;
+
+	while (Entries.Num() > MaxEntries)
+	{
+		const FString* OldestKey = nullptr;
+		double OldestAccess = TNumericLimits<double>::Max();
+
+		for (const TPair<FString, FCacheEntry>& Pair : Entries)
+		{
+			if (!Pair.Value.bRefreshInFlight && Pair.Value.LastAccessTime < OldestAccess)
+			{
+				OldestAccess = Pair.Value.LastAccessTime;
+				OldestKey = &Pair.Key;
+			}
+		}
+
+		if (!OldestKey)
+			break;
+
+		Entries.Remove(FString(*OldestKey));
+	}
+}
+
+// ──────────────────────────────────────────────
+// DIFF
+// ──────────────────────────────────────────────
+
+FNexusSessionResultDiff UNexusSessionCacheSubsystem::ComputeDiff(const TArray<FOnlineSessionSearchResultData>& OldResults, const TArray<FOnlineSessionSearchResultData>& NewResults)
+{
+	FNexusSessionResultDiff Diff;
+
+	TMap<FString, int32> OldIndexById;
+	OldIndexById.Reserve(OldResults.Num());
+	for (int32 i = 0; i < OldResults.Num(); ++i)
+	{
+		OldIndexById.Add(NexusOnline::GetSessionIdentity(OldResults[i].GetRawResult()), i);
+	}
+
+	TSet<FString> SeenIds;
+	SeenIds.Reserve(NewResults.Num());
+
+	for (const FOnlineSessionSearchResultData& New : NewResults)
+	{
+		const FString Id = NexusOnline::GetSessionIdentity(New.GetRawResult());
+		SeenIds.Add(Id);
+
+		const int32* OldIndex = OldIndexById.Find(Id);
+		if (!OldIndex)
+		{
+			Diff.Added.Add(New);
+			continue;
+		}
+
+		const FOnlineSessionSearchResultData& Old = OldResults[*OldIndex];
+		if (Old.CurrentPlayers != New.CurrentPlayers || Old.MaxPlayers != New.MaxPlayers || Old.Ping != New.Ping
+			|| Old.SessionDisplayName != New.SessionDisplayName || Old.MapName != New.MapName || Old.GameMode != New.GameMode)
+		{
+			Diff.Updated.Add(New);
+		}
+	}
+
+	for (const FOnlineSessionSearchResultData& Old : OldResults)
+	{
+		if (!SeenIds.Contains(NexusOnline::GetSessionIdentity(Old.GetRawResult())))
+		{
+			Diff.Removed.Add(Old);
+		}
+	}
+
+	return Diff;
+}
@@ -0,0 +1,730 @@
+#include "Subsystems/NexusSessionOperationSubsystem.h"
+#include "Configs/NexusSessionUpdateConfig.h"
+#include "Subsystems/NexusSessionCacheSubsystem.h"
+#include "Utils/NexusOnlineHelpers.h"
+#include "Utils/NexusTrace.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+
+
+namespace
+{
+	/** A dropped operation answering after this long (seconds) is no longer expected. */
+	constexpr double LateAnswerWindow = 120.0;
+
+	const TCHAR* OperationTypeToString(ENexusSessionOperationType Type)
+	{
+		switch (Type)
+		{
+		case ENexusSessionOperationType::Create:  return TEXT("Create");
+		case ENexusSessionOperationType::Join:    return TEXT("Join");
+		case ENexusSessionOperationType::Destroy: return TEXT("Destroy");
+		}
+		return TEXT("?");
+	}
+
+	const TCHAR* OperationStatusToString(ENexusSessionOperationStatus Status)
+	{
+		switch (Status)
+		{
+		case ENexusSessionOperationStatus::Succeeded: return TEXT("succeeded");
+		case ENexusSessionOperationStatus::Failed:    return TEXT("failed");
+		case ENexusSessionOperationStatus::Cancelled: return TEXT("cancelled");
+		case ENexusSessionOperationStatus::TimedOut:  return TEXT("timed out");
+		}
+		return TEXT("?");
+	}
+}
+
+
+void UNexusSessionOperationSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UNexusSessionOperationSubsystem::Tick), 0.1f);
+}
+
+void UNexusSessionOperationSubsystem::Deinitialize()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+
+	// Les appelants encore en attente sont prévenus ; les appels OSS en vol n'ont plus de destinataire
+	TArray<FName> SessionNames;
+	Queues.GetKeys(SessionNames);
+
+	for (const FName SessionName : SessionNames)
+	{
+		TArray<FOperationRef> Operations;
+		if (Queues.RemoveAndCopyValue(SessionName, Operations))
+		{
+			for (const FOperationRef& Operation : Operations)
+			{
+				if (!Operation->bAbandoned)
+				{
+					NotifyCallers(*Operation, ENexusSessionOperationStatus::Cancelled, EOnJoinSessionCompleteResult::UnknownError);
+				}
+			}
+		}
+	}
+
+	UnbindSessionDelegates();
+
+	Super::Deinitialize();
+}
+
+UNexusSessionOperationSubsystem* UNexusSessionOperationSubsystem::Get(const UObject* WorldContextObject)
+{
+	UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	return GameInstance ? GameInstance->GetSubsystem<UNexusSessionOperationSubsystem>() : nullptr;
+}
+
+int32 UNexusSessionOperationSubsystem::GetQueueLength(FName SessionName) const
+{
+	const TArray<FOperationRef>* Queue = Queues.Find(SessionName);
+	return Queue ? Queue->Num() : 0;
+}
+
+// ──────────────────────────────────────────────
+// REQUESTS
+// ──────────────────────────────────────────────
+
+int32 UNexusSessionOperationSubsystem::Enqueue(FNexusSessionOperationRequest&& Request, FOnNexusSessionOperationComplete OnComplete)
+{
+	TArray<FOperationRef>& Queue = Queues.FindOrAdd(Request.SessionName);
+
+	// ---- Même demande déjà en attente ou en cours : l'appelant attend le même résultat
+	if (!Request.CoalesceKey.IsEmpty())
+	{
+		for (const FOperationRef& Existing : Queue)
+		{
+			if (!Existing->bAbandoned && Existing->Request.Type == Request.Type && Existing->Request.CoalesceKey == Request.CoalesceKey)
+			{
+				Existing->Completions.Add(MoveTemp(OnComplete));
+
+				UE_LOG(LogNexusOnline, Log, TEXT("[NexusSessionOps] %s on '%s' merged into operation #%d."),
+					OperationTypeToString(Request.Type), *Request.SessionName.ToString(), Existing->Id);
+				return Existing->Id;
+			}
+		}
+	}
+
+	const UNexusSessionUpdateConfig* Config = GetDefault<UNexusSessionUpdateConfig>();
+	const float Timeout = Request.Timeout >= 0.f ? Request.Timeout : (Config ? Config->OperationTimeout : 30.f);
+
+	FOperationRef Operation = MakeShared<FOperation>();
+	Operation->Id = NextOperationId++;
+	Operation->EnqueueTime = FPlatformTime::Seconds();
+	Operation->Timeout = Timeout;
+	Operation->Request = MoveTemp(Request);
+
+	// Échéance armée au démarrage pour les tentatives qui ne doivent pas payer l'attente
+	if (Timeout > 0.f && !Operation->Request.bDeadlineFromStart)
+	{
+		Operation->Deadline = Operation->EnqueueTime + Timeout;
+	}
+
+	Operation->Completions.Add(MoveTemp(OnComplete));
+
+	const FName SessionName = Operation->Request.SessionName;
+	const int32 OperationId = Operation->Id;
+
+	Queue.Add(Operation);
+
+	UE_LOG(LogNexusOnline, Log, TEXT("[NexusSessionOps] #%d %s on '%s' queued (%d in queue)."),
+		OperationId, OperationTypeToString(Operation->Request.Type), *SessionName.ToString(), Queue.Num());
+
+	Pump(SessionName);
+	return OperationId;
+}
+
+bool UNexusSessionOperationSubsystem::CancelOperation(int32 OperationId)
+{
+	TSharedPtr<FOperation> Operation = FindOperation(OperationId);
+	if (!Operation.IsValid() || Operation->bAbandoned)
+		return false;
+
+	if (Operation->Step == EStep::Pending)
+	{
+		Complete(Operation.ToSharedRef(), ENexusSessionOperationStatus::Cancelled);
+	}
+	else
+	{
+		Abandon(Operation.ToSharedRef(), ENexusSessionOperationStatus::Cancelled);
+	}
+
+	return true;
+}
+
+void UNexusSessionOperationSubsystem::CancelAll(FName SessionName)
+{
+	const TArray<FOperationRef>* Queue = Queues.Find(SessionName);
+	if (!Queue)
+		return;
+
+	// Copie : chaque annulation modifie la file
+	const TArray<FOperationRef> Operations = *Queue;
+	for (const FOperationRef& Operation : Operations)
+	{
+		CancelOperation(Operation->Id);
+	}
+}
+
+// ──────────────────────────────────────────────
+// EXECUTION
+// ──────────────────────────────────────────────
+
+void UNexusSessionOperationSubsystem::Pump(FName SessionName)
+{
+	TArray<FOperationRef>* Queue = Queues.Find(SessionName);
+	if (!Queue)
+		return;
+
+	if (Queue->IsEmpty())
+	{
+		Queues.Remove(SessionName);
+		return;
+	}
+
+	// Une seule opération à la fois par nom de session
+	const FOperationRef Head = (*Queue)[0];
+	if (Head->Step == EStep::Pending)
+	{
+		StartOperation(Head);
+	}
+}
+
+void UNexusSessionOperationSubsystem::StartOperation(const FOperationRef& Operation)
+{
+	NEXUS_TRACE_SCOPE(NexusSessionOps_Start);
+
+	const FName SessionName = Operation->Request.SessionName;
+
+	IOnlineSessionPtr Session = GetSessionInterface();
+	if (!Session.IsValid())
+	{
+		UE_LOG(LogNexusOnline, Error, TEXT("[NexusSessionOps] #%d : online session interface invalid."), Operation->Id);
+		Complete(Operation, ENexusSessionOperationStatus::Failed);
+		return;
+	}
+
+	BindSessionDelegates(Session);
+
+	if (Operation->Timeout > 0.f && Operation->Request.bDeadlineFromStart)
+	{
+		Operation->Deadline = FPlatformTime::Seconds() + Operation->Timeout;
+	}
+
+	const bool bSessionExists = Session->GetNamedSession(SessionName) != nullptr;
+
+	if (Operation->Request.Type == ENexusSessionOperationType::Destroy)
+	{
+		if (!bSessionExists)
+		{
+			UE_LOG(LogNexusOnline, Warning, TEXT("[NexusSessionOps] #%d : no session '%s' to destroy."), Operation->Id, *SessionName.ToString());
+			Complete(Operation, ENexusSessionOperationStatus::Failed);
+			return;
+		}
+
+		Operation->Step = EStep::Running;
+		Operation->OssCallTime = NexusTrace::BeginOssCall();
+		BeginCall(*Operation, ENexusSessionOperationType::Destroy);
+		if (!Session->DestroySession(SessionName))
+		{
+			CancelCall(*Operation, ENexusSessionOperationType::Destroy);
+			Complete(Operation, ENexusSessionOperationStatus::Failed);
+		}
+		return;
+	}
+
+	// ---- Create / Join : la session existante est quittée d'abord
+	if (bSessionExists)
+	{
+		if (!Operation->Request.bReplaceExisting)
+		{
+			UE_LOG(LogNexusOnline, Warning, TEXT("[NexusSessionOps] #%d : session '%s' already exists."), Operation->Id, *SessionName.ToString());
+			Complete(Operation, ENexusSessionOperationStatus::Failed);
+			return;
+		}
+
+		UE_LOG(LogNexusOnline, Log, TEXT("[NexusSessionOps] #%d : existing session '%s' destroyed first."), Operation->Id, *SessionName.ToString());
+
+		Operation->Step = EStep::DestroyingExisting;
+		Operation->OssCallTime = NexusTrace::BeginOssCall();
+		BeginCall(*Operation, ENexusSessionOperationType::Destroy);
+		if (!Session->DestroySession(SessionName))
+		{
+			CancelCall(*Operation, ENexusSessionOperationType::Destroy);
+			Complete(Operation, ENexusSessionOperationStatus::Failed);
+		}
+		return;
+	}
+
+	RunAction(Operation);
+}
+
+void UNexusSessionOperationSubsystem::RunAction(const FOperationRef& Operation)
+{
+	NEXUS_TRACE_SCOPE(NexusSessionOps_RunAction);
+
+	IOnlineSessionPtr Session = GetSessionInterface();
+	if (!Session.IsValid())
+	{
+		Complete(Operation, ENexusSessionOperationStatus::Failed);
+		return;
+	}
+
+	const FName SessionName = Operation->Request.SessionName;
+	Operation->Step = EStep::Running;
+
+	bool bStarted = false;
+
+	if (Operation->Request.Type == ENexusSessionOperationType::Create)
+	{
+		UE_LOG(LogNexusOnline, Log, TEXT("[NexusSessionOps] #%d : creating session '%s'..."), Operation->Id, *SessionName.ToString());
+
+		Operation->OssCallTime = NexusTrace::BeginOssCall();
+		BeginCall(*Operation, ENexusSessionOperationType::Create);
+		bStarted = Session->CreateSession(0, SessionName, Operation->Request.Settings);
+	}
+	else if (Operation->Request.Type == ENexusSessionOperationType::Join)
+	{
+		if (!Operation->Request.JoinTarget.HasRawResult())
+		{
+			UE_LOG(LogNexusOnline, Error, TEXT("[NexusSessionOps] #%d : join target has no backing search result."), Operation->Id);
+			Complete(Operation, ENexusSessionOperationStatus::Failed);
+			return;
+		}
+
+		UE_LOG(LogNexusOnline, Log, TEXT("[NexusSessionOps] #%d : joining session '%s'..."), Operation->Id, *SessionName.ToString());
+
+		TSharedPtr<const FUniqueNetId> LocalPlayerId;
+		const UWorld* World = GetGameInstance() ? GetGameInstance()->GetWorld() : nullptr;
+		if (APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr)
+		{
+			if (ULocalPlayer* LP = PC->GetLocalPlayer())
+			{
+				LocalPlayerId = LP->GetPreferredUniqueNetId().GetUniqueNetId();
+			}
+		}
+
+		const FOnlineSessionSearchResult& RawResult = Operation->Request.JoinTarget.GetRawResult();
+		Operation->OssCallTime = NexusTrace::BeginOssCall();
+		BeginCall(*Operation, ENexusSessionOperationType::Join);
+		bStarted = LocalPlayerId.IsValid()
+			? Session->JoinSession(*LocalPlayerId, SessionName, RawResult)
+			: Session->JoinSession(0, SessionName, RawResult);
+	}
+
+	if (!bStarted)
+	{
+		CancelCall(*Operation, Operation->Request.Type);
+		Complete(Operation, ENexusSessionOperationStatus::Failed);
+	}
+}
+
+// ──────────────────────────────────────────────
+// COMPLETION
+// ──────────────────────────────────────────────
+
+void UNexusSessionOperationSubsystem::Complete(const FOperationRef& Operation, ENexusSessionOperationStatus Status, EOnJoinSessionCompleteResult::Type JoinResult)
+{
+	NEXUS_TRACE_SCOPE(NexusSessionOps_Complete);
+
+	const FName SessionName = Operation->Request.SessionName;
+	EndOssCall(*Operation);
+
+	// Retirée avant de prévenir (un callback peut remettre une opération dans la file).
+	// Déjà absente : l'OSS a répondu pendant l'appel puis renvoyé false, l'opération est terminée
+	if (!RemoveOperation(Operation))
+		return;
+
+	// Listes en cache périmées : notre session y apparaît / en disparaît, ou la session visée n'est plus joignable
+	const ENexusSessionOperationType Type = Operation->Request.Type;
+	const bool bSessionsChanged = (Status == ENexusSessionOperationStatus::Succeeded && Type != ENexusSessionOperationType::Join)
+		|| (Status == ENexusSessionOperationStatus::Failed && Type == ENexusSessionOperationType::Join);
+
+	if (bSessionsChanged)
+	{
+		if (UNexusSessionCacheSubsystem* Cache = GetGameInstance()->GetSubsystem<UNexusSessionCacheSubsystem>())
+		{
+			Cache->InvalidateAll();
+		}
+	}
+
+	if (!Operation->bAbandoned)
+	{
+		NotifyCallers(*Operation, Status, JoinResult);
+	}
+
+	Pump(SessionName);
+}
+
+void UNexusSessionOperationSubsystem::Abandon(const FOperationRef& Operation, ENexusSessionOperationStatus Status)
+{
+	NotifyCallers(*Operation, Status, EOnJoinSessionCompleteResult::UnknownError);
+
+	Operation->Completions.Reset();
+	Operation->bAbandoned = true;
+	Operation->AbandonTime = FPlatformTime::Seconds();
+}
+
+void UNexusSessionOperationSubsystem::FinishAbandoned(const FOperationRef& Operation, bool bSessionExists)
+{
+	// L'opération a abouti alors que personne ne l'attend plus : elle devient la destruction de ce qu'elle a créé / rejoint
+	if (bSessionExists && Operation->Request.Type != ENexusSessionOperationType::Destroy)
+	{
+		IOnlineSessionPtr Session = GetSessionInterface();
+		if (Session.IsValid())
+		{
+			UE_LOG(LogNexusOnline, Log, TEXT("[NexusSessionOps] #%d : abandoned %s succeeded, session '%s' rolled back."),
+				Operation->Id, OperationTypeToString(Operation->Request.Type), *Operation->Request.SessionName.ToString());
+
+			Operation->Request.Type = ENexusSessionOperationType::Destroy;
+			Operation->Step = EStep::Running;
+			Operation->AbandonTime = FPlatformTime::Seconds();
+			Operation->OssCallTime = NexusTrace::BeginOssCall();
+			BeginCall(*Operation, ENexusSessionOperationType::Destroy);
+
+			if (Session->DestroySession(Operation->Request.SessionName))
+				return;
+
+			CancelCall(*Operation, ENexusSessionOperationType::Destroy);
+		}
+	}
+
+	Complete(Operation, ENexusSessionOperationStatus::Cancelled);
+}
+
+void UNexusSessionOperationSubsystem::NotifyCallers(const FOperation& Operation, ENexusSessionOperationStatus Status, EOnJoinSessionCompleteResult::Type JoinResult) const
+{
+	FNexusSessionOperationResult Result;
+	Result.OperationId = Operation.Id;
+	Result.Type = Operation.Request.Type;
+	Result.SessionName = Operation.Request.SessionName;
+	Result.Status = Status;
+	Result.JoinResult = JoinResult;
+	Result.ElapsedMs = static_cast<float>((FPlatformTime::Seconds() - Operation.EnqueueTime) * 1000.0);
+
+	// Abandon : l'appel en vol compte jusqu'ici
+	Result.OssWaitMs = Operation.OssWaitMs;
+	if (Operation.OssCallTime > 0.0)
+	{
+		Result.OssWaitMs += static_cast<float>((FPlatformTime::Seconds() - Operation.OssCallTime) * 1000.0);
+	}
+
+	UE_LOG(LogNexusOnline, Log, TEXT("[NexusSessionOps] #%d %s on '%s' %s after %.1f ms (online service %.1f ms, %d caller(s))."),
+		Result.OperationId, OperationTypeToString(Result.Type), *Result.SessionName.ToString(),
+		OperationStatusToString(Status), Result.ElapsedMs, Result.OssWaitMs, Operation.Completions.Num());
+
+	// Copie : les appelants peuvent relancer une opération depuis leur callback
+	const TArray<FOnNexusSessionOperationComplete> Completions = Operation.Completions;
+	for (const FOnNexusSessionOperationComplete& Completion : Completions)
+	{
+		Completion.ExecuteIfBound(Result);
+	}
+}
+
+bool UNexusSessionOperationSubsystem::RemoveOperation(const FOperationRef& Operation)
+{
+	TArray<FOperationRef>* Queue = Queues.Find(Operation->Request.SessionName);
+	return Queue && Queue->Remove(Operation) > 0;
+}
+
+void UNexusSessionOperationSubsystem::EndOssCall(FOperation& Operation)
+{
+	Operation.OssWaitMs += NexusTrace::EndOssCall(Operation.OssCallTime);
+}
+
+TSharedPtr<UNexusSessionOperationSubsystem::FOperation> UNexusSessionOperationSubsystem::FindActive(FName SessionName) const
+{
+	const TArray<FOperationRef>* Queue = Queues.Find(SessionName);
+	if (!Queue || Queue->IsEmpty() || (*Queue)[0]->Step == EStep::Pending)
+		return nullptr;
+
+	return (*Queue)[0];
+}
+
+TSharedPtr<UNexusSessionOperationSubsystem::FOperation> UNexusSessionOperationSubsystem::FindOperation(int32 OperationId) const
+{
+	for (const TPair<FName, TArray<FOperationRef>>& Pair : Queues)
+	{
+		for (const FOperationRef& Operation : Pair.Value)
+		{
+			if (Operation->Id == OperationId)
+				return Operation;
+		}
+	}
+
+	return nullptr;
+}
+
+// ──────────────────────────────────────────────
+// DEADLINES
+// ──────────────────────────────────────────────
+
+bool UNexusSessionOperationSubsystem::Tick(float DeltaTime)
+{
+	if (Queues.IsEmpty() && PendingCalls.IsEmpty())
+		return true;
+
+	NEXUS_TRACE_SCOPE(NexusSessionOps_Tick);
+
+	const UNexusSessionUpdateConfig* Config = GetDefault<UNexusSessionUpdateConfig>();
+	const double Grace = Config ? Config->AbandonedOperationGrace : 15.0;
+	const double Now = FPlatformTime::Seconds();
+
+	// Appels d'opérations retirées de la file restés sans réponse : plus attendus
+	PendingCalls.RemoveAll([this, Now](const FOssCall& Call)
+	{
+		return (Now - Call.CallTime) > LateAnswerWindow && !FindOperation(Call.OperationId).IsValid();
+	});
+
+	TArray<FOperationRef> Expired;
+	TArray<FOperationRef> Stuck;
+
+	for (const TPair<FName, TArray<FOperationRef>>& Pair : Queues)
+	{
+		for (const FOperationRef& Operation : Pair.Value)
+		{
+			if (Operation->bAbandoned)
+			{
+				// Une tentative (Join Best Session...) ne bloque pas la suivante plus longtemps que sa propre échéance
+				const double OperationGrace = Operation->Request.AbandonGrace >= 0.f ? FMath::Min<double>(Grace, Operation->Request.AbandonGrace) : Grace;
+				if ((Now - Operation->AbandonTime) >= OperationGrace)
+				{
+					Stuck.Add(Operation);
+				}
+			}
+			else if (Operation->Deadline > 0.0 && Now >= Operation->Deadline)
+			{
+				Expired.Add(Operation);
+			}
+		}
+	}
+
+	for (const FOperationRef& Operation : Expired)
+	{
+		// Un callback précédent a pu l'annuler entre-temps
+		if (Operation->bAbandoned || !FindOperation(Operation->Id).IsValid())
+			continue;
+
+		if (Operation->Step == EStep::Pending)
+		{
+			Complete(Operation, ENexusSessionOperationStatus::TimedOut);
+		}
+		else
+		{
+			Abandon(Operation, ENexusSessionOperationStatus::TimedOut);
+		}
+	}
+
+	// L'OSS n'a jamais répondu : la file ne peut pas rester bloquée
+	for (const FOperationRef& Operation : Stuck)
+	{
+		if (!FindOperation(Operation->Id).IsValid())
+			continue;
+
+		UE_LOG(LogNexusOnline, Warning, TEXT("[NexusSessionOps] #%d : no answer from the online service, operation dropped."), Operation->Id);
+
+		// Sa réponse peut encore arriver (son appel reste dans PendingCalls) : elle sera annulée si elle a abouti
+		Complete(Operation, ENexusSessionOperationStatus::TimedOut);
+	}
+
+	return true;
+}
+
+// ──────────────────────────────────────────────
+// OSS
+// ──────────────────────────────────────────────
+
+IOnlineSessionPtr UNexusSessionOperationSubsystem::GetSessionInterface() const
+{
+	return NexusOnline::GetSessionInterface(GetGameInstance());
+}
+
+void UNexusSessionOperationSubsystem::BindSessionDelegates(const IOnlineSessionPtr& Session)
+{
+	if (BoundSession.Pin() == Session)
+		return;
+
+	UnbindSessionDelegates();
+
+	// Liés une seule fois : chaque réponse est routée vers l'opération en cours du même nom de session
+	CreateHandle = Session->AddOnCreateSessionCompleteDelegate_Handle(
+		FOnCreateSessionCompleteDelegate::CreateUObject(this, &UNexusSessionOperationSubsystem::HandleCreateComplete));
+	JoinHandle = Session->AddOnJoinSessionCompleteDelegate_Handle(
+		FOnJoinSessionCompleteDelegate::CreateUObject(this, &UNexusSessionOperationSubsystem::HandleJoinComplete));
+	DestroyHandle = Session->AddOnDestroySessionCompleteDelegate_Handle(
+		FOnDestroySessionCompleteDelegate::CreateUObject(this, &UNexusSessionOperationSubsystem::HandleDestroyComplete));
+
+	BoundSession = Session;
+}
+
+void UNexusSessionOperationSubsystem::UnbindSessionDelegates()
+{
+	if (IOnlineSessionPtr Session = BoundSession.Pin())
+	{
+		Session->ClearOnCreateSessionCompleteDelegate_Handle(CreateHandle);
+		Session->ClearOnJoinSessionCompleteDelegate_Handle(JoinHandle);
+		Session->ClearOnDestroySessionCompleteDelegate_Handle(DestroyHandle);
+	}
+
+	BoundSession.Reset();
+}
+
+void UNexusSessionOperationSubsystem::HandleCreateComplete(FName SessionName, bool bWasSuccessful)
+{
+	// Création lancée hors de la file : pas la nôtre
+	const int32 CallerId = TakeCall(SessionName, ENexusSessionOperationType::Create);
+	if (CallerId == INDEX_NONE)
+		return;
+
+	TSharedPtr<FOperation> Operation = FindActive(SessionName);
+	if (!Operation.IsValid() || Operation->Id != CallerId || Operation->Step != EStep::Running || Operation->Request.Type != ENexusSessionOperationType::Create)
+	{
+		HandleLateAnswer(SessionName, ENexusSessionOperationType::Create, bWasSuccessful);
+		return;
+	}
+
+	NEXUS_TRACE_SCOPE(NexusSessionOps_HandleCreate);
+	EndOssCall(*Operation);
+
+	if (Operation->bAbandoned)
+	{
+		FinishAbandoned(Operation.ToSharedRef(), bWasSuccessful);
+		return;
+	}
+
+	Complete(Operation.ToSharedRef(), bWasSuccessful ? ENexusSessionOperationStatus::Succeeded : ENexusSessionOperationStatus::Failed);
+}
+
+void UNexusSessionOperationSubsystem::HandleJoinComplete(FName SessionName, EOnJoinSessionCompleteResult::Type Result)
+{
+	const int32 CallerId = TakeCall(SessionName, ENexusSessionOperationType::Join);
+	if (CallerId == INDEX_NONE)
+		return;
+
+	// Réponse d'une tentative retirée de la file : elle ne termine pas le Join suivant du même nom
+	TSharedPtr<FOperation> Operation = FindActive(SessionName);
+	if (!Operation.IsValid() || Operation->Id != CallerId || Operation->Step != EStep::Running || Operation->Request.Type != ENexusSessionOperationType::Join)
+	{
+		HandleLateAnswer(SessionName, ENexusSessionOperationType::Join, Result == EOnJoinSessionCompleteResult::Success);
+		return;
+	}
+
+	NEXUS_TRACE_SCOPE(NexusSessionOps_HandleJoin);
+	EndOssCall(*Operation);
+
+	const bool bWasSuccessful = Result == EOnJoinSessionCompleteResult::Success;
+
+	if (Operation->bAbandoned)
+	{
+		FinishAbandoned(Operation.ToSharedRef(), bWasSuccessful);
+		return;
+	}
+
+	Complete(Operation.ToSharedRef(), bWasSuccessful ? ENexusSessionOperationStatus::Succeeded : ENexusSessionOperationStatus::Failed, Result);
+}
+
+void UNexusSessionOperationSubsystem::HandleDestroyComplete(FName SessionName, bool bWasSuccessful)
+{
+	// Destruction demandée hors de la file, ou par une opération déjà retirée : l'opération en cours n'est pas concernée
+	const int32 CallerId = TakeCall(SessionName, ENexusSessionOperationType::Destroy);
+	if (CallerId == INDEX_NONE)
+		return;
+
+	TSharedPtr<FOperation> Operation = FindActive(SessionName);
+	if (!Operation.IsValid() || Operation->Id != CallerId)
+		return;
+
+	NEXUS_TRACE_SCOPE(NexusSessionOps_HandleDestroy);
+
+	const FOperationRef OperationRef = Operation.ToSharedRef();
+
+	// ---- Destruction préalable d'un Create / Join
+	if (Operation->Step == EStep::DestroyingExisting)
+	{
+		EndOssCall(*Operation);
+
+		if (Operation->bAbandoned)
+		{
+			Complete(OperationRef, ENexusSessionOperationStatus::Cancelled);
+		}
+		else if (bWasSuccessful)
+		{
+			RunAction(OperationRef);
+		}
+		else
+		{
+			UE_LOG(LogNexusOnline, Error, TEXT("[NexusSessionOps] #%d : failed to destroy the existing session '%s'."), Operation->Id, *SessionName.ToString());
+			Complete(OperationRef, ENexusSessionOperationStatus::Failed);
+		}
+		return;
+	}
+
+	// ---- Destroy demandé (ou annulation d'un Create / Join abouti)
+	if (Operation->Step == EStep::Running && Operation->Request.Type == ENexusSessionOperationType::Destroy)
+	{
+		EndOssCall(*Operation);
+		Complete(OperationRef, bWasSuccessful ? ENexusSessionOperationStatus::Succeeded : ENexusSessionOperationStatus::Failed);
+	}
+}
+
+void UNexusSessionOperationSubsystem::HandleLateAnswer(FName SessionName, ENexusSessionOperationType Type, bool bWasSuccessful)
+{
+	if (!bWasSuccessful)
+		return;
+
+	// Une opération de la file gère déjà ce nom : elle remplace la session (bReplaceExisting) ou la détruit
+	if (Queues.Contains(SessionName))
+	{
+		UE_LOG(LogNexusOnline, Log, TEXT("[NexusSessionOps] Late %s on '%s' succeeded, left to the queued operation."), OperationTypeToString(Type), *SessionName.ToString());
+		return;
+	}
+
+	UE_LOG(LogNexusOnline, Log, TEXT("[NexusSessionOps] Late %s on '%s' succeeded after being dropped, rolled back."), OperationTypeToString(Type), *SessionName.ToString());
+
+	FNexusSessionOperationRequest Request;
+	Request.Type = ENexusSessionOperationType::Destroy;
+	Request.SessionName = SessionName;
+	Enqueue(MoveTemp(Request), FOnNexusSessionOperationComplete());
+}
+
+void UNexusSessionOperationSubsystem::BeginCall(const FOperation& Operation, ENexusSessionOperationType Type)
+{
+	PendingCalls.Add({ Operation.Id, Operation.Request.SessionName, Type, FPlatformTime::Seconds() });
+}
+
+void UNexusSessionOperationSubsystem::CancelCall(const FOperation& Operation, ENexusSessionOperationType Type)
+{
+	const int32 OperationId = Operation.Id;
+	const int32 Index = PendingCalls.IndexOfByPredicate([OperationId, Type](const FOssCall& Call)
+	{
+		return Call.OperationId == OperationId && Call.Type == Type;
+	});
+
+	if (Index != INDEX_NONE)
+	{
+		PendingCalls.RemoveAt(Index);
+	}
+}
+
+int32 UNexusSessionOperationSubsystem::TakeCall(FName SessionName, ENexusSessionOperationType Type)
+{
+	// Les réponses d'un même nom et d'un même type arrivent dans l'ordre des appels
+	const int32 Index = PendingCalls.IndexOfByPredicate([SessionName, Type](const FOssCall& Call)
+	{
+		return Call.SessionName == SessionName && Call.Type == Type;
+	});
+
+	if (Index == INDEX_NONE)
+		return INDEX_NONE;
+
+	const int32 OperationId = PendingCalls[Index].OperationId;
+	PendingCalls.RemoveAt(Index);
+	return OperationId;
+}
@@ -0,0 +1,284 @@
+#include "Subsystems/NexusSessionUpdateSubsystem.h"
+#include "Configs/NexusSessionUpdateConfig.h"
+#include "Utils/NexusOnlineHelpers.h"
+#include "Utils/NexusTrace.h"
+#include "Interfaces/OnlineSessionInterface.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+
+
+namespace
+{
+	FString GetNamedSessionId(const FNamedOnlineSession& Session)
+	{
+		return Session.SessionInfo.IsValid() ? Session.SessionInfo->GetSessionId().ToString() : FString();
+	}
+
+	bool ContainsPlayer(const TArray<FUniqueNetIdRef>& Players, const FUniqueNetId& PlayerId)
+	{
+		return Players.ContainsByPredicate([&PlayerId](const FUniqueNetIdRef& Other) { return *Other == PlayerId; });
+	}
+
+	bool RemovePlayer(TArray<FUniqueNetIdRef>& Players, const FUniqueNetId& PlayerId)
+	{
+		return Players.RemoveAll([&PlayerId](const FUniqueNetIdRef& Other) { return *Other == PlayerId; }) > 0;
+	}
+}
+
+
+void UNexusSessionUpdateSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UNexusSessionUpdateSubsystem::Tick), 0.1f);
+}
+
+void UNexusSessionUpdateSubsystem::Deinitialize()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+
+	// Les sessions encore en vie reçoivent ce qui était en attente
+	FlushAll();
+	AdvertisedStates.Empty();
+
+	Super::Deinitialize();
+}
+
+UNexusSessionUpdateSubsystem* UNexusSessionUpdateSubsystem::Get(const UObject* WorldContextObject)
+{
+	UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	return GameInstance ? GameInstance->GetSubsystem<UNexusSessionUpdateSubsystem>() : nullptr;
+}
+
+// ──────────────────────────────────────────────
+// REQUESTS
+// ──────────────────────────────────────────────
+
+void UNexusSessionUpdateSubsystem::QueueRegisterPlayer(FName SessionName, const FUniqueNetIdRepl& PlayerId)
+{
+	if (!PlayerId.IsValid())
+		return;
+
+	FPendingSession& Pending = TouchPending(SessionName);
+
+	// Départ puis retour dans la même fenêtre : le joueur n'a jamais quitté la session côté backend
+	if (RemovePlayer(Pending.ToUnregister, *PlayerId))
+	{
+		Stats.RegistrationsCancelled += 2;
+	}
+	else if (!ContainsPlayer(Pending.ToRegister, *PlayerId))
+	{
+		Pending.ToRegister.Add(PlayerId->AsShared());
+	}
+
+	Pending.bUpdateRequested = true;
+	++Stats.UpdatesRequested;
+
+	ScheduleOrFlush(SessionName);
+}
+
+void UNexusSessionUpdateSubsystem::QueueUnregisterPlayer(FName SessionName, const FUniqueNetIdRepl& PlayerId)
+{
+	if (!PlayerId.IsValid())
+		return;
+
+	FPendingSession& Pending = TouchPending(SessionName);
+
+	// Arrivée puis départ dans la même fenêtre : rien à envoyer pour ce joueur
+	if (RemovePlayer(Pending.ToRegister, *PlayerId))
+	{
+		Stats.RegistrationsCancelled += 2;
+	}
+	else if (!ContainsPlayer(Pending.ToUnregister, *PlayerId))
+	{
+		Pending.ToUnregister.Add(PlayerId->AsShared());
+	}
+
+	Pending.bUpdateRequested = true;
+	++Stats.UpdatesRequested;
+
+	ScheduleOrFlush(SessionName);
+}
+
+void UNexusSessionUpdateSubsystem::RequestSessionUpdate(FName SessionName)
+{
+	TouchPending(SessionName).bUpdateRequested = true;
+	++Stats.UpdatesRequested;
+
+	ScheduleOrFlush(SessionName);
+}
+
+UNexusSessionUpdateSubsystem::FPendingSession& UNexusSessionUpdateSubsystem::TouchPending(FName SessionName)
+{
+	const double Now = FPlatformTime::Seconds();
+
+	FPendingSession* Pending = PendingSessions.Find(SessionName);
+	if (!Pending)
+	{
+		Pending = &PendingSessions.Add(SessionName);
+		Pending->FirstRequestTime = Now;
+	}
+
+	Pending->LastRequestTime = Now;
+	return *Pending;
+}
+
+void UNexusSessionUpdateSubsystem::ScheduleOrFlush(FName SessionName)
+{
+	const UNexusSessionUpdateConfig* Config = GetDefault<UNexusSessionUpdateConfig>();
+	if (!Config || !Config->bBatchUpdates)
+	{
+		FlushSession(SessionName);
+	}
+}
+
+// ──────────────────────────────────────────────
+// FLUSH
+// ──────────────────────────────────────────────
+
+bool UNexusSessionUpdateSubsystem::Tick(float DeltaTime)
+{
+	if (PendingSessions.IsEmpty())
+		return true;
+
+	const UNexusSessionUpdateConfig* Config = GetDefault<UNexusSessionUpdateConfig>();
+	const double Window = Config ? Config->CoalesceWindow : 1.0;
+	const double MaxDelay = Config ? Config->MaxUpdateDelay : 3.0;
+	const double Now = FPlatformTime::Seconds();
+
+	TArray<FName, TInlineAllocator<4>> Ready;
+	for (const TPair<FName, FPendingSession>& Pair : PendingSessions)
+	{
+		if ((Now - Pair.Value.LastRequestTime) >= Window || (Now - Pair.Value.FirstRequestTime) >= MaxDelay)
+		{
+			Ready.Add(Pair.Key);
+		}
+	}
+
+	for (const FName SessionName : Ready)
+	{
+		FlushSession(SessionName);
+	}
+
+	return true;
+}
+
+void UNexusSessionUpdateSubsystem::FlushAll()
+{
+	TArray<FName> SessionNames;
+	PendingSessions.GetKeys(SessionNames);
+
+	for (const FName SessionName : SessionNames)
+	{
+		FlushSession(SessionName);
+	}
+}
+
+void UNexusSessionUpdateSubsystem::FlushSession(FName SessionName)
+{
+	FPendingSession Pending;
+	if (!PendingSessions.RemoveAndCopyValue(SessionName, Pending))
+		return;
+
+	IOnlineSessionPtr Session = NexusOnline::GetSessionInterface(GetGameInstance());
+	FNamedOnlineSession* Named = Session.IsValid() ? Session->GetNamedSession(SessionName) : nullptr;
+	if (!Named)
+	{
+		// Session détruite entre-temps : les demandes n'ont plus de cible
+		AdvertisedStates.Remove(SessionName);
+		UE_LOG(LogNexusOnline, Verbose, TEXT("[NexusSessionUpdate] '%s' no longer exists, pending updates dropped."), *SessionName.ToString());
+		return;
+	}
+
+	// ---- Enregistrements groupés
+	if (Pending.ToRegister.Num() > 0)
+	{
+		Session->RegisterPlayers(SessionName, Pending.ToRegister, false);
+		Stats.PlayersRegistered += Pending.ToRegister.Num();
+		++Stats.RegistrationBatches;
+	}
+
+	if (Pending.ToUnregister.Num() > 0)
+	{
+		Session->UnregisterPlayers(SessionName, Pending.ToUnregister);
+		Stats.PlayersUnregistered += Pending.ToUnregister.Num();
+		++Stats.RegistrationBatches;
+	}
+
+	if (!Pending.bUpdateRequested)
+		return;
+
+	// RegisterPlayers peut avoir invalidé le pointeur (sessions recréées par certains OSS)
+	Named = Session->GetNamedSession(SessionName);
+	if (!Named)
+		return;
+
+	// ---- Diff contre la dernière annonce envoyée
+	const UNexusSessionUpdateConfig* Config = GetDefault<UNexusSessionUpdateConfig>();
+	const FAdvertisedState* Previous = AdvertisedStates.Find(SessionName);
+	const bool bSameSession = Previous && Previous->SessionId == GetNamedSessionId(*Named);
+	const int32 ChangedKeys = bSameSession ? CountChangedKeys(*Previous, *Named) : INDEX_NONE;
+
+	if (ChangedKeys == 0 && Config && Config->bSkipUnchangedUpdates)
+	{
+		++Stats.UpdatesSkipped;
+		UE_LOG(LogNexusOnline, Verbose, TEXT("[NexusSessionUpdate] '%s' unchanged, update skipped."), *SessionName.ToString());
+		return;
+	}
+
+	Session->UpdateSession(SessionName, Named->SessionSettings, true);
+	++Stats.UpdatesSent;
+	Stats.ChangedKeys += FMath::Max(ChangedKeys, 0);
+
+	FAdvertisedState& State = AdvertisedStates.FindOrAdd(SessionName);
+	State.SessionId = GetNamedSessionId(*Named);
+	State.Settings = Named->SessionSettings;
+	State.NumOpenPublicConnections = Named->NumOpenPublicConnections;
+	State.NumOpenPrivateConnections = Named->NumOpenPrivateConnections;
+
+	UE_LOG(LogNexusOnline, Verbose, TEXT("[NexusSessionUpdate] '%s' advertised (%d changed key(s), +%d / -%d players). Sent %d / requested %d."),
+		*SessionName.ToString(), ChangedKeys, Pending.ToRegister.Num(), Pending.ToUnregister.Num(), Stats.UpdatesSent, Stats.UpdatesRequested);
+}
+
+int32 UNexusSessionUpdateSubsystem::CountChangedKeys(const FAdvertisedState& Previous, const FNamedOnlineSession& Current)
+{
+	const FOnlineSessionSettings& Old = Previous.Settings;
+	const FOnlineSessionSettings& New = Current.SessionSettings;
+
+	int32 Changed = 0;
+
+	// ---- Champs de la session
+	Changed += (Previous.NumOpenPublicConnections != Current.NumOpenPublicConnections);
+	Changed += (Previous.NumOpenPrivateConnections != Current.NumOpenPrivateConnections);
+	Changed += (Old.NumPublicConnections != New.NumPublicConnections);
+	Changed += (Old.NumPrivateConnections != New.NumPrivateConnections);
+	Changed += (Old.bShouldAdvertise != New.bShouldAdvertise);
+	Changed += (Old.bAllowJoinInProgress != New.bAllowJoinInProgress);
+	Changed += (Old.bAllowInvites != New.bAllowInvites);
+	Changed += (Old.bUsesPresence != New.bUsesPresence);
+	Changed += (Old.bAllowJoinViaPresence != New.bAllowJoinViaPresence);
+	Changed += (Old.bAllowJoinViaPresenceFriendsOnly != New.bAllowJoinViaPresenceFriendsOnly);
+	Changed += (Old.BuildUniqueId != New.BuildUniqueId);
+
+	// ---- Clés personnalisées (ajoutées, modifiées ou retirées)
+	for (const TPair<FName, FOnlineSessionSetting>& Pair : New.Settings)
+	{
+		const FOnlineSessionSetting* OldSetting = Old.Settings.Find(Pair.Key);
+		if (!OldSetting || !(OldSetting->Data == Pair.Value.Data) || OldSetting->AdvertisementType != Pair.Value.AdvertisementType)
+		{
+			++Changed;
+		}
+	}
+
+	for (const TPair<FName, FOnlineSessionSetting>& Pair : Old.Settings)
+	{
+		if (!New.Settings.Contains(Pair.Key))
+		{
+			++Changed;
+		}
+	}
+
+	return Changed;
+}
@@ -0,0 +1,762 @@
+#include "Subsystems/NexusSnapshotSubsystem.h"
+#include "Components/NexusSnapshotComponent.h"
+#include "Configs/NexusMigrationConfig.h"
+#include "Managers/OnlineSessionManager.h"
+#include "Utils/NexusTrace.h"
+#include "Engine/Engine.h"
+#include "Engine/ActorChannel.h"
+#include "Engine/NetConnection.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerState.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+#include "Misc/Compression.h"
+
+
+namespace
+{
+	constexpr uint32 SnapshotMagic = 0x5353584E; // "NXSS"
+	constexpr uint8 SnapshotVersion = 2;
+
+	/** Garde-fou sur les tailles annoncées par le réseau. */
+	constexpr int32 MaxSnapshotBytes = 64 * 1024 * 1024;
+
+	/** Morceaux fiables non acquittés sur le canal du contrôleur : bien en dessous de RELIABLE_BUFFER (débordement = déconnexion). */
+	constexpr int32 MaxPendingReliableBunches = RELIABLE_BUFFER / 4;
+
+	/** ClampMax de SnapshotBandwidthKBps, réappliqué aux valeurs venues d'un .ini. */
+	constexpr int32 MaxSnapshotBandwidthKBps = 1024;
+
+	enum class EEntryOp : uint8
+	{
+		Full,		// Classe + données complètes
+		Xor,		// Même taille que la base : données XOR base (les octets inchangés valent 0 et se compressent)
+		Removed
+	};
+
+	/** Indicateurs d'une entrée complète. */
+	enum EEntryFlags : uint8
+	{
+		EntryIsActor = 1 << 0,
+		EntryRespawn = 1 << 1
+	};
+}
+
+
+void UNexusSnapshotSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UNexusSnapshotSubsystem::Tick));
+}
+
+void UNexusSnapshotSubsystem::Deinitialize()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+
+	ResetChannel();
+	Registered.Reset();
+
+	Super::Deinitialize();
+}
+
+UNexusSnapshotSubsystem* UNexusSnapshotSubsystem::Get(const UObject* WorldContextObject)
+{
+	UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	return GameInstance ? GameInstance->GetSubsystem<UNexusSnapshotSubsystem>() : nullptr;
+}
+
+// ──────────────────────────────────────────────
+// Registration
+// ──────────────────────────────────────────────
+
+void UNexusSnapshotSubsystem::RegisterObject(UObject* Object, FName Key, bool bRespawnIfMissing)
+{
+	if (!Object)
+		return;
+
+	const FName EntryKey = Key.IsNone() ? Object->GetFName() : Key;
+	Registered.Add(Object, FRegistration{ EntryKey, bRespawnIfMissing && Object->IsA<AActor>() });
+
+	// Restauration différée : l'objet s'inscrit après RestoreLatestSnapshot
+	if (const FEntry* Pending = PendingRestore.Find(EntryKey))
+	{
+		LoadObjectState(Object, *Pending);
+		PendingRestore.Remove(EntryKey);
+
+		UE_LOG(LogNexusMigration, Verbose, TEXT("[NexusSnapshot] '%s' restored on registration."), *EntryKey.ToString());
+	}
+}
+
+void UNexusSnapshotSubsystem::UnregisterObject(UObject* Object)
+{
+	Registered.Remove(Object);
+}
+
+// ──────────────────────────────────────────────
+// Capture / restore
+// ──────────────────────────────────────────────
+
+void UNexusSnapshotSubsystem::Capture(FState& OutState)
+{
+	NEXUS_TRACE_SCOPE(NexusSnapshot_Capture);
+
+	OutState.Reserve(Registered.Num());
+	for (auto It = Registered.CreateIterator(); It; ++It)
+	{
+		UObject* Object = It->Key.Get();
+		if (!Object)
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		FEntry& Entry = OutState.Add(It->Value.Key);
+		SaveObjectState(Object, Entry);
+		Entry.bRespawn = It->Value.bRespawnIfMissing;
+	}
+}
+
+void UNexusSnapshotSubsystem::SaveObjectState(UObject* Object, FEntry& OutEntry)
+{
+	OutEntry.ClassPath = Object->GetClass()->GetPathName();
+
+	FMemoryWriter Writer(OutEntry.Data, true);
+	FObjectAndNameAsStringProxyArchive Ar(Writer, true);
+	Ar.ArIsSaveGame = true;
+	Ar.ArNoDelta = true; // Valeurs par défaut comprises : la restauration ne dépend pas de l'état de l'objet cible
+
+	if (AActor* Actor = Cast<AActor>(Object))
+	{
+		OutEntry.bIsActor = true;
+		FTransform Transform = Actor->GetActorTransform();
+		Ar << Transform;
+	}
+
+	Object->Serialize(Ar);
+}
+
+void UNexusSnapshotSubsystem::LoadObjectState(UObject* Object, const FEntry& Entry)
+{
+	FMemoryReader Reader(Entry.Data, true);
+	FObjectAndNameAsStringProxyArchive Ar(Reader, true);
+	Ar.ArIsSaveGame = true;
+	Ar.ArNoDelta = true;
+
+	if (Entry.bIsActor)
+	{
+		FTransform Transform;
+		Ar << Transform;
+
+		if (AActor* Actor = Cast<AActor>(Object))
+		{
+			Actor->SetActorTransform(Transform, false, nullptr, ETeleportType::TeleportPhysics);
+		}
+	}
+
+	Object->Serialize(Ar);
+}
+
+int32 UNexusSnapshotSubsystem::RestoreLatestSnapshot(UWorld* World)
+{
+	NEXUS_TRACE_SCOPE(NexusSnapshot_Restore);
+
+	if (!World || HeldSequence == INDEX_NONE)
+		return 0;
+
+	const int32 Sequence = HeldSequence;
+	PendingRestore = MoveTemp(HeldState);
+	HeldState.Reset();
+	HeldSequence = INDEX_NONE;
+
+	int32 Restored = 0;
+	TArray<AActor*> Removed;
+
+	// 1. Objets déjà inscrits : acteurs placés (BeginPlay passé), sous-systèmes
+	for (auto It = Registered.CreateIterator(); It; ++It)
+	{
+		UObject* Object = It->Key.Get();
+		if (!Object)
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		if (const FEntry* Entry = PendingRestore.Find(It->Value.Key))
+		{
+			LoadObjectState(Object, *Entry);
+			PendingRestore.Remove(It->Value.Key);
+			++Restored;
+			continue;
+		}
+
+		// Acteur de la map détruit chez l'ancien hôte : le rechargement l'a fait réapparaître
+		AActor* Actor = Cast<AActor>(Object);
+		if (Actor && Actor->GetWorld() == World && Actor->IsNetStartupActor())
+		{
+			Removed.Add(Actor);
+		}
+	}
+
+	// Détruits hors de l'itération : leur EndPlay peut se désinscrire
+	for (AActor* Actor : Removed)
+	{
+		UE_LOG(LogNexusMigration, Verbose, TEXT("[NexusSnapshot] '%s' is not in the snapshot : destroyed."), *Actor->GetName());
+		Actor->Destroy();
+	}
+
+	// 2. Acteurs absents de la map (apparus en cours de partie) inscrits pour être recréés depuis leur classe.
+	// Clés copiées d'abord : le BeginPlay de l'acteur peut s'inscrire et retirer son entrée.
+	TArray<FName> ActorKeys;
+	for (const TPair<FName, FEntry>& Pair : PendingRestore)
+	{
+		if (Pair.Value.bIsActor && Pair.Value.bRespawn)
+		{
+			ActorKeys.Add(Pair.Key);
+		}
+	}
+
+	for (const FName& Key : ActorKeys)
+	{
+		const FEntry* Entry = PendingRestore.Find(Key);
+		UClass* ActorClass = Entry ? LoadClass<AActor>(nullptr, *Entry->ClassPath) : nullptr;
+		if (!ActorClass)
+		{
+			UE_LOG(LogNexusMigration, Warning, TEXT("[NexusSnapshot] Cannot respawn '%s' : class '%s' not found."), *Key.ToString(), Entry ? *Entry->ClassPath : TEXT("?"));
+			PendingRestore.Remove(Key);
+			continue;
+		}
+
+		FActorSpawnParameters Params;
+		Params.Name = Key;
+		Params.NameMode = FActorSpawnParameters::ESpawnActorNameMode::Requested;
+		Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+		AActor* Actor = World->SpawnActor<AActor>(ActorClass, FTransform::Identity, Params);
+		if (!Actor)
+			continue;
+
+		++Restored;
+
+		// Pas inscrit par son BeginPlay : appliqué et inscrit ici
+		if (const FEntry* Remaining = PendingRestore.Find(Key))
+		{
+			LoadObjectState(Actor, *Remaining);
+			PendingRestore.Remove(Key);
+			Registered.Add(Actor, FRegistration{ Key, true });
+		}
+	}
+
+	UE_LOG(LogNexusMigration, Log, TEXT("[NexusSnapshot] Snapshot #%d restored : %d object(s), %d removed, %d waiting for registration."), Sequence, Restored, Removed.Num(), PendingRestore.Num());
+	OnSnapshotRestored.Broadcast(Sequence, Restored);
+
+	return Restored;
+}
+
+void UNexusSnapshotSubsystem::ClearHeldSnapshot()
+{
+	HeldState.Reset();
+	HeldSequence = INDEX_NONE;
+	PendingRestore.Reset();
+	IncomingBlob.Reset();
+	IncomingSequence = INDEX_NONE;
+	IncomingReceived = 0;
+}
+
+// ──────────────────────────────────────────────
+// Wire format
+// ──────────────────────────────────────────────
+
+void UNexusSnapshotSubsystem::Encode(int32 Sequence, const FState& State, const FState* Baseline, int32 BaselineSequence, TArray<uint8>& OutBlob, int32& OutChangedEntries)
+{
+	NEXUS_TRACE_SCOPE(NexusSnapshot_Encode);
+
+	// ---- Corps : seules les entrées qui diffèrent de la base
+	TArray<uint8> Body;
+	FMemoryWriter BodyWriter(Body);
+	int32 NumOps = 0;
+
+	for (const TPair<FName, FEntry>& Pair : State)
+	{
+		const FEntry* Previous = Baseline ? Baseline->Find(Pair.Key) : nullptr;
+		const bool bSameHeader = Previous && Previous->ClassPath == Pair.Value.ClassPath && Previous->bRespawn == Pair.Value.bRespawn;
+		if (bSameHeader && Previous->Data == Pair.Value.Data)
+			continue;
+
+		FString Key = Pair.Key.ToString();
+		BodyWriter << Key;
+
+		if (bSameHeader && Previous->Data.Num() == Pair.Value.Data.Num())
+		{
+			uint8 Op = static_cast<uint8>(EEntryOp::Xor);
+			BodyWriter << Op;
+
+			TArray<uint8> Delta;
+			Delta.SetNumUninitialized(Pair.Value.Data.Num());
+			for (int32 Index = 0; Index < Delta.Num(); ++Index)
+			{
+				Delta[Index] = Pair.Value.Data[Index] ^ Previous->Data[Index];
+			}
+			BodyWriter << Delta;
+		}
+		else
+		{
+			uint8 Op = static_cast<uint8>(EEntryOp::Full);
+			FString ClassPath = Pair.Value.ClassPath;
+			uint8 Flags = (Pair.Value.bIsActor ? EntryIsActor : 0) | (Pair.Value.bRespawn ? EntryRespawn : 0);
+			TArray<uint8> Data = Pair.Value.Data;
+			BodyWriter << Op << ClassPath << Flags << Data;
+		}
+
+		++NumOps;
+	}
+
+	if (Baseline)
+	{
+		for (const TPair<FName, FEntry>& Pair : *Baseline)
+		{
+			if (State.Contains(Pair.Key))
+				continue;
+
+			FString Key = Pair.Key.ToString();
+			uint8 Op = static_cast<uint8>(EEntryOp::Removed);
+			BodyWriter << Key << Op;
+			++NumOps;
+		}
+	}
+
+	OutChangedEntries = NumOps;
+
+	// ---- Trame : en-tête + corps
+	TArray<uint8> Raw;
+	FMemoryWriter Writer(Raw);
+	uint32 Magic = SnapshotMagic;
+	uint8 Version = SnapshotVersion;
+	Writer << Magic << Version << Sequence << BaselineSequence << NumOps;
+	Raw.Append(Body);
+
+	// ---- Compression ; taille brute en tête (négative = stockée sans compression)
+	int32 RawSize = Raw.Num();
+	int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Oodle, RawSize);
+	TArray<uint8> Compressed;
+	Compressed.SetNumUninitialized(CompressedSize);
+
+	const bool bCompressed = FCompression::CompressMemory(NAME_Oodle, Compressed.GetData(), CompressedSize, Raw.GetData(), RawSize)
+		&& CompressedSize < RawSize;
+
+	OutBlob.Reset();
+	FMemoryWriter BlobWriter(OutBlob);
+	int32 StoredSize = bCompressed ? RawSize : -RawSize;
+	BlobWriter << StoredSize;
+
+	if (bCompressed)
+	{
+		OutBlob.Append(Compressed.GetData(), CompressedSize);
+	}
+	else
+	{
+		OutBlob.Append(Raw);
+	}
+}
+
+bool UNexusSnapshotSubsystem::Decode(const TArray<uint8>& Blob, const FState* Baseline, FState& OutState)
+{
+	NEXUS_TRACE_SCOPE(NexusSnapshot_Decode);
+
+	if (Blob.Num() < static_cast<int32>(sizeof(int32)))
+		return false;
+
+	int32 StoredSize = 0;
+	FMemoryReader BlobReader(Blob);
+	BlobReader << StoredSize;
+
+	const uint8* Payload = Blob.GetData() + sizeof(int32);
+	const int32 PayloadSize = Blob.Num() - sizeof(int32);
+	const int32 RawSize = FMath::Abs(StoredSize);
+	if (RawSize > MaxSnapshotBytes)
+		return false;
+
+	TArray<uint8> Raw;
+	if (StoredSize >= 0)
+	{
+		Raw.SetNumUninitialized(RawSize);
+		if (!FCompression::UncompressMemory(NAME_Oodle, Raw.GetData(), RawSize, Payload, PayloadSize))
+			return false;
+	}
+	else
+	{
+		if (PayloadSize != RawSize)
+			return false;
+
+		Raw.Append(Payload, PayloadSize);
+	}
+
+	FMemoryReader Reader(Raw);
+	uint32 Magic = 0;
+	uint8 Version = 0;
+	int32 Sequence = INDEX_NONE;
+	int32 BaselineSequence = INDEX_NONE;
+	int32 NumOps = 0;
+	Reader << Magic << Version << Sequence << BaselineSequence << NumOps;
+
+	if (Reader.IsError() || Magic != SnapshotMagic || Version != SnapshotVersion)
+		return false;
+
+	OutState = Baseline ? *Baseline : FState();
+
+	for (int32 Index = 0; Index < NumOps && !Reader.IsError(); ++Index)
+	{
+		FString KeyString;
+		uint8 Op = 0;
+		Reader << KeyString << Op;
+		const FName Key(*KeyString);
+
+		switch (static_cast<EEntryOp>(Op))
+		{
+		case EEntryOp::Full:
+			{
+				FEntry& Entry = OutState.FindOrAdd(Key);
+				uint8 Flags = 0;
+				Reader << Entry.ClassPath << Flags << Entry.Data;
+				Entry.bIsActor = (Flags & EntryIsActor) != 0;
+				Entry.bRespawn = (Flags & EntryRespawn) != 0;
+				break;
+			}
+
+		case EEntryOp::Xor:
+			{
+				TArray<uint8> Delta;
+				Reader << Delta;
+
+				FEntry* Entry = OutState.Find(Key);
+				if (!Entry || Entry->Data.Num() != Delta.Num())
+					return false;
+
+				for (int32 Byte = 0; Byte < Delta.Num(); ++Byte)
+				{
+					Entry->Data[Byte] ^= Delta[Byte];
+				}
+				break;
+			}
+
+		case EEntryOp::Removed:
+			OutState.Remove(Key);
+			break;
+
+		default:
+			return false;
+		}
+	}
+
+	return !Reader.IsError();
+}
+
+// ──────────────────────────────────────────────
+// Heir side
+// ──────────────────────────────────────────────
+
+void UNexusSnapshotSubsystem::ReceiveChunk(UNexusSnapshotComponent* Component, int32 Sequence, int32 BaselineSequence, int32 TotalSize, int32 Offset, const TArray<uint8>& Chunk)
+{
+	if (!Component)
+		return;
+
+	// Premier morceau d'un nouveau snapshot (RPC fiables : les morceaux arrivent dans l'ordre)
+	if (Offset == 0)
+	{
+		if (TotalSize <= 0 || TotalSize > MaxSnapshotBytes)
+			return;
+
+		IncomingSequence = Sequence;
+		IncomingBaselineSequence = BaselineSequence;
+		IncomingBlob.SetNumUninitialized(TotalSize);
+		IncomingReceived = 0;
+	}
+
+	if (Sequence != IncomingSequence || Offset != IncomingReceived || Offset + Chunk.Num() > IncomingBlob.Num())
+	{
+		UE_LOG(LogNexusMigration, Warning, TEXT("[NexusSnapshot] Unexpected chunk of snapshot #%d at %d. Asking for a keyframe."), Sequence, Offset);
+		IncomingBlob.Reset();
+		IncomingSequence = INDEX_NONE;
+		IncomingReceived = 0;
+		Component->Server_AckSnapshot(INDEX_NONE);
+		return;
+	}
+
+	FMemory::Memcpy(IncomingBlob.GetData() + Offset, Chunk.GetData(), Chunk.Num());
+	IncomingReceived += Chunk.Num();
+
+	if (IncomingReceived < IncomingBlob.Num())
+		return;
+
+	// ---- Complet : appliqué sur la base détenue (delta) ou seul (image complète)
+	const bool bKeyframe = IncomingBaselineSequence == INDEX_NONE;
+	FState Decoded;
+
+	if ((bKeyframe || IncomingBaselineSequence == HeldSequence) && Decode(IncomingBlob, bKeyframe ? nullptr : &HeldState, Decoded))
+	{
+		HeldState = MoveTemp(Decoded);
+		HeldSequence = IncomingSequence;
+		++Stats.SnapshotsReceived;
+
+		UE_LOG(LogNexusMigration, Verbose, TEXT("[NexusSnapshot] Snapshot #%d held (%d bytes, %d object(s), %s)."),
+			HeldSequence, IncomingBlob.Num(), HeldState.Num(), bKeyframe ? TEXT("keyframe") : TEXT("delta"));
+
+		Component->Server_AckSnapshot(HeldSequence);
+	}
+	else
+	{
+		// La snapshot détenue reste utilisable pour une migration ; l'hôte renvoie une image complète
+		UE_LOG(LogNexusMigration, Warning, TEXT("[NexusSnapshot] Snapshot #%d rejected (baseline #%d, held #%d). Asking for a keyframe."),
+			IncomingSequence, IncomingBaselineSequence, HeldSequence);
+		++Stats.SnapshotsRejected;
+
+		Component->Server_AckSnapshot(INDEX_NONE);
+	}
+
+	IncomingBlob.Reset();
+	IncomingSequence = INDEX_NONE;
+	IncomingReceived = 0;
+}
+
+// ──────────────────────────────────────────────
+// Host side
+// ──────────────────────────────────────────────
+
+bool UNexusSnapshotSubsystem::IsServerWorld() const
+{
+	const UWorld* World = GetGameInstance() ? GetGameInstance()->GetWorld() : nullptr;
+	if (!World)
+		return false;
+
+	const ENetMode NetMode = World->GetNetMode();
+	return NetMode == NM_ListenServer || NetMode == NM_DedicatedServer;
+}
+
+bool UNexusSnapshotSubsystem::Tick(float DeltaTime)
+{
+	NEXUS_TRACE_SCOPE(NexusSnapshot_Tick);
+
+	const UNexusMigrationConfig* Config = GetDefault<UNexusMigrationConfig>();
+	if (!Config || !Config->bEnableMigration || !Config->bEnableSnapshots || !IsServerWorld())
+	{
+		if (!HeirId.IsEmpty())
+		{
+			ResetChannel();
+		}
+		return true;
+	}
+
+	UpdateHeirChannel(GetGameInstance()->GetWorld());
+	if (!HeirComponent.IsValid() || !bHeirReady)
+		return true;
+
+	const double Now = FPlatformTime::Seconds();
+
+	// Acquittement jamais reçu (ne devrait pas arriver en fiable) : la base acquittée reste la référence
+	if (SentSequence != INDEX_NONE && OutgoingBlob.Num() == 0 && Now - SentTime > Config->SnapshotInterval * 10.f)
+	{
+		SentState.Reset();
+		SentSequence = INDEX_NONE;
+	}
+
+	if (SentSequence == INDEX_NONE && Now >= NextCaptureTime)
+	{
+		NextCaptureTime = Now + Config->SnapshotInterval;
+		StartCapture();
+	}
+
+	SendChunks(DeltaTime);
+	return true;
+}
+
+void UNexusSnapshotSubsystem::UpdateHeirChannel(UWorld* World)
+{
+	const AOnlineSessionManager* Manager = World ? AOnlineSessionManager::Get(World) : nullptr;
+	const FString NewHeirId = (Manager && Manager->HeirList.Num() > 0) ? Manager->HeirList[0].ToString() : FString();
+
+	if (NewHeirId == HeirId && (HeirId.IsEmpty() || HeirComponent.IsValid()))
+		return;
+
+	ResetChannel();
+	HeirId = NewHeirId;
+	if (HeirId.IsEmpty())
+		return;
+
+	APlayerController* HeirPC = nullptr;
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		APlayerController* PC = It->Get();
+		if (PC && PC->PlayerState && PC->PlayerState->GetUniqueId().ToString() == HeirId)
+		{
+			HeirPC = PC;
+			break;
+		}
+	}
+
+	if (!HeirPC)
+		return;
+
+	// Composant déjà présent (classe du contrôleur, ou héritier précédent) : déjà répliqué, utilisable tout de suite
+	UNexusSnapshotComponent* Component = HeirPC->FindComponentByClass<UNexusSnapshotComponent>();
+	bHeirReady = Component != nullptr;
+
+	if (!Component)
+	{
+		Component = NewObject<UNexusSnapshotComponent>(HeirPC, TEXT("NexusSnapshotComponent"));
+		Component->RegisterComponent();
+	}
+
+	HeirComponent = Component;
+
+	UE_LOG(LogNexusMigration, Log, TEXT("[NexusSnapshot] Streaming snapshots to heir %s."), *HeirId);
+}
+
+void UNexusSnapshotSubsystem::StartCapture()
+{
+	const UNexusMigrationConfig* Config = GetDefault<UNexusMigrationConfig>();
+
+	FState State;
+	Capture(State);
+
+	const bool bKeyframe = AckedSequence == INDEX_NONE || SnapshotsSinceKeyframe + 1 >= Config->SnapshotKeyframeInterval;
+	const int32 Sequence = NextSequence++;
+	const int32 BaselineSequence = bKeyframe ? INDEX_NONE : AckedSequence;
+
+	int32 ChangedEntries = 0;
+	Encode(Sequence, State, bKeyframe ? nullptr : &AckedState, BaselineSequence, OutgoingBlob, ChangedEntries);
+
+	int32 StateBytes = 0;
+	for (const TPair<FName, FEntry>& Pair : State)
+	{
+		StateBytes += Pair.Value.Data.Num();
+	}
+
+	Stats.LastStateBytes = StateBytes;
+	Stats.LastChangedEntries = ChangedEntries;
+
+	// Rien n'a bougé depuis la base acquittée : rien à envoyer
+	if (!bKeyframe && ChangedEntries == 0)
+	{
+		OutgoingBlob.Reset();
+		Stats.LastSentBytes = 0;
+		NexusTrace::RecordSnapshot(StateBytes, 0);
+		return;
+	}
+
+	SnapshotsSinceKeyframe = bKeyframe ? 0 : SnapshotsSinceKeyframe + 1;
+	Stats.LastSentBytes = OutgoingBlob.Num();
+	if (bKeyframe)
+	{
+		++Stats.KeyframesSent;
+	}
+
+	SentState = MoveTemp(State);
+	SentSequence = Sequence;
+	SentBaselineSequence = BaselineSequence;
+	SentTime = FPlatformTime::Seconds();
+	OutgoingOffset = 0;
+
+	NexusTrace::RecordSnapshot(StateBytes, OutgoingBlob.Num());
+}
+
+void UNexusSnapshotSubsystem::SendChunks(float DeltaTime)
+{
+	UNexusSnapshotComponent* Component = HeirComponent.Get();
+	if (!Component || OutgoingBlob.Num() == 0)
+		return;
+
+	const UNexusMigrationConfig* Config = GetDefault<UNexusMigrationConfig>();
+	const int32 ChunkSize = FMath::Clamp(Config->SnapshotChunkSize, 256, 16384);
+	const float BytesPerSecond = FMath::Clamp(Config->SnapshotBandwidthKBps, 1, MaxSnapshotBandwidthKBps) * 1024.f;
+
+	// Connexion de l'héritier : le flux cède la place au jeu quand elle sature
+	AActor* Owner = Component->GetOwner();
+	UNetConnection* Connection = Owner ? Owner->GetNetConnection() : nullptr;
+	if (!Connection)
+		return;
+
+	// Seau à jetons plafonné à un quart de seconde : pas de rafale après une pause
+	SendBudget = FMath::Min(SendBudget + BytesPerSecond * DeltaTime, FMath::Max(static_cast<float>(ChunkSize), BytesPerSecond * 0.25f));
+
+	while (OutgoingOffset < OutgoingBlob.Num())
+	{
+		const int32 Size = FMath::Min(ChunkSize, OutgoingBlob.Num() - OutgoingOffset);
+		if (SendBudget < Size)
+			break;
+
+		// Données déjà en attente d'envoi, ou trop de RPC fiables en vol : on reprend au tick suivant
+		if (Connection->QueuedBits + Connection->SendBuffer.GetNumBits() > 0)
+			break;
+
+		const UActorChannel* Channel = Connection->FindActorChannelRef(Owner);
+		if (Channel && Channel->NumOutRec >= MaxPendingReliableBunches)
+			break;
+
+		TArray<uint8> Chunk(OutgoingBlob.GetData() + OutgoingOffset, Size);
+		Component->Client_ReceiveSnapshotChunk(SentSequence, SentBaselineSequence, OutgoingBlob.Num(), OutgoingOffset, Chunk);
+
+		OutgoingOffset += Size;
+		SendBudget -= Size;
+		Stats.BytesSent += Size;
+	}
+
+	if (OutgoingOffset >= OutgoingBlob.Num())
+	{
+		++Stats.SnapshotsSent;
+		OutgoingBlob.Reset();
+		OutgoingOffset = 0;
+	}
+}
+
+void UNexusSnapshotSubsystem::HandleAck(UNexusSnapshotComponent* Component, int32 Sequence)
+{
+	if (!Component || Component != HeirComponent.Get())
+		return;
+
+	bHeirReady = true;
+
+	if (Sequence == INDEX_NONE)
+	{
+		// Canal prêt, ou delta rejeté : la prochaine capture sera une image complète
+		AckedState.Reset();
+		AckedSequence = INDEX_NONE;
+
+		if (OutgoingBlob.Num() == 0)
+		{
+			SentState.Reset();
+			SentSequence = INDEX_NONE;
+		}
+		return;
+	}
+
+	if (Sequence == SentSequence)
+	{
+		AckedState = MoveTemp(SentState);
+		AckedSequence = SentSequence;
+		SentState.Reset();
+		SentSequence = INDEX_NONE;
+	}
+}
+
+void UNexusSnapshotSubsystem::ResetChannel()
+{
+	HeirComponent.Reset();
+	HeirId.Empty();
+	bHeirReady = false;
+	SnapshotsSinceKeyframe = 0;
+	NextCaptureTime = 0.0;
+
+	AckedState.Reset();
+	AckedSequence = INDEX_NONE;
+
+	SentState.Reset();
+	SentSequence = INDEX_NONE;
+	SentBaselineSequence = INDEX_NONE;
+	OutgoingBlob.Reset();
+	OutgoingOffset = 0;
+	SendBudget = 0.f;
+}
@@ -0,0 +1,80 @@
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "Engine/World.h"
+#include "Engine/GameInstance.h"
+#include "Managers/OnlineSessionManager.h"
+#include "Subsystems/NexusMigrationSubsystem.h"
+#include "Subsystems/NexusSnapshotSubsystem.h"
+
+#if !UE_BUILD_SHIPPING
+
+// ──────────────────────────────────────────────
+// Classement des héritiers (serveur)
+// Usage : Nexus.Migration.Heirs
+// ──────────────────────────────────────────────
+namespace NexusMigrationCommands
+{
+	static void Heirs(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		AOnlineSessionManager* Manager = AOnlineSessionManager::Get(World);
+		if (!Manager)
+		{
+			Ar.Logf(TEXT("[NexusMigration] No session manager in this world."));
+			return;
+		}
+
+		const TArray<FString> HeirIds = Manager->GetHeirList();
+		Ar.Logf(TEXT("[NexusMigration] Replicated heirs : %d (next host '%s')."), HeirIds.Num(), *Manager->GetNextHostUniqueId());
+
+		// Vue locale : adresse de reconnexion directe, veille et dernière migration
+		if (const UNexusMigrationSubsystem* Migration = World && World->GetGameInstance() ? World->GetGameInstance()->GetSubsystem<UNexusMigrationSubsystem>() : nullptr)
+		{
+			const FNexusMigrationMetrics Last = Migration->GetLastMigrationMetrics();
+			Ar.Logf(TEXT("[NexusMigration] Next host address '%s' | local standby %s | last recovery %.0f ms (generation %d)."),
+				*Migration->GetCachedNextHostAddress(), Migration->IsInStandby() ? TEXT("ON") : TEXT("off"), Last.TotalMs, Last.Generation);
+		}
+
+		// Détail des scores : disponible uniquement là où le classement est calculé
+		const TArray<FNexusHeirScore> Ranking = Manager->GetHeirRanking();
+		for (int32 Index = 0; Index < Ranking.Num(); ++Index)
+		{
+			const FNexusHeirScore& Entry = Ranking[Index];
+			Ar.Logf(TEXT("  #%d %s : score %.2f | rtt %.0f ms | loss %.1f%% | up %d kbps | tier %d | standby %s%s"),
+				Index + 1, *Entry.PlayerId, Entry.Score, Entry.RttMs, Entry.PacketLoss * 100.f,
+				Entry.UploadKbps, Entry.HardwareTier, Entry.StandbyAddress.IsEmpty() ? TEXT("-") : *Entry.StandbyAddress,
+				Entry.bRegistered ? TEXT("") : TEXT(" | not registered"));
+		}
+	}
+
+	// ──────────────────────────────────────────────
+	// Flux de snapshots vers l'héritier
+	// Usage : Nexus.Migration.Snapshot
+	// ──────────────────────────────────────────────
+	static void Snapshot(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		const UNexusSnapshotSubsystem* Snapshots = UNexusSnapshotSubsystem::Get(World);
+		if (!Snapshots)
+		{
+			Ar.Logf(TEXT("[NexusSnapshot] Snapshot subsystem unavailable."));
+			return;
+		}
+
+		const FNexusSnapshotStats Stats = Snapshots->GetStats();
+		Ar.Logf(TEXT("[NexusSnapshot] Host : %d sent (%d keyframes), %lld bytes. Last capture %d bytes -> %d on the wire, %d changed object(s)."),
+			Stats.SnapshotsSent, Stats.KeyframesSent, Stats.BytesSent, Stats.LastStateBytes, Stats.LastSentBytes, Stats.LastChangedEntries);
+		Ar.Logf(TEXT("[NexusSnapshot] Heir : %d received, %d rejected, holding #%d."),
+			Stats.SnapshotsReceived, Stats.SnapshotsRejected, Snapshots->GetHeldSequence());
+	}
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GNexusMigrationHeirsCommand(
+	TEXT("Nexus.Migration.Heirs"),
+	TEXT("Prints the ranked heir list, the local standby state and, on the host, each candidate's score. Usage: Nexus.Migration.Heirs"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&NexusMigrationCommands::Heirs));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GNexusMigrationSnapshotCommand(
+	TEXT("Nexus.Migration.Snapshot"),
+	TEXT("Prints the game state snapshot stream counters (host and heir side). Usage: Nexus.Migration.Snapshot"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&NexusMigrationCommands::Snapshot));
+
+#endif
@@ -0,0 +1,88 @@
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "Subsystems/NexusPingProberSubsystem.h"
+
+#if !UE_BUILD_SHIPPING
+
+// ──────────────────────────────────────────────
+// Sondes de ping contre un écho local
+// Usage : Nexus.Ping.Echo [Port]                 -> démarre le répondeur (stand-in d'un hôte)
+//         Nexus.Ping.Probe 127.0.0.1:7787 [N]    -> envoie N sondes (tout écho UDP convient)
+//         Nexus.Ping.Show 127.0.0.1:7787         -> affiche l'estimation courante
+// ──────────────────────────────────────────────
+namespace NexusPingCommands
+{
+	static UNexusPingProberSubsystem* GetProber(UWorld* World, FOutputDevice& Ar)
+	{
+		UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+		UNexusPingProberSubsystem* Prober = GameInstance ? GameInstance->GetSubsystem<UNexusPingProberSubsystem>() : nullptr;
+		if (!Prober)
+		{
+			Ar.Logf(TEXT("[NexusPing] No game instance / prober subsystem."));
+		}
+		return Prober;
+	}
+
+	static void Echo(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		if (UNexusPingProberSubsystem* Prober = GetProber(World, Ar))
+		{
+			const int32 Port = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 0;
+			Ar.Logf(TEXT("[NexusPing] Echo responder %s."), Prober->StartEchoResponder(Port) ? TEXT("running") : TEXT("failed to start"));
+		}
+	}
+
+	static void Probe(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		if (Args.Num() < 1)
+		{
+			Ar.Logf(TEXT("Usage: Nexus.Ping.Probe ip:port [NumProbes]"));
+			return;
+		}
+
+		if (UNexusPingProberSubsystem* Prober = GetProber(World, Ar))
+		{
+			const int32 NumProbes = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 0;
+			Ar.Logf(TEXT("[NexusPing] Probing %s : %s."), *Args[0], Prober->ProbeAddress(Args[0], NumProbes) ? TEXT("queued") : TEXT("failed"));
+		}
+	}
+
+	static void Show(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		if (Args.Num() < 1)
+		{
+			Ar.Logf(TEXT("Usage: Nexus.Ping.Show ip:port"));
+			return;
+		}
+
+		FNexusPingEstimate Estimate;
+		if (!FNexusPingCache::Get().FindByHost(Args[0], Estimate))
+		{
+			Ar.Logf(TEXT("[NexusPing] No estimate for %s."), *Args[0]);
+			return;
+		}
+
+		Ar.Logf(TEXT("[NexusPing] %s : srtt %.2f ms, jitter %.2f ms, last %.2f ms, %d samples, %d lost (%.0f%%)."),
+			*Args[0], Estimate.SmoothedRttMs, Estimate.JitterMs, Estimate.LastRttMs,
+			Estimate.NumSamples, Estimate.NumLost, Estimate.GetLossRatio() * 100.f);
+	}
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GNexusPingEchoCommand(
+	TEXT("Nexus.Ping.Echo"),
+	TEXT("Starts the ping echo responder (local stand-in for a session host). Usage: Nexus.Ping.Echo [Port]"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&NexusPingCommands::Echo));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GNexusPingProbeCommand(
+	TEXT("Nexus.Ping.Probe"),
+	TEXT("Sends UDP ping probes to an address. Usage: Nexus.Ping.Probe ip:port [NumProbes]"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&NexusPingCommands::Probe));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GNexusPingShowCommand(
+	TEXT("Nexus.Ping.Show"),
+	TEXT("Prints the RTT estimate of an address. Usage: Nexus.Ping.Show ip:port"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&NexusPingCommands::Show));
+
+#endif
@@ -0,0 +1,168 @@
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "OnlineSessionSettings.h"
+#include "Data/SessionSearchFilter.h"
+#include "Filters/Rules/SessionFilterRule_KeyValue.h"
+
+#if !UE_BUILD_SHIPPING
+
+// ──────────────────────────────────────────────
+// Benchmark : filtres legacy vs prédicats compilés
+// Usage : Nexus.Filters.Benchmark [NumResults=5000] [Iterations=20]
+// ──────────────────────────────────────────────
+namespace NexusFilterBenchmark
+{
+	static TArray<FOnlineSessionSearchResult> MakeSyntheticResults(int32 Num)
+	{
+		const EOnlineDataAdvertisementType::Type Adv = EOnlineDataAdvertisementType::ViaOnlineService;
+
+		TArray<FOnlineSessionSearchResult> Results;
+		Results.SetNum(Num);
+
+		for (int32 i = 0; i < Num; ++i)
+		{
+			FOnlineSessionSearchResult& Result = Results[i];
+			FOnlineSessionSettings& Settings = Result.Session.SessionSettings;
+
+			Settings.NumPublicConnections = 16;
+			Result.Session.NumOpenPublicConnections = i % 17;
+			Result.PingInMs = 20 + (i * 37) % 200;
+
+			Settings.Set(TEXT("SESSION_ID_KEY"), FString::Printf(TEXT("S%06d"), i), Adv);
+			Settings.Set(TEXT("MAP_NAME_KEY"), FString::Printf(TEXT("Map_%d"), i % 8), Adv);
+			Settings.Set(TEXT("GAME_MODE_KEY"), FString((i % 3 == 0) ? TEXT("Deathmatch") : TEXT("Survival")), Adv);
+			Settings.Set(TEXT("BUILD_VERSION"), 1 + (i % 2), Adv);
+			Settings.Set(TEXT("SKILL"), static_cast<double>(i % 100) / 10.0, Adv);
+			Settings.Set(TEXT("RANKED"), (i % 4) != 0, Adv);
+			Settings.Set(TEXT("REGION"), FString((i % 5 == 0) ? TEXT("EU") : TEXT("NA")), Adv);
+		}
+
+		return Results;
+	}
+
+	static FSessionSearchFilter MakeFilter(FName Key, ENexusSessionFilterValueType Type, ENexusSessionComparisonOp Op)
+	{
+		FSessionSearchFilter Filter;
+		Filter.Key = Key;
+		Filter.Value.Type = Type;
+		Filter.ComparisonOp = Op;
+		return Filter;
+	}
+
+	static TArray<FSessionSearchFilter> MakeFilters()
+	{
+		TArray<FSessionSearchFilter> Filters;
+
+		FSessionSearchFilter Mode = MakeFilter(TEXT("GAME_MODE_KEY"), ENexusSessionFilterValueType::String, ENexusSessionComparisonOp::Equals);
+		Mode.Value.StringValue = TEXT("survival");
+		Filters.Add(Mode);
+
+		FSessionSearchFilter Build = MakeFilter(TEXT("BUILD_VERSION"), ENexusSessionFilterValueType::Int32, ENexusSessionComparisonOp::GreaterThanEquals);
+		Build.Value.IntValue = 1;
+		Filters.Add(Build);
+
+		FSessionSearchFilter Skill = MakeFilter(TEXT("SKILL"), ENexusSessionFilterValueType::Float, ENexusSessionComparisonOp::LessThan);
+		Skill.Value.FloatValue = 9.5f;
+		Filters.Add(Skill);
+
+		FSessionSearchFilter Ranked = MakeFilter(TEXT("RANKED"), ENexusSessionFilterValueType::Bool, ENexusSessionComparisonOp::Equals);
+		Ranked.Value.bBoolValue = true;
+		Filters.Add(Ranked);
+
+		Filters.Add(MakeFilter(TEXT("MAP_NAME_KEY"), ENexusSessionFilterValueType::String, ENexusSessionComparisonOp::Exists));
+
+		// Type différent (Float contre Int32) : exerce le chemin de conversion
+		FSessionSearchFilter BuildAsFloat = MakeFilter(TEXT("BUILD_VERSION"), ENexusSessionFilterValueType::Float, ENexusSessionComparisonOp::LessThanEquals);
+		BuildAsFloat.Value.FloatValue = 2.f;
+		Filters.Add(BuildAsFloat);
+
+		return Filters;
+	}
+
+	static void Run(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		const int32 NumResults = FMath::Max(1, Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 5000);
+		const int32 Iterations = FMath::Max(1, Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 20);
+
+		const TArray<FOnlineSessionSearchResult> Results = MakeSyntheticResults(NumResults);
+		const TArray<FSessionSearchFilter> Filters = MakeFilters();
+
+		USessionFilterRule_KeyValue* RegionRule = NewObject<USessionFilterRule_KeyValue>(GetTransientPackage());
+		RegionRule->Key = TEXT("REGION");
+		RegionRule->ExpectedValue.Type = ENexusSessionFilterValueType::String;
+		RegionRule->ExpectedValue.StringValue = TEXT("NA");
+		RegionRule->Comparison = ENexusSessionComparisonOp::Equals;
+
+		// --- Legacy ---
+		int32 LegacyKept = 0;
+		const double LegacyStart = FPlatformTime::Seconds();
+		for (int32 It = 0; It < Iterations; ++It)
+		{
+			LegacyKept = 0;
+			for (const FOnlineSessionSearchResult& Result : Results)
+			{
+				if (NexusSessionFilterUtils::PassesAllFilters(Filters, Result) && RegionRule->PassesFilter(Result))
+				{
+					++LegacyKept;
+				}
+			}
+		}
+		const double LegacyMs = (FPlatformTime::Seconds() - LegacyStart) * 1000.0;
+
+		// --- Compilé (compilation incluse, une fois par recherche) ---
+		int32 CompiledKept = 0;
+		int32 Mismatches = 0;
+		const double CompiledStart = FPlatformTime::Seconds();
+		for (int32 It = 0; It < Iterations; ++It)
+		{
+			TArray<FNexusCompiledSessionFilter> Compiled;
+			NexusSessionFilterUtils::CompileFilters(Filters, Compiled);
+
+			FNexusCompiledSessionFilter RegionCompiled;
+			if (RegionRule->CompileFilter(RegionCompiled))
+			{
+				Compiled.Add(MoveTemp(RegionCompiled));
+			}
+
+			CompiledKept = 0;
+			for (const FOnlineSessionSearchResult& Result : Results)
+			{
+				if (NexusSessionFilterUtils::PassesAllCompiled(Compiled, Result))
+				{
+					++CompiledKept;
+				}
+			}
+		}
+		const double CompiledMs = (FPlatformTime::Seconds() - CompiledStart) * 1000.0;
+
+		// --- Vérification résultat par résultat ---
+		TArray<FNexusCompiledSessionFilter> Compiled;
+		NexusSessionFilterUtils::CompileFilters(Filters, Compiled);
+		FNexusCompiledSessionFilter RegionCompiled;
+		if (RegionRule->CompileFilter(RegionCompiled))
+		{
+			Compiled.Add(MoveTemp(RegionCompiled));
+		}
+
+		for (const FOnlineSessionSearchResult& Result : Results)
+		{
+			const bool bLegacy = NexusSessionFilterUtils::PassesAllFilters(Filters, Result) && RegionRule->PassesFilter(Result);
+			if (bLegacy != NexusSessionFilterUtils::PassesAllCompiled(Compiled, Result))
+			{
+				++Mismatches;
+			}
+		}
+
+		Ar.Logf(TEXT("[NexusFilterBenchmark] %d results x %d filters x %d iterations"), NumResults, Filters.Num() + 1, Iterations);
+		Ar.Logf(TEXT("[NexusFilterBenchmark] Legacy   : %8.2f ms total, %6.3f us/result, kept %d"), LegacyMs, LegacyMs * 1000.0 / (NumResults * Iterations), LegacyKept);
+		Ar.Logf(TEXT("[NexusFilterBenchmark] Compiled : %8.2f ms total, %6.3f us/result, kept %d"), CompiledMs, CompiledMs * 1000.0 / (NumResults * Iterations), CompiledKept);
+		Ar.Logf(TEXT("[NexusFilterBenchmark] Speedup x%.2f, mismatches : %d"), CompiledMs > 0.0 ? LegacyMs / CompiledMs : 0.0, Mismatches);
+	}
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GNexusFilterBenchmarkCommand(
+	TEXT("Nexus.Filters.Benchmark"),
+	TEXT("Compares legacy session filter evaluation with compiled predicates. Usage: Nexus.Filters.Benchmark [NumResults] [Iterations]"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&NexusFilterBenchmark::Run));
+
+#endif
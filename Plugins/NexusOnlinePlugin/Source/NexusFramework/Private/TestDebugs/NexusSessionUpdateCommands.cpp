@@ -0,0 +1,43 @@
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "Subsystems/NexusSessionUpdateSubsystem.h"
+
+#if !UE_BUILD_SHIPPING
+
+// ──────────────────────────────────────────────
+// Compteurs du planificateur d'annonces
+// Usage : Nexus.Session.UpdateStats [reset]
+// ──────────────────────────────────────────────
+namespace NexusSessionUpdateCommands
+{
+	static void Stats(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		UNexusSessionUpdateSubsystem* Updates = UNexusSessionUpdateSubsystem::Get(World);
+		if (!Updates)
+		{
+			Ar.Logf(TEXT("[NexusSessionUpdate] No game instance / update subsystem."));
+			return;
+		}
+
+		const FNexusSessionUpdateStats Stats = Updates->GetStats();
+		Ar.Logf(TEXT("[NexusSessionUpdate] Updates : %d requested, %d sent, %d skipped (%d changed keys)."),
+			Stats.UpdatesRequested, Stats.UpdatesSent, Stats.UpdatesSkipped, Stats.ChangedKeys);
+		Ar.Logf(TEXT("[NexusSessionUpdate] Players : +%d / -%d in %d batches, %d cancelled."),
+			Stats.PlayersRegistered, Stats.PlayersUnregistered, Stats.RegistrationBatches, Stats.RegistrationsCancelled);
+
+		if (Args.Num() > 0 && Args[0].Equals(TEXT("reset"), ESearchCase::IgnoreCase))
+		{
+			Updates->ResetStats();
+			Ar.Logf(TEXT("[NexusSessionUpdate] Counters reset."));
+		}
+	}
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GNexusSessionUpdateStatsCommand(
+	TEXT("Nexus.Session.UpdateStats"),
+	TEXT("Prints the session advertisement counters (sent vs requested). Usage: Nexus.Session.UpdateStats [reset]"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&NexusSessionUpdateCommands::Stats));
+
+#endif
@@ -0,0 +1,73 @@
+#include "Utils/NexusTrace.h"
+
+DEFINE_LOG_CATEGORY(LogNexusOnline);
+DEFINE_LOG_CATEGORY(LogNexusMigration);
+
+UE_TRACE_CHANNEL_DEFINE(NexusChannel);
+
+TRACE_DECLARE_INT_COUNTER(NexusOnline_OssCallsInFlight, TEXT("Nexus/Online/OSS Calls In Flight"));
+TRACE_DECLARE_FLOAT_COUNTER(NexusOnline_OssWaitMs, TEXT("Nexus/Online/OSS Wait (ms)"));
+TRACE_DECLARE_INT_COUNTER(NexusMigration_Generation, TEXT("Nexus/Migration/Generation"));
+TRACE_DECLARE_FLOAT_COUNTER(NexusMigration_RecoveryMs, TEXT("Nexus/Migration/Recovery (ms)"));
+TRACE_DECLARE_INT_COUNTER(NexusMigration_SnapshotStateBytes, TEXT("Nexus/Migration/Snapshot State (bytes)"));
+TRACE_DECLARE_INT_COUNTER(NexusMigration_SnapshotWireBytes, TEXT("Nexus/Migration/Snapshot Sent (bytes)"));
+TRACE_DECLARE_INT_COUNTER(NexusBan_Checks, TEXT("Nexus/Ban/Checks"));
+TRACE_DECLARE_INT_COUNTER(NexusBan_Rejected, TEXT("Nexus/Ban/Rejected"));
+
+namespace NexusTrace
+{
+	namespace
+	{
+		int32 OssCallsInFlight = 0;
+	}
+
+	double BeginOssCall()
+	{
+		++OssCallsInFlight;
+		TRACE_COUNTER_SET(NexusOnline_OssCallsInFlight, OssCallsInFlight);
+
+		return FPlatformTime::Seconds();
+	}
+
+	float EndOssCall(double& StartTime)
+	{
+		// Déjà clôturé (réponse synchrone puis retour false, abandon...)
+		if (StartTime <= 0.0)
+			return 0.f;
+
+		const float WaitMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+		StartTime = 0.0;
+
+		OssCallsInFlight = FMath::Max(OssCallsInFlight - 1, 0);
+		TRACE_COUNTER_SET(NexusOnline_OssCallsInFlight, OssCallsInFlight);
+		TRACE_COUNTER_SET(NexusOnline_OssWaitMs, WaitMs);
+
+		return WaitMs;
+	}
+
+	void MigrationPhase(const TCHAR* Phase, int32 Generation)
+	{
+		TRACE_BOOKMARK(TEXT("Nexus Migration #%d : %s"), Generation, Phase);
+		TRACE_COUNTER_SET(NexusMigration_Generation, Generation);
+	}
+
+	void RecordMigrationRecovery(float RecoveryMs)
+	{
+		TRACE_COUNTER_SET(NexusMigration_RecoveryMs, RecoveryMs);
+	}
+
+	void RecordSnapshot(int32 StateBytes, int32 WireBytes)
+	{
+		TRACE_COUNTER_SET(NexusMigration_SnapshotStateBytes, StateBytes);
+		TRACE_COUNTER_SET(NexusMigration_SnapshotWireBytes, WireBytes);
+	}
+
+	void RecordBanCheck(bool bRejected)
+	{
+		TRACE_COUNTER_INCREMENT(NexusBan_Checks);
+		if (bRejected)
+		{
+			TRACE_COUNTER_INCREMENT(NexusBan_Rejected);
+		}
+	}
+}
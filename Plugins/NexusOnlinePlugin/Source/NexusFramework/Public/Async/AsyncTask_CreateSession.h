@@ -4,6 +4,7 @@
 #include "Types/OnlineSessionData.h"
 #include "Data/SessionSearchFilter.h"
 #include "Data/SessionFilterPreset.h"
+#include "Subsystems/NexusSessionOperationSubsystem.h"
 #include "AsyncTask_CreateSession.generated.h"
 
 
@@ -29,6 +30,7 @@ public:
 	 * @param AdditionalSettings   Filtres ou métadonnées supplémentaires.
 	 * @param bAutoTravel          Si VRAI, effectue un ServerTravel vers la map dès la création. Si FAUX, appelle juste OnSuccess
 	 * @param Preset               Preset de filtres optionnel.
+	 * @param bPreloadMap          Si VRAI, charge la map en asynchrone pendant la création (UNexusMapPreloadSubsystem).
 	 */
 	UFUNCTION(BlueprintCallable, meta=(BlueprintInternalUseOnly="true", WorldContext="WorldContextObject", AutoCreateRefTerm="AdditionalSettings"), Category="Nexus|Online|Session")
 	static UAsyncTask_CreateSession* CreateSession(
@@ -36,21 +38,25 @@ public:
 	   const FSessionSettingsData& SettingsData,
 	   const TArray<FSessionSearchFilter>& AdditionalSettings,
 	   bool bAutoTravel = true, 
-	   USessionFilterPreset* Preset = nullptr
+	   USessionFilterPreset* Preset = nullptr,
+	   bool bPreloadMap = false
 	);
 
 	virtual void Activate() override;
 
 private:
 	
-	/** Étape 1 : Callback appelé quand l'ancienne session est bien détruite */
-	void OnOldSessionDestroyed(FName SessionName, bool bWasSuccessful);
+	/** Settings annoncés, construits depuis Data + filtres additionnels + preset */
+	void BuildSessionSettings(UWorld* World, FOnlineSessionSettings& Settings);
 
-	/** Étape 2 : Lance la vraie création */
-	void CreateSessionInternal();
+	/** Clé de fusion : deux nœuds identiques en attente ne créent qu'une session */
+	FString MakeCoalesceKey() const;
 
-	/** Étape 3 : Fin du processus */
-	void OnCreateSessionComplete(FName SessionName, bool bWasSuccessful);
+	/** Fin de l'opération mise en file : StartSession puis voyage */
+	void OnOperationComplete(const FNexusSessionOperationResult& Result);
+
+	/** Échec : annule le préchargement éventuel puis appelle OnFailure */
+	void Fail();
 
 	
 	// ───────────────────────────────
@@ -61,13 +67,12 @@ private:
 	
 	FSessionSettingsData Data;
 	bool bShouldAutoTravel = true;
+	bool bPreloadMap = false;
+	bool bTravelFlowStarted = false;
 
 	UPROPERTY()
 	TArray<FSessionSearchFilter> SessionAdditionalSettings;
 	
 	UPROPERTY()
 	TObjectPtr<USessionFilterPreset> SessionPreset;
-
-	FDelegateHandle CreateDelegateHandle;
-	FDelegateHandle DestroyDelegateHandle;
 };
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include "Kismet/BlueprintAsyncActionBase.h"
 #include "AsyncTask_CreateSessionFromConfig.generated.h"
 
+struct FNexusSessionOperationResult;
 class UNexusSessionConfig;
 class USessionFilterPreset;
 
@@ -43,14 +44,8 @@ public:
 
 private:
 	
-	/** Step 1: Callback when/if old session is destroyed */
-	void OnOldSessionDestroyed(FName SessionName, bool bWasSuccessful);
-
-	/** Step 2: Main Logic */
-	void CreateSessionInternal();
-
-	/** Step 3: Completion */
-	void OnCreateSessionComplete(FName SessionName, bool bWasSuccessful);
+	/** Completion of the queued create : StartSession + travel */
+	void OnOperationComplete(const FNexusSessionOperationResult& Result);
 
 	UPROPERTY()
 	UObject* WorldContextObject = nullptr;
@@ -59,7 +54,4 @@ private:
 	UNexusSessionConfig* SessionConfig = nullptr;
 
 	bool bShouldAutoTravel = true;
-
-	FDelegateHandle CreateDelegateHandle;
-	FDelegateHandle DestroyDelegateHandle;
 };
@@ -2,6 +2,7 @@
 #include "CoreMinimal.h"
 #include "Kismet/BlueprintAsyncActionBase.h"
 #include "Types/OnlineSessionData.h"
+#include "Subsystems/NexusSessionOperationSubsystem.h"
 #include "AsyncTask_DestroySession.generated.h"
 
 
@@ -33,12 +34,10 @@ public:
 
 private:
 
-	void OnDestroySessionComplete(FName SessionName, bool bWasSuccessful);
+	void OnOperationComplete(const FNexusSessionOperationResult& Result);
 	
 	UPROPERTY()
 	UObject* WorldContextObject = nullptr;
 	
 	ENexusSessionType TargetSessionType = ENexusSessionType::GameSession;
-	
-	FDelegateHandle DestroyDelegateHandle;
 };
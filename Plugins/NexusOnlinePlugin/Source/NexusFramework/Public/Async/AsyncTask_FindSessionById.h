@@ -4,31 +4,77 @@
 #include "Types/OnlineSessionData.h"
 #include "AsyncTask_FindSessionById.generated.h"
 
+class FOnlineSessionSearch;
+
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnFindSessionByIdCompleted, bool, bWasSuccessful, FOnlineSessionSearchResultData, Result);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnFindSessionsByIdsCompleted, bool, bAllFound, const TArray<FOnlineSessionSearchResultData>&, Found, const TArray<FString>&, MissingIds);
 
 
+/**
+ * Resolves session ids (SESSION_ID_KEY : invite codes, party follow...).
+ * Ids already in the session id index of UNexusSessionCacheSubsystem are answered locally ; the others are looked up with
+ * one query filtered on SESSION_ID_KEY each, run back to back, whose results are indexed in turn.
+ */
 UCLASS(meta=(DisplayName="Find Session By ID"))
 class NEXUSFRAMEWORK_API UAsyncTask_FindSessionById : public UBlueprintAsyncActionBase
 {
 	GENERATED_BODY()
 
 public:
+	/** Single lookup (Find Session By ID). */
 	UPROPERTY(BlueprintAssignable)
 	FOnFindSessionByIdCompleted OnCompleted;
 
+	/** Bulk lookup (Find Sessions By IDs) : found sessions in request order, and the ids that could not be resolved. */
+	UPROPERTY(BlueprintAssignable)
+	FOnFindSessionsByIdsCompleted OnBulkCompleted;
+
 	UFUNCTION(BlueprintCallable, meta=(BlueprintInternalUseOnly="true", WorldContext="WorldContextObject"), Category="Nexus|Online|Session")
 	static UAsyncTask_FindSessionById* FindSessionById(UObject* WorldContextObject, const FString& SessionId);
 
+	/**
+	 * Resolves many ids : one filtered online query per id missing from the index, at most BulkLookupMaxQueries.
+	 * @param bForceRefresh Ignores the index and queries every id (fresh player counts before a join).
+	 */
+	UFUNCTION(BlueprintCallable, meta=(BlueprintInternalUseOnly="true", WorldContext="WorldContextObject", DisplayName="Find Sessions By IDs"), Category="Nexus|Online|Session")
+	static UAsyncTask_FindSessionById* FindSessionsByIds(UObject* WorldContextObject, const TArray<FString>& SessionIds, bool bForceRefresh = false);
+
 	virtual void Activate() override;
 
+	/**
+	 * Stops the lookup without broadcasting (the caller gave up waiting). The running online search is left to finish :
+	 * the session interface only cancels "its" current search, which may belong to another node.
+	 */
+	void Cancel();
+
 private:
+	/** Sends the query of the next queried id not resolved yet. False once there is none left (or the call failed). */
+	bool StartNextQuery();
 	void OnFindSessionsComplete(bool bWasSuccessful);
+	void Finish();
 
 	UPROPERTY()
 	UObject* WorldContextObject;
-	
-	FString TargetSessionId;
-	
+
+	/** Ids to resolve, without duplicates, in request order. */
+	TArray<FString> RequestedIds;
+
+	/** Ids sent to the online service (missing from the index). */
+	TArray<FString> QueriedIds;
+
+	/** Next entry of QueriedIds to look up. */
+	int32 NextQueryIndex = 0;
+
+	TMap<FString, FOnlineSessionSearchResultData> ResolvedSessions;
+
+	bool bBulk = false;
+	bool bForceRefresh = false;
+
 	TSharedPtr<FOnlineSessionSearch> SearchSettings;
+
+	FDelegateHandle FindSessionsHandle;
+
+	/** FindSessions call in flight since (0 = none). */
+	double OssCallTime = 0.0;
 };
@@ -1,15 +1,26 @@
 ﻿#pragma once
 #include "CoreMinimal.h"
 #include "Kismet/BlueprintAsyncActionBase.h"
+#include "Containers/Ticker.h"
+#include "GameFramework/OnlineReplStructs.h"
 #include "Types/OnlineSessionData.h"
+#include "Data/SessionSearchFilter.h"
+#include "Filters/SessionMatchScoring.h"
 #include "AsyncTask_FindSessions.generated.h"
 
 class USessionFilterRule;
 class USessionSortRule;
 class USessionFilterPreset;
+class UNexusSessionCacheSubsystem;
+class IOnlineSession;
 struct FSessionSearchFilter;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnFindSessionsCompleted, bool, bWasSuccessful, const TArray<FOnlineSessionSearchResultData>&, Results);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnFindSessionsRefreshed, bool, bWasSuccessful, const TArray<FOnlineSessionSearchResultData>&, Results, const FNexusSessionResultDiff&, Diff);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnFindSessionsPartialResults, const TArray<FOnlineSessionSearchResultData>&, NewResults, int32, ProcessedCount, int32, TotalCount);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnFindSessionsPageReady, const TArray<FOnlineSessionSearchResultData>&, Page, int32, NextCursor);
+DECLARE_DELEGATE_TwoParams(FOnNexusQuickMatchComplete, bool /*bWasSuccessful*/, const TArray<FOnlineSessionSearchResultData>& /*BestFirst*/);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnFindSessionsSubQueryCompleted, int32, SubQueryIndex, const FNexusSessionSubQueryReport&, Report);
 
 
 UCLASS(meta=(DisplayName="Find Sessions"))
@@ -25,6 +36,22 @@ public:
 	UPROPERTY(BlueprintAssignable, Category="Nexus|Online|Session")
 	FOnFindSessionsCompleted OnCompleted;
 
+	/** Only fired when OnCompleted was served from stale cache : up-to-date results and what changed. */
+	UPROPERTY(BlueprintAssignable, Category="Nexus|Online|Session")
+	FOnFindSessionsRefreshed OnRefreshed;
+
+	/** Streamed mode : fired after each processing chunk with the results it kept, already in their final order. */
+	UPROPERTY(BlueprintAssignable, Category="Nexus|Online|Session")
+	FOnFindSessionsPartialResults OnPartialResults;
+
+	/** Streamed mode : fired once, as soon as the first page is filled (or processing ended). Use GetPage(NextCursor) for the rest. */
+	UPROPERTY(BlueprintAssignable, Category="Nexus|Online|Session")
+	FOnFindSessionsPageReady OnFirstPage;
+
+	/** Multi-query mode : fired when each sub-query answers (or times out), before the merged OnCompleted. */
+	UPROPERTY(BlueprintAssignable, Category="Nexus|Online|Session")
+	FOnFindSessionsSubQueryCompleted OnSubQueryCompleted;
+
 	/**
 	 * Creates a Find session async node.
 	 * @param WorldContextObject Reference to the world or player calling this async node.
@@ -42,15 +69,74 @@ public:
 	 * @param SortRules Optional sorting rules to order results (Blueprint subclasses of USessionSortRule).
 	 * .
 	 * @param Preset Optional preset combining reusable filter and sort configurations.
+	 * .
+	 * @param bUseCache Serve results from UNexusSessionCacheSubsystem when possible (stale results are refreshed in background).
 	 */
 	UFUNCTION(BlueprintCallable, meta=(BlueprintInternalUseOnly="true", WorldContext="WorldContextObject", AutoCreateRefTerm="SimpleFilters,AdvancedRules,SortRules"), Category="Nexus|Online|Session")
 	static UAsyncTask_FindSessions* FindSessions(UObject* WorldContextObject, ENexusSessionType SessionType, int32 MaxResults, bool bIsLANQuery,
+		const TArray<FSessionSearchFilter>& SimpleFilters, const TArray<USessionFilterRule*>& AdvancedRules,
+		const TArray<USessionSortRule*>& SortRules, USessionFilterPreset* Preset, bool bUseCache = false
+	);
+
+	/**
+	 * Same search, but results are filtered and converted in chunks over several frames.
+	 * OnPartialResults fires after each chunk, OnFirstPage as soon as PageSize results are ready, OnCompleted at the end.
+	 * Sort rules are applied before filtering so that every chunk is emitted in final order.
+	 * @param PageSize Number of results in the first page (<= 0 uses the project setting).
+	 */
+	UFUNCTION(BlueprintCallable, meta=(BlueprintInternalUseOnly="true", WorldContext="WorldContextObject", AutoCreateRefTerm="SimpleFilters,AdvancedRules,SortRules", DisplayName="Find Sessions (Streamed)"), Category="Nexus|Online|Session")
+	static UAsyncTask_FindSessions* FindSessionsStreamed(UObject* WorldContextObject, ENexusSessionType SessionType, int32 MaxResults, bool bIsLANQuery,
+		const TArray<FSessionSearchFilter>& SimpleFilters, const TArray<USessionFilterRule*>& AdvancedRules,
+		const TArray<USessionSortRule*>& SortRules, USessionFilterPreset* Preset, int32 PageSize = 0
+	);
+
+	/**
+	 * Runs several searches (e.g. LAN + online, GameSession + SpectatorSession) as one node.
+	 * Sub-queries are sent together; those the online subsystem refuses while another search is pending are sent as soon as it answers.
+	 * Results are merged and deduplicated by SESSION_ID_KEY (lowest ping kept), then filtered and sorted once.
+	 * Each sub-query keeps its own session type check. Per sub-query latency : OnSubQueryCompleted / GetSubQueryReports.
+	 */
+	UFUNCTION(BlueprintCallable, meta=(BlueprintInternalUseOnly="true", WorldContext="WorldContextObject", AutoCreateRefTerm="SimpleFilters,AdvancedRules,SortRules", DisplayName="Find Sessions (Multi)"), Category="Nexus|Online|Session")
+	static UAsyncTask_FindSessions* FindSessionsMulti(UObject* WorldContextObject, const TArray<FNexusSessionSubQuery>& SubQueries,
 		const TArray<FSessionSearchFilter>& SimpleFilters, const TArray<USessionFilterRule*>& AdvancedRules,
 		const TArray<USessionSortRule*>& SortRules, USessionFilterPreset* Preset
 	);
 
+	/**
+	 * Native quick match : searches, scores every result once (weighted criteria) and returns the K best, best first.
+	 * The node is activated immediately and released once OnComplete has run.
+	 */
+	static UAsyncTask_FindSessions* QuickMatch(UObject* WorldContextObject, ENexusSessionType SessionType, const FNexusMatchScoringParams& Scoring,
+		int32 K, FOnNexusQuickMatchComplete OnComplete, const TArray<FSessionSearchFilter>& SimpleFilters = TArray<FSessionSearchFilter>(), int32 MaxResults = 100);
+
 	virtual void Activate() override;
 
+	/** Blueprint view of one raw result (display keys, player counts, effective ping), sharing its result set. */
+	static FOnlineSessionSearchResultData MakeResultData(const FNexusSessionResultSetPtr& Results, int32 ResultIndex);
+	virtual void BeginDestroy() override;
+
+	// ───────────────────────────────
+	// Pagination
+	// ───────────────────────────────
+
+	/**
+	 * Reads up to Count results starting at Cursor (0 = first result).
+	 * Returns false if nothing is available yet at this cursor (processing still running : retry after OnPartialResults).
+	 * NextCursor is -1 once the last result has been read and processing is complete.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Nexus|Online|Session")
+	bool GetPage(int32 Cursor, int32 Count, TArray<FOnlineSessionSearchResultData>& OutResults, int32& NextCursor) const;
+
+	UFUNCTION(BlueprintPure, Category="Nexus|Online|Session")
+	bool IsProcessingComplete() const { return bProcessingComplete; }
+
+	UFUNCTION(BlueprintPure, Category="Nexus|Online|Session")
+	int32 GetAvailableResultCount() const { return StreamedResults.Num(); }
+
+	/** Multi-query mode : one report per sub-query, filled as they answer. */
+	UFUNCTION(BlueprintPure, Category="Nexus|Online|Session")
+	const TArray<FNexusSessionSubQueryReport>& GetSubQueryReports() const { return SubQueryReports; }
+
 private:
 
 	// ───────────────────────────────
@@ -58,14 +144,57 @@ private:
 	// ───────────────────────────────
 	
 	void OnFindSessionsComplete(bool bWasSuccessful);
-	void ProcessSearchResults(const TArray<FOnlineSessionSearchResult>& InResults);
+	void ProcessSearchResults();
+	void FinishSearch(bool bWasSuccessful, const TArray<FOnlineSessionSearchResultData>& Results);
+
+	bool PassesResultFilters(const FOnlineSessionSearchResult& Result, const FString& DesiredTypeStr, bool bIsNullSubsystem) const;
+	bool PassesThreadSafeFilters(const FOnlineSessionSearchResult& Result, const FString& DesiredTypeStr, bool bIsNullSubsystem) const;
+	bool PassesGameThreadRules(const FOnlineSessionSearchResult& Result) const;
+	void FilterResultsParallel(const FString& DesiredTypeStr, bool bIsNullSubsystem, TArray<int32>& OutIndices) const;
+	void SortSearchResults(TArray<int32>& InOutIndices) const;
+	bool SelectBestScored(TArray<int32>& InOutIndices, TArray<float>& OutScores) const;
+	FOnlineSessionSearchResultData MakeResultData(int32 ResultIndex) const;
+	bool IsNullSubsystem() const;
+	FString GetDesiredTypeFilter() const;
+	static bool PassesTypeFilter(const FOnlineSessionSearchResult& Result, const FString& DesiredTypeStr, bool bIsNullSubsystem);
+
+	// ───────────────────────────────
+	// Streaming
+	// ───────────────────────────────
+
+	void StartStreaming();
+	bool TickStreaming(float DeltaTime);
+	void ProcessStreamChunk();
+
+	// ───────────────────────────────
+	// Multi-query
+	// ───────────────────────────────
+
+	void StartSubQueries(IOnlineSession& Session);
+	void LaunchPendingSubQueries(IOnlineSession& Session);
+	void OnSubQuerySearchComplete(bool bWasSuccessful);
+	void FinishSubQuery(int32 SubQueryIndex, bool bWasSuccessful);
+	bool TickSubQueryTimeout(float DeltaTime);
+	void MergeSubQueryResults();
+
+	// ───────────────────────────────
+	// Cache
+	// ───────────────────────────────
+
+	/** Returns true if the search is fully handled by the cache (fresh hit or refresh already in flight). */
+	bool TryServeFromCache(UWorld* World);
+	void OnCacheRefreshCompleted(const FString& InCacheKey, bool bWasSuccessful, const FNexusSessionResultDiff& Diff);
+
+	/** The refresh this node waits for never answered : finishes with what the cache holds. */
+	bool TickCacheWaitTimeout(float DeltaTime);
 
 	// ───────────────────────────────
 	// Filter & Sorting Utilities
 	// ───────────────────────────────
 	
 	void RebuildResolvedFilters();
-	void ApplyQueryFilters();
+	void CompileResolvedFilters();
+	void ApplyQueryFilters(FOnlineSessionSearch& Search, ENexusSessionType SessionType) const;
 
 	// ───────────────────────────────
 	// Context & Session Data
@@ -75,11 +204,77 @@ private:
 	UObject* WorldContextObject = nullptr;
 	
 	TSharedPtr<FOnlineSessionSearch> SearchSettings;
+
+	/** Raw results moved out of SearchSettings, shared with every FOnlineSessionSearchResultData we emit. */
+	TSharedPtr<FNexusSessionResultSet, ESPMode::ThreadSafe> ResultSet;
 	
 	FDelegateHandle FindSessionsHandle;
+
+	/** Single query : FindSessions call in flight since (0 = none). Sub-queries use their own StartTime. */
+	double OssCallTime = 0.0;
 	
 	ENexusSessionType DesiredType = ENexusSessionType::GameSession;
 
+	bool bUseCache = false;
+	bool bServedFromCache = false;
+	bool bOwnsCacheRefresh = false;
+	
+	FString CacheKey;
+	
+	TWeakObjectPtr<UNexusSessionCacheSubsystem> CacheSubsystem;
+	
+	FDelegateHandle CacheRefreshHandle;
+
+	FTSTicker::FDelegateHandle CacheWaitTimeoutHandle;
+
+	// ───────────────────────────────
+	// Streaming state
+	// ───────────────────────────────
+
+	bool bStreaming = false;
+	bool bFirstPageSent = false;
+	bool bProcessingComplete = false;
+	bool bStreamIsNullSubsystem = false;
+
+	int32 StreamPageSize = 0;
+	int32 StreamCursor = 0;
+
+	FString StreamDesiredTypeStr;
+
+	/** Indices into ResultSet, already sorted, waiting to be filtered. */
+	TArray<int32> StreamOrder;
+
+	/** Results kept so far, in final order (read by GetPage). */
+	TArray<FOnlineSessionSearchResultData> StreamedResults;
+
+	FTSTicker::FDelegateHandle StreamTickHandle;
+
+	// ───────────────────────────────
+	// Multi-query state
+	// ───────────────────────────────
+
+	struct FSubQueryState
+	{
+		TSharedPtr<FOnlineSessionSearch> Search;
+		ENexusSessionType SessionType = ENexusSessionType::GameSession;
+		double StartTime = 0.0;
+		bool bInFlight = false;
+		bool bFinished = false;
+	};
+
+	bool bMultiQuery = false;
+
+	TArray<FSubQueryState> SubQueries;
+
+	TArray<FNexusSessionSubQueryReport> SubQueryReports;
+
+	FUniqueNetIdRepl SearchPlayerId;
+
+	FTSTicker::FDelegateHandle SubQueryTimeoutHandle;
+
+	/** Quick match : native completion, the node releases itself after calling it. */
+	FOnNexusQuickMatchComplete QuickMatchCompletion;
+
 	// ───────────────────────────────
 	// User-defined configuration
 	// ───────────────────────────────
@@ -107,4 +302,19 @@ private:
 	
 	UPROPERTY()
 	TArray<TObjectPtr<USessionSortRule>> ResolvedSortRules;
+
+	// ───────────────────────────────
+	// Compiled filters (built once per search)
+	// ───────────────────────────────
+
+	/** Simple filters + key/value rules, evaluated without virtual calls nor string conversions. */
+	TArray<FNexusCompiledSessionFilter> CompiledFilters;
+
+	/** Enabled rules that could not be compiled but may run on worker threads. */
+	UPROPERTY()
+	TArray<TObjectPtr<USessionFilterRule>> ThreadSafeRules;
+
+	/** Enabled rules that must stay on the game thread (Blueprint classes, rules not declared thread-safe). */
+	UPROPERTY()
+	TArray<TObjectPtr<USessionFilterRule>> GameThreadRules;
 };
@@ -0,0 +1,156 @@
+﻿#pragma once
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+#include "Containers/Ticker.h"
+#include "Types/OnlineSessionData.h"
+#include "Subsystems/NexusSessionOperationSubsystem.h"
+#include "AsyncTask_JoinBestSession.generated.h"
+
+class UAsyncTask_FindSessionById;
+
+
+/** One join attempt of Join Best Session. */
+USTRUCT(BlueprintType)
+struct FNexusJoinAttempt
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Session")
+	FString SessionId;
+
+	/** Rank of the candidate in the list given to the node (0 = best). */
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Session")
+	int32 CandidateIndex = INDEX_NONE;
+
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Session")
+	ENexusSessionOperationStatus Status = ENexusSessionOperationStatus::Failed;
+
+	/** The online service answered that the session is full. */
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Session")
+	bool bSessionFull = false;
+
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Session")
+	float ElapsedMs = 0.f;
+};
+
+USTRUCT(BlueprintType)
+struct FNexusJoinReport
+{
+	GENERATED_BODY()
+
+public:
+	/** 1-based number of the attempt that joined (0 = none). */
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Session")
+	int32 WinningAttempt = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Session")
+	FOnlineSessionSearchResultData JoinedSession;
+
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Session")
+	TArray<FNexusJoinAttempt> Attempts;
+
+	/** Candidates dropped before any attempt : full according to the refreshed data. */
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Session")
+	int32 SkippedFull = 0;
+
+	/** Time spent refreshing the candidates (0 when not refreshed). */
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Session")
+	float RefreshMs = 0.f;
+
+	/** Activation -> joined (or given up). */
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Session")
+	float TotalMs = 0.f;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnJoinBestSessionCompleted, const FNexusJoinReport&, Report);
+
+
+/**
+ * Quick join over a ranked candidate list (e.g. the sorted results of Find Sessions).
+ *
+ * The player counts of the first MaxAttempts candidates are refreshed first (one query per id, AttemptTimeout each),
+ * full sessions are dropped and the list is trimmed to MaxAttempts, then the best remaining one is joined. An attempt that fails or exceeds AttemptTimeout moves on to the next candidate ; a join that answers after
+ * its timeout is rolled back by UNexusSessionOperationSubsystem. OSS v1 joins one session per name at a time, so attempts
+ * run one after another.
+ */
+UCLASS(meta=(DisplayName="Join Best Session"))
+class NEXUSFRAMEWORK_API UAsyncTask_JoinBestSession : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(BlueprintAssignable, Category="Nexus|Online|Session")
+	FOnJoinBestSessionCompleted OnSuccess;
+
+	UPROPERTY(BlueprintAssignable, Category="Nexus|Online|Session")
+	FOnJoinBestSessionCompleted OnFailure;
+
+	/**
+	 * Rejoint la meilleure session disponible parmi Candidates (ordre = préférence).
+	 *
+	 * @param Candidates       Sessions classées, la meilleure en premier.
+	 * @param MaxAttempts      Nombre de candidats essayés au plus.
+	 * @param AttemptTimeout   Durée max (secondes) d'une tentative avant de passer au candidat suivant.
+	 * @param bRefreshCapacity Si VRAI, relit le nombre de joueurs des candidats avant d'essayer.
+	 * @param bAutoTravel      Si VRAI, lance le ClientTravel vers la session rejointe.
+	 * @param bPreloadMap      Si VRAI, charge la map du meilleur candidat pendant le join.
+	 */
+	UFUNCTION(BlueprintCallable, meta=(BlueprintInternalUseOnly="true", WorldContext="WorldContextObject"), Category="Nexus|Online|Session")
+	static UAsyncTask_JoinBestSession* JoinBestSession(UObject* WorldContextObject, const TArray<FOnlineSessionSearchResultData>& Candidates,
+		int32 MaxAttempts = 3, float AttemptTimeout = 5.f, bool bRefreshCapacity = true, bool bAutoTravel = true,
+		ENexusSessionType SessionType = ENexusSessionType::GameSession, bool bPreloadMap = false);
+
+	virtual void Activate() override;
+
+private:
+	// ---- Refresh
+	void StartRefresh();
+
+	UFUNCTION()
+	void OnRefreshCompleted(bool bAllFound, const TArray<FOnlineSessionSearchResultData>& Found, const TArray<FString>& MissingIds);
+
+	bool OnRefreshTimeout(float DeltaTime);
+	void FinishRefresh();
+
+	/** Removes the candidates that look full, then keeps the best MaxAttempts. */
+	void DropFullCandidates();
+
+	// ---- Attempts
+	void TryNextCandidate();
+	void OnAttemptComplete(const FNexusSessionOperationResult& Result);
+
+	void Succeed(const FString& ConnectString);
+	void Fail();
+
+	static bool LooksFull(const FOnlineSessionSearchResultData& Candidate);
+
+	UPROPERTY()
+	UObject* WorldContextObject = nullptr;
+
+	UPROPERTY()
+	TObjectPtr<UAsyncTask_FindSessionById> RefreshTask;
+
+	/** Candidates still to try, best first. */
+	TArray<FOnlineSessionSearchResultData> Candidates;
+	TArray<int32> CandidateRanks;
+
+	int32 MaxAttempts = 3;
+	float AttemptTimeout = 5.f;
+	bool bRefreshCapacity = true;
+	bool bShouldAutoTravel = true;
+	bool bPreloadMap = false;
+	ENexusSessionType DesiredType = ENexusSessionType::GameSession;
+
+	int32 NextCandidate = 0;
+	bool bRefreshing = false;
+	bool bTravelFlowStarted = false;
+	bool bFinished = false;
+
+	double StartTime = 0.0;
+	double RefreshStartTime = 0.0;
+
+	FNexusJoinReport Report;
+
+	FTSTicker::FDelegateHandle RefreshTimeoutHandle;
+};
@@ -2,6 +2,7 @@
 #include "CoreMinimal.h"
 #include "Kismet/BlueprintAsyncActionBase.h"
 #include "Types/OnlineSessionData.h"
+#include "Subsystems/NexusSessionOperationSubsystem.h"
 #include "Interfaces/OnlineSessionInterface.h"
 #include "OnlineSessionSettings.h"
 #include "AsyncTask_JoinSession.generated.h"
@@ -28,31 +29,32 @@ public:
 	 * * @param SessionResult Le résultat brut obtenu via FindSessions.
 	 * @param bAutoTravel Si VRAI, lance le ClientTravel automatiquement vers le serveur.
 	 * @param SessionType Le type de session interne (GameSession généralement).
+	 * @param bPreloadMap Si VRAI, charge la map annoncée (MAP_NAME_KEY) en asynchrone pendant le join.
 	 */
 	UFUNCTION(BlueprintCallable, meta=(BlueprintInternalUseOnly="true", WorldContext="WorldContextObject"), Category="Nexus|Online|Session")
 	static UAsyncTask_JoinSession* JoinSession(UObject* WorldContextObject, const FOnlineSessionSearchResultData& SessionResult, bool bAutoTravel = true,
-		ENexusSessionType SessionType = ENexusSessionType::GameSession);
+		ENexusSessionType SessionType = ENexusSessionType::GameSession, bool bPreloadMap = false);
 
 	virtual void Activate() override;
 
 private:
 	
-	void OnOldSessionDestroyed(FName SessionName, bool bWasSuccessful);
+	/** Fin de l'opération mise en file : résolution de l'adresse puis ClientTravel */
+	void OnOperationComplete(const FNexusSessionOperationResult& Result);
 
-	void JoinSessionInternal();
-
-	void OnJoinSessionComplete(FName SessionName, EOnJoinSessionCompleteResult::Type Result);
+	/** Annule le préchargement éventuel puis appelle OnFailure. */
+	void Fail();
 	
 	
 	UPROPERTY()
 	UObject* WorldContextObject = nullptr;
 	
-	FOnlineSessionSearchResult RawResult;
+	/** Champs d'affichage + référence vers l'ensemble de résultats partagé (pas de copie du résultat brut). */
+	FOnlineSessionSearchResultData SessionData;
 	
 	ENexusSessionType DesiredType = ENexusSessionType::GameSession;
 	
 	bool bShouldAutoTravel = true;
-
-	FDelegateHandle JoinDelegateHandle;
-	FDelegateHandle DestroyDelegateHandle;
+	bool bPreloadMap = false;
+	bool bTravelFlowStarted = false;
 };
\ No newline at end of file
@@ -0,0 +1,30 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "NexusSnapshotComponent.generated.h"
+
+
+/**
+ * Snapshot channel between the host and one heir, on the heir's player controller.
+ * Added at runtime by UNexusSnapshotSubsystem when the player becomes first heir (a player controller class may also
+ * own one : it is reused). The payload is handled by the subsystems on both sides.
+ */
+UCLASS(ClassGroup=(Nexus), meta=(BlueprintSpawnableComponent))
+class NEXUSFRAMEWORK_API UNexusSnapshotComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UNexusSnapshotComponent();
+
+	/** Host -> heir : part of a snapshot blob (BaselineSequence = INDEX_NONE for a keyframe). */
+	UFUNCTION(Client, Reliable)
+	void Client_ReceiveSnapshotChunk(int32 Sequence, int32 BaselineSequence, int32 TotalSize, int32 Offset, const TArray<uint8>& Chunk);
+
+	/** Heir -> host : snapshot complete and held (INDEX_NONE = nothing usable held, send a keyframe). */
+	UFUNCTION(Server, Reliable)
+	void Server_AckSnapshot(int32 Sequence);
+
+protected:
+	virtual void BeginPlay() override;
+};
@@ -29,4 +29,83 @@ public:
 
     UPROPERTY(Config, EditAnywhere, Category="General")
     FString MainMenuMap = TEXT("TestMap");
+
+    /** Number of ranked heirs replicated to clients (best first). */
+    UPROPERTY(Config, EditAnywhere, Category="Heir Election", meta=(ClampMin=1, ClampMax=16))
+    int32 HeirListSize;
+
+    /** Seconds between two rankings (also re-ranked on every join / leave). */
+    UPROPERTY(Config, EditAnywhere, Category="Heir Election", meta=(ClampMin=0.5f))
+    float HeirRankInterval;
+
+    UPROPERTY(Config, EditAnywhere, Category="Heir Election", meta=(ClampMin=0.0f))
+    float RttWeight;
+
+    UPROPERTY(Config, EditAnywhere, Category="Heir Election", meta=(ClampMin=0.0f))
+    float PacketLossWeight;
+
+    UPROPERTY(Config, EditAnywhere, Category="Heir Election", meta=(ClampMin=0.0f))
+    float UploadWeight;
+
+    UPROPERTY(Config, EditAnywhere, Category="Heir Election", meta=(ClampMin=0.0f))
+    float HardwareWeight;
+
+    /** RTT (ms) at which the RTT score reaches 0. */
+    UPROPERTY(Config, EditAnywhere, Category="Heir Election", meta=(ClampMin=1.0f))
+    float MaxHeirRttMs;
+
+    /** Packet loss (0-1) at which the loss score reaches 0. */
+    UPROPERTY(Config, EditAnywhere, Category="Heir Election", meta=(ClampMin=0.001f, ClampMax=1.0f))
+    float MaxHeirPacketLoss;
+
+    /** Reported upload (kbps) at which the upload score reaches 1. */
+    UPROPERTY(Config, EditAnywhere, Category="Heir Election", meta=(ClampMin=1))
+    int32 TargetUploadKbps;
+
+    /** The current heir keeps its place unless a candidate beats it by this score (0-1) : avoids flapping on RTT noise. */
+    UPROPERTY(Config, EditAnywhere, Category="Heir Election", meta=(ClampMin=0.0f, ClampMax=1.0f))
+    float HeirSwitchMargin;
+
+    /**
+     * The first heir reserves its listen port and prepares the next-generation session while the host is alive ;
+     * the other clients reconnect straight to its address instead of searching for the new session.
+     */
+    UPROPERTY(Config, EditAnywhere, Category="Hot Standby")
+    bool bEnableHotStandby;
+
+    /** Port the heir reserves, then listens on once it hosts (0 = engine default port). Must differ from the host's port when testing on one machine. */
+    UPROPERTY(Config, EditAnywhere, Category="Hot Standby", meta=(EditCondition="bEnableHotStandby", ClampMin=0, ClampMax=65535))
+    int32 StandbyListenPort;
+
+    /** Seconds between the failure and the first direct reconnect (time for the heir to reopen the map). */
+    UPROPERTY(Config, EditAnywhere, Category="Hot Standby", meta=(EditCondition="bEnableHotStandby", ClampMin=0.0f))
+    float DirectReconnectDelay;
+
+    /** Seconds between a failed direct reconnect and the next one (a connection still negotiating is never restarted). */
+    UPROPERTY(Config, EditAnywhere, Category="Hot Standby", meta=(EditCondition="bEnableHotStandby", ClampMin=0.5f))
+    float DirectReconnectInterval;
+
+    /** Direct reconnects tried before falling back to the session search. */
+    UPROPERTY(Config, EditAnywhere, Category="Hot Standby", meta=(EditCondition="bEnableHotStandby", ClampMin=1, ClampMax=50))
+    int32 MaxDirectReconnectAttempts;
+
+    /** The host streams the SaveGame state of the registered objects to the first heir (UNexusSnapshotSubsystem). */
+    UPROPERTY(Config, EditAnywhere, Category="State Snapshots")
+    bool bEnableSnapshots;
+
+    /** Seconds between two captures (a capture waits for the previous snapshot to be fully sent). */
+    UPROPERTY(Config, EditAnywhere, Category="State Snapshots", meta=(EditCondition="bEnableSnapshots", ClampMin=0.1f))
+    float SnapshotInterval;
+
+    /** Upload budget of the snapshot stream, in KB/s. Sending also pauses while the heir's connection is saturated. */
+    UPROPERTY(Config, EditAnywhere, Category="State Snapshots", meta=(EditCondition="bEnableSnapshots", ClampMin=1, ClampMax=1024))
+    int32 SnapshotBandwidthKBps;
+
+    /** Bytes per RPC. */
+    UPROPERTY(Config, EditAnywhere, Category="State Snapshots", meta=(EditCondition="bEnableSnapshots", ClampMin=256, ClampMax=16384))
+    int32 SnapshotChunkSize;
+
+    /** A full snapshot is sent every N snapshots, the others are deltas against the last one the heir acknowledged. */
+    UPROPERTY(Config, EditAnywhere, Category="State Snapshots", meta=(EditCondition="bEnableSnapshots", ClampMin=1))
+    int32 SnapshotKeyframeInterval;
 };
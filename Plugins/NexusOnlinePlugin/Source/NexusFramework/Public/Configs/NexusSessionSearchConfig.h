@@ -0,0 +1,123 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "NexusSessionSearchConfig.generated.h"
+
+
+UCLASS(Config=Game, DefaultConfig, meta=(DisplayName="Nexus Session Search"))
+class NEXUSFRAMEWORK_API UNexusSessionSearchConfig : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	UNexusSessionSearchConfig();
+
+	/** Master switch for the GameInstance result cache (UNexusSessionCacheSubsystem). */
+	UPROPERTY(Config, EditAnywhere, Category="Cache")
+	bool bEnableCache;
+
+	/** Age (seconds) under which cached results are returned without going back to the online service. */
+	UPROPERTY(Config, EditAnywhere, Category="Cache", meta=(ClampMin=0.0f, EditCondition="bEnableCache"))
+	float CacheFreshTime;
+
+	/** Age (seconds) under which stale results are still returned instantly while a background refresh runs. */
+	UPROPERTY(Config, EditAnywhere, Category="Cache", meta=(ClampMin=0.0f, EditCondition="bEnableCache"))
+	float CacheMaxStaleTime;
+
+	/** Maximum number of distinct queries kept in memory (least recently used are evicted first). */
+	UPROPERTY(Config, EditAnywhere, Category="Cache", meta=(ClampMin=1, EditCondition="bEnableCache"))
+	int32 MaxCacheEntries;
+
+	/** A refresh still running after this delay (seconds) is considered lost and may be restarted. */
+	UPROPERTY(Config, EditAnywhere, Category="Cache", meta=(ClampMin=1.0f, EditCondition="bEnableCache"))
+	float RefreshTimeout;
+
+	/** Streamed searches : raw results filtered per chunk. */
+	UPROPERTY(Config, EditAnywhere, Category="Streaming", meta=(ClampMin=1))
+	int32 StreamChunkSize;
+
+	/** Streamed searches : maximum processing time per frame (milliseconds). At least one chunk is processed per frame. */
+	UPROPERTY(Config, EditAnywhere, Category="Streaming", meta=(ClampMin=0.1f))
+	float StreamTimeBudgetMs;
+
+	/** Streamed searches : size of the first page when the node does not specify one. */
+	UPROPERTY(Config, EditAnywhere, Category="Streaming", meta=(ClampMin=1))
+	int32 DefaultPageSize;
+
+	/** Filters large result sets with ParallelFor (simple filters and thread-safe native rules only). */
+	UPROPERTY(Config, EditAnywhere, Category="Parallel Filtering")
+	bool bParallelFiltering;
+
+	/** Minimum number of raw results before the parallel path is used. */
+	UPROPERTY(Config, EditAnywhere, Category="Parallel Filtering", meta=(ClampMin=32, EditCondition="bParallelFiltering"))
+	int32 ParallelFilterThreshold;
+
+	/** Results per parallel task (rounded up to a multiple of 32). */
+	UPROPERTY(Config, EditAnywhere, Category="Parallel Filtering", meta=(ClampMin=32, EditCondition="bParallelFiltering"))
+	int32 ParallelChunkSize;
+
+	/** Multi-query searches : sub-queries still running after this delay (seconds) are reported as failed. */
+	UPROPERTY(Config, EditAnywhere, Category="Multi Query", meta=(ClampMin=1.0f))
+	float SubQueryTimeout;
+
+	/** Finished searches send UDP probes to their hosts (UNexusPingProberSubsystem). Ping rules use the measured RTT once available. */
+	UPROPERTY(Config, EditAnywhere, Category="Ping Probing")
+	bool bAutoProbeResults;
+
+	/**
+	 * Listen / dedicated servers answer ping probes on ProbePort (advertised as PING_PORT_KEY). Opt-in : it opens an extra
+	 * UDP port that answers anyone, open it in the firewall / NAT rules before enabling.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Ping Probing")
+	bool bEnableEchoResponder;
+
+	/** UDP port of the echo responder, used when a session does not advertise PING_PORT_KEY. */
+	UPROPERTY(Config, EditAnywhere, Category="Ping Probing", meta=(ClampMin=1, ClampMax=65535))
+	int32 ProbePort;
+
+	UPROPERTY(Config, EditAnywhere, Category="Ping Probing", meta=(ClampMin=1, ClampMax=32))
+	int32 ProbesPerHost;
+
+	/** Delay between two probes to the same host (milliseconds). */
+	UPROPERTY(Config, EditAnywhere, Category="Ping Probing", meta=(ClampMin=0.0f))
+	float ProbeSpacingMs;
+
+	/** A probe without reply after this delay (seconds) counts as lost. */
+	UPROPERTY(Config, EditAnywhere, Category="Ping Probing", meta=(ClampMin=0.05f))
+	float ProbeTimeout;
+
+	/** Hosts probed per batch of results. */
+	UPROPERTY(Config, EditAnywhere, Category="Ping Probing", meta=(ClampMin=1))
+	int32 MaxProbeHosts;
+
+	/** EWMA gain of the smoothed RTT (RFC 6298 alpha). */
+	UPROPERTY(Config, EditAnywhere, Category="Ping Probing", meta=(ClampMin=0.01f, ClampMax=1.0f))
+	float RttSmoothing;
+
+	/** EWMA gain of the jitter (RFC 6298 beta). */
+	UPROPERTY(Config, EditAnywhere, Category="Ping Probing", meta=(ClampMin=0.01f, ClampMax=1.0f))
+	float JitterSmoothing;
+
+	/** Estimates older than this (seconds) are ignored by the ping rules (backend PingInMs is used instead). */
+	UPROPERTY(Config, EditAnywhere, Category="Ping Probing", meta=(ClampMin=1.0f))
+	float PingEstimateLifetime;
+
+	/** Successful searches fill a session id -> result index, used to answer Find Session By ID locally. */
+	UPROPERTY(Config, EditAnywhere, Category="Id Lookup")
+	bool bEnableIdIndex;
+
+	/** Indexed results older than this (seconds) are ignored and looked up online again. */
+	UPROPERTY(Config, EditAnywhere, Category="Id Lookup", meta=(ClampMin=0.0f, EditCondition="bEnableIdIndex"))
+	float IdIndexMaxAge;
+
+	/** Maximum number of indexed sessions (oldest are evicted first). */
+	UPROPERTY(Config, EditAnywhere, Category="Id Lookup", meta=(ClampMin=1, EditCondition="bEnableIdIndex"))
+	int32 MaxIndexedSessions;
+
+	/**
+	 * Find Sessions By IDs : ids missing from the index are looked up one filtered query at a time (online services run a
+	 * single search at once). Ids beyond this many queries are reported missing.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Id Lookup", meta=(ClampMin=1))
+	int32 BulkLookupMaxQueries;
+};
@@ -0,0 +1,41 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "NexusSessionUpdateConfig.generated.h"
+
+
+UCLASS(Config=Game, DefaultConfig, meta=(DisplayName="Nexus Session Updates"))
+class NEXUSFRAMEWORK_API UNexusSessionUpdateConfig : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	UNexusSessionUpdateConfig();
+
+	/** Batches player registrations and advertisement updates (UNexusSessionUpdateSubsystem). Disabled = every call is sent immediately. */
+	UPROPERTY(Config, EditAnywhere, Category="Batching")
+	bool bBatchUpdates;
+
+	/** A session is flushed once no new request arrived for this long (seconds). */
+	UPROPERTY(Config, EditAnywhere, Category="Batching", meta=(ClampMin=0.0f, EditCondition="bBatchUpdates"))
+	float CoalesceWindow;
+
+	/** Upper bound (seconds) between the first queued request and the flush, even if requests keep coming. */
+	UPROPERTY(Config, EditAnywhere, Category="Batching", meta=(ClampMin=0.0f, EditCondition="bBatchUpdates"))
+	float MaxUpdateDelay;
+
+	/** Advertisement updates whose settings and open slots did not change since the last push are dropped. */
+	UPROPERTY(Config, EditAnywhere, Category="Batching")
+	bool bSkipUnchangedUpdates;
+
+	/** Default deadline (seconds) of a queued create / join / destroy operation, waiting time included. 0 = no deadline. */
+	UPROPERTY(Config, EditAnywhere, Category="Operations", meta=(ClampMin=0.0f))
+	float OperationTimeout;
+
+	/**
+	 * An operation abandoned while the online call runs is dropped after this extra delay (seconds) if the call never answers,
+	 * letting the next queued operation start. Requests can ask for less (FNexusSessionOperationRequest::AbandonGrace).
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Operations", meta=(ClampMin=1.0f))
+	float AbandonedOperationGrace;
+};
@@ -90,9 +90,44 @@ public:
     EOnlineComparisonOp::Type ToOnlineOp() const;
 };
 
+/**
+ * Prédicat compilé une fois par recherche à partir d'un FSessionSearchFilter (ou d'une règle clé/valeur).
+ * Clé, opérateur et opérande sont résolus à la compilation : aucune conversion en chaîne quand le type du setting correspond.
+ * Les types qui ne correspondent pas retombent sur FSessionFilterValue::CompareVariant (même sémantique).
+ */
+struct NEXUSFRAMEWORK_API FNexusCompiledSessionFilter
+{
+    FName Key = NAME_None;
+    EOnlineComparisonOp::Type Op = EOnlineComparisonOp::Equals;
+    ENexusSessionFilterValueType Type = ENexusSessionFilterValueType::String;
+
+    /** Opérateur Exists : seule la présence de la clé compte. */
+    bool bExists = false;
+
+    /** Résultat quand le setting est absent de la session. */
+    bool bMissingResult = false;
+
+    FString StringOperand;
+    int32 IntOperand = 0;
+    double NumericOperand = 0.0;
+    bool bBoolOperand = false;
+
+    /** Valeur d'origine, utilisée pour les types non triviaux. */
+    FSessionFilterValue SourceValue;
+
+    static FNexusCompiledSessionFilter Compile(const FSessionSearchFilter& Filter);
+
+    bool Matches(const FOnlineSessionSearchResult& Result) const;
+    bool MatchesData(const FVariantData& Data) const;
+};
+
 namespace NexusSessionFilterUtils
 {
     void ApplyFiltersToSettings(const TArray<FSessionSearchFilter>& Filters, FOnlineSessionSearch& SearchSettings);
     void ApplyFiltersToSettings(const TArray<FSessionSearchFilter>& Filters, FOnlineSessionSettings& SessionSettings);
     bool PassesAllFilters(const TArray<FSessionSearchFilter>& Filters, const FOnlineSessionSearchResult& Result);
+
+    /** Compiles every filter with a valid key. Filters without key always pass and are skipped. */
+    void CompileFilters(const TArray<FSessionSearchFilter>& Filters, TArray<FNexusCompiledSessionFilter>& OutCompiled);
+    bool PassesAllCompiled(const TArray<FNexusCompiledSessionFilter>& Compiled, const FOnlineSessionSearchResult& Result);
 }
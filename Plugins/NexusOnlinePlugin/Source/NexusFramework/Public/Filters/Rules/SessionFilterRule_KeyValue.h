@@ -27,6 +27,8 @@ public:
 
     virtual void ConfigureSearchSettings(FOnlineSessionSearch& SearchSettings) const override;
     virtual bool PassesFilter(const FOnlineSessionSearchResult& Result) const override;
+    virtual bool IsThreadSafe() const override { return true; }
+    virtual bool CompileFilter(FNexusCompiledSessionFilter& OutFilter) const override;
     virtual FString GetRuleDescription() const override;
 };
 
@@ -16,7 +16,12 @@ public:
         UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Nexus|Online|Filter")
         int32 MaxPing = 100;
 
+        /** Utilise le RTT mesuré par UNexusPingProberSubsystem quand il est disponible (sinon PingInMs). */
+        UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Nexus|Online|Filter")
+        bool bUseMeasuredPing = true;
+
         virtual bool PassesFilter(const FOnlineSessionSearchResult& Result) const override;
+        virtual bool IsThreadSafe() const override { return true; }
         virtual FString GetRuleDescription() const override;
 };
 
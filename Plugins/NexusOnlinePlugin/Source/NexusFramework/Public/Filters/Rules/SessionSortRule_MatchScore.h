@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Filters/SessionSortRule.h"
+#include "Filters/SessionMatchScoring.h"
+#include "SessionSortRule_MatchScore.generated.h"
+
+/**
+ * Règle de tri par score de matchmaking pondéré (ping, remplissage, région, version, niveau), meilleur score en premier.
+ * Placée en tête des règles avec TopK > 0, Find Sessions ne garde que les K meilleures sessions (sélection par tas, sans tri complet).
+ */
+UCLASS(BlueprintType, EditInlineNew)
+class NEXUSFRAMEWORK_API USessionSortRule_MatchScore : public USessionSortRule
+{
+        GENERATED_BODY()
+
+public:
+        UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Nexus|Online|Sort")
+        FNexusMatchScoringParams Scoring;
+
+        /** Nombre de sessions gardées (0 = toutes, triées par score). Ignoré en mode streamé. */
+        UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Nexus|Online|Sort", meta=(ClampMin=0))
+        int32 TopK = 0;
+
+        virtual bool Compare(const FOnlineSessionSearchResult& A, const FOnlineSessionSearchResult& B) const override;
+        virtual int32 GetSortKeyWidth() const override { return 1; }
+        virtual void ExtractSortKey(const FOnlineSessionSearchResult& Result, TArrayView<double> OutKey) const override;
+        virtual FString GetRuleDescription() const override;
+};
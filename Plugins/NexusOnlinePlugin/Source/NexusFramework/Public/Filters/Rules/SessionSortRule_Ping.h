@@ -16,7 +16,16 @@ public:
         UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Nexus|Online|Sort")
         bool bAscending = true;
 
+        /** Utilise le RTT mesuré par UNexusPingProberSubsystem quand il est disponible (sinon PingInMs). */
+        UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Nexus|Online|Sort")
+        bool bUseMeasuredPing = true;
+
         virtual bool Compare(const FOnlineSessionSearchResult& A, const FOnlineSessionSearchResult& B) const override;
+        virtual int32 GetSortKeyWidth() const override { return 1; }
+        virtual void ExtractSortKey(const FOnlineSessionSearchResult& Result, TArrayView<double> OutKey) const override;
         virtual FString GetRuleDescription() const override;
+
+private:
+        int32 GetPing(const FOnlineSessionSearchResult& Result) const;
 };
 
@@ -5,6 +5,7 @@
 
 class FOnlineSessionSearch;
 class FOnlineSessionSearchResult;
+struct FNexusCompiledSessionFilter;
 
 
 /**
@@ -34,6 +35,21 @@ public:
     /** Vérifie si le résultat répond à la règle (post-filtre). */
     virtual bool PassesFilter(const FOnlineSessionSearchResult& Result) const;
 
+    /**
+     * Permet à une règle simple de se réduire à un prédicat compilé (évalué sans appel virtuel ni allocation).
+     * Retourne false si la règle doit rester évaluée via PassesFilter.
+     */
+    virtual bool CompileFilter(FNexusCompiledSessionFilter& OutFilter) const;
+
+    /**
+     * Déclare que PassesFilter ne lit que des données immuables pendant la recherche et peut tourner hors game thread.
+     * Ignoré pour les classes Blueprint, toujours évaluées sur le game thread.
+     */
+    virtual bool IsThreadSafe() const;
+
+    /** IsThreadSafe() et classe native. */
+    bool CanEvaluateOffGameThread() const;
+
     /** Texte de debug affiché dans les logs. */
     virtual FString GetRuleDescription() const;
 };
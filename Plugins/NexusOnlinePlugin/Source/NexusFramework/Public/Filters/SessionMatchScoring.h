@@ -0,0 +1,114 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Function.h"
+#include "SessionMatchScoring.generated.h"
+
+class FOnlineSessionSearchResult;
+
+
+/**
+ * Critères pondérés du score de matchmaking.
+ * Chaque critère donne une note entre 0 et 1 ; le score final est leur moyenne pondérée (poids <= 0 = critère ignoré).
+ */
+USTRUCT(BlueprintType)
+struct NEXUSFRAMEWORK_API FNexusMatchScoringParams
+{
+	GENERATED_BODY()
+
+public:
+	// ---- Ping
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Nexus|Online|Score|Ping", meta=(ClampMin=0.0f))
+	float PingWeight = 1.f;
+
+	/** Note maximale jusqu'à ce ping (ms). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Nexus|Online|Score|Ping", meta=(ClampMin=0))
+	int32 IdealPingMs = 30;
+
+	/** Note nulle à partir de ce ping (ms). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Nexus|Online|Score|Ping", meta=(ClampMin=1))
+	int32 MaxPingMs = 250;
+
+	/** Utilise le RTT mesuré par UNexusPingProberSubsystem quand il est disponible. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Nexus|Online|Score|Ping")
+	bool bUseMeasuredPing = true;
+
+	// ---- Remplissage
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Nexus|Online|Score|Fill", meta=(ClampMin=0.0f))
+	float FillWeight = 0.5f;
+
+	/** Taux de remplissage idéal (0 = vide, 1 = pleine). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Nexus|Online|Score|Fill", meta=(ClampMin=0.0f, ClampMax=1.0f))
+	float IdealFillRatio = 0.75f;
+
+	/** Les sessions pleines sont écartées (elles ne peuvent pas être rejointes). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Nexus|Online|Score|Fill")
+	bool bRejectFullSessions = true;
+
+	// ---- Région
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Nexus|Online|Score|Region", meta=(ClampMin=0.0f))
+	float RegionWeight = 0.5f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Nexus|Online|Score|Region")
+	FName RegionKey = TEXT("REGION");
+
+	/** Région préférée (comparaison insensible à la casse). Vide = critère ignoré. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Nexus|Online|Score|Region")
+	FString PreferredRegion;
+
+	// ---- Version
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Nexus|Online|Score|Build", meta=(ClampMin=0.0f))
+	float BuildWeight = 1.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Nexus|Online|Score|Build")
+	FName BuildKey = TEXT("BUILD_VERSION");
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Nexus|Online|Score|Build")
+	int32 BuildVersion = 1;
+
+	/** Une autre version écarte la session au lieu de seulement baisser sa note. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Nexus|Online|Score|Build")
+	bool bRequireSameBuild = true;
+
+	// ---- Niveau
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Nexus|Online|Score|Skill", meta=(ClampMin=0.0f))
+	float SkillWeight = 0.f;
+
+	/** Clé numérique (int, float ou double) du niveau moyen de la session. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Nexus|Online|Score|Skill")
+	FName SkillKey = TEXT("SKILL");
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Nexus|Online|Score|Skill")
+	float PlayerSkill = 0.f;
+
+	/** Écart de niveau à partir duquel la note tombe à 0. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Nexus|Online|Score|Skill", meta=(ClampMin=0.001f))
+	float SkillBandWidth = 1.f;
+
+	FString ToDebugString() const;
+};
+
+
+namespace NexusMatchScoring
+{
+	struct FScoredIndex
+	{
+		float Score = 0.f;
+		int32 Index = INDEX_NONE;
+	};
+
+	/** Score in [0, 1], or a negative value if the session is rejected (full, other build when required). */
+	NEXUSFRAMEWORK_API float ScoreResult(const FNexusMatchScoringParams& Params, const FOnlineSessionSearchResult& Result);
+
+	/**
+	 * Scores Num results once each and keeps the K best with a bounded min-heap (O(N log K), no full sort).
+	 * Rejected results are skipped. OutBest is sorted best first ; equal scores keep their input order. K <= 0 keeps everything.
+	 */
+	NEXUSFRAMEWORK_API void SelectTopK(const FNexusMatchScoringParams& Params, int32 Num,
+		TFunctionRef<const FOnlineSessionSearchResult&(int32)> GetResult, int32 K, TArray<FScoredIndex>& OutBest);
+}
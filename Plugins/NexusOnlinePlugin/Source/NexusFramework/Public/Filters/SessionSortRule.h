@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "UObject/Object.h"
+#include "Templates/Function.h"
 #include "SessionSortRule.generated.h"
 
 class FOnlineSessionSearch;
@@ -25,10 +26,37 @@ public:
         /** Possibilité d'influencer les QuerySettings (ex: ping max). */
         virtual void ConfigureSearchSettings(FOnlineSessionSearch& SearchSettings) const;
 
-        /** Méthode de comparaison utilisée pour le tri final. */
+        /** Méthode de comparaison utilisée pour le tri final (fallback quand la règle n'expose pas de clé). */
         virtual bool Compare(const FOnlineSessionSearchResult& A, const FOnlineSessionSearchResult& B) const;
 
+        /**
+         * Nombre de composantes de la clé de tri (1 = scalaire, >1 = tuple).
+         * 0 = pas d'extracteur : le tri retombe sur Compare pour toutes les règles.
+         */
+        virtual int32 GetSortKeyWidth() const;
+
+        /**
+         * Écrit GetSortKeyWidth() composantes, comparées dans l'ordre croissant (lexicographique pour un tuple).
+         * Un tri décroissant s'obtient en négativant la clé. Doit être cohérent avec Compare.
+         */
+        virtual void ExtractSortKey(const FOnlineSessionSearchResult& Result, TArrayView<double> OutKey) const;
+
         /** Description lisible utilisée pour les logs. */
         virtual FString GetRuleDescription() const;
 };
 
+
+namespace NexusSessionSortUtils
+{
+        /**
+         * Computes the final order of Num results (stable : equal keys keep their input order).
+         * If every enabled rule exposes a key, keys are extracted once per result and a compact (key, index) array is sorted;
+         * otherwise the pairwise Compare path is used.
+         */
+        NEXUSFRAMEWORK_API void ComputeSortOrder(const TArray<TObjectPtr<USessionSortRule>>& Rules, int32 Num,
+                TFunctionRef<const FOnlineSessionSearchResult&(int32)> GetResult, TArray<int32>& OutOrder);
+
+        /** Sorts the array in place, moving each result exactly once. */
+        NEXUSFRAMEWORK_API void SortResults(const TArray<TObjectPtr<USessionSortRule>>& Rules, TArray<FOnlineSessionSearchResult>& InOutResults);
+}
+
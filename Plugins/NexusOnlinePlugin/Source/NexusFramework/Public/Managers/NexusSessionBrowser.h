@@ -0,0 +1,213 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "Containers/Ticker.h"
+#include "Types/OnlineSessionData.h"
+#include "Data/SessionSearchFilter.h"
+#include "NexusSessionBrowser.generated.h"
+
+class UAsyncTask_FindSessions;
+class USessionFilterRule;
+class USessionSortRule;
+class USessionFilterPreset;
+
+
+UENUM(BlueprintType, meta=(Bitflags, UseEnumValuesAsMaskValuesInEditor="true"))
+enum class ENexusSessionChangedFields : uint8
+{
+	None        = 0 UMETA(Hidden),
+	Players     = 1 << 0,
+	MaxPlayers  = 1 << 1,
+	Ping        = 1 << 2,
+	Metadata    = 1 << 3 UMETA(ToolTip="Display name, map or game mode")
+};
+ENUM_CLASS_FLAGS(ENexusSessionChangedFields);
+
+
+/**
+ * Changement d'une ligne du navigateur : seuls les champs marqués dans ChangedFields ont bougé.
+ */
+USTRUCT(BlueprintType)
+struct FNexusSessionRowUpdate
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Browser")
+	FString SessionId;
+
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Browser", meta=(Bitmask, BitmaskEnum="/Script/NexusFramework.ENexusSessionChangedFields"))
+	int32 ChangedFields = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Browser")
+	int32 CurrentPlayers = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Browser")
+	int32 MaxPlayers = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Browser")
+	int32 Ping = 0;
+
+	/** Position avant / après le changement (différentes si le tri a déplacé la ligne). */
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Browser")
+	int32 OldIndex = INDEX_NONE;
+
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Browser")
+	int32 NewIndex = INDEX_NONE;
+
+	bool HasChanged(ENexusSessionChangedFields Field) const { return (ChangedFields & static_cast<int32>(Field)) != 0; }
+};
+
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnBrowserSessionAdded, const FOnlineSessionSearchResultData&, Session, int32, Index);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnBrowserSessionRemoved, const FString&, SessionId, int32, Index);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnBrowserSessionUpdated, const FNexusSessionRowUpdate&, Update);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_FourParams(FOnBrowserRefreshed, bool, bWasSuccessful, int32, NumAdded, int32, NumRemoved, int32, NumUpdated);
+
+
+/**
+ * Live server browser.
+ *
+ * Refreshes in the background every RefreshInterval seconds and keeps its rows keyed by session id.
+ * Instead of replacing the list, each refresh emits Removed, then Updated, then Added events; indices are valid
+ * at the time each event fires, so a UI list can apply them one by one and keep its rows and scroll position.
+ * Searches run without sort rules : the browser keeps its rows ordered itself, inserting new rows by binary search
+ * and moving only the rows whose sort key changed.
+ */
+UCLASS(BlueprintType)
+class NEXUSFRAMEWORK_API UNexusSessionBrowser : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Creates a browser (call Start to begin refreshing).
+	 * @param RefreshInterval Seconds between the end of a refresh and the start of the next one.
+	 */
+	UFUNCTION(BlueprintCallable, meta=(WorldContext="WorldContextObject", AutoCreateRefTerm="SimpleFilters,AdvancedRules,SortRules"), Category="Nexus|Online|Browser")
+	static UNexusSessionBrowser* CreateSessionBrowser(UObject* WorldContextObject, ENexusSessionType SessionType, int32 MaxResults, bool bIsLANQuery,
+		const TArray<FSessionSearchFilter>& SimpleFilters, const TArray<USessionFilterRule*>& AdvancedRules,
+		const TArray<USessionSortRule*>& SortRules, USessionFilterPreset* Preset, float RefreshInterval = 15.f);
+
+	virtual void BeginDestroy() override;
+
+	// ──────────────────────────────────────────────
+	// Control
+	// ──────────────────────────────────────────────
+
+	/** Starts refreshing (first refresh immediately). */
+	UFUNCTION(BlueprintCallable, Category="Nexus|Online|Browser")
+	void Start();
+
+	/** Stops the periodic refresh. Rows are kept. */
+	UFUNCTION(BlueprintCallable, Category="Nexus|Online|Browser")
+	void Stop();
+
+	/** Refreshes now (ignored if a refresh is already running). */
+	UFUNCTION(BlueprintCallable, Category="Nexus|Online|Browser")
+	void RefreshNow();
+
+	UFUNCTION(BlueprintPure, Category="Nexus|Online|Browser")
+	bool IsRunning() const { return bRunning; }
+
+	UFUNCTION(BlueprintPure, Category="Nexus|Online|Browser")
+	bool IsRefreshing() const { return ActiveSearch != nullptr; }
+
+	// ──────────────────────────────────────────────
+	// Rows
+	// ──────────────────────────────────────────────
+
+	UFUNCTION(BlueprintPure, Category="Nexus|Online|Browser")
+	int32 GetSessionCount() const { return Rows.Num(); }
+
+	UFUNCTION(BlueprintPure, Category="Nexus|Online|Browser")
+	bool GetSessionAt(int32 Index, FOnlineSessionSearchResultData& OutSession) const;
+
+	UFUNCTION(BlueprintPure, Category="Nexus|Online|Browser")
+	bool FindSession(const FString& SessionId, FOnlineSessionSearchResultData& OutSession, int32& OutIndex) const;
+
+	/** Copy of every row, in display order. */
+	UFUNCTION(BlueprintPure, Category="Nexus|Online|Browser")
+	TArray<FOnlineSessionSearchResultData> GetSessions() const;
+
+	// ──────────────────────────────────────────────
+	// Events
+	// ──────────────────────────────────────────────
+
+	UPROPERTY(BlueprintAssignable, Category="Nexus|Online|Browser")
+	FOnBrowserSessionAdded OnSessionAdded;
+
+	UPROPERTY(BlueprintAssignable, Category="Nexus|Online|Browser")
+	FOnBrowserSessionRemoved OnSessionRemoved;
+
+	UPROPERTY(BlueprintAssignable, Category="Nexus|Online|Browser")
+	FOnBrowserSessionUpdated OnSessionUpdated;
+
+	/** Fired after each refresh, once every row event has been sent. */
+	UPROPERTY(BlueprintAssignable, Category="Nexus|Online|Browser")
+	FOnBrowserRefreshed OnRefreshed;
+
+private:
+	struct FRow
+	{
+		FString SessionId;
+		FOnlineSessionSearchResultData Data;
+		TArray<double, TInlineAllocator<4>> SortKey;
+	};
+
+	bool TickRefresh(float DeltaTime);
+
+	UFUNCTION()
+	void HandleSearchCompleted(bool bWasSuccessful, const TArray<FOnlineSessionSearchResultData>& Results);
+
+	void ApplyResults(const TArray<FOnlineSessionSearchResultData>& Results, int32& OutAdded, int32& OutRemoved, int32& OutUpdated);
+
+	// ---- Ordering
+
+	void ResolveSortRules();
+	void ComputeSortKey(FRow& Row) const;
+	bool IsRowBefore(const FRow& A, const FRow& B) const;
+	bool IsInOrder(int32 Index) const;
+	int32 FindInsertIndex(const FRow& Row) const;
+	int32 IndexOfRow(const FRow* Row) const;
+	int32 IndexOfSession(const FString& SessionId) const;
+
+	static int32 ComputeChangedFields(const FOnlineSessionSearchResultData& Old, const FOnlineSessionSearchResultData& New);
+
+	// ---- Search configuration
+
+	UPROPERTY()
+	TObjectPtr<UObject> WorldContextObject;
+
+	ENexusSessionType SessionType = ENexusSessionType::GameSession;
+	int32 MaxResults = 50;
+	bool bIsLANQuery = false;
+	float RefreshInterval = 15.f;
+
+	UPROPERTY()
+	TArray<FSessionSearchFilter> SimpleFilters;
+
+	UPROPERTY()
+	TArray<TObjectPtr<USessionFilterRule>> AdvancedRules;
+
+	/** Sort rules applied by the browser itself (user rules + preset rules, by priority). */
+	UPROPERTY()
+	TArray<TObjectPtr<USessionSortRule>> SortRules;
+
+	TArray<const USessionSortRule*, TInlineAllocator<8>> ActiveSortRules;
+	int32 SortKeyWidth = 0;
+	bool bKeyedSort = false;
+
+	// ---- State
+
+	UPROPERTY()
+	TObjectPtr<UAsyncTask_FindSessions> ActiveSearch;
+
+	/** Rows in display order (heap-allocated : a refresh keeps stable pointers while rows move). */
+	TArray<TUniquePtr<FRow>> Rows;
+
+	bool bRunning = false;
+	double NextRefreshTime = 0.0;
+
+	FTSTicker::FDelegateHandle TickHandle;
+};
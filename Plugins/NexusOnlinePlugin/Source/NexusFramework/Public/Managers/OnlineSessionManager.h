@@ -1,16 +1,59 @@
 #pragma once
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "GameFramework/OnlineReplStructs.h"
 #include "OnlineSessionManager.generated.h"
 
 class IOnlineSession;
 class FUniqueNetId;
+class AGameModeBase;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnPlayerCountChanged, int32, NewPlayerCount);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnPlayerJoinedSignature, const FString&, PlayerName);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnPlayerLeftSignature, const FString&, PlayerName);
 
 
+/**
+ * Heir election details of one candidate (server only).
+ */
+USTRUCT(BlueprintType)
+struct FNexusHeirScore
+{
+    GENERATED_BODY()
+
+public:
+    UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Migration")
+    FString PlayerId;
+
+    /** 0-1, weighted by the Heir Election settings of Nexus Migration. */
+    UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Migration")
+    float Score = 0.f;
+
+    UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Migration")
+    float RttMs = 0.f;
+
+    /** Client -> host loss (0-1) : the direction that matters once the candidate hosts. */
+    UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Migration")
+    float PacketLoss = 0.f;
+
+    /** Reported by the client at login (0 = unknown). */
+    UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Migration")
+    int32 UploadKbps = 0;
+
+    /** Reported by the client at login (-1 = unknown). */
+    UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Migration")
+    int32 HardwareTier = -1;
+
+    /** Registered in the online session : ranked before unregistered players. */
+    UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Migration")
+    bool bRegistered = false;
+
+    /** "ip:port" the candidate listens on if it becomes host (empty = no standby port reported). */
+    UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Migration")
+    FString StandbyAddress;
+};
+
+
 UCLASS(Blueprintable, BlueprintType)
 class NEXUSFRAMEWORK_API AOnlineSessionManager : public AActor
 {
@@ -27,15 +70,36 @@ public:
     UPROPERTY(Replicated, BlueprintReadOnly, Category="Nexus|Online")
     FName TrackedSessionName;
 
+    /** Push-model : only sent when the count actually changes. */
     UPROPERTY(ReplicatedUsing=OnRep_PlayerCount, BlueprintReadOnly, Category="Nexus|Online")
     int32 PlayerCount;
 
-    UPROPERTY(ReplicatedUsing=OnRep_NextHostUniqueId, BlueprintReadOnly, Category="Nexus|Online|Migration")
+    /** Full recount from the session and the connected controllers, as a safety net for missed events (seconds, 0 = off). */
+    UPROPERTY(EditDefaultsOnly, Category="Nexus|Online")
+    float ReconcileInterval = 60.f;
+
+    /** Ranked heirs, best first (push-model : only sent when the ranking changes). */
+    UPROPERTY(ReplicatedUsing=OnRep_HeirList, BlueprintReadOnly, Category="Nexus|Online|Migration")
+    TArray<FUniqueNetIdRepl> HeirList;
+
+    /** Standby connect string of each heir, same order as HeirList : clients reconnect there without searching. */
+    UPROPERTY(ReplicatedUsing=OnRep_HeirList, BlueprintReadOnly, Category="Nexus|Online|Migration")
+    TArray<FString> HeirAddresses;
+
+    /** HeirList[0] as a string, kept on server and clients. */
+    UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Migration")
     FString NextHostUniqueId;
 
     UFUNCTION(BlueprintCallable, Category="Nexus|Online|Migration")
     FString GetNextHostUniqueId() const { return NextHostUniqueId; }
 
+    UFUNCTION(BlueprintCallable, Category="Nexus|Online|Migration")
+    TArray<FString> GetHeirList() const;
+
+    /** Scores of the last ranking, every candidate included (server only). */
+    UFUNCTION(BlueprintPure, Category="Nexus|Online|Migration")
+    TArray<FNexusHeirScore> GetHeirRanking() const { return LastHeirRanking; }
+
 
     UPROPERTY(BlueprintAssignable, Category="Nexus|Online")
     FOnPlayerCountChanged OnPlayerCountChanged;
@@ -66,7 +130,7 @@ protected:
     void OnRep_PlayerCount();
 
     UFUNCTION()
-    void OnRep_NextHostUniqueId();
+    void OnRep_HeirList();
 
     // --- Internal Logic ---
 
@@ -75,7 +139,8 @@ protected:
 
     FDelegateHandle RegisterPlayersHandle;
     FDelegateHandle UnregisterPlayersHandle;
-    FTimerHandle TimerHandle_Refresh;
+    FTimerHandle TimerHandle_Reconcile;
+    FTimerHandle TimerHandle_HeirRank;
     FTimerHandle TimerHandle_RetryRegister;
     int32 RegisterHostRetries = 0;
     static const int32 MAX_REGISTER_RETRIES = 10;
@@ -83,12 +148,44 @@ protected:
     void TryRegisterHost();
     bool GetHostUniqueId(FUniqueNetIdRepl& OutId) const;
 
-    void RefreshPlayerCount();
+    /** Full recount : rebuilds the tracked controllers and re-reads the session. */
+    void ReconcilePlayerCount();
+
+    /** Count = max(connected controllers, registered session players). Marks PlayerCount dirty only on change. */
+    void UpdatePlayerCount();
+
     void BindSessionDelegates();
     void UnbindSessionDelegates();
 
+    void OnGameModePostLogin(AGameModeBase* GameMode, APlayerController* NewPlayer);
+    void OnGameModeLogout(AGameModeBase* GameMode, AController* Exiting);
+
+    /** Player controllers logged in on this server, maintained from PostLogin / Logout. */
+    TSet<TWeakObjectPtr<AController>> ConnectedControllers;
+
+    /** RegisteredPlayers.Num() of the tracked session, read on register / unregister. */
+    int32 RegisteredPlayerCount = 0;
+
+    FDelegateHandle PostLoginHandle;
+    FDelegateHandle LogoutHandle;
+
+    /** Ranks the connected players and replicates the top HeirListSize if the order changed. */
     void UpdateHeir();
 
+    /** Upload / hardware tier / standby port a client sent as login options (see UNexusMigrationSubsystem::GetHeirLoginOptions). */
+    struct FReportedCapabilities
+    {
+        int32 UploadKbps = 0;
+        int32 HardwareTier = -1;
+        int32 StandbyPort = 0;
+    };
+
+    const FReportedCapabilities& GetReportedCapabilities(APlayerController* PC);
+
+    TMap<TWeakObjectPtr<AController>, FReportedCapabilities> ReportedCapabilities;
+
+    TArray<FNexusHeirScore> LastHeirRanking;
+
     void OnPlayersRegistered(FName SessionName, const TArray<FUniqueNetIdRef>& Players, bool bWasSuccessful);
     void OnPlayersUnregistered(FName SessionName, const TArray<FUniqueNetIdRef>& Players, bool bWasSuccessful);
 
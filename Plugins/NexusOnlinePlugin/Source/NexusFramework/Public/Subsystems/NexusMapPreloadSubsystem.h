@@ -0,0 +1,128 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "UObject/UObjectGlobals.h"
+#include "NexusMapPreloadSubsystem.generated.h"
+
+
+/**
+ * Timings of one create / join flow, from the moment the player committed to the first frame of the new map.
+ */
+USTRUCT(BlueprintType)
+struct FNexusTravelMetrics
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Travel")
+	FString MapName;
+
+	/** The map package was (at least partly) loaded while the session call was running. */
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Travel")
+	bool bPreloaded = false;
+
+	/** Commit -> session created / joined. */
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Travel")
+	float SessionMs = 0.f;
+
+	/** Duration of the async preload (-1 if none or not finished before the travel). */
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Travel")
+	float PreloadMs = -1.f;
+
+	/** Part of the preload that ran in parallel with the session call : the time saved on the level change. */
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Travel")
+	float OverlapMs = 0.f;
+
+	/** Session ready -> new map loaded. */
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Travel")
+	float TravelMs = 0.f;
+
+	/** Commit -> new map loaded. */
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Travel")
+	float TimeToInGameMs = 0.f;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnNexusTravelMetrics, const FNexusTravelMetrics&, Metrics);
+
+
+/**
+ * Async map preloading for the create / join flows.
+ *
+ * BeginFlow starts LoadPackageAsync on the target map as soon as the player commits, in parallel with the session call.
+ * The loaded package is kept referenced until the level change, which then finds it in memory instead of loading it
+ * from scratch. Every flow (preloaded or not) reports its timings through OnTravelMetrics once the new map is loaded.
+ */
+UCLASS()
+class NEXUSFRAMEWORK_API UNexusMapPreloadSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	static UNexusMapPreloadSubsystem* Get(const UObject* WorldContextObject);
+
+	// ──────────────────────────────────────────────
+	// Flow (used by the create / join tasks)
+	// ──────────────────────────────────────────────
+
+	/** The player committed : starts timing and, if requested, preloading MapName (short name or /Game/... path). */
+	void BeginFlow(const FString& MapName, bool bPreload);
+
+	/** The session call succeeded : the level change is about to start. */
+	void NotifySessionReady();
+
+	/** The flow failed : the preloaded package is released. */
+	void CancelFlow();
+
+	// ──────────────────────────────────────────────
+	// Queries
+	// ──────────────────────────────────────────────
+
+	UFUNCTION(BlueprintPure, Category="Nexus|Online|Travel")
+	bool IsPreloading() const { return PreloadRequestId != INDEX_NONE; }
+
+	UFUNCTION(BlueprintPure, Category="Nexus|Online|Travel")
+	bool IsMapPreloaded() const { return PreloadedPackage != nullptr; }
+
+	UFUNCTION(BlueprintPure, Category="Nexus|Online|Travel")
+	FNexusTravelMetrics GetLastTravelMetrics() const { return LastMetrics; }
+
+	/** Drops the preloaded map if the travel will not happen (e.g. after a join without auto travel). */
+	UFUNCTION(BlueprintCallable, Category="Nexus|Online|Travel")
+	void ReleasePreload();
+
+	UPROPERTY(BlueprintAssignable, Category="Nexus|Online|Travel")
+	FOnNexusTravelMetrics OnTravelMetrics;
+
+private:
+	void StartPreload(const FString& MapName);
+	void OnPreloadCompleted(const FName& PackageName, UPackage* Package, EAsyncLoadingResult::Type Result);
+	void OnPostLoadMap(UWorld* LoadedWorld);
+
+	static bool ResolveMapPackage(const FString& MapName, FString& OutPackageName);
+
+	struct FFlowState
+	{
+		bool bActive = false;
+		FString MapName;
+		FString PackageName;
+		double CommitTime = 0.0;
+		double SessionReadyTime = 0.0;
+		double PreloadStartTime = 0.0;
+		double PreloadEndTime = 0.0;
+	};
+
+	FFlowState Flow;
+
+	/** Keeps the preloaded map alive until LoadMap picks it up. */
+	UPROPERTY()
+	TObjectPtr<UPackage> PreloadedPackage;
+
+	int32 PreloadRequestId = INDEX_NONE;
+
+	FNexusTravelMetrics LastMetrics;
+
+	FDelegateHandle PostLoadMapHandle;
+};
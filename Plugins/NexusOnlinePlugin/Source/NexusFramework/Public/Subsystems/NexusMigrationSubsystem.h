@@ -1,16 +1,63 @@
 #pragma once
 #include "CoreMinimal.h"
 #include "Subsystems/GameInstanceSubsystem.h"
+#include "Engine/TimerHandle.h"
 #include "Types/OnlineSessionData.h"
 #include "NexusMigrationSubsystem.generated.h"
 
 class UAsyncTask_CreateSession;
 class UAsyncTask_FindSessions;
 class UAsyncTask_JoinSession;
+struct FSessionSearchFilter;
+class FSocket;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnMigrationStarted);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnMigrationFailed, FString, Reason);
 
+
+/**
+ * Timings of one host migration, in ms since the network failure was detected.
+ */
+USTRUCT(BlueprintType)
+struct FNexusMigrationMetrics
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Migration")
+	int32 Generation = 0;
+
+	/** This instance became the new host. */
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Migration")
+	bool bAsHost = false;
+
+	/** Hot standby path : prepared session on the heir, direct reconnect on the clients. */
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Migration")
+	bool bHotStandby = false;
+
+	/** Host only : next-generation session created. */
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Migration")
+	float SessionReadyMs = 0.f;
+
+	/** Host : map reopened and listening. Client : connected to the new host and map loaded. */
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Migration")
+	float MapLoadedMs = 0.f;
+
+	/** Failure -> back in game. */
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Migration")
+	float TotalMs = 0.f;
+
+	/** Client only : direct reconnects tried. */
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Migration")
+	int32 DirectAttempts = 0;
+
+	/** Host only : objects rehydrated from the last game state snapshot (UNexusSnapshotSubsystem). */
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Migration")
+	int32 RestoredObjects = 0;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnMigrationCompleted, const FNexusMigrationMetrics&, Metrics);
+
 UCLASS()
 class NEXUSFRAMEWORK_API UNexusMigrationSubsystem : public UGameInstanceSubsystem
 {
@@ -25,6 +72,48 @@ public:
 
 	void SetCachedNextHostId(const FString& NewHeirId) { CachedNextHostId = NewHeirId; }
 
+	/**
+	 * Ranked heirs replicated by AOnlineSessionManager (best first) ; the first one becomes the next host.
+	 * HeirAddresses holds their standby connect strings in the same order (empty when unknown).
+	 */
+	void SetCachedHeirList(const TArray<FString>& HeirIds, const TArray<FString>& HeirAddresses = TArray<FString>());
+
+	UFUNCTION(BlueprintPure, Category="Nexus|Migration")
+	TArray<FString> GetCachedHeirList() const { return CachedHeirList; }
+
+	/** "ip:port" the next host will listen on, reached directly on failover (empty = session search). */
+	UFUNCTION(BlueprintPure, Category="Nexus|Migration")
+	FString GetCachedNextHostAddress() const { return CachedNextHostAddress; }
+
+	// ──────────────────────────────────────────────
+	// Hot standby (first heir)
+	// ──────────────────────────────────────────────
+
+	/** True while this client is the first heir : standby port reserved and next-generation session prepared. */
+	UFUNCTION(BlueprintPure, Category="Nexus|Migration")
+	bool IsInStandby() const { return bInStandby; }
+
+	/** Port reserved in standby and listened on after failover. */
+	static int32 GetStandbyPort();
+
+	UFUNCTION(BlueprintPure, Category="Nexus|Migration")
+	FNexusMigrationMetrics GetLastMigrationMetrics() const { return LastMigrationMetrics; }
+
+	// ──────────────────────────────────────────────
+	// Heir capabilities (sent to the host as login options)
+	// ──────────────────────────────────────────────
+
+	/** Upload bandwidth measured by the game (speed test, platform API...). 0 = unknown. */
+	UFUNCTION(BlueprintCallable, Category="Nexus|Migration")
+	void SetLocalUploadBandwidth(int32 UploadKbps) { LocalUploadKbps = FMath::Max(0, UploadKbps); }
+
+	/** 0 (low end) to 3 (high end), from core count and physical memory. */
+	UFUNCTION(BlueprintPure, Category="Nexus|Migration")
+	static int32 GetLocalHardwareTier();
+
+	/** "?NexusUpKbps=...?NexusHwTier=...?NexusStandbyPort=..." : appended to the travel URL by the join nodes. */
+	FString GetHeirLoginOptions() const;
+
 	UFUNCTION(BlueprintPure, Category="Nexus|Migration")
 	bool IsMigrating() const { return bIsMigrating; }
 
@@ -38,11 +127,18 @@ public:
 	UPROPERTY(BlueprintAssignable, Category="Nexus|Migration")
 	FOnMigrationFailed OnMigrationFailed;
 
+	/** Local player back in game after a migration, with the recovery timings. */
+	UPROPERTY(BlueprintAssignable, Category="Nexus|Migration")
+	FOnMigrationCompleted OnMigrationCompleted;
+
 protected:
 	UPROPERTY(Transient)
 	FSessionSettingsData CachedSessionSettings;
 
 	FString CachedNextHostId;
+	FString CachedNextHostAddress;
+	TArray<FString> CachedHeirList;
+	int32 LocalUploadKbps = 0;
 	bool bIsMigrating = false;
 	bool bRecoveringHost = false; // Pending Host Recovery State
 	bool bIntentionalLeave = false;
@@ -57,6 +153,7 @@ protected:
 	int32 MigrationRetries = 0;
 
 	FString GetEffectiveMigrationId() const;
+	FString GetMigrationIdForGeneration(int32 Generation) const;
     
     // Timestamp of the last migration failure (Travel or Network) to prevent loops
     double LastMigrationFailureTime = 0.0;
@@ -70,6 +167,50 @@ protected:
 	UPROPERTY()
 	UAsyncTask_JoinSession* CurrentJoinTask;
 
+	// ---- Hot standby
+	bool bInStandby = false;
+	bool bStandbyOwnsEcho = false;
+
+	/** Plain UDP socket holding the standby port when the echo responder is disabled (bEnableEchoResponder). */
+	FSocket* StandbyPortSocket = nullptr;
+
+	/** Next-generation create, built in standby and activated as soon as the host is lost. */
+	UPROPERTY()
+	UAsyncTask_CreateSession* StandbyCreateTask;
+
+	FString StandbyMigrationId;
+
+	bool bHotStandbyRecovery = false;
+	bool bHostSessionReady = false;
+	bool bHostMapReady = false;
+
+	bool bDirectReconnecting = false;
+	bool bDirectReconnectInFlight = false;
+	int32 DirectReconnectAttempts = 0;
+	FTimerHandle TimerHandle_DirectReconnect;
+
+	/** Searches for the new host's session after a direct reconnect (joined without travel). */
+	int32 ReconnectedSessionSearches = 0;
+	int32 ReconnectedSessionGeneration = 0;
+
+	// ---- Metrics
+	double RecoveryStartTime = 0.0;
+	FNexusMigrationMetrics PendingMetrics;
+	FNexusMigrationMetrics LastMigrationMetrics;
+
+	FString GetLocalPlayerId() const;
+	UAsyncTask_CreateSession* MakeRecoveryCreateTask(UObject* WorldContext, const FString& EffectiveId);
+
+	void UpdateStandby();
+	void EnterStandby();
+	void LeaveStandby();
+	bool ReserveStandbyPort();
+	void ReleaseStandbyPort();
+
+	void TryCompleteHostRecovery();
+	float GetRecoveryElapsedMs() const;
+	void CompleteMigrationMetrics();
+
 public:
 	void OnNetworkFailure(UWorld* World, UNetDriver* NetDriver, ENetworkFailure::Type FailureType, const FString& ErrorString);
 	void OnTravelFailure(UWorld* World, ETravelFailure::Type FailureType, const FString& ErrorString);
@@ -82,9 +223,19 @@ public:
 	void StartClientRecovery();
 	void PerformClientSearch();
 
+	void StartDirectReconnect();
+	void AttemptDirectReconnect();
+	void OnDirectReconnectFailed(const FString& ErrorString);
+	bool IsDirectReconnectPending() const;
+	void JoinReconnectedSession();
+	void OnReconnectedSessionJoined(const struct FNexusSessionOperationResult& Result);
+	TArray<FSessionSearchFilter> MakeMigrationSearchFilters() const;
+
 	// Callbacks
 	UFUNCTION() void OnRecoveryCreateSuccess();
+	UFUNCTION() void OnStandbyCreateFailure();
 	UFUNCTION() void OnRecoveryFindComplete(bool bWasSuccessful, const TArray<struct FOnlineSessionSearchResultData>& Results);
 	UFUNCTION() void OnRecoveryJoinSuccess();
 	UFUNCTION() void OnRecoveryJoinFailure();
+	UFUNCTION() void OnReconnectedSessionFound(bool bWasSuccessful, const TArray<struct FOnlineSessionSearchResultData>& Results);
 };
\ No newline at end of file
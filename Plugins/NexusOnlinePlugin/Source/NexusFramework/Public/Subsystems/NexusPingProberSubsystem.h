@@ -0,0 +1,164 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Containers/Ticker.h"
+#include "Misc/ScopeRWLock.h"
+#include "Types/OnlineSessionData.h"
+#include "NexusPingProberSubsystem.generated.h"
+
+class FNexusPingProbeWorker;
+class FNexusPingEchoWorker;
+
+
+/**
+ * Round-trip estimate of a host, measured with UDP probes (RFC 6298 style : smoothed RTT + mean deviation).
+ */
+USTRUCT(BlueprintType)
+struct FNexusPingEstimate
+{
+	GENERATED_BODY()
+
+public:
+	/** Exponentially weighted moving average of the RTT (milliseconds). */
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Ping")
+	float SmoothedRttMs = 0.f;
+
+	/** Smoothed mean deviation of the RTT (milliseconds). */
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Ping")
+	float JitterMs = 0.f;
+
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Ping")
+	float LastRttMs = 0.f;
+
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Ping")
+	int32 NumSamples = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Ping")
+	int32 NumLost = 0;
+
+	/** FPlatformTime::Seconds() of the last sample or loss. */
+	double LastUpdateTime = 0.0;
+
+	float GetLossRatio() const { return (NumSamples + NumLost) > 0 ? static_cast<float>(NumLost) / (NumSamples + NumLost) : 0.f; }
+};
+
+
+/**
+ * Process-wide, thread-safe store of ping estimates.
+ * Written by UNexusPingProberSubsystem, read by the ping filter / sort rules (which may run on worker threads).
+ * Estimates are kept per host address ; sessions are bound to the host that was probed for them.
+ */
+class NEXUSFRAMEWORK_API FNexusPingCache
+{
+public:
+	static FNexusPingCache& Get();
+
+	void RecordSample(const FString& HostAddress, float RttMs);
+	void RecordLoss(const FString& HostAddress);
+	void BindSession(const FString& SessionId, const FString& HostAddress);
+
+	bool FindByHost(const FString& HostAddress, FNexusPingEstimate& OutEstimate) const;
+	bool FindBySession(const FString& SessionId, FNexusPingEstimate& OutEstimate) const;
+
+	/** Measured ping of the result's host if a recent estimate exists, otherwise the backend PingInMs. */
+	int32 GetEffectivePing(const FOnlineSessionSearchResult& Result) const;
+
+	void Reset();
+
+private:
+	bool IsUsable(const FNexusPingEstimate& Estimate) const;
+
+	mutable FRWLock Lock;
+	TMap<FString, FNexusPingEstimate> EstimatesByHost;
+	TMap<FString, FString> HostBySession;
+};
+
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnNexusPingUpdated, const FString&, HostAddress, const FNexusPingEstimate&, Estimate);
+
+
+/**
+ * Active RTT measurement of session hosts.
+ *
+ * Probes are 16-byte UDP datagrams echoed verbatim by the host (see StartEchoResponder), so any UDP echo
+ * service can stand in for a host. Probes to every host are sent in parallel from a worker thread, which
+ * also timestamps the replies : RTTs are not quantized to the game frame rate.
+ * Results feed FNexusPingCache ; OnPingUpdated fires on the game thread as measurements come in.
+ */
+UCLASS()
+class NEXUSFRAMEWORK_API UNexusPingProberSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// ──────────────────────────────────────────────
+	// Probing
+	// ──────────────────────────────────────────────
+
+	/** Probes the hosts of the given results (host IP from the connect string, port from PING_PORT_KEY or the project setting). Returns the number of hosts queued. */
+	UFUNCTION(BlueprintCallable, Category="Nexus|Online|Ping")
+	int32 ProbeSearchResults(const TArray<FOnlineSessionSearchResultData>& Results);
+
+	int32 ProbeRawResults(const TArray<FOnlineSessionSearchResult>& Results);
+
+	/** Probes an explicit "ip:port" address (e.g. a local echo server). */
+	UFUNCTION(BlueprintCallable, Category="Nexus|Online|Ping")
+	bool ProbeAddress(const FString& HostAddress, int32 NumProbes = 0);
+
+	UFUNCTION(BlueprintPure, Category="Nexus|Online|Ping")
+	bool GetEstimate(const FString& HostAddress, FNexusPingEstimate& OutEstimate) const;
+
+	UFUNCTION(BlueprintPure, Category="Nexus|Online|Ping")
+	bool GetSessionEstimate(const FOnlineSessionSearchResultData& Result, FNexusPingEstimate& OutEstimate) const;
+
+	/** Rewrites the displayed Ping of each result with its measured estimate. Returns the number of results changed. */
+	UFUNCTION(BlueprintCallable, Category="Nexus|Online|Ping")
+	int32 UpdateResultPings(UPARAM(ref) TArray<FOnlineSessionSearchResultData>& Results) const;
+
+	UFUNCTION(BlueprintPure, Category="Nexus|Online|Ping")
+	int32 GetPendingProbeCount() const { return PendingProbeCount; }
+
+	// ──────────────────────────────────────────────
+	// Echo responder (host side)
+	// ──────────────────────────────────────────────
+
+	/** Answers probes on the given UDP port (<= 0 uses the project setting). Started automatically on servers when bEnableEchoResponder is set. */
+	UFUNCTION(BlueprintCallable, Category="Nexus|Online|Ping")
+	bool StartEchoResponder(int32 Port = 0);
+
+	UFUNCTION(BlueprintCallable, Category="Nexus|Online|Ping")
+	void StopEchoResponder();
+
+	UFUNCTION(BlueprintPure, Category="Nexus|Online|Ping")
+	bool IsEchoResponderRunning() const { return EchoWorker != nullptr; }
+
+	/** UDP port the echo responder is bound to (0 = not running). */
+	UFUNCTION(BlueprintPure, Category="Nexus|Online|Ping")
+	int32 GetEchoResponderPort() const { return EchoWorker ? EchoPort : 0; }
+
+	// ──────────────────────────────────────────────
+	// Events
+	// ──────────────────────────────────────────────
+
+	UPROPERTY(BlueprintAssignable, Category="Nexus|Online|Ping")
+	FOnNexusPingUpdated OnPingUpdated;
+
+private:
+	bool Tick(float DeltaTime);
+	bool IsServerWorld() const;
+	bool EnsureProbeWorker();
+	bool ResolveProbeAddress(const FOnlineSessionSearchResult& Result, FString& OutHostAddress) const;
+
+	/** Owned, created on first probe (raw pointers : the worker types are private to the .cpp). */
+	FNexusPingProbeWorker* ProbeWorker = nullptr;
+	FNexusPingEchoWorker* EchoWorker = nullptr;
+	int32 EchoPort = 0;
+
+	int32 PendingProbeCount = 0;
+	bool bEchoAutoStartAttempted = false;
+
+	FTSTicker::FDelegateHandle TickHandle;
+};
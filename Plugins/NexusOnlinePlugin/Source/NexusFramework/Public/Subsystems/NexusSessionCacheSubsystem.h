@@ -0,0 +1,152 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Types/OnlineSessionData.h"
+#include "NexusSessionCacheSubsystem.generated.h"
+
+class USessionFilterRule;
+class USessionSortRule;
+struct FSessionSearchFilter;
+
+
+UENUM(BlueprintType)
+enum class ENexusSessionCacheState : uint8
+{
+	Missing  UMETA(DisplayName="Missing"),
+	Fresh    UMETA(DisplayName="Fresh"),
+	Stale    UMETA(DisplayName="Stale"),
+	Expired  UMETA(DisplayName="Expired")
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnSessionCacheUpdated, const FString&, CacheKey, const FNexusSessionResultDiff&, Diff);
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnSessionCacheRefreshCompleted, const FString& /*CacheKey*/, bool /*bWasSuccessful*/, const FNexusSessionResultDiff& /*Diff*/);
+
+
+/**
+ * GameInstance-level cache of FindSessions results.
+ * Entries are keyed by (session type, LAN, normalized filters & rules) and follow a stale-while-revalidate policy :
+ * fresh entries are served without any online call, stale entries are served instantly while a single background refresh runs.
+ * Concurrent searches for the same key share the refresh in flight instead of starting a new one.
+ */
+UCLASS()
+class NEXUSFRAMEWORK_API UNexusSessionCacheSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	/** Cache of the world's GameInstance (nullptr outside of a game world). */
+	static UNexusSessionCacheSubsystem* Get(const UObject* WorldContextObject);
+
+	// ──────────────────────────────────────────────
+	// Keys
+	// ──────────────────────────────────────────────
+
+	/**
+	 * Builds an order-independent key for a search. String values are case-folded (string filters ignore case).
+	 * Rules are keyed by class and property values.
+	 */
+	static FString MakeCacheKey(ENexusSessionType SessionType, bool bIsLAN, int32 MaxResults,
+		const TArray<FSessionSearchFilter>& SimpleFilters,
+		const TArray<TObjectPtr<USessionFilterRule>>& AdvancedRules,
+		const TArray<TObjectPtr<USessionSortRule>>& SortRules);
+
+	// ──────────────────────────────────────────────
+	// Lookup
+	// ──────────────────────────────────────────────
+
+	UFUNCTION(BlueprintPure, Category="Nexus|Online|Cache")
+	ENexusSessionCacheState GetEntryState(const FString& CacheKey) const;
+
+	/** Returns false if nothing usable (fresh or stale) is cached for this key. */
+	UFUNCTION(BlueprintCallable, Category="Nexus|Online|Cache")
+	bool GetCachedResults(const FString& CacheKey, TArray<FOnlineSessionSearchResultData>& OutResults, float& OutAge);
+
+	/** Last stored results regardless of their age (nullptr if none). */
+	const TArray<FOnlineSessionSearchResultData>* FindResults(const FString& CacheKey) const;
+
+	UFUNCTION(BlueprintPure, Category="Nexus|Online|Cache")
+	bool IsRefreshInFlight(const FString& CacheKey) const;
+
+	// ──────────────────────────────────────────────
+	// Refresh (used by UAsyncTask_FindSessions)
+	// ──────────────────────────────────────────────
+
+	/** Marks a refresh as started. Returns false if another search already refreshes this key. */
+	bool BeginRefresh(const FString& CacheKey);
+
+	/** Stores the new results, computes the diff against the previous ones and notifies listeners. */
+	void CompleteRefresh(const FString& CacheKey, bool bWasSuccessful, const TArray<FOnlineSessionSearchResultData>& Results);
+
+	/** The search refreshing this key went away without an answer : releases the key and fails the waiting searches. */
+	void AbandonRefresh(const FString& CacheKey);
+
+	// ──────────────────────────────────────────────
+	// Session id index
+	// ──────────────────────────────────────────────
+
+	/** Adds or refreshes results in the session id index (keyed by SESSION_ID_KEY). Fed by every successful search. */
+	void IndexResults(const TArray<FOnlineSessionSearchResultData>& Results);
+
+	/** Indexed result for this id, if it is younger than IdIndexMaxAge. */
+	UFUNCTION(BlueprintCallable, Category="Nexus|Online|Cache")
+	bool FindIndexedSession(const FString& SessionId, FOnlineSessionSearchResultData& OutResult) const;
+
+	/** Drops an id from the index (e.g. after a failed join). */
+	UFUNCTION(BlueprintCallable, Category="Nexus|Online|Cache")
+	void RemoveIndexedSession(const FString& SessionId);
+
+	UFUNCTION(BlueprintPure, Category="Nexus|Online|Cache")
+	int32 GetIndexedSessionCount() const { return SessionIndex.Num(); }
+
+	// ──────────────────────────────────────────────
+	// Invalidation
+	// ──────────────────────────────────────────────
+
+	/** Drops every cached list and the id index. Called by the operation queue when a session is created, destroyed or fails to be joined. */
+	UFUNCTION(BlueprintCallable, Category="Nexus|Online|Cache")
+	void InvalidateAll();
+
+	// ──────────────────────────────────────────────
+	// Utils
+	// ──────────────────────────────────────────────
+
+	static FNexusSessionResultDiff ComputeDiff(const TArray<FOnlineSessionSearchResultData>& OldResults, const TArray<FOnlineSessionSearchResultData>& NewResults);
+
+	// ──────────────────────────────────────────────
+	// Events
+	// ──────────────────────────────────────────────
+
+	/** Fired when a refresh changed the cached content of a key. */
+	UPROPERTY(BlueprintAssignable, Category="Nexus|Online|Cache")
+	FOnSessionCacheUpdated OnCacheUpdated;
+
+	/** Fired after every refresh (even failed or unchanged ones) so that waiting searches can complete. */
+	FOnSessionCacheRefreshCompleted OnRefreshCompleted;
+
+private:
+	struct FCacheEntry
+	{
+		TArray<FOnlineSessionSearchResultData> Results;
+		double FetchTime = 0.0;
+		double LastAccessTime = 0.0;
+		double RefreshStartTime = 0.0;
+		bool bHasData = false;
+		bool bRefreshInFlight = false;
+	};
+
+	struct FIndexedSession
+	{
+		FOnlineSessionSearchResultData Result;
+		double IndexTime = 0.0;
+	};
+
+	void TrimEntries();
+	void TrimIndex();
+
+	TMap<FString, FCacheEntry> Entries;
+
+	/** Session id -> last result seen. Entries share the raw result sets of the searches that produced them. */
+	TMap<FString, FIndexedSession> SessionIndex;
+};
@@ -0,0 +1,238 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Containers/Ticker.h"
+#include "OnlineSessionSettings.h"
+#include "Interfaces/OnlineSessionInterface.h"
+#include "Types/OnlineSessionData.h"
+#include "NexusSessionOperationSubsystem.generated.h"
+
+
+UENUM(BlueprintType)
+enum class ENexusSessionOperationType : uint8
+{
+	Create,
+	Join,
+	Destroy
+};
+
+UENUM(BlueprintType)
+enum class ENexusSessionOperationStatus : uint8
+{
+	Succeeded,
+	Failed,
+	Cancelled,
+	TimedOut
+};
+
+
+USTRUCT(BlueprintType)
+struct FNexusSessionOperationResult
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Session")
+	int32 OperationId = INDEX_NONE;
+
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Session")
+	ENexusSessionOperationType Type = ENexusSessionOperationType::Create;
+
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Session")
+	FName SessionName;
+
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Session")
+	ENexusSessionOperationStatus Status = ENexusSessionOperationStatus::Failed;
+
+	/** Enqueue -> completion, waiting time included. */
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Session")
+	float ElapsedMs = 0.f;
+
+	/** Part of ElapsedMs spent waiting for the online service (call -> delegate), the rest is queueing and processing. */
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Session")
+	float OssWaitMs = 0.f;
+
+	/** Join only : result reported by the online service. */
+	EOnJoinSessionCompleteResult::Type JoinResult = EOnJoinSessionCompleteResult::UnknownError;
+
+	bool WasSuccessful() const { return Status == ENexusSessionOperationStatus::Succeeded; }
+};
+
+DECLARE_DELEGATE_OneParam(FOnNexusSessionOperationComplete, const FNexusSessionOperationResult&);
+
+
+/**
+ * One create / join / destroy request.
+ */
+struct NEXUSFRAMEWORK_API FNexusSessionOperationRequest
+{
+	ENexusSessionOperationType Type = ENexusSessionOperationType::Create;
+	FName SessionName = NAME_GameSession;
+
+	/** Create only. */
+	FOnlineSessionSettings Settings;
+
+	/** Join only. */
+	FOnlineSessionSearchResultData JoinTarget;
+
+	/** Create / Join : an existing session with this name is destroyed first (otherwise the operation fails). */
+	bool bReplaceExisting = true;
+
+	/** Seconds from enqueue. < 0 = OperationTimeout (Nexus Session Updates), 0 = no deadline. */
+	float Timeout = -1.f;
+
+	/** Timeout counted from the moment the operation starts, waiting time excluded (per-attempt deadlines). */
+	bool bDeadlineFromStart = false;
+
+	/**
+	 * Abandoned while its online call runs : seconds the queue keeps waiting for the answer before starting the next operation.
+	 * < 0 = AbandonedOperationGrace (capped by it otherwise). A success answering later is rolled back.
+	 */
+	float AbandonGrace = -1.f;
+
+	/** Pending or running requests of the same type with the same key are merged into one. Empty = never merged. */
+	FString CoalesceKey;
+};
+
+
+/**
+ * Session operation scheduler.
+ *
+ * Keeps one queue per session name : operations run one at a time, in order, and own the OSS delegates (the async nodes
+ * only build requests and react to results). A request identical to one already pending or running (same CoalesceKey) is
+ * attached to it instead of being queued again. Operations can be cancelled and have deadlines ; one abandoned while its
+ * online call is running completes immediately, and a session it still manages to create or join is destroyed afterwards.
+ * The queue waits for that answer at most AbandonGrace, then moves on ; a later success is destroyed if nothing else
+ * replaced the session meanwhile. Each online call is tracked with the id of the operation that made it, so a late answer
+ * or a DestroySession issued outside the queue never completes another operation.
+ */
+UCLASS()
+class NEXUSFRAMEWORK_API UNexusSessionOperationSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	static UNexusSessionOperationSubsystem* Get(const UObject* WorldContextObject);
+
+	/** Queues an operation. Returns its id (the id of the existing operation when merged). OnComplete always fires once. */
+	int32 Enqueue(FNexusSessionOperationRequest&& Request, FOnNexusSessionOperationComplete OnComplete);
+
+	/** Cancels a pending or running operation (every merged caller is notified). */
+	UFUNCTION(BlueprintCallable, Category="Nexus|Online|Session")
+	bool CancelOperation(int32 OperationId);
+
+	UFUNCTION(BlueprintCallable, Category="Nexus|Online|Session")
+	void CancelAll(FName SessionName);
+
+	/** True while an operation runs or waits for this session. */
+	UFUNCTION(BlueprintPure, Category="Nexus|Online|Session")
+	bool IsBusy(FName SessionName) const { return Queues.Contains(SessionName); }
+
+	UFUNCTION(BlueprintPure, Category="Nexus|Online|Session")
+	int32 GetQueueLength(FName SessionName) const;
+
+private:
+	enum class EStep : uint8
+	{
+		Pending,
+		DestroyingExisting,
+		Running
+	};
+
+	struct FOperation
+	{
+		int32 Id = INDEX_NONE;
+		FNexusSessionOperationRequest Request;
+		TArray<FOnNexusSessionOperationComplete> Completions;
+		double EnqueueTime = 0.0;
+		double Deadline = 0.0;
+		float Timeout = 0.f;
+		EStep Step = EStep::Pending;
+
+		/** Online call in flight since (0 = none), and waiting time of the calls already answered. */
+		double OssCallTime = 0.0;
+		float OssWaitMs = 0.f;
+
+		/** Callers already notified (cancelled / timed out) : the online call is only awaited, then rolled back. */
+		bool bAbandoned = false;
+		double AbandonTime = 0.0;
+	};
+
+	typedef TSharedRef<FOperation> FOperationRef;
+
+	bool Tick(float DeltaTime);
+
+	void Pump(FName SessionName);
+	void StartOperation(const FOperationRef& Operation);
+	void RunAction(const FOperationRef& Operation);
+
+	/** Notifies callers and removes the operation, then starts the next one. */
+	void Complete(const FOperationRef& Operation, ENexusSessionOperationStatus Status,
+		EOnJoinSessionCompleteResult::Type JoinResult = EOnJoinSessionCompleteResult::UnknownError);
+
+	/** Notifies callers now ; the operation stays at the head of its queue until the online call answers. */
+	void Abandon(const FOperationRef& Operation, ENexusSessionOperationStatus Status);
+
+	/** Abandoned operation whose call answered : destroys what it created / joined, or just leaves the queue. */
+	void FinishAbandoned(const FOperationRef& Operation, bool bSessionExists);
+
+	void NotifyCallers(const FOperation& Operation, ENexusSessionOperationStatus Status, EOnJoinSessionCompleteResult::Type JoinResult) const;
+	bool RemoveOperation(const FOperationRef& Operation);
+
+	/** Closes the online call timing of the operation, if one is in flight. */
+	static void EndOssCall(FOperation& Operation);
+
+	TSharedPtr<FOperation> FindActive(FName SessionName) const;
+	TSharedPtr<FOperation> FindOperation(int32 OperationId) const;
+
+	// ---- OSS
+
+	IOnlineSessionPtr GetSessionInterface() const;
+	void BindSessionDelegates(const IOnlineSessionPtr& Session);
+	void UnbindSessionDelegates();
+
+	void HandleCreateComplete(FName SessionName, bool bWasSuccessful);
+	void HandleJoinComplete(FName SessionName, EOnJoinSessionCompleteResult::Type Result);
+	void HandleDestroyComplete(FName SessionName, bool bWasSuccessful);
+
+	/** Answer to an operation dropped without its answer : rolled back when it created / joined a session nobody replaces. */
+	void HandleLateAnswer(FName SessionName, ENexusSessionOperationType Type, bool bWasSuccessful);
+
+	/** Records an online call before it is made (some subsystems answer from inside the call). */
+	void BeginCall(const FOperation& Operation, ENexusSessionOperationType Type);
+
+	/** The call was refused : forgets it, unless it was already answered. */
+	void CancelCall(const FOperation& Operation, ENexusSessionOperationType Type);
+
+	/** Operation that issued the oldest call of this type on this session (INDEX_NONE = not a call of the queue). */
+	int32 TakeCall(FName SessionName, ENexusSessionOperationType Type);
+
+	/** Per session name, in execution order : element 0 is the running operation once started. */
+	TMap<FName, TArray<FOperationRef>> Queues;
+
+	/**
+	 * Online calls awaiting their answer, oldest first. The session delegates only give the session name : an answer is
+	 * attributed to the operation that issued the oldest call of its type, and ignored when that is not the running one.
+	 */
+	struct FOssCall
+	{
+		int32 OperationId = INDEX_NONE;
+		FName SessionName;
+		ENexusSessionOperationType Type = ENexusSessionOperationType::Create;
+		double CallTime = 0.0;
+	};
+
+	TArray<FOssCall> PendingCalls;
+
+	int32 NextOperationId = 1;
+
+	TWeakPtr<IOnlineSession, ESPMode::ThreadSafe> BoundSession;
+	FDelegateHandle CreateHandle;
+	FDelegateHandle JoinHandle;
+	FDelegateHandle DestroyHandle;
+
+	FTSTicker::FDelegateHandle TickHandle;
+};
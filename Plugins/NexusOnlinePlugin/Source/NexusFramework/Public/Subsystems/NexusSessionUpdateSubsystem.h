@@ -0,0 +1,137 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Containers/Ticker.h"
+#include "OnlineSessionSettings.h"
+#include "GameFramework/OnlineReplStructs.h"
+#include "NexusSessionUpdateSubsystem.generated.h"
+
+
+/**
+ * Counters of UNexusSessionUpdateSubsystem (since start or the last ResetStats).
+ */
+USTRUCT(BlueprintType)
+struct FNexusSessionUpdateStats
+{
+	GENERATED_BODY()
+
+public:
+	/** Advertisement updates asked for (including the implicit one after each register / unregister). */
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Session")
+	int32 UpdatesRequested = 0;
+
+	/** UpdateSession calls actually sent to the online service. */
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Session")
+	int32 UpdatesSent = 0;
+
+	/** Flushes dropped because nothing changed since the last push. */
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Session")
+	int32 UpdatesSkipped = 0;
+
+	/** Settings keys and session fields found changed over all sent updates. */
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Session")
+	int32 ChangedKeys = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Session")
+	int32 PlayersRegistered = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Session")
+	int32 PlayersUnregistered = 0;
+
+	/** Register + unregister requests cancelled by their opposite within the same window (join then leave...). */
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Session")
+	int32 RegistrationsCancelled = 0;
+
+	/** RegisterPlayers / UnregisterPlayers calls sent. */
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Session")
+	int32 RegistrationBatches = 0;
+};
+
+
+/**
+ * Session advertisement scheduler.
+ *
+ * Player registrations and advertisement updates are queued per session name and flushed together once no request arrived
+ * for CoalesceWindow seconds (at most MaxUpdateDelay after the first one) : a join wave sends one RegisterPlayers call and
+ * one UpdateSession instead of one of each per player.
+ * OSS v1 UpdateSession always takes the whole settings object, so the diff against the last pushed settings is used to
+ * drop updates that change nothing and to count the keys that did change.
+ */
+UCLASS()
+class NEXUSFRAMEWORK_API UNexusSessionUpdateSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	static UNexusSessionUpdateSubsystem* Get(const UObject* WorldContextObject);
+
+	// ──────────────────────────────────────────────
+	// Requests
+	// ──────────────────────────────────────────────
+
+	/** Queues RegisterPlayer + an advertisement update. Cancels a pending unregister of the same player. */
+	void QueueRegisterPlayer(FName SessionName, const FUniqueNetIdRepl& PlayerId);
+
+	/** Queues UnregisterPlayer + an advertisement update. Cancels a pending register of the same player. */
+	void QueueUnregisterPlayer(FName SessionName, const FUniqueNetIdRepl& PlayerId);
+
+	/** Asks for the current settings of the session to be advertised (call after editing them). */
+	UFUNCTION(BlueprintCallable, Category="Nexus|Online|Session")
+	void RequestSessionUpdate(FName SessionName);
+
+	/** Sends what is pending for this session now. */
+	UFUNCTION(BlueprintCallable, Category="Nexus|Online|Session")
+	void FlushSession(FName SessionName);
+
+	UFUNCTION(BlueprintCallable, Category="Nexus|Online|Session")
+	void FlushAll();
+
+	UFUNCTION(BlueprintPure, Category="Nexus|Online|Session")
+	bool HasPendingUpdates(FName SessionName) const { return PendingSessions.Contains(SessionName); }
+
+	// ──────────────────────────────────────────────
+	// Stats
+	// ──────────────────────────────────────────────
+
+	UFUNCTION(BlueprintPure, Category="Nexus|Online|Session")
+	FNexusSessionUpdateStats GetStats() const { return Stats; }
+
+	UFUNCTION(BlueprintCallable, Category="Nexus|Online|Session")
+	void ResetStats() { Stats = FNexusSessionUpdateStats(); }
+
+private:
+	struct FPendingSession
+	{
+		TArray<FUniqueNetIdRef> ToRegister;
+		TArray<FUniqueNetIdRef> ToUnregister;
+		bool bUpdateRequested = false;
+		double FirstRequestTime = 0.0;
+		double LastRequestTime = 0.0;
+	};
+
+	/** What was last sent for a session : the next update is compared against it. */
+	struct FAdvertisedState
+	{
+		FString SessionId;
+		FOnlineSessionSettings Settings;
+		int32 NumOpenPublicConnections = 0;
+		int32 NumOpenPrivateConnections = 0;
+	};
+
+	bool Tick(float DeltaTime);
+
+	FPendingSession& TouchPending(FName SessionName);
+	void ScheduleOrFlush(FName SessionName);
+
+	static int32 CountChangedKeys(const FAdvertisedState& Previous, const FNamedOnlineSession& Current);
+
+	TMap<FName, FPendingSession> PendingSessions;
+	TMap<FName, FAdvertisedState> AdvertisedStates;
+
+	FNexusSessionUpdateStats Stats;
+
+	FTSTicker::FDelegateHandle TickHandle;
+};
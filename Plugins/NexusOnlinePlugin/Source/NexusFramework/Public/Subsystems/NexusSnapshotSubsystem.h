@@ -0,0 +1,205 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Containers/Ticker.h"
+#include "NexusSnapshotSubsystem.generated.h"
+
+class UNexusSnapshotComponent;
+
+
+/**
+ * Counters of UNexusSnapshotSubsystem (since start or the last ResetStats).
+ */
+USTRUCT(BlueprintType)
+struct FNexusSnapshotStats
+{
+	GENERATED_BODY()
+
+public:
+	// ---- Host
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Migration|Snapshot")
+	int32 SnapshotsSent = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Migration|Snapshot")
+	int32 KeyframesSent = 0;
+
+	/** Compressed bytes sent to heirs. */
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Migration|Snapshot")
+	int64 BytesSent = 0;
+
+	/** Serialized state of the last capture, before delta and compression. */
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Migration|Snapshot")
+	int32 LastStateBytes = 0;
+
+	/** Size on the wire of the last capture. */
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Migration|Snapshot")
+	int32 LastSentBytes = 0;
+
+	/** Objects of the last capture that changed since the acknowledged baseline. */
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Migration|Snapshot")
+	int32 LastChangedEntries = 0;
+
+	// ---- Heir
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Migration|Snapshot")
+	int32 SnapshotsReceived = 0;
+
+	/** Deltas dropped because their baseline was not the one held (a keyframe is requested). */
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Migration|Snapshot")
+	int32 SnapshotsRejected = 0;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnNexusSnapshotRestored, int32, Sequence, int32, RestoredObjects);
+
+
+/**
+ * Game state hand-over for host migration.
+ *
+ * Objects registered here (actors, subsystems...) have their SaveGame properties, plus the transform for actors, captured
+ * every SnapshotInterval on the host. Each capture is encoded against the last snapshot the first heir acknowledged :
+ * unchanged objects are skipped, changed ones are XORed with their previous bytes, then the frame is compressed.
+ * It is streamed to the heir's UNexusSnapshotComponent within SnapshotBandwidthKBps.
+ * The heir keeps the latest complete snapshot across the map change ; UNexusMigrationSubsystem restores it once the map
+ * is reopened, before the session is advertised again.
+ */
+UCLASS()
+class NEXUSFRAMEWORK_API UNexusSnapshotSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	static UNexusSnapshotSubsystem* Get(const UObject* WorldContextObject);
+
+	// ──────────────────────────────────────────────
+	// Registration
+	// ──────────────────────────────────────────────
+
+	/**
+	 * Adds an object to the snapshots (call on every machine, e.g. in BeginPlay : the heir needs it registered to restore it).
+	 * @param Key Stable name across the map reload. None = the object name (fine for placed actors and subsystems).
+	 * @param bRespawnIfMissing Actors only : respawned from their class by the new host if the reopened map lacks them
+	 * (spawned during the game). Others wait for an object to register with their key.
+	 * If a restored snapshot holds state for this key, it is applied now.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Nexus|Migration|Snapshot")
+	void RegisterObject(UObject* Object, FName Key = NAME_None, bool bRespawnIfMissing = false);
+
+	UFUNCTION(BlueprintCallable, Category="Nexus|Migration|Snapshot")
+	void UnregisterObject(UObject* Object);
+
+	// ──────────────────────────────────────────────
+	// Heir side
+	// ──────────────────────────────────────────────
+
+	/** Sequence of the snapshot held for a migration (INDEX_NONE = none). */
+	UFUNCTION(BlueprintPure, Category="Nexus|Migration|Snapshot")
+	int32 GetHeldSequence() const { return HeldSequence; }
+
+	/**
+	 * Applies the held snapshot to the freshly loaded world : registered objects are updated, placed actors the snapshot
+	 * no longer holds are destroyed, missing actors registered with bRespawnIfMissing are respawned, the rest waits for
+	 * its object to register. Returns the number of objects restored now.
+	 */
+	int32 RestoreLatestSnapshot(UWorld* World);
+
+	/** Drops the held snapshot (new session : it belongs to another game). */
+	void ClearHeldSnapshot();
+
+	/** Chunk received by the local heir's component, which acknowledges the snapshot once complete (INDEX_NONE = keyframe needed). */
+	void ReceiveChunk(UNexusSnapshotComponent* Component, int32 Sequence, int32 BaselineSequence, int32 TotalSize, int32 Offset, const TArray<uint8>& Chunk);
+
+	// ──────────────────────────────────────────────
+	// Host side
+	// ──────────────────────────────────────────────
+
+	/** The heir finished (or rejected) a snapshot. */
+	void HandleAck(UNexusSnapshotComponent* Component, int32 Sequence);
+
+	// ──────────────────────────────────────────────
+	// Events & stats
+	// ──────────────────────────────────────────────
+
+	UPROPERTY(BlueprintAssignable, Category="Nexus|Migration|Snapshot")
+	FOnNexusSnapshotRestored OnSnapshotRestored;
+
+	UFUNCTION(BlueprintPure, Category="Nexus|Migration|Snapshot")
+	FNexusSnapshotStats GetStats() const { return Stats; }
+
+	UFUNCTION(BlueprintCallable, Category="Nexus|Migration|Snapshot")
+	void ResetStats() { Stats = FNexusSnapshotStats(); }
+
+private:
+	/** State of one object : [transform if actor][SaveGame properties]. */
+	struct FEntry
+	{
+		FString ClassPath;
+		bool bIsActor = false;
+		bool bRespawn = false;
+		TArray<uint8> Data;
+	};
+
+	struct FRegistration
+	{
+		FName Key;
+		bool bRespawnIfMissing = false;
+	};
+
+	using FState = TMap<FName, FEntry>;
+
+	bool Tick(float DeltaTime);
+	bool IsServerWorld() const;
+
+	// ---- Capture / restore
+	void Capture(FState& OutState);
+	static void SaveObjectState(UObject* Object, FEntry& OutEntry);
+	static void LoadObjectState(UObject* Object, const FEntry& Entry);
+
+	// ---- Wire format
+	static void Encode(int32 Sequence, const FState& State, const FState* Baseline, int32 BaselineSequence, TArray<uint8>& OutBlob, int32& OutChangedEntries);
+	static bool Decode(const TArray<uint8>& Blob, const FState* Baseline, FState& OutState);
+
+	// ---- Host stream
+	void UpdateHeirChannel(UWorld* World);
+	void StartCapture();
+	void SendChunks(float DeltaTime);
+	void ResetChannel();
+
+	TMap<TWeakObjectPtr<UObject>, FRegistration> Registered;
+
+	/** Host : channel to the current first heir. */
+	TWeakObjectPtr<UNexusSnapshotComponent> HeirComponent;
+	FString HeirId;
+	bool bHeirReady = false;
+	int32 NextSequence = 1;
+	int32 SnapshotsSinceKeyframe = 0;
+	double NextCaptureTime = 0.0;
+
+	FState AckedState;
+	int32 AckedSequence = INDEX_NONE;
+
+	/** Capture being streamed (kept until acknowledged, as the next baseline). */
+	FState SentState;
+	int32 SentSequence = INDEX_NONE;
+	int32 SentBaselineSequence = INDEX_NONE;
+	double SentTime = 0.0;
+	TArray<uint8> OutgoingBlob;
+	int32 OutgoingOffset = 0;
+	float SendBudget = 0.f;
+
+	/** Heir : latest complete snapshot, and the one being received. */
+	FState HeldState;
+	int32 HeldSequence = INDEX_NONE;
+	TArray<uint8> IncomingBlob;
+	int32 IncomingSequence = INDEX_NONE;
+	int32 IncomingBaselineSequence = INDEX_NONE;
+	int32 IncomingReceived = 0;
+
+	/** Restored entries whose object has not registered yet. */
+	FState PendingRestore;
+
+	FNexusSnapshotStats Stats;
+
+	FTSTicker::FDelegateHandle TickHandle;
+};
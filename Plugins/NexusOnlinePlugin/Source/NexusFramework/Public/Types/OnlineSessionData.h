@@ -97,8 +97,70 @@ public:
 };
 
 
+/**
+ * Une requête d'une recherche multiple (Find Sessions (Multi)).
+ */
+USTRUCT(BlueprintType)
+struct FNexusSessionSubQuery
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Nexus|Online|Session")
+	ENexusSessionType SessionType = ENexusSessionType::GameSession;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Nexus|Online|Session")
+	bool bIsLANQuery = false;
+
+	/** Maximum de résultats bruts pour cette requête (<= 0 : 50). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Nexus|Online|Session")
+	int32 MaxResults = 50;
+};
+
+
+/**
+ * Bilan d'une requête d'une recherche multiple.
+ */
+USTRUCT(BlueprintType)
+struct FNexusSessionSubQueryReport
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Session")
+	ENexusSessionType SessionType = ENexusSessionType::GameSession;
+
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Session")
+	bool bIsLANQuery = false;
+
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Session")
+	bool bWasSuccessful = false;
+
+	/** Résultats renvoyés par le backend, avant fusion et filtrage. */
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Session")
+	int32 RawResultCount = 0;
+
+	/** Temps entre l'envoi de la requête au backend et sa réponse (millisecondes). */
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Session")
+	float LatencyMs = 0.f;
+};
+
+
+/**
+ * Résultats bruts d'une recherche, possédés par la recherche et partagés (ref-counted) par tous les
+ * FOnlineSessionSearchResultData qui en sont issus : filtrage, tri, cache et join manipulent des indices, jamais des copies.
+ */
+struct FNexusSessionResultSet
+{
+	TArray<FOnlineSessionSearchResult> Results;
+};
+
+typedef TSharedPtr<const FNexusSessionResultSet, ESPMode::ThreadSafe> FNexusSessionResultSetPtr;
+
+
 /**
  * Structure regroupant les resultat de la recherche d'une session.
+ * Seuls les champs d'affichage sont copiés ; le résultat brut reste dans le FNexusSessionResultSet partagé.
  */
 USTRUCT(BlueprintType)
 struct FOnlineSessionSearchResultData
@@ -127,6 +189,51 @@ public:
 	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Session")
 	int32 Ping = 0;
 
-	FOnlineSessionSearchResult RawResult;
+	/** Score de matchmaking [0..1] quand la recherche utilise une règle Match Score avec TopK, -1 sinon. */
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Session")
+	float MatchScore = -1.f;
+
+	/** Ensemble partagé contenant le résultat brut. */
+	FNexusSessionResultSetPtr ResultSet;
+
+	/** Index du résultat brut dans ResultSet. */
+	int32 ResultIndex = INDEX_NONE;
+
+	bool HasRawResult() const
+	{
+		return ResultSet.IsValid() && ResultSet->Results.IsValidIndex(ResultIndex);
+	}
+
+	/** Résultat brut (référence dans l'ensemble partagé, résultat vide si absent). */
+	const FOnlineSessionSearchResult& GetRawResult() const
+	{
+		static const FOnlineSessionSearchResult EmptyResult;
+		return HasRawResult() ? ResultSet->Results[ResultIndex] : EmptyResult;
+	}
 };
 
+
+
+/**
+ * Différence entre deux listes de résultats (identité : SESSION_ID_KEY, sinon l'id du backend).
+ */
+USTRUCT(BlueprintType)
+struct FNexusSessionResultDiff
+{
+	GENERATED_BODY()
+
+public:
+	/** Sessions absentes de la liste précédente. */
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Session")
+	TArray<FOnlineSessionSearchResultData> Added;
+
+	/** Sessions qui ne sont plus annoncées. */
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Session")
+	TArray<FOnlineSessionSearchResultData> Removed;
+
+	/** Sessions toujours présentes dont l'affichage a changé (joueurs, ping, map...). */
+	UPROPERTY(BlueprintReadOnly, Category="Nexus|Online|Session")
+	TArray<FOnlineSessionSearchResultData> Updated;
+
+	bool IsEmpty() const { return Added.IsEmpty() && Removed.IsEmpty() && Updated.IsEmpty(); }
+};
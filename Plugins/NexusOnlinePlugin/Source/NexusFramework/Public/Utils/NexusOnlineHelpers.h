@@ -13,6 +13,11 @@ namespace NexusOnline
 	inline const FName SESSION_KEY_PROJECT_ID_INT = FName("ProjectID");
 	inline const int32 PROJECT_ID_VALUE_INT = 888888;
 
+	// Options de login envoyées par les clients (classement des héritiers de l'hôte)
+	inline const FString LOGIN_OPTION_UPLOAD_KBPS = TEXT("NexusUpKbps");
+	inline const FString LOGIN_OPTION_HARDWARE_TIER = TEXT("NexusHwTier");
+	inline const FString LOGIN_OPTION_STANDBY_PORT = TEXT("NexusStandbyPort");
+
 	//───────────────────────────────────────────────
 	// ID Generator
 	//───────────────────────────────────────────────
@@ -69,6 +74,18 @@ namespace NexusOnline
 		return ENexusSessionType::GameSession;
 	}
 
+	//───────────────────────────────────────────────
+	// Session Identity
+	//───────────────────────────────────────────────
+	inline FString GetSessionIdentity(const FOnlineSessionSearchResult& Result)
+	{
+		FString SessionId;
+		if (Result.Session.SessionSettings.Get(TEXT("SESSION_ID_KEY"), SessionId) && !SessionId.IsEmpty())
+			return SessionId;
+
+		return Result.GetSessionIdStr();
+	}
+
 	//───────────────────────────────────────────────
 	// Subsystem Access Helpers
 	//───────────────────────────────────────────────
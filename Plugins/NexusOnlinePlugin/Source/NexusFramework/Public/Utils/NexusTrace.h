@@ -0,0 +1,60 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Logging/LogMacros.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CountersTrace.h"
+#include "ProfilingDebugging/MiscTrace.h"
+
+// ──────────────────────────────────────────────
+// Log categories
+// ──────────────────────────────────────────────
+
+// Verbosité maximale compilée : en Shipping, tout ce qui est sous Warning disparaît du binaire
+#ifndef NEXUS_LOG_COMPILE_VERBOSITY
+	#if UE_BUILD_SHIPPING
+		#define NEXUS_LOG_COMPILE_VERBOSITY Warning
+	#else
+		#define NEXUS_LOG_COMPILE_VERBOSITY All
+	#endif
+#endif
+
+/** Sessions : async tasks, operation queue, session manager, bans. */
+NEXUSFRAMEWORK_API DECLARE_LOG_CATEGORY_EXTERN(LogNexusOnline, Log, NEXUS_LOG_COMPILE_VERBOSITY);
+
+/** Host migration and heir election. */
+NEXUSFRAMEWORK_API DECLARE_LOG_CATEGORY_EXTERN(LogNexusMigration, Log, NEXUS_LOG_COMPILE_VERBOSITY);
+
+// ──────────────────────────────────────────────
+// Trace channel (Unreal Insights : -trace=default,nexus or "Trace.Enable Nexus")
+// ──────────────────────────────────────────────
+UE_TRACE_CHANNEL_EXTERN(NexusChannel, NEXUSFRAMEWORK_API);
+
+/** Scoped CPU event on the Nexus channel. Name is an identifier, e.g. NEXUS_TRACE_SCOPE(NexusFindSessions_Filter). */
+#define NEXUS_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Name, NexusChannel)
+
+
+/**
+ * Counters and bookmarks shared by the Nexus modules (counters need the "counters" channel, bookmarks the "bookmark" one).
+ * Game thread only.
+ */
+namespace NexusTrace
+{
+	/** An online service call was sent. Returns its start time, to hand back to EndOssCall. */
+	NEXUSFRAMEWORK_API double BeginOssCall();
+
+	/** The online service answered (or the call was given up) : returns the time spent waiting for it in ms and resets StartTime. */
+	NEXUSFRAMEWORK_API float EndOssCall(double& StartTime);
+
+	/** Marks a host migration step in the timeline (bookmark) and updates the generation counter. */
+	NEXUSFRAMEWORK_API void MigrationPhase(const TCHAR* Phase, int32 Generation);
+
+	/** Host migration finished locally : failure -> back in game. */
+	NEXUSFRAMEWORK_API void RecordMigrationRecovery(float RecoveryMs);
+
+	/** Game state snapshot captured for the heir : serialized size, and size on the wire after delta and compression. */
+	NEXUSFRAMEWORK_API void RecordSnapshot(int32 StateBytes, int32 WireBytes);
+
+	/** PreLogin ban check. */
+	NEXUSFRAMEWORK_API void RecordBanCheck(bool bRejected);
+}
@@ -0,0 +1,23 @@
+using System.IO;
+using UnrealBuildTool;
+
+public class NexusChatRelay : ModuleRules
+{
+	public NexusChatRelay(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PrivateIncludePathModuleNames.Add("Launch");
+
+		// Shares the wire protocol header with the NexusChat runtime module (header-only, Core + Sockets)
+		PrivateIncludePaths.Add(Path.Combine(ModuleDirectory, "..", "..", "NexusChat", "Public"));
+
+		PrivateDependencyModuleNames.AddRange(new string[]
+		{
+			"Core",
+			"Projects",
+			"Sockets",
+			"Networking"
+		});
+	}
+}
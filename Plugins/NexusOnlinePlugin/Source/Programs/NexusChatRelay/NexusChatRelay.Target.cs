@@ -0,0 +1,26 @@
+using UnrealBuildTool;
+
+/**
+ * Headless cross-server chat relay.
+ * Build : RunUAT BuildTarget -Target=NexusChatRelay -Platform=Linux -Configuration=Development
+ */
+[SupportedPlatforms(UnrealPlatformClass.Desktop)]
+public class NexusChatRelayTarget : TargetRules
+{
+	public NexusChatRelayTarget(TargetInfo Target) : base(Target)
+	{
+		Type = TargetType.Program;
+		LinkType = TargetLinkType.Monolithic;
+		LaunchModuleName = "NexusChatRelay";
+		DefaultBuildSettings = BuildSettingsVersion.V5;
+		IncludeOrderVersion = EngineIncludeOrderVersion.Unreal5_6;
+
+		bBuildDeveloperTools = false;
+		bCompileAgainstEngine = false;
+		bCompileAgainstCoreUObject = false;
+		bCompileAgainstApplicationCore = false;
+		bCompileICU = false;
+		bUseLoggingInShipping = true;
+		bIsBuildingConsoleApplication = true;
+	}
+}
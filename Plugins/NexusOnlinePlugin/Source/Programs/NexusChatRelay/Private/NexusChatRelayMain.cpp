@@ -0,0 +1,65 @@
+#include "NexusChatRelayServer.h"
+#include "RequiredProgramMainCPPInclude.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+
+IMPLEMENT_APPLICATION(NexusChatRelay, "NexusChatRelay");
+
+/**
+ * Headless cross-server chat relay.
+ *
+ * Usage : NexusChatRelay [-Bind=127.0.0.1] [-Port=7790] [-SoftQueueKB=256] [-HardQueueKB=4096]
+ *                        [-MaxBatch=128] [-TickMs=5] [-StatsInterval=30]
+ */
+INT32_MAIN_INT32_ARGC_TCHAR_ARGV()
+{
+	FTaskTagScope Scope(ETaskTag::EGameThread);
+	ON_SCOPE_EXIT
+	{
+		LLM(FLowLevelMemTracker::Get().UpdateStatsPerFrame());
+		RequestEngineExit(TEXT("NexusChatRelay exiting"));
+		FEngineLoop::AppPreExit();
+		FModuleManager::Get().UnloadModulesAtShutdown();
+		FEngineLoop::AppExit();
+	};
+
+	if (const int32 Ret = GEngineLoop.PreInit(ArgC, ArgV))
+	{
+		return Ret;
+	}
+
+	const TCHAR* CmdLine = FCommandLine::Get();
+
+	FNexusChatRelayServer::FSettings Settings;
+	FParse::Value(CmdLine, TEXT("-Bind="), Settings.BindAddress);
+	FParse::Value(CmdLine, TEXT("-Port="), Settings.Port);
+	FParse::Value(CmdLine, TEXT("-MaxBatch="), Settings.MaxBatchMessages);
+	FParse::Value(CmdLine, TEXT("-StatsInterval="), Settings.StatsInterval);
+
+	int32 SoftQueueKB = Settings.SoftQueueBytes / 1024;
+	int32 HardQueueKB = Settings.HardQueueBytes / 1024;
+	FParse::Value(CmdLine, TEXT("-SoftQueueKB="), SoftQueueKB);
+	FParse::Value(CmdLine, TEXT("-HardQueueKB="), HardQueueKB);
+	Settings.SoftQueueBytes = FMath::Max(1, SoftQueueKB) * 1024;
+	Settings.HardQueueBytes = FMath::Max(SoftQueueKB + 1, HardQueueKB) * 1024;
+	Settings.MaxBatchMessages = FMath::Clamp(Settings.MaxBatchMessages, 1, static_cast<int32>(MAX_uint16));
+
+	int32 TickMs = 5;
+	FParse::Value(CmdLine, TEXT("-TickMs="), TickMs);
+	const float TickSeconds = FMath::Max(1, TickMs) / 1000.f;
+
+	FNexusChatRelayServer Server(Settings);
+	if (!Server.Start())
+	{
+		return 1;
+	}
+
+	while (!IsEngineExitRequested())
+	{
+		Server.Tick();
+		FPlatformProcess::Sleep(TickSeconds);
+	}
+
+	Server.Stop();
+	return 0;
+}
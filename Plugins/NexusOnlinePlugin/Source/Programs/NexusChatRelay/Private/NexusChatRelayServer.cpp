@@ -0,0 +1,478 @@
+#include "NexusChatRelayServer.h"
+#include "Interfaces/IPv4/IPv4Address.h"
+#include "IPAddress.h"
+
+DEFINE_LOG_CATEGORY(LogNexusChatRelay);
+
+using namespace NexusChatRelay;
+
+
+FNexusChatRelayServer::FNexusChatRelayServer(const FSettings& InSettings)
+	: Settings(InSettings)
+{
+}
+
+FNexusChatRelayServer::~FNexusChatRelayServer()
+{
+	Stop();
+}
+
+// ──────────────────────────────────────────────
+// LIFECYCLE
+// ──────────────────────────────────────────────
+
+bool FNexusChatRelayServer::Start()
+{
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+	if (!SocketSubsystem)
+	{
+		UE_LOG(LogNexusChatRelay, Error, TEXT("No socket subsystem available."));
+		return false;
+	}
+
+	TSharedRef<FInternetAddr> Addr = SocketSubsystem->CreateInternetAddr();
+	bool bIsValid = false;
+	Addr->SetIp(*Settings.BindAddress, bIsValid);
+	Addr->SetPort(Settings.Port);
+
+	if (!bIsValid)
+	{
+		UE_LOG(LogNexusChatRelay, Error, TEXT("Invalid bind address '%s'."), *Settings.BindAddress);
+		return false;
+	}
+
+	ListenSocket = SocketSubsystem->CreateSocket(NAME_Stream, TEXT("NexusChatRelayListen"), Addr->GetProtocolType());
+	if (!ListenSocket)
+	{
+		UE_LOG(LogNexusChatRelay, Error, TEXT("Failed to create listen socket."));
+		return false;
+	}
+
+	ListenSocket->SetReuseAddr(true);
+	ListenSocket->SetNonBlocking(true);
+
+	if (!ListenSocket->Bind(*Addr) || !ListenSocket->Listen(64))
+	{
+		UE_LOG(LogNexusChatRelay, Error, TEXT("Failed to listen on %s:%d."), *Settings.BindAddress, Settings.Port);
+		SocketSubsystem->DestroySocket(ListenSocket);
+		ListenSocket = nullptr;
+		return false;
+	}
+
+	LastStatsTime = FPlatformTime::Seconds();
+	UE_LOG(LogNexusChatRelay, Display, TEXT("Relay listening on %s:%d (soft queue %d KB, hard queue %d KB)."),
+		*Settings.BindAddress, Settings.Port, Settings.SoftQueueBytes / 1024, Settings.HardQueueBytes / 1024);
+
+	return true;
+}
+
+void FNexusChatRelayServer::Stop()
+{
+	Peers.Empty();
+	PlayerLocations.Empty();
+	PlayerGuilds.Empty();
+	GuildServers.Empty();
+
+	if (ListenSocket)
+	{
+		ListenSocket->Close();
+		if (ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM))
+		{
+			SocketSubsystem->DestroySocket(ListenSocket);
+		}
+		ListenSocket = nullptr;
+	}
+}
+
+void FNexusChatRelayServer::Tick()
+{
+	if (!ListenSocket)
+		return;
+
+	AcceptPendingConnections();
+
+	// 1. Read everything, route into per-peer batches
+	for (auto& Pair : Peers)
+	{
+		if (!Pair.Value->bPendingKill)
+		{
+			ReceiveFromPeer(*Pair.Value);
+		}
+	}
+
+	// 2. One Batch frame per peer per tick, then push bytes to the sockets
+	for (auto& Pair : Peers)
+	{
+		if (!Pair.Value->bPendingKill)
+		{
+			FlushPeer(*Pair.Value);
+		}
+	}
+
+	// 3. Cleanup
+	TArray<uint32> DeadPeers;
+	for (const auto& Pair : Peers)
+	{
+		if (Pair.Value->bPendingKill)
+		{
+			DeadPeers.Add(Pair.Key);
+		}
+	}
+
+	for (uint32 ServerId : DeadPeers)
+	{
+		RemovePeer(ServerId);
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	if (Settings.StatsInterval > 0.0 && Now - LastStatsTime >= Settings.StatsInterval)
+	{
+		LastStatsTime = Now;
+		LogStats();
+	}
+}
+
+// ──────────────────────────────────────────────
+// CONNECTIONS
+// ──────────────────────────────────────────────
+
+void FNexusChatRelayServer::AcceptPendingConnections()
+{
+	bool bHasPending = false;
+	while (ListenSocket->HasPendingConnection(bHasPending) && bHasPending)
+	{
+		FSocket* ClientSocket = ListenSocket->Accept(TEXT("NexusChatRelayPeer"));
+		if (!ClientSocket)
+			break;
+
+		TUniquePtr<FNexusRelayPeer> Peer = MakeUnique<FNexusRelayPeer>();
+		Peer->ServerId = NextServerId++;
+		Peer->Stream = MakeUnique<FStream>(ClientSocket);
+
+		if (ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM))
+		{
+			TSharedRef<FInternetAddr> RemoteAddr = SocketSubsystem->CreateInternetAddr();
+			ClientSocket->GetPeerAddress(*RemoteAddr);
+			Peer->RemoteAddress = RemoteAddr->ToString(true);
+		}
+
+		UE_LOG(LogNexusChatRelay, Log, TEXT("Connection #%u from %s."), Peer->ServerId, *Peer->RemoteAddress);
+		Peers.Add(Peer->ServerId, MoveTemp(Peer));
+	}
+}
+
+void FNexusChatRelayServer::ReceiveFromPeer(FNexusRelayPeer& Peer)
+{
+	TArray<FFrame> Frames;
+	const bool bAlive = Peer.Stream->Receive(Frames);
+
+	for (const FFrame& Frame : Frames)
+	{
+		HandleFrame(Peer, Frame);
+		if (Peer.bPendingKill)
+			return;
+	}
+
+	if (!bAlive)
+	{
+		UE_LOG(LogNexusChatRelay, Log, TEXT("Server #%u (%s) disconnected."), Peer.ServerId, *Peer.ServerName);
+		Peer.bPendingKill = true;
+	}
+}
+
+void FNexusChatRelayServer::FlushPeer(FNexusRelayPeer& Peer)
+{
+	const int32 Skipped = QueueBatchFrames(Peer.PendingBatch, Settings.MaxBatchMessages, [&Peer](const TArray<uint8>& Payload)
+	{
+		Peer.Stream->QueueFrame(EFrameType::Batch, Payload);
+	});
+
+	if (Skipped > 0)
+	{
+		UE_LOG(LogNexusChatRelay, Warning, TEXT("Server #%u (%s): %d message(s) too large for a frame, dropped."), Peer.ServerId, *Peer.ServerName, Skipped);
+	}
+
+	Peer.PendingBatch.Reset();
+	Peer.PendingBatchBytes = 0;
+
+	if (!Peer.Stream->Flush())
+	{
+		UE_LOG(LogNexusChatRelay, Log, TEXT("Server #%u (%s) send failed, dropping connection."), Peer.ServerId, *Peer.ServerName);
+		Peer.bPendingKill = true;
+	}
+}
+
+void FNexusChatRelayServer::RemovePeer(uint32 ServerId)
+{
+	TUniquePtr<FNexusRelayPeer> Peer;
+	if (!Peers.RemoveAndCopyValue(ServerId, Peer) || !Peer)
+		return;
+
+	for (const FString& PlayerName : Peer->Players)
+	{
+		const uint32* Location = PlayerLocations.Find(PlayerName);
+		if (Location && *Location == ServerId)
+		{
+			PlayerLocations.Remove(PlayerName);
+		}
+
+		FString GuildName;
+		if (PlayerGuilds.RemoveAndCopyValue(PlayerName, GuildName))
+		{
+			RemoveGuildMember(GuildName, ServerId);
+		}
+	}
+
+	UE_LOG(LogNexusChatRelay, Log, TEXT("Server #%u (%s) removed. In: %llu, Out: %llu, Dropped: %llu."),
+		ServerId, *Peer->ServerName, Peer->MessagesIn, Peer->MessagesOut, Peer->MessagesDropped);
+}
+
+// ──────────────────────────────────────────────
+// PROTOCOL
+// ──────────────────────────────────────────────
+
+void FNexusChatRelayServer::HandleFrame(FNexusRelayPeer& Peer, const FFrame& Frame)
+{
+	if (!Peer.bHandshakeDone && Frame.Type != EFrameType::Hello)
+	{
+		UE_LOG(LogNexusChatRelay, Warning, TEXT("Connection #%u sent data before Hello. Closing."), Peer.ServerId);
+		Peer.bPendingKill = true;
+		return;
+	}
+
+	switch (Frame.Type)
+	{
+	case EFrameType::Hello:
+	{
+		FHello Hello;
+		if (!ReadPayload(Frame.Payload, Hello) || Hello.ProtocolVersion != PROTOCOL_VERSION)
+		{
+			UE_LOG(LogNexusChatRelay, Warning, TEXT("Connection #%u: bad Hello (version %u). Closing."), Peer.ServerId, Hello.ProtocolVersion);
+			Peer.bPendingKill = true;
+			return;
+		}
+
+		Peer.ServerName = Hello.ServerName;
+		Peer.bHandshakeDone = true;
+
+		uint32 AssignedId = Peer.ServerId;
+		Peer.Stream->QueueFrame(EFrameType::HelloAck, MakePayload(AssignedId));
+
+		UE_LOG(LogNexusChatRelay, Display, TEXT("Server #%u registered as '%s'."), Peer.ServerId, *Peer.ServerName);
+		break;
+	}
+
+	case EFrameType::PlayerOnline:
+	{
+		FPresence Presence;
+		if (ReadPayload(Frame.Payload, Presence) && !Presence.PlayerName.IsEmpty())
+		{
+			HandlePlayerOnline(Peer, Presence);
+		}
+		break;
+	}
+
+	case EFrameType::PlayerOffline:
+	{
+		FString PlayerName;
+		if (ReadPayload(Frame.Payload, PlayerName))
+		{
+			HandlePlayerOffline(Peer, PlayerName);
+		}
+		break;
+	}
+
+	case EFrameType::Batch:
+	{
+		TArray<FMessage> Messages;
+		if (!ReadBatchPayload(Frame.Payload, Messages))
+		{
+			UE_LOG(LogNexusChatRelay, Warning, TEXT("Server #%u sent a malformed batch. Closing."), Peer.ServerId);
+			Peer.bPendingKill = true;
+			return;
+		}
+
+		Peer.MessagesIn += Messages.Num();
+		for (FMessage& Msg : Messages)
+		{
+			RouteMessage(Peer, Msg);
+		}
+		break;
+	}
+
+	default:
+		break;
+	}
+}
+
+void FNexusChatRelayServer::HandlePlayerOnline(FNexusRelayPeer& Peer, const FPresence& Presence)
+{
+	// Player moved servers without a clean Offline : detach from the previous one
+	if (const uint32* PreviousServer = PlayerLocations.Find(Presence.PlayerName))
+	{
+		if (*PreviousServer != Peer.ServerId)
+		{
+			if (TUniquePtr<FNexusRelayPeer>* Previous = Peers.Find(*PreviousServer))
+			{
+				(*Previous)->Players.Remove(Presence.PlayerName);
+			}
+		}
+	}
+
+	FString PreviousGuild;
+	if (PlayerGuilds.RemoveAndCopyValue(Presence.PlayerName, PreviousGuild))
+	{
+		RemoveGuildMember(PreviousGuild, PlayerLocations.FindRef(Presence.PlayerName));
+	}
+
+	PlayerLocations.Add(Presence.PlayerName, Peer.ServerId);
+	Peer.Players.Add(Presence.PlayerName);
+
+	if (!Presence.GuildName.IsEmpty())
+	{
+		PlayerGuilds.Add(Presence.PlayerName, Presence.GuildName);
+		AddGuildMember(Presence.GuildName, Peer.ServerId);
+	}
+}
+
+void FNexusChatRelayServer::HandlePlayerOffline(FNexusRelayPeer& Peer, const FString& PlayerName)
+{
+	const uint32* Location = PlayerLocations.Find(PlayerName);
+	if (!Location || *Location != Peer.ServerId)
+		return;
+
+	PlayerLocations.Remove(PlayerName);
+	Peer.Players.Remove(PlayerName);
+
+	FString GuildName;
+	if (PlayerGuilds.RemoveAndCopyValue(PlayerName, GuildName))
+	{
+		RemoveGuildMember(GuildName, Peer.ServerId);
+	}
+}
+
+// ──────────────────────────────────────────────
+// ROUTING
+// ──────────────────────────────────────────────
+
+void FNexusChatRelayServer::RouteMessage(FNexusRelayPeer& Origin, FMessage& Msg)
+{
+	Msg.OriginServerId = Origin.ServerId;
+
+	switch (Msg.Route)
+	{
+	case ERoute::Global:
+	{
+		// Origin already delivered locally
+		for (auto& Pair : Peers)
+		{
+			if (Pair.Key != Origin.ServerId && Pair.Value->bHandshakeDone && !Pair.Value->bPendingKill)
+			{
+				EnqueueForPeer(*Pair.Value, Msg);
+			}
+		}
+		break;
+	}
+
+	case ERoute::Guild:
+	{
+		if (const TMap<uint32, int32>* Servers = GuildServers.Find(Msg.Target))
+		{
+			for (const auto& Pair : *Servers)
+			{
+				if (Pair.Key == Origin.ServerId)
+					continue;
+
+				if (TUniquePtr<FNexusRelayPeer>* Peer = Peers.Find(Pair.Key))
+				{
+					EnqueueForPeer(**Peer, Msg);
+				}
+			}
+		}
+		break;
+	}
+
+	case ERoute::Whisper:
+	{
+		const uint32* Location = PlayerLocations.Find(Msg.Target);
+		if (!Location || *Location == Origin.ServerId)
+			break;
+
+		if (TUniquePtr<FNexusRelayPeer>* Peer = Peers.Find(*Location))
+		{
+			EnqueueForPeer(**Peer, Msg);
+		}
+		break;
+	}
+
+	default:
+		break;
+	}
+}
+
+void FNexusChatRelayServer::EnqueueForPeer(FNexusRelayPeer& Peer, const FMessage& Msg)
+{
+	if (Peer.bPendingKill)
+		return;
+
+	const int32 Backlog = Peer.GetBacklogBytes();
+
+	if (Backlog >= Settings.HardQueueBytes)
+	{
+		UE_LOG(LogNexusChatRelay, Warning, TEXT("Server #%u (%s) exceeded hard queue limit (%d bytes). Disconnecting."),
+			Peer.ServerId, *Peer.ServerName, Backlog);
+		Peer.bPendingKill = true;
+		return;
+	}
+
+	// Global is the only lossy route : whispers and guild chat still go through until the hard limit
+	if (Backlog >= Settings.SoftQueueBytes && Msg.Route == ERoute::Global)
+	{
+		Peer.MessagesDropped++;
+		TotalDropped++;
+		return;
+	}
+
+	Peer.PendingBatch.Add(Msg);
+	Peer.PendingBatchBytes += Msg.GetApproximateSize();
+	Peer.MessagesOut++;
+	TotalRouted++;
+}
+
+void FNexusChatRelayServer::AddGuildMember(const FString& GuildName, uint32 ServerId)
+{
+	GuildServers.FindOrAdd(GuildName).FindOrAdd(ServerId)++;
+}
+
+void FNexusChatRelayServer::RemoveGuildMember(const FString& GuildName, uint32 ServerId)
+{
+	TMap<uint32, int32>* Servers = GuildServers.Find(GuildName);
+	if (!Servers)
+		return;
+
+	if (int32* Count = Servers->Find(ServerId))
+	{
+		if (--(*Count) <= 0)
+		{
+			Servers->Remove(ServerId);
+		}
+	}
+
+	if (Servers->IsEmpty())
+	{
+		GuildServers.Remove(GuildName);
+	}
+}
+
+void FNexusChatRelayServer::LogStats()
+{
+	UE_LOG(LogNexusChatRelay, Display, TEXT("Stats: %d servers, %d players, %d guilds, %llu routed, %llu dropped."),
+		Peers.Num(), PlayerLocations.Num(), GuildServers.Num(), TotalRouted, TotalDropped);
+
+	for (const auto& Pair : Peers)
+	{
+		const FNexusRelayPeer& Peer = *Pair.Value;
+		UE_LOG(LogNexusChatRelay, Display, TEXT("  #%u %-20s players=%d backlog=%dB in=%llu out=%llu dropped=%llu"),
+			Peer.ServerId, *Peer.ServerName, Peer.Players.Num(), Peer.GetBacklogBytes(), Peer.MessagesIn, Peer.MessagesOut, Peer.MessagesDropped);
+	}
+}
@@ -0,0 +1,107 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Relay/NexusChatRelayProtocol.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogNexusChatRelay, Log, All);
+
+
+/**
+ * One connected game server.
+ */
+struct FNexusRelayPeer
+{
+	uint32 ServerId = 0;
+	FString ServerName;
+	FString RemoteAddress;
+	TUniquePtr<NexusChatRelay::FStream> Stream;
+
+	bool bHandshakeDone = false;
+	bool bPendingKill = false;
+
+	/** Messages routed to this peer since the last flush, sent as Batch frames (see QueueBatchFrames). */
+	TArray<NexusChatRelay::FMessage> PendingBatch;
+	int32 PendingBatchBytes = 0;
+
+	/** Players currently hosted by this peer (for cleanup on disconnect). */
+	TSet<FString> Players;
+
+	uint64 MessagesIn = 0;
+	uint64 MessagesOut = 0;
+	uint64 MessagesDropped = 0;
+
+	int32 GetBacklogBytes() const { return (Stream ? Stream->GetQueuedBytes() : 0) + PendingBatchBytes; }
+};
+
+
+/**
+ * Routes Global, Guild and Whisper chat between game servers.
+ *
+ * Single-threaded : everything happens inside Tick(), called by the program main loop.
+ * Backpressure is per connection : above SoftQueueBytes, Global traffic for that peer is shed,
+ * above HardQueueBytes the peer is disconnected (it will reconnect and re-announce its players).
+ */
+class FNexusChatRelayServer
+{
+public:
+	struct FSettings
+	{
+		FString BindAddress = TEXT("127.0.0.1");
+		int32 Port = NexusChatRelay::DEFAULT_PORT;
+		int32 SoftQueueBytes = 256 * 1024;
+		int32 HardQueueBytes = 4 * 1024 * 1024;
+		int32 MaxBatchMessages = 128;
+		double StatsInterval = 30.0;
+	};
+
+	explicit FNexusChatRelayServer(const FSettings& InSettings);
+	~FNexusChatRelayServer();
+
+	bool Start();
+	void Stop();
+	void Tick();
+
+private:
+	// ───────────────────────────────
+	// Connections
+	// ───────────────────────────────
+	void AcceptPendingConnections();
+	void ReceiveFromPeer(FNexusRelayPeer& Peer);
+	void FlushPeer(FNexusRelayPeer& Peer);
+	void RemovePeer(uint32 ServerId);
+
+	// ───────────────────────────────
+	// Protocol
+	// ───────────────────────────────
+	void HandleFrame(FNexusRelayPeer& Peer, const NexusChatRelay::FFrame& Frame);
+	void HandlePlayerOnline(FNexusRelayPeer& Peer, const NexusChatRelay::FPresence& Presence);
+	void HandlePlayerOffline(FNexusRelayPeer& Peer, const FString& PlayerName);
+
+	// ───────────────────────────────
+	// Routing
+	// ───────────────────────────────
+	void RouteMessage(FNexusRelayPeer& Origin, NexusChatRelay::FMessage& Msg);
+	void EnqueueForPeer(FNexusRelayPeer& Peer, const NexusChatRelay::FMessage& Msg);
+	void AddGuildMember(const FString& GuildName, uint32 ServerId);
+	void RemoveGuildMember(const FString& GuildName, uint32 ServerId);
+
+	void LogStats();
+
+	FSettings Settings;
+	FSocket* ListenSocket = nullptr;
+
+	uint32 NextServerId = 1;
+	TMap<uint32, TUniquePtr<FNexusRelayPeer>> Peers;
+
+	/** PlayerName -> ServerId hosting that player. */
+	TMap<FString, uint32> PlayerLocations;
+
+	/** PlayerName -> GuildName. */
+	TMap<FString, FString> PlayerGuilds;
+
+	/** GuildName -> (ServerId -> members on that server). */
+	TMap<FString, TMap<uint32, int32>> GuildServers;
+
+	double LastStatsTime = 0.0;
+	uint64 TotalRouted = 0;
+	uint64 TotalDropped = 0;
+};